@@ -33,8 +33,13 @@
 
 #include "api/cvc4cpp.h"
 
+#include <chrono>
+#include <condition_variable>
 #include <cstring>
+#include <exception>
+#include <mutex>
 #include <sstream>
+#include <thread>
 
 #include "base/check.h"
 #include "base/configuration.h"
@@ -54,6 +59,7 @@
 #include "theory/logic_info.h"
 #include "theory/theory_model.h"
 #include "util/random.h"
+#include "util/resource_manager.h"
 #include "util/result.h"
 #include "util/utility.h"
 
@@ -620,7 +626,15 @@ uint32_t minArity(Kind k)
 {
   Assert(isDefinedKind(k));
   Assert(isDefinedIntKind(extToIntKind(k)));
-  return CVC4::ExprManager::minArity(extToIntKind(k));
+  uint32_t min = CVC4::ExprManager::minArity(extToIntKind(k));
+
+  // At the API level, we treat functions/constructors/selectors/testers as
+  // normal terms instead of making them part of the operator
+  if (isApplyKind(extToIntKind(k)))
+  {
+    min++;
+  }
+  return min;
 }
 
 uint32_t maxArity(Kind k)
@@ -641,6 +655,114 @@ uint32_t maxArity(Kind k)
   return max;
 }
 
+/**
+ * The owner of the node or type node that is wrapped by a Term or a Sort.
+ * Terms and sorts are released wherever the user drops them, hence the node
+ * is released in the scope of the node manager of its solver.
+ */
+template <class T>
+struct NodeOwner
+{
+  NodeOwner(NodeManager* nm, const T& n) : d_nm(nm), d_node(n) {}
+  ~NodeOwner()
+  {
+    NodeManagerScope scope(d_nm);
+    d_node = T::null();
+  }
+  /* The node manager of the solver. */
+  NodeManager* d_nm;
+  /* The owned node. */
+  T d_node;
+};
+
+/**
+ * Create the shared pointer that is wrapped by a Term or a Sort, with a single
+ * allocation for the owner and the reference count.
+ */
+template <class T>
+std::shared_ptr<T> mkNodePtr(NodeManager* nm, const T& n)
+{
+  std::shared_ptr<NodeOwner<T>> owner = std::make_shared<NodeOwner<T>>(nm, n);
+  return std::shared_ptr<T>(owner, &owner->d_node);
+}
+
+/** Whether mkTermHelper() makes terms of kind left-associative */
+bool isLeftAssociative(Kind kind)
+{
+  return kind == INTS_DIVISION || kind == XOR || kind == MINUS
+         || kind == DIVISION || kind == BITVECTOR_XNOR || kind == HO_APPLY;
+}
+
+/** Whether mkTermHelper() makes terms of kind chainable */
+bool isChainable(Kind kind)
+{
+  return kind == EQUAL || kind == LT || kind == GT || kind == LEQ
+         || kind == GEQ;
+}
+
+/**
+ * Make the node of the API kind with the given children. This handles the
+ * cases of left/right associative operators, chainable operators, and cases
+ * when the number of children exceeds the maximum arity for the kind. The
+ * children must be valid for the kind.
+ */
+Node mkNodeHelper(NodeManager* nm, Kind kind, std::vector<Node>& children)
+{
+  CVC4::Kind k = extToIntKind(kind);
+  size_t size = children.size();
+  if (size > 2)
+  {
+    if (isLeftAssociative(kind))
+    {
+      Node n = children[0];
+      for (size_t i = 1; i < size; i++)
+      {
+        n = nm->mkNode(k, n, children[i]);
+      }
+      return n;
+    }
+    else if (kind == IMPLIES)
+    {
+      Node n = children[size - 1];
+      for (size_t i = size - 1; i > 0;)
+      {
+        n = nm->mkNode(k, children[--i], n);
+      }
+      return n;
+    }
+    else if (isChainable(kind))
+    {
+      std::vector<Node> cchildren;
+      for (size_t i = 0; i < size - 1; i++)
+      {
+        cchildren.push_back(nm->mkNode(k, children[i], children[i + 1]));
+      }
+      return nm->mkNode(CVC4::kind::AND, cchildren);
+    }
+  }
+  if (kind::isAssociative(k))
+  {
+    // split the children into nodes of the maximal arity, as
+    // ExprManager::mkAssociative() does
+    const size_t max = CVC4::ExprManager::maxArity(k);
+    while (children.size() > max)
+    {
+      std::vector<Node> next;
+      size_t i = 0;
+      for (size_t csize = children.size(); csize - i > max; i += max)
+      {
+        next.push_back(nm->mkNode(
+            k,
+            std::vector<Node>(children.begin() + i,
+                              children.begin() + i + max)));
+      }
+      next.insert(next.end(), children.begin() + i, children.end());
+      children.swap(next);
+    }
+  }
+  return nm->mkNode(k, children);
+}
+
 }  // namespace
 
 std::string kindToString(Kind k)
@@ -754,6 +876,11 @@ class CVC4ApiExceptionStream
   CVC4_API_CHECK(this == term.d_solver)  \
       << "Given term is not associated with this solver";
 
+#define CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK                                   \
+  CVC4_API_CHECK(d_asyncCheck == nullptr || d_asyncCheck->isFinished())        \
+      << "Cannot use the SMT engine while an asynchronous check is in "        \
+         "progress";
+
 #define CVC4_API_SOLVER_CHECK_OP(op)  \
   CVC4_API_CHECK(this == op.d_solver) \
       << "Given operator is not associated with this solver";
@@ -838,16 +965,202 @@ std::ostream& operator<<(std::ostream& out, const Result& r)
   return out;
 }
 
+/* -------------------------------------------------------------------------- */
+/* AsyncResult                                                                */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * A satisfiability check that is run by Solver::checkSatAsync() on a thread
+ * of its own. Its result is set by that thread, and waited for by the
+ * threads that hold a handle to it.
+ */
+class AsyncCheck
+{
+ public:
+  AsyncCheck(ResourceManager* rm) : d_resourceManager(rm), d_finished(false)
+  {
+  }
+
+  ~AsyncCheck() { join(); }
+
+  /**
+   * Set the result of this check, or the exception it failed with, and wake
+   * up the threads waiting for it.
+   */
+  void finish(const CVC4::Result& r, std::exception_ptr e)
+  {
+    {
+      std::lock_guard<std::mutex> lock(d_mutex);
+      d_finished = true;
+      d_result = Result(r);
+      d_exception = e;
+      // a cancellation that came too late must not interrupt the next check
+      d_resourceManager->clearInterrupt();
+    }
+    d_finishedCond.notify_all();
+  }
+
+  bool isFinished() const
+  {
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_finished;
+  }
+
+  void wait() const
+  {
+    std::unique_lock<std::mutex> lock(d_mutex);
+    d_finishedCond.wait(lock, [this]() { return d_finished; });
+  }
+
+  bool waitFor(uint64_t millis) const
+  {
+    std::unique_lock<std::mutex> lock(d_mutex);
+    return d_finishedCond.wait_for(lock,
+                                   std::chrono::milliseconds(millis),
+                                   [this]() { return d_finished; });
+  }
+
+  Result getResult() const
+  {
+    wait();
+    if (d_exception != nullptr)
+    {
+      std::rethrow_exception(d_exception);
+    }
+    return d_result;
+  }
+
+  void cancel()
+  {
+    std::lock_guard<std::mutex> lock(d_mutex);
+    if (!d_finished)
+    {
+      d_resourceManager->interrupt();
+    }
+  }
+
+  /** Wait for the thread of this check to terminate. */
+  void join()
+  {
+    if (d_thread.joinable())
+    {
+      d_thread.join();
+    }
+  }
+
+  /** The thread that runs this check. */
+  std::thread d_thread;
+
+ private:
+  /** The resource manager of the solver, which handles the cancellation. */
+  ResourceManager* d_resourceManager;
+  /** Protects the members below. */
+  mutable std::mutex d_mutex;
+  /** Notified when this check is finished. */
+  mutable std::condition_variable d_finishedCond;
+  /** Whether this check is finished. */
+  bool d_finished;
+  /** The result of this check, if it is finished. */
+  Result d_result;
+  /** The exception this check failed with, if any. */
+  std::exception_ptr d_exception;
+};
+
+namespace {
+
+/** Reports the progress of an asynchronous check to its callback. */
+class ProgressListener : public Listener
+{
+ public:
+  ProgressListener(ResourceManager* rm,
+                   const std::function<void(const CheckProgress&)>& progress)
+      : d_resourceManager(rm),
+        d_progress(progress),
+        d_start(std::chrono::steady_clock::now())
+  {
+  }
+
+  void notify() override
+  {
+    CheckProgress p;
+    p.d_decisions = d_resourceManager->getResourceCount(
+        ResourceManager::Resource::DecisionStep);
+    p.d_conflicts = d_resourceManager->getResourceCount(
+        ResourceManager::Resource::SatConflictStep);
+    p.d_lemmas = d_resourceManager->getResourceCount(
+        ResourceManager::Resource::LemmaStep);
+    p.d_resourceUnits = d_resourceManager->getResourceUsage();
+    p.d_millis = std::chrono::duration_cast<std::chrono::milliseconds>(
+                     std::chrono::steady_clock::now() - d_start)
+                     .count();
+    d_progress(p);
+  }
+
+ private:
+  ResourceManager* d_resourceManager;
+  std::function<void(const CheckProgress&)> d_progress;
+  std::chrono::steady_clock::time_point d_start;
+};
+
+}  // namespace
+
+AsyncResult::AsyncResult() : d_check(nullptr) {}
+
+AsyncResult::AsyncResult(const std::shared_ptr<AsyncCheck>& check)
+    : d_check(check)
+{
+}
+
+bool AsyncResult::isNullHelper() const { return d_check == nullptr; }
+
+bool AsyncResult::isNull() const { return isNullHelper(); }
+
+bool AsyncResult::isReady() const
+{
+  CVC4_API_CHECK_NOT_NULL;
+  return d_check->isFinished();
+}
+
+void AsyncResult::wait() const
+{
+  CVC4_API_CHECK_NOT_NULL;
+  d_check->wait();
+}
+
+bool AsyncResult::waitFor(uint64_t millis) const
+{
+  CVC4_API_CHECK_NOT_NULL;
+  return d_check->waitFor(millis);
+}
+
+Result AsyncResult::getResult() const
+{
+  CVC4_API_CHECK_NOT_NULL;
+  return d_check->getResult();
+}
+
+void AsyncResult::cancel() const
+{
+  CVC4_API_CHECK_NOT_NULL;
+  d_check->cancel();
+}
+
 /* -------------------------------------------------------------------------- */
 /* Sort                                                                       */
 /* -------------------------------------------------------------------------- */
 
 Sort::Sort(const Solver* slv, const CVC4::Type& t)
-    : d_solver(slv), d_type(new CVC4::Type(t))
+    : d_solver(slv),
+      d_type(mkNodePtr(slv->getNodeManager(), TypeNode::fromType(t)))
 {
 }
 
-Sort::Sort() : d_solver(nullptr), d_type(new CVC4::Type()) {}
+Sort::Sort(const Solver* slv, const CVC4::TypeNode& t)
+    : d_solver(slv), d_type(mkNodePtr(slv->getNodeManager(), t))
+{
+}
+
+Sort::Sort() : d_solver(nullptr), d_type(std::make_shared<CVC4::TypeNode>()) {}
 
 Sort::~Sort() {}
 
@@ -893,8 +1206,7 @@ bool Sort::isDatatype() const { return d_type->isDatatype(); }
 
 bool Sort::isParametricDatatype() const
 {
-  if (!d_type->isDatatype()) return false;
-  return DatatypeType(*d_type).isParametric();
+  return d_type->isParametricDatatype();
 }
 
 bool Sort::isConstructor() const { return d_type->isConstructor(); }
@@ -905,77 +1217,125 @@ bool Sort::isFunction() const { return d_type->isFunction(); }
 
 bool Sort::isPredicate() const { return d_type->isPredicate(); }
 
-bool Sort::isTuple() const { return d_type->isTuple(); }
+bool Sort::isTuple() const
+{
+  if (!d_type->isDatatype()) return false;
+  NodeManagerScope scope(d_solver->getNodeManager());
+  return d_type->isTuple();
+}
 
-bool Sort::isRecord() const { return d_type->isRecord(); }
+bool Sort::isRecord() const
+{
+  if (!d_type->isDatatype()) return false;
+  return getType().isRecord();
+}
 
 bool Sort::isArray() const { return d_type->isArray(); }
 
 bool Sort::isSet() const { return d_type->isSet(); }
 
-bool Sort::isUninterpretedSort() const { return d_type->isSort(); }
+bool Sort::isUninterpretedSort() const
+{
+  if (d_type->getKind() != CVC4::Kind::SORT_TYPE) return false;
+  NodeManagerScope scope(d_solver->getNodeManager());
+  return d_type->isSort();
+}
 
-bool Sort::isSortConstructor() const { return d_type->isSortConstructor(); }
+bool Sort::isSortConstructor() const
+{
+  if (d_type->getKind() != CVC4::Kind::SORT_TYPE) return false;
+  NodeManagerScope scope(d_solver->getNodeManager());
+  return d_type->isSortConstructor();
+}
 
-bool Sort::isFirstClass() const { return d_type->isFirstClass(); }
+bool Sort::isFirstClass() const
+{
+  if (d_type->isNull()) return true;
+  NodeManagerScope scope(d_solver->getNodeManager());
+  return d_type->isFirstClass();
+}
 
 bool Sort::isFunctionLike() const { return d_type->isFunctionLike(); }
 
-bool Sort::isSubsortOf(Sort s) const { return d_type->isSubtypeOf(*s.d_type); }
+bool Sort::isSubsortOf(Sort s) const
+{
+  if (*d_type == *s.d_type) return true;
+  if (d_type->isNull() || s.d_type->isNull()) return false;
+  NodeManagerScope scope(d_solver->getNodeManager());
+  return d_type->isSubtypeOf(*s.d_type);
+}
 
 bool Sort::isComparableTo(Sort s) const
 {
+  if (*d_type == *s.d_type) return true;
+  if (d_type->isNull() || s.d_type->isNull()) return false;
+  NodeManagerScope scope(d_solver->getNodeManager());
   return d_type->isComparableTo(*s.d_type);
 }
 
 Datatype Sort::getDatatype() const
 {
   CVC4_API_CHECK(isDatatype()) << "Expected datatype sort.";
-  return Datatype(d_solver, DatatypeType(*d_type).getDatatype());
+  return Datatype(d_solver, DatatypeType(getType()).getDatatype());
 }
 
 Sort Sort::instantiate(const std::vector<Sort>& params) const
 {
   CVC4_API_CHECK(isParametricDatatype() || isSortConstructor())
       << "Expected parametric datatype or sort constructor sort.";
-  std::vector<Type> tparams;
-  for (const Sort& s : params)
-  {
-    tparams.push_back(*s.d_type.get());
-  }
+  std::vector<Type> tparams = sortVectorToTypes(params);
   if (d_type->isDatatype())
   {
-    return Sort(d_solver, DatatypeType(*d_type).instantiate(tparams));
+    return Sort(d_solver, DatatypeType(getType()).instantiate(tparams));
   }
   Assert(d_type->isSortConstructor());
-  return Sort(d_solver, SortConstructorType(*d_type).instantiate(tparams));
+  return Sort(d_solver, SortConstructorType(getType()).instantiate(tparams));
 }
 
-std::string Sort::toString() const { return d_type->toString(); }
+std::string Sort::toString() const
+{
+  // null sorts are printed without a node manager
+  NodeManagerScope scope(d_solver == nullptr ? nullptr
+                                             : d_solver->getNodeManager());
+  std::stringstream ss;
+  ss << *d_type;
+  return ss.str();
+}
 
 // !!! This is only temporarily available until the parser is fully migrated
 // to the new API. !!!
-CVC4::Type Sort::getType(void) const { return *d_type; }
+CVC4::Type Sort::getType(void) const
+{
+  if (d_solver == nullptr)
+  {
+    return CVC4::Type();
+  }
+  return d_solver->getNodeManager()->toType(*d_type);
+}
 
 /* Constructor sort ------------------------------------------------------- */
 
 size_t Sort::getConstructorArity() const
 {
   CVC4_API_CHECK(isConstructor()) << "Not a function sort: " << (*this);
-  return ConstructorType(*d_type).getArity();
+  return d_type->getNumChildren() - 1;
 }
 
 std::vector<Sort> Sort::getConstructorDomainSorts() const
 {
   CVC4_API_CHECK(isConstructor()) << "Not a function sort: " << (*this);
-  std::vector<CVC4::Type> types = ConstructorType(*d_type).getArgTypes();
-  return typeVectorToSorts(d_solver, types);
+  std::vector<Sort> sorts;
+  for (const TypeNode& t : d_type->getArgTypes())
+  {
+    sorts.push_back(Sort(d_solver, t));
+  }
+  return sorts;
 }
 
 Sort Sort::getConstructorCodomainSort() const
 {
   CVC4_API_CHECK(isConstructor()) << "Not a function sort: " << (*this);
-  return Sort(d_solver, ConstructorType(*d_type).getRangeType());
+  return Sort(d_solver, d_type->getRangeType());
 }
 
 /* Function sort ------------------------------------------------------- */
@@ -983,20 +1343,24 @@ Sort Sort::getConstructorCodomainSort() const
 size_t Sort::getFunctionArity() const
 {
   CVC4_API_CHECK(isFunction()) << "Not a function sort: " << (*this);
-  return FunctionType(*d_type).getArity();
+  return d_type->getNumChildren() - 1;
 }
 
 std::vector<Sort> Sort::getFunctionDomainSorts() const
 {
   CVC4_API_CHECK(isFunction()) << "Not a function sort: " << (*this);
-  std::vector<CVC4::Type> types = FunctionType(*d_type).getArgTypes();
-  return typeVectorToSorts(d_solver, types);
+  std::vector<Sort> sorts;
+  for (const TypeNode& t : d_type->getArgTypes())
+  {
+    sorts.push_back(Sort(d_solver, t));
+  }
+  return sorts;
 }
 
 Sort Sort::getFunctionCodomainSort() const
 {
   CVC4_API_CHECK(isFunction()) << "Not a function sort" << (*this);
-  return Sort(d_solver, FunctionType(*d_type).getRangeType());
+  return Sort(d_solver, d_type->getRangeType());
 }
 
 /* Array sort ---------------------------------------------------------- */
@@ -1004,13 +1368,13 @@ Sort Sort::getFunctionCodomainSort() const
 Sort Sort::getArrayIndexSort() const
 {
   CVC4_API_CHECK(isArray()) << "Not an array sort.";
-  return Sort(d_solver, ArrayType(*d_type).getIndexType());
+  return Sort(d_solver, d_type->getArrayIndexType());
 }
 
 Sort Sort::getArrayElementSort() const
 {
   CVC4_API_CHECK(isArray()) << "Not an array sort.";
-  return Sort(d_solver, ArrayType(*d_type).getConstituentType());
+  return Sort(d_solver, d_type->getArrayConstituentType());
 }
 
 /* Set sort ------------------------------------------------------------ */
@@ -1018,7 +1382,7 @@ Sort Sort::getArrayElementSort() const
 Sort Sort::getSetElementSort() const
 {
   CVC4_API_CHECK(isSet()) << "Not a set sort.";
-  return Sort(d_solver, SetType(*d_type).getElementType());
+  return Sort(d_solver, d_type->getSetElementType());
 }
 
 /* Uninterpreted sort -------------------------------------------------- */
@@ -1026,19 +1390,19 @@ Sort Sort::getSetElementSort() const
 std::string Sort::getUninterpretedSortName() const
 {
   CVC4_API_CHECK(isUninterpretedSort()) << "Not an uninterpreted sort.";
-  return SortType(*d_type).getName();
+  return SortType(getType()).getName();
 }
 
 bool Sort::isUninterpretedSortParameterized() const
 {
   CVC4_API_CHECK(isUninterpretedSort()) << "Not an uninterpreted sort.";
-  return SortType(*d_type).isParameterized();
+  return SortType(getType()).isParameterized();
 }
 
 std::vector<Sort> Sort::getUninterpretedSortParamSorts() const
 {
   CVC4_API_CHECK(isUninterpretedSort()) << "Not an uninterpreted sort.";
-  std::vector<CVC4::Type> types = SortType(*d_type).getParamTypes();
+  std::vector<CVC4::Type> types = SortType(getType()).getParamTypes();
   return typeVectorToSorts(d_solver, types);
 }
 
@@ -1047,13 +1411,13 @@ std::vector<Sort> Sort::getUninterpretedSortParamSorts() const
 std::string Sort::getSortConstructorName() const
 {
   CVC4_API_CHECK(isSortConstructor()) << "Not a sort constructor sort.";
-  return SortConstructorType(*d_type).getName();
+  return SortConstructorType(getType()).getName();
 }
 
 size_t Sort::getSortConstructorArity() const
 {
   CVC4_API_CHECK(isSortConstructor()) << "Not a sort constructor sort.";
-  return SortConstructorType(*d_type).getArity();
+  return SortConstructorType(getType()).getArity();
 }
 
 /* Bit-vector sort ----------------------------------------------------- */
@@ -1061,7 +1425,7 @@ size_t Sort::getSortConstructorArity() const
 uint32_t Sort::getBVSize() const
 {
   CVC4_API_CHECK(isBitVector()) << "Not a bit-vector sort.";
-  return BitVectorType(*d_type).getSize();
+  return d_type->getBitVectorSize();
 }
 
 /* Floating-point sort ------------------------------------------------- */
@@ -1069,13 +1433,13 @@ uint32_t Sort::getBVSize() const
 uint32_t Sort::getFPExponentSize() const
 {
   CVC4_API_CHECK(isFloatingPoint()) << "Not a floating-point sort.";
-  return FloatingPointType(*d_type).getExponentSize();
+  return d_type->getFloatingPointExponentSize();
 }
 
 uint32_t Sort::getFPSignificandSize() const
 {
   CVC4_API_CHECK(isFloatingPoint()) << "Not a floating-point sort.";
-  return FloatingPointType(*d_type).getSignificandSize();
+  return d_type->getFloatingPointSignificandSize();
 }
 
 /* Datatype sort ------------------------------------------------------- */
@@ -1083,14 +1447,14 @@ uint32_t Sort::getFPSignificandSize() const
 std::vector<Sort> Sort::getDatatypeParamSorts() const
 {
   CVC4_API_CHECK(isParametricDatatype()) << "Not a parametric datatype sort.";
-  std::vector<CVC4::Type> types = DatatypeType(*d_type).getParamTypes();
+  std::vector<CVC4::Type> types = DatatypeType(getType()).getParamTypes();
   return typeVectorToSorts(d_solver, types);
 }
 
 size_t Sort::getDatatypeArity() const
 {
   CVC4_API_CHECK(isDatatype()) << "Not a datatype sort.";
-  return DatatypeType(*d_type).getArity();
+  return DatatypeType(getType()).getArity();
 }
 
 /* Tuple sort ---------------------------------------------------------- */
@@ -1098,13 +1462,13 @@ size_t Sort::getDatatypeArity() const
 size_t Sort::getTupleLength() const
 {
   CVC4_API_CHECK(isTuple()) << "Not a tuple sort.";
-  return DatatypeType(*d_type).getTupleLength();
+  return DatatypeType(getType()).getTupleLength();
 }
 
 std::vector<Sort> Sort::getTupleSorts() const
 {
   CVC4_API_CHECK(isTuple()) << "Not a tuple sort.";
-  std::vector<CVC4::Type> types = DatatypeType(*d_type).getTupleTypes();
+  std::vector<CVC4::Type> types = DatatypeType(getType()).getTupleTypes();
   return typeVectorToSorts(d_solver, types);
 }
 
@@ -1118,7 +1482,7 @@ std::ostream& operator<<(std::ostream& out, const Sort& s)
 
 size_t SortHashFunction::operator()(const Sort& s) const
 {
-  return TypeHashFunction()(*s.d_type);
+  return TypeNodeHashFunction()(*s.d_type);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -1349,10 +1713,15 @@ size_t OpHashFunction::operator()(const Op& t) const
 /* Term                                                                       */
 /* -------------------------------------------------------------------------- */
 
-Term::Term() : d_solver(nullptr), d_expr(new CVC4::Expr()) {}
+Term::Term() : d_solver(nullptr), d_node(std::make_shared<CVC4::Node>()) {}
 
 Term::Term(const Solver* slv, const CVC4::Expr& e)
-    : d_solver(slv), d_expr(new CVC4::Expr(e))
+    : d_solver(slv), d_node(mkNodePtr(slv->getNodeManager(), Node::fromExpr(e)))
+{
+}
+
+Term::Term(const Solver* slv, const CVC4::Node& n)
+    : d_solver(slv), d_node(mkNodePtr(slv->getNodeManager(), n))
 {
 }
 
@@ -1361,67 +1730,68 @@ Term::~Term() {}
 bool Term::isNullHelper() const
 {
   /* Split out to avoid nested API calls (problematic with API tracing). */
-  return d_expr->isNull();
+  return d_node->isNull();
 }
 
-bool Term::operator==(const Term& t) const { return *d_expr == *t.d_expr; }
+bool Term::operator==(const Term& t) const { return *d_node == *t.d_node; }
 
-bool Term::operator!=(const Term& t) const { return *d_expr != *t.d_expr; }
+bool Term::operator!=(const Term& t) const { return *d_node != *t.d_node; }
 
-bool Term::operator<(const Term& t) const { return *d_expr < *t.d_expr; }
+bool Term::operator<(const Term& t) const { return *d_node < *t.d_node; }
 
-bool Term::operator>(const Term& t) const { return *d_expr > *t.d_expr; }
+bool Term::operator>(const Term& t) const { return *d_node > *t.d_node; }
 
-bool Term::operator<=(const Term& t) const { return *d_expr <= *t.d_expr; }
+bool Term::operator<=(const Term& t) const { return *d_node <= *t.d_node; }
 
-bool Term::operator>=(const Term& t) const { return *d_expr >= *t.d_expr; }
+bool Term::operator>=(const Term& t) const { return *d_node >= *t.d_node; }
 
 size_t Term::getNumChildren() const
 {
   CVC4_API_CHECK_NOT_NULL;
   // special case for apply kinds
-  if (isApplyKind(d_expr->getKind()))
+  if (isApplyKind(d_node->getKind()))
   {
-    return d_expr->getNumChildren() + 1;
+    return d_node->getNumChildren() + 1;
   }
-  return d_expr->getNumChildren();
+  return d_node->getNumChildren();
 }
 
 Term Term::operator[](size_t index) const
 {
   CVC4_API_CHECK_NOT_NULL;
   // special cases for apply kinds
-  if (isApplyKind(d_expr->getKind()))
+  if (isApplyKind(d_node->getKind()))
   {
-    CVC4_API_CHECK(d_expr->hasOperator())
+    CVC4_API_CHECK(d_node->hasOperator())
         << "Expected apply kind to have operator when accessing child of Term";
     if (index == 0)
     {
-      // return the operator
-      return Term(d_solver, d_expr->getOperator());
+      // return the operator, which is a term for the apply kinds
+      return Term(d_solver, d_node->getOperator());
     }
     // otherwise we are looking up child at (index-1)
     index--;
   }
-  return Term(d_solver, (*d_expr)[index]);
+  return Term(d_solver, (*d_node)[index]);
 }
 
 uint64_t Term::getId() const
 {
   CVC4_API_CHECK_NOT_NULL;
-  return d_expr->getId();
+  return d_node->getId();
 }
 
 Kind Term::getKind() const
 {
   CVC4_API_CHECK_NOT_NULL;
-  return intToExtKind(d_expr->getKind());
+  return intToExtKind(d_node->getKind());
 }
 
 Sort Term::getSort() const
 {
   CVC4_API_CHECK_NOT_NULL;
-  return Sort(d_solver, d_expr->getType());
+  NodeManagerScope scope(d_solver->getNodeManager());
+  return Sort(d_solver, d_node->getType());
 }
 
 Term Term::substitute(Term e, Term replacement) const
@@ -1433,7 +1803,9 @@ Term Term::substitute(Term e, Term replacement) const
       << "Expected non-null term as replacement in substitute";
   CVC4_API_CHECK(e.getSort().isComparableTo(replacement.getSort()))
       << "Expecting terms of comparable sort in substitute";
-  return Term(d_solver, d_expr->substitute(e.getExpr(), replacement.getExpr()));
+  NodeManagerScope scope(d_solver->getNodeManager());
+  return Term(d_solver,
+              d_node->substitute(TNode(*e.d_node), TNode(*replacement.d_node)));
 }
 
 Term Term::substitute(const std::vector<Term> es,
@@ -1442,6 +1814,8 @@ Term Term::substitute(const std::vector<Term> es,
   CVC4_API_CHECK_NOT_NULL;
   CVC4_API_CHECK(es.size() == replacements.size())
       << "Expecting vectors of the same arity in substitute";
+  std::vector<Node> nodes;
+  std::vector<Node> rnodes;
   for (unsigned i = 0, nterms = es.size(); i < nterms; i++)
   {
     CVC4_API_CHECK(!es[i].isNull())
@@ -1450,22 +1824,25 @@ Term Term::substitute(const std::vector<Term> es,
         << "Expected non-null term as replacement in substitute";
     CVC4_API_CHECK(es[i].getSort().isComparableTo(replacements[i].getSort()))
         << "Expecting terms of comparable sort in substitute";
+    nodes.push_back(*es[i].d_node);
+    rnodes.push_back(*replacements[i].d_node);
   }
+  NodeManagerScope scope(d_solver->getNodeManager());
   return Term(d_solver,
-              d_expr->substitute(termVectorToExprs(es),
-                                 termVectorToExprs(replacements)));
+              d_node->substitute(
+                  nodes.begin(), nodes.end(), rnodes.begin(), rnodes.end()));
 }
 
 bool Term::hasOp() const
 {
   CVC4_API_CHECK_NOT_NULL;
-  return d_expr->hasOperator();
+  return d_node->hasOperator();
 }
 
 Op Term::getOp() const
 {
   CVC4_API_CHECK_NOT_NULL;
-  CVC4_API_CHECK(d_expr->hasOperator())
+  CVC4_API_CHECK(d_node->hasOperator())
       << "Expecting Term to have an Op when calling getOp()";
 
   // special cases for parameterized operators that are not indexed operators
@@ -1473,20 +1850,22 @@ Op Term::getOp() const
   // indexed operators are stored in Ops
   // whereas functions and datatype operators are terms, and the Op
   // is one of the APPLY_* kinds
-  if (isApplyKind(d_expr->getKind()))
+  if (isApplyKind(d_node->getKind()))
   {
-    return Op(d_solver, intToExtKind(d_expr->getKind()));
+    return Op(d_solver, intToExtKind(d_node->getKind()));
   }
-  else if (d_expr->isParameterized())
+  else if (d_node->getMetaKind() == kind::metakind::PARAMETERIZED)
   {
     // it's an indexed operator
     // so we should return the indexed op
-    CVC4::Expr op = d_expr->getOperator();
-    return Op(d_solver, intToExtKind(d_expr->getKind()), op);
+    NodeManager* nm = d_solver->getNodeManager();
+    NodeManagerScope scope(nm);
+    CVC4::Expr op = nm->toExpr(d_node->getOperator());
+    return Op(d_solver, intToExtKind(d_node->getKind()), op);
   }
   else
   {
-    return Op(d_solver, intToExtKind(d_expr->getKind()));
+    return Op(d_solver, intToExtKind(d_node->getKind()));
   }
 }
 
@@ -1495,28 +1874,31 @@ bool Term::isNull() const { return isNullHelper(); }
 bool Term::isConst() const
 {
   CVC4_API_CHECK_NOT_NULL;
-  return d_expr->isConst();
+  NodeManagerScope scope(d_solver->getNodeManager());
+  return d_node->isConst();
 }
 
 Term Term::getConstArrayBase() const
 {
   CVC4_API_CHECK_NOT_NULL;
   // CONST_ARRAY kind maps to STORE_ALL internal kind
-  CVC4_API_CHECK(d_expr->getKind() == CVC4::Kind::STORE_ALL)
+  CVC4_API_CHECK(d_node->getKind() == CVC4::Kind::STORE_ALL)
       << "Expecting a CONST_ARRAY Term when calling getConstArrayBase()";
-  return Term(d_solver, d_expr->getConst<ArrayStoreAll>().getExpr());
+  return Term(d_solver, d_node->getConst<ArrayStoreAll>().getExpr());
 }
 
 Term Term::notTerm() const
 {
   CVC4_API_CHECK_NOT_NULL;
+  NodeManager* nm = d_solver->getNodeManager();
+  NodeManagerScope scope(nm);
   try
   {
-    Expr res = d_expr->notExpr();
+    Node res = nm->mkNode(CVC4::Kind::NOT, *d_node);
     (void)res.getType(true); /* kick off type checking */
     return Term(d_solver, res);
   }
-  catch (const CVC4::TypeCheckingException& e)
+  catch (const CVC4::TypeCheckingExceptionPrivate& e)
   {
     throw CVC4ApiException(e.getMessage());
   }
@@ -1526,13 +1908,15 @@ Term Term::andTerm(const Term& t) const
 {
   CVC4_API_CHECK_NOT_NULL;
   CVC4_API_ARG_CHECK_NOT_NULL(t);
+  NodeManager* nm = d_solver->getNodeManager();
+  NodeManagerScope scope(nm);
   try
   {
-    Expr res = d_expr->andExpr(*t.d_expr);
+    Node res = nm->mkNode(CVC4::Kind::AND, *d_node, *t.d_node);
     (void)res.getType(true); /* kick off type checking */
     return Term(d_solver, res);
   }
-  catch (const CVC4::TypeCheckingException& e)
+  catch (const CVC4::TypeCheckingExceptionPrivate& e)
   {
     throw CVC4ApiException(e.getMessage());
   }
@@ -1542,13 +1926,15 @@ Term Term::orTerm(const Term& t) const
 {
   CVC4_API_CHECK_NOT_NULL;
   CVC4_API_ARG_CHECK_NOT_NULL(t);
+  NodeManager* nm = d_solver->getNodeManager();
+  NodeManagerScope scope(nm);
   try
   {
-    Expr res = d_expr->orExpr(*t.d_expr);
+    Node res = nm->mkNode(CVC4::Kind::OR, *d_node, *t.d_node);
     (void)res.getType(true); /* kick off type checking */
     return Term(d_solver, res);
   }
-  catch (const CVC4::TypeCheckingException& e)
+  catch (const CVC4::TypeCheckingExceptionPrivate& e)
   {
     throw CVC4ApiException(e.getMessage());
   }
@@ -1558,13 +1944,15 @@ Term Term::xorTerm(const Term& t) const
 {
   CVC4_API_CHECK_NOT_NULL;
   CVC4_API_ARG_CHECK_NOT_NULL(t);
+  NodeManager* nm = d_solver->getNodeManager();
+  NodeManagerScope scope(nm);
   try
   {
-    Expr res = d_expr->xorExpr(*t.d_expr);
+    Node res = nm->mkNode(CVC4::Kind::XOR, *d_node, *t.d_node);
     (void)res.getType(true); /* kick off type checking */
     return Term(d_solver, res);
   }
-  catch (const CVC4::TypeCheckingException& e)
+  catch (const CVC4::TypeCheckingExceptionPrivate& e)
   {
     throw CVC4ApiException(e.getMessage());
   }
@@ -1574,13 +1962,15 @@ Term Term::eqTerm(const Term& t) const
 {
   CVC4_API_CHECK_NOT_NULL;
   CVC4_API_ARG_CHECK_NOT_NULL(t);
+  NodeManager* nm = d_solver->getNodeManager();
+  NodeManagerScope scope(nm);
   try
   {
-    Expr res = d_expr->eqExpr(*t.d_expr);
+    Node res = nm->mkNode(CVC4::Kind::EQUAL, *d_node, *t.d_node);
     (void)res.getType(true); /* kick off type checking */
     return Term(d_solver, res);
   }
-  catch (const CVC4::TypeCheckingException& e)
+  catch (const CVC4::TypeCheckingExceptionPrivate& e)
   {
     throw CVC4ApiException(e.getMessage());
   }
@@ -1590,13 +1980,15 @@ Term Term::impTerm(const Term& t) const
 {
   CVC4_API_CHECK_NOT_NULL;
   CVC4_API_ARG_CHECK_NOT_NULL(t);
+  NodeManager* nm = d_solver->getNodeManager();
+  NodeManagerScope scope(nm);
   try
   {
-    Expr res = d_expr->impExpr(*t.d_expr);
+    Node res = nm->mkNode(CVC4::Kind::IMPLIES, *d_node, *t.d_node);
     (void)res.getType(true); /* kick off type checking */
     return Term(d_solver, res);
   }
-  catch (const CVC4::TypeCheckingException& e)
+  catch (const CVC4::TypeCheckingExceptionPrivate& e)
   {
     throw CVC4ApiException(e.getMessage());
   }
@@ -1607,39 +1999,48 @@ Term Term::iteTerm(const Term& then_t, const Term& else_t) const
   CVC4_API_CHECK_NOT_NULL;
   CVC4_API_ARG_CHECK_NOT_NULL(then_t);
   CVC4_API_ARG_CHECK_NOT_NULL(else_t);
+  NodeManager* nm = d_solver->getNodeManager();
+  NodeManagerScope scope(nm);
   try
   {
-    Expr res = d_expr->iteExpr(*then_t.d_expr, *else_t.d_expr);
+    Node res =
+        nm->mkNode(CVC4::Kind::ITE, *d_node, *then_t.d_node, *else_t.d_node);
     (void)res.getType(true); /* kick off type checking */
     return Term(d_solver, res);
   }
-  catch (const CVC4::TypeCheckingException& e)
+  catch (const CVC4::TypeCheckingExceptionPrivate& e)
   {
     throw CVC4ApiException(e.getMessage());
   }
 }
 
-std::string Term::toString() const { return d_expr->toString(); }
+std::string Term::toString() const
+{
+  // null terms are printed without a node manager
+  NodeManagerScope scope(d_solver == nullptr ? nullptr
+                                             : d_solver->getNodeManager());
+  return d_node->toString();
+}
 
 Term::const_iterator::const_iterator()
-    : d_solver(nullptr), d_orig_expr(nullptr), d_pos(0)
+    : d_solver(nullptr), d_origNode(nullptr), d_pos(0)
 {
 }
 
 Term::const_iterator::const_iterator(const Solver* slv,
-                                     const std::shared_ptr<CVC4::Expr>& e,
+                                     const std::shared_ptr<CVC4::Node>& n,
                                      uint32_t p)
-    : d_solver(slv), d_orig_expr(e), d_pos(p)
+    : d_solver(slv), d_origNode(n), d_pos(p)
 {
 }
 
 Term::const_iterator::const_iterator(const const_iterator& it)
-    : d_solver(nullptr), d_orig_expr(nullptr)
+    : d_solver(nullptr), d_origNode(nullptr)
 {
-  if (it.d_orig_expr != nullptr)
+  if (it.d_origNode != nullptr)
   {
     d_solver = it.d_solver;
-    d_orig_expr = it.d_orig_expr;
+    d_origNode = it.d_origNode;
     d_pos = it.d_pos;
   }
 }
@@ -1647,18 +2048,18 @@ Term::const_iterator::const_iterator(const const_iterator& it)
 Term::const_iterator& Term::const_iterator::operator=(const const_iterator& it)
 {
   d_solver = it.d_solver;
-  d_orig_expr = it.d_orig_expr;
+  d_origNode = it.d_origNode;
   d_pos = it.d_pos;
   return *this;
 }
 
 bool Term::const_iterator::operator==(const const_iterator& it) const
 {
-  if (d_orig_expr == nullptr || it.d_orig_expr == nullptr)
+  if (d_origNode == nullptr || it.d_origNode == nullptr)
   {
     return false;
   }
-  return (d_solver == it.d_solver && *d_orig_expr == *it.d_orig_expr)
+  return (d_solver == it.d_solver && *d_origNode == *it.d_origNode)
          && (d_pos == it.d_pos);
 }
 
@@ -1669,14 +2070,14 @@ bool Term::const_iterator::operator!=(const const_iterator& it) const
 
 Term::const_iterator& Term::const_iterator::operator++()
 {
-  Assert(d_orig_expr != nullptr);
+  Assert(d_origNode != nullptr);
   ++d_pos;
   return *this;
 }
 
 Term::const_iterator Term::const_iterator::operator++(int)
 {
-  Assert(d_orig_expr != nullptr);
+  Assert(d_origNode != nullptr);
   const_iterator it = *this;
   ++d_pos;
   return it;
@@ -1684,14 +2085,14 @@ Term::const_iterator Term::const_iterator::operator++(int)
 
 Term Term::const_iterator::operator*() const
 {
-  Assert(d_orig_expr != nullptr);
+  Assert(d_origNode != nullptr);
   // this term has an extra child (mismatch between API and internal structure)
   // the extra child will be the first child
-  bool extra_child = isApplyKind(d_orig_expr->getKind());
+  bool extra_child = isApplyKind(d_origNode->getKind());
 
   if (!d_pos && extra_child)
   {
-    return Term(d_solver, d_orig_expr->getOperator());
+    return Term(d_solver, d_origNode->getOperator());
   }
   else
   {
@@ -1702,35 +2103,42 @@ Term Term::const_iterator::operator*() const
       --idx;
     }
     Assert(idx >= 0);
-    return Term(d_solver, (*d_orig_expr)[idx]);
+    return Term(d_solver, (*d_origNode)[idx]);
   }
 }
 
 Term::const_iterator Term::begin() const
 {
-  return Term::const_iterator(d_solver, d_expr, 0);
+  return Term::const_iterator(d_solver, d_node, 0);
 }
 
 Term::const_iterator Term::end() const
 {
-  int endpos = d_expr->getNumChildren();
+  int endpos = d_node->getNumChildren();
   // special cases for APPLY_*
   // the API differs from the internal structure
   // the API takes a "higher-order" perspective and the applied
   //   function or datatype constructor/selector/tester is a Term
   // which means it needs to be one of the children, even though
   //   internally it is not
-  if (isApplyKind(d_expr->getKind()))
+  if (isApplyKind(d_node->getKind()))
   {
     // one more child if this is a UF application (count the UF as a child)
     ++endpos;
   }
-  return Term::const_iterator(d_solver, d_expr, endpos);
+  return Term::const_iterator(d_solver, d_node, endpos);
 }
 
 // !!! This is only temporarily available until the parser is fully migrated
 // to the new API. !!!
-CVC4::Expr Term::getExpr(void) const { return *d_expr; }
+CVC4::Expr Term::getExpr(void) const
+{
+  if (d_solver == nullptr)
+  {
+    return CVC4::Expr();
+  }
+  return d_solver->getNodeManager()->toExpr(*d_node);
+}
 
 std::ostream& operator<<(std::ostream& out, const Term& t)
 {
@@ -1776,7 +2184,7 @@ std::ostream& operator<<(
 
 size_t TermHashFunction::operator()(const Term& t) const
 {
-  return ExprHashFunction()(*t.d_expr);
+  return NodeHashFunction()(*t.d_node);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -1800,7 +2208,7 @@ void DatatypeConstructorDecl::addSelector(const std::string& name, Sort sort)
 {
   CVC4_API_ARG_CHECK_EXPECTED(!sort.isNull(), sort)
       << "non-null range sort for selector";
-  d_ctor->addArg(name, *sort.d_type);
+  d_ctor->addArg(name, sort.getType());
 }
 
 void DatatypeConstructorDecl::addSelectorSelf(const std::string& name)
@@ -1856,7 +2264,7 @@ DatatypeDecl::DatatypeDecl(const Solver* slv,
     : d_solver(slv),
       d_dtype(new CVC4::Datatype(slv->getExprManager(),
                                  name,
-                                 std::vector<Type>{*param.d_type},
+                                 std::vector<Type>{param.getType()},
                                  isCoDatatype))
 {
 }
@@ -1870,7 +2278,7 @@ DatatypeDecl::DatatypeDecl(const Solver* slv,
   std::vector<Type> tparams;
   for (const Sort& p : params)
   {
-    tparams.push_back(*p.d_type);
+    tparams.push_back(p.getType());
   }
   d_dtype = std::shared_ptr<CVC4::Datatype>(
       new CVC4::Datatype(slv->getExprManager(), name, tparams, isCoDatatype));
@@ -2332,7 +2740,7 @@ void Grammar::addRule(Term ntSymbol, Term rule)
       d_ntsToTerms.find(ntSymbol) != d_ntsToTerms.cend(), ntSymbol)
       << "ntSymbol to be one of the non-terminal symbols given in the "
          "predeclaration";
-  CVC4_API_CHECK(ntSymbol.d_expr->getType() == rule.d_expr->getType())
+  CVC4_API_CHECK(ntSymbol.getExpr().getType() == rule.getExpr().getType())
       << "Expected ntSymbol and rule to have the same sort";
 
   d_ntsToTerms[ntSymbol].push_back(rule);
@@ -2353,7 +2761,7 @@ void Grammar::addRules(Term ntSymbol, std::vector<Term> rules)
     CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(
         !rules[i].isNull(), "parameter rule", rules[i], i)
         << "non-null term";
-    CVC4_API_CHECK(ntSymbol.d_expr->getType() == rules[i].d_expr->getType())
+    CVC4_API_CHECK(ntSymbol.getExpr().getType() == rules[i].getExpr().getType())
         << "Expected ntSymbol and rule at index " << i
         << " to have the same sort";
   }
@@ -2429,12 +2837,12 @@ Sort Grammar::resolve()
     if (d_allowVars.find(ntSym) != d_allowVars.cend())
     {
       addSygusConstructorVariables(dtDecl,
-                                   Sort(d_solver, ntSym.d_expr->getType()));
+                                   Sort(d_solver, ntSym.getExpr().getType()));
     }
 
     bool aci = d_allowConst.find(ntSym) != d_allowConst.end();
-    Type btt = ntSym.d_expr->getType();
-    dtDecl.d_dtype->setSygus(btt, *bvl.d_expr, aci, false);
+    Type btt = ntSym.getExpr().getType();
+    dtDecl.d_dtype->setSygus(btt, bvl.getExpr(), aci, false);
 
     // We can be in a case where the only rule specified was (Variable T)
     // and there are no variables of type T, in which case this is a bogus
@@ -2444,7 +2852,7 @@ Sort Grammar::resolve()
         << " produced an empty rule list";
 
     datatypes.push_back(*dtDecl.d_dtype);
-    unresTypes.insert(*ntsToUnres[ntSym].d_type);
+    unresTypes.insert(ntsToUnres[ntSym].getType());
   }
 
   std::vector<DatatypeType> datatypeTypes =
@@ -2476,7 +2884,7 @@ void Grammar::addSygusConstructorTerm(
   std::shared_ptr<SygusPrintCallback> spc;
   // callback prints as the expression
   spc = std::make_shared<printer::SygusExprPrintCallback>(
-      *op.d_expr, termVectorToExprs(args));
+      op.getExpr(), termVectorToExprs(args));
   if (!args.empty())
   {
     Term lbvl = Term(d_solver,
@@ -2484,11 +2892,11 @@ void Grammar::addSygusConstructorTerm(
                          CVC4::kind::BOUND_VAR_LIST, termVectorToExprs(args)));
     // its operator is a lambda
     op = Term(d_solver,
-              d_solver->getExprManager()->mkExpr(CVC4::kind::LAMBDA,
-                                                 {*lbvl.d_expr, *op.d_expr}));
+              d_solver->getExprManager()->mkExpr(
+                  CVC4::kind::LAMBDA, {lbvl.getExpr(), op.getExpr()}));
   }
   dt.d_dtype->addSygusConstructor(
-      *op.d_expr, ssCName.str(), sortVectorToTypes(cargs), spc);
+      op.getExpr(), ssCName.str(), sortVectorToTypes(cargs), spc);
 }
 
 Term Grammar::purifySygusGTerm(
@@ -2503,19 +2911,19 @@ Term Grammar::purifySygusGTerm(
   {
     Term ret =
         Term(d_solver,
-             d_solver->getExprManager()->mkBoundVar(term.d_expr->getType()));
+             d_solver->getExprManager()->mkBoundVar(term.getExpr().getType()));
     args.push_back(ret);
     cargs.push_back(itn->second);
     return ret;
   }
   std::vector<Term> pchildren;
   bool childChanged = false;
-  for (unsigned i = 0, nchild = term.d_expr->getNumChildren(); i < nchild; i++)
+  for (unsigned i = 0, nchild = term.d_node->getNumChildren(); i < nchild; i++)
   {
     Term ptermc = purifySygusGTerm(
-        Term(d_solver, (*term.d_expr)[i]), args, cargs, ntsToUnres);
+        Term(d_solver, (*term.d_node)[i]), args, cargs, ntsToUnres);
     pchildren.push_back(ptermc);
-    childChanged = childChanged || *ptermc.d_expr != (*term.d_expr)[i];
+    childChanged = childChanged || *ptermc.d_node != (*term.d_node)[i];
   }
   if (!childChanged)
   {
@@ -2524,16 +2932,16 @@ Term Grammar::purifySygusGTerm(
 
   Expr nret;
 
-  if (term.d_expr->isParameterized())
+  if (term.getExpr().isParameterized())
   {
     // it's an indexed operator so we should provide the op
-    nret = d_solver->getExprManager()->mkExpr(term.d_expr->getKind(),
-                                              term.d_expr->getOperator(),
+    nret = d_solver->getExprManager()->mkExpr(term.getExpr().getKind(),
+                                              term.getExpr().getOperator(),
                                               termVectorToExprs(pchildren));
   }
   else
   {
-    nret = d_solver->getExprManager()->mkExpr(term.d_expr->getKind(),
+    nret = d_solver->getExprManager()->mkExpr(term.getExpr().getKind(),
                                               termVectorToExprs(pchildren));
   }
 
@@ -2547,13 +2955,13 @@ void Grammar::addSygusConstructorVariables(DatatypeDecl& dt, Sort sort) const
   for (unsigned i = 0, size = d_sygusVars.size(); i < size; i++)
   {
     Term v = d_sygusVars[i];
-    if (v.d_expr->getType() == *sort.d_type)
+    if (v.getExpr().getType() == sort.getType())
     {
       std::stringstream ss;
       ss << v;
       std::vector<Sort> cargs;
       dt.d_dtype->addSygusConstructor(
-          *v.d_expr, ss.str(), sortVectorToTypes(cargs));
+          v.getExpr(), ss.str(), sortVectorToTypes(cargs));
     }
   }
 }
@@ -2606,7 +3014,14 @@ Solver::Solver(Options* opts)
   if (opts == nullptr) delete o;
 }
 
-Solver::~Solver() {}
+Solver::~Solver()
+{
+  if (d_asyncCheck != nullptr)
+  {
+    d_asyncCheck->cancel();
+    d_asyncCheck->join();
+  }
+}
 
 /* Helpers                                                                    */
 /* -------------------------------------------------------------------------- */
@@ -2617,9 +3032,18 @@ Solver::~Solver() {}
 template <typename T>
 Term Solver::mkValHelper(T t) const
 {
-  Expr res = d_exprMgr->mkConst(t);
-  (void)res.getType(true); /* kick off type checking */
-  return Term(this, res);
+  NodeManager* nm = getNodeManager();
+  NodeManagerScope scope(nm);
+  try
+  {
+    Node res = nm->mkConst(t);
+    (void)res.getType(true); /* kick off type checking */
+    return Term(this, res);
+  }
+  catch (const CVC4::TypeCheckingExceptionPrivate& e)
+  {
+    throw CVC4ApiException(e.getMessage());
+  }
 }
 
 Term Solver::mkRealFromStrHelper(const std::string& s) const
@@ -2733,58 +3157,38 @@ Term Solver::mkTermHelper(Kind kind, const std::vector<Term>& children) const
         << "a child term associated to this solver object";
   }
 
-  std::vector<Expr> echildren = termVectorToExprs(children);
   CVC4::Kind k = extToIntKind(kind);
   Assert(isDefinedIntKind(k))
       << "Not a defined internal kind : " << k << " " << kind;
+  // left-associative, right-associative and chainable operators with more
+  // than two children, as well as associative operators with more than their
+  // maximal number of children are expanded by mkNodeHelper()
+  bool expands = (children.size() > 2
+                  && (isLeftAssociative(kind) || kind == IMPLIES
+                      || isChainable(kind)))
+                 || kind::isAssociative(k);
+  if (!expands || children.size() <= maxArity(kind))
+  {
+    checkMkTerm(kind, children.size());
+  }
 
-  Expr res;
-  if (echildren.size() > 2)
+  std::vector<Node> nchildren;
+  for (const Term& t : children)
   {
-    if (kind == INTS_DIVISION || kind == XOR || kind == MINUS
-        || kind == DIVISION || kind == BITVECTOR_XNOR || kind == HO_APPLY)
-    {
-      // left-associative, but CVC4 internally only supports 2 args
-      res = d_exprMgr->mkLeftAssociative(k, echildren);
-    }
-    else if (kind == IMPLIES)
-    {
-      // right-associative, but CVC4 internally only supports 2 args
-      res = d_exprMgr->mkRightAssociative(k, echildren);
-    }
-    else if (kind == EQUAL || kind == LT || kind == GT || kind == LEQ
-             || kind == GEQ)
-    {
-      // "chainable", but CVC4 internally only supports 2 args
-      res = d_exprMgr->mkChain(k, echildren);
-    }
-    else if (kind::isAssociative(k))
-    {
-      // mkAssociative has special treatment for associative operators with lots
-      // of children
-      res = d_exprMgr->mkAssociative(k, echildren);
-    }
-    else
-    {
-      // default case, must check kind
-      checkMkTerm(kind, children.size());
-      res = d_exprMgr->mkExpr(k, echildren);
-    }
+    nchildren.push_back(*t.d_node);
   }
-  else if (kind::isAssociative(k))
+  NodeManager* nm = getNodeManager();
+  NodeManagerScope scope(nm);
+  try
   {
-    // associative case, same as above
-    res = d_exprMgr->mkAssociative(k, echildren);
+    Node res = mkNodeHelper(nm, kind, nchildren);
+    (void)res.getType(true); /* kick off type checking */
+    return Term(this, res);
   }
-  else
+  catch (const CVC4::TypeCheckingExceptionPrivate& e)
   {
-    // default case, same as above
-    checkMkTerm(kind, children.size());
-    res = d_exprMgr->mkExpr(k, echildren);
+    throw CVC4ApiException(e.getMessage());
   }
-
-  (void)res.getType(true); /* kick off type checking */
-  return Term(this, res);
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
 
@@ -2836,7 +3240,7 @@ std::vector<Type> Solver::sortVectorToTypes(
   for (const Sort& s : sorts)
   {
     CVC4_API_SOLVER_CHECK_SORT(s);
-    res.push_back(*s.d_type);
+    res.push_back(s.getType());
   }
   return res;
 }
@@ -2848,7 +3252,7 @@ std::vector<Expr> Solver::termVectorToExprs(
   for (const Term& t : terms)
   {
     CVC4_API_SOLVER_CHECK_TERM(t);
-    res.push_back(*t.d_expr);
+    res.push_back(t.getExpr());
   }
   return res;
 }
@@ -2940,7 +3344,7 @@ Sort Solver::mkArraySort(Sort indexSort, Sort elemSort) const
   CVC4_API_SOLVER_CHECK_SORT(elemSort);
 
   return Sort(this,
-              d_exprMgr->mkArrayType(*indexSort.d_type, *elemSort.d_type));
+              d_exprMgr->mkArrayType(indexSort.getType(), elemSort.getType()));
 
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
@@ -3006,7 +3410,7 @@ Sort Solver::mkFunctionSort(Sort domain, Sort codomain) const
   Assert(!codomain.isFunction()); /* A function sort is not first-class. */
 
   return Sort(this,
-              d_exprMgr->mkFunctionType(*domain.d_type, *codomain.d_type));
+              d_exprMgr->mkFunctionType(domain.getType(), codomain.getType()));
 
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
@@ -3036,7 +3440,7 @@ Sort Solver::mkFunctionSort(const std::vector<Sort>& sorts, Sort codomain) const
   Assert(!codomain.isFunction()); /* A function sort is not first-class. */
 
   std::vector<Type> argTypes = sortVectorToTypes(sorts);
-  return Sort(this, d_exprMgr->mkFunctionType(argTypes, *codomain.d_type));
+  return Sort(this, d_exprMgr->mkFunctionType(argTypes, codomain.getType()));
 
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
@@ -3088,7 +3492,7 @@ Sort Solver::mkRecordSort(
         this == p.second.d_solver, "parameter sort", p.second, i)
         << "sort associated to this solver object";
     i += 1;
-    f.emplace_back(p.first, *p.second.d_type);
+    f.emplace_back(p.first, p.second.getType());
   }
 
   return Sort(this, d_exprMgr->mkRecordType(Record(f)));
@@ -3103,7 +3507,7 @@ Sort Solver::mkSetSort(Sort elemSort) const
       << "non-null element sort";
   CVC4_API_SOLVER_CHECK_SORT(elemSort);
 
-  return Sort(this, d_exprMgr->mkSetType(*elemSort.d_type));
+  return Sort(this, d_exprMgr->mkSetType(elemSort.getType()));
 
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
@@ -3289,7 +3693,7 @@ Term Solver::mkEmptySet(Sort s) const
   CVC4_API_ARG_CHECK_EXPECTED(s.isNull() || this == s.d_solver, s)
       << "set sort associated to this solver object";
 
-  return mkValHelper<CVC4::EmptySet>(CVC4::EmptySet(*s.d_type));
+  return mkValHelper<CVC4::EmptySet>(CVC4::EmptySet(s.getType()));
 
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
@@ -3300,7 +3704,7 @@ Term Solver::mkSepNil(Sort sort) const
   CVC4_API_ARG_CHECK_EXPECTED(!sort.isNull(), sort) << "non-null sort";
   CVC4_API_SOLVER_CHECK_SORT(sort);
 
-  Expr res = d_exprMgr->mkNullaryOperator(*sort.d_type, CVC4::kind::SEP_NIL);
+  Expr res = d_exprMgr->mkNullaryOperator(sort.getType(), CVC4::kind::SEP_NIL);
   (void)res.getType(true); /* kick off type checking */
   return Term(this, res);
 
@@ -3357,7 +3761,7 @@ Term Solver::mkUniverseSet(Sort sort) const
   CVC4_API_SOLVER_CHECK_SORT(sort);
 
   Expr res =
-      d_exprMgr->mkNullaryOperator(*sort.d_type, CVC4::kind::UNIVERSE_SET);
+      d_exprMgr->mkNullaryOperator(sort.getType(), CVC4::kind::UNIVERSE_SET);
   // TODO(#2771): Reenable?
   // (void)res->getType(true); /* kick off type checking */
   return Term(this, res);
@@ -3415,7 +3819,7 @@ Term Solver::mkConstArray(Sort sort, Term val) const
   CVC4_API_CHECK(sort.getArrayElementSort().isComparableTo(val.getSort()))
       << "Value does not match element sort.";
   Term res = mkValHelper<CVC4::ArrayStoreAll>(
-      CVC4::ArrayStoreAll(*sort.d_type, *val.d_expr));
+      CVC4::ArrayStoreAll(sort.getType(), val.getExpr()));
   return res;
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
@@ -3494,7 +3898,7 @@ Term Solver::mkUninterpretedConst(Sort sort, int32_t index) const
   CVC4_API_SOLVER_CHECK_SORT(sort);
 
   return mkValHelper<CVC4::UninterpretedConstant>(
-      CVC4::UninterpretedConstant(*sort.d_type, index));
+      CVC4::UninterpretedConstant(sort.getType(), index));
 
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
@@ -3537,11 +3941,11 @@ Term Solver::mkFloatingPoint(uint32_t exp, uint32_t sig, Term val) const
   CVC4_API_ARG_CHECK_EXPECTED(!val.isNull(), val) << "non-null term";
   CVC4_API_SOLVER_CHECK_TERM(val);
   CVC4_API_ARG_CHECK_EXPECTED(
-      val.getSort().isBitVector() && val.d_expr->isConst(), val)
+      val.getSort().isBitVector() && val.getExpr().isConst(), val)
       << "bit-vector constant";
 
   return mkValHelper<CVC4::FloatingPoint>(
-      CVC4::FloatingPoint(exp, sig, val.d_expr->getConst<BitVector>()));
+      CVC4::FloatingPoint(exp, sig, val.d_node->getConst<BitVector>()));
 
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
@@ -3555,8 +3959,8 @@ Term Solver::mkConst(Sort sort, const std::string& symbol) const
   CVC4_API_ARG_CHECK_EXPECTED(!sort.isNull(), sort) << "non-null sort";
   CVC4_API_SOLVER_CHECK_SORT(sort);
 
-  Expr res = symbol.empty() ? d_exprMgr->mkVar(*sort.d_type)
-                            : d_exprMgr->mkVar(symbol, *sort.d_type);
+  Expr res = symbol.empty() ? d_exprMgr->mkVar(sort.getType())
+                            : d_exprMgr->mkVar(symbol, sort.getType());
   (void)res.getType(true); /* kick off type checking */
   return Term(this, res);
 
@@ -3572,8 +3976,8 @@ Term Solver::mkVar(Sort sort, const std::string& symbol) const
   CVC4_API_ARG_CHECK_EXPECTED(!sort.isNull(), sort) << "non-null sort";
   CVC4_API_SOLVER_CHECK_SORT(sort);
 
-  Expr res = symbol.empty() ? d_exprMgr->mkBoundVar(*sort.d_type)
-                            : d_exprMgr->mkBoundVar(symbol, *sort.d_type);
+  Expr res = symbol.empty() ? d_exprMgr->mkBoundVar(sort.getType())
+                            : d_exprMgr->mkBoundVar(symbol, sort.getType());
   (void)res.getType(true); /* kick off type checking */
   return Term(this, res);
 
@@ -3628,9 +4032,18 @@ Term Solver::mkTerm(Kind kind, Term child) const
   CVC4_API_SOLVER_CHECK_TERM(child);
   checkMkTerm(kind, 1);
 
-  Expr res = d_exprMgr->mkExpr(extToIntKind(kind), *child.d_expr);
-  (void)res.getType(true); /* kick off type checking */
-  return Term(this, res);
+  NodeManager* nm = getNodeManager();
+  NodeManagerScope scope(nm);
+  try
+  {
+    Node res = nm->mkNode(extToIntKind(kind), *child.d_node);
+    (void)res.getType(true); /* kick off type checking */
+    return Term(this, res);
+  }
+  catch (const CVC4::TypeCheckingExceptionPrivate& e)
+  {
+    throw CVC4ApiException(e.getMessage());
+  }
 
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
@@ -3644,10 +4057,18 @@ Term Solver::mkTerm(Kind kind, Term child1, Term child2) const
   CVC4_API_SOLVER_CHECK_TERM(child2);
   checkMkTerm(kind, 2);
 
-  Expr res =
-      d_exprMgr->mkExpr(extToIntKind(kind), *child1.d_expr, *child2.d_expr);
-  (void)res.getType(true); /* kick off type checking */
-  return Term(this, res);
+  NodeManager* nm = getNodeManager();
+  NodeManagerScope scope(nm);
+  try
+  {
+    Node res = nm->mkNode(extToIntKind(kind), *child1.d_node, *child2.d_node);
+    (void)res.getType(true); /* kick off type checking */
+    return Term(this, res);
+  }
+  catch (const CVC4::TypeCheckingExceptionPrivate& e)
+  {
+    throw CVC4ApiException(e.getMessage());
+  }
 
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
@@ -3679,7 +4100,7 @@ Term Solver::mkTerm(Op op) const
     res = mkTermFromKind(op.d_kind);
   }
 
-  (void)res.d_expr->getType(true); /* kick off type checking */
+  (void)res.getExpr().getType(true); /* kick off type checking */
   return res;
 
   CVC4_API_SOLVER_TRY_CATCH_END;
@@ -3696,11 +4117,11 @@ Term Solver::mkTerm(Op op, Term child) const
   Expr res;
   if (op.isIndexedHelper())
   {
-    res = d_exprMgr->mkExpr(int_kind, *op.d_expr, *child.d_expr);
+    res = d_exprMgr->mkExpr(int_kind, *op.d_expr, child.getExpr());
   }
   else
   {
-    res = d_exprMgr->mkExpr(int_kind, *child.d_expr);
+    res = d_exprMgr->mkExpr(int_kind, child.getExpr());
   }
 
   (void)res.getType(true); /* kick off type checking */
@@ -3722,12 +4143,12 @@ Term Solver::mkTerm(Op op, Term child1, Term child2) const
   Expr res;
   if (op.isIndexedHelper())
   {
-    res =
-        d_exprMgr->mkExpr(int_kind, *op.d_expr, *child1.d_expr, *child2.d_expr);
+    res = d_exprMgr->mkExpr(
+        int_kind, *op.d_expr, child1.getExpr(), child2.getExpr());
   }
   else
   {
-    res = d_exprMgr->mkExpr(int_kind, *child1.d_expr, *child2.d_expr);
+    res = d_exprMgr->mkExpr(int_kind, child1.getExpr(), child2.getExpr());
   }
 
   (void)res.getType(true); /* kick off type checking */
@@ -3750,13 +4171,16 @@ Term Solver::mkTerm(Op op, Term child1, Term child2, Term child3) const
   Expr res;
   if (op.isIndexedHelper())
   {
-    res = d_exprMgr->mkExpr(
-        int_kind, *op.d_expr, *child1.d_expr, *child2.d_expr, *child3.d_expr);
+    res = d_exprMgr->mkExpr(int_kind,
+                            *op.d_expr,
+                            child1.getExpr(),
+                            child2.getExpr(),
+                            child3.getExpr());
   }
   else
   {
     res = d_exprMgr->mkExpr(
-        int_kind, *child1.d_expr, *child2.d_expr, *child3.d_expr);
+        int_kind, child1.getExpr(), child2.getExpr(), child3.getExpr());
   }
 
   (void)res.getType(true); /* kick off type checking */
@@ -3797,6 +4221,141 @@ Term Solver::mkTerm(Op op, const std::vector<Term>& children) const
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
 
+std::vector<Term> Solver::mkTerms(const std::vector<Term>& leaves,
+                                  const std::vector<Op>& ops,
+                                  const std::vector<TermRecord>& records,
+                                  const std::vector<uint32_t>& children,
+                                  const std::vector<uint32_t>& roots) const
+{
+  CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  for (size_t i = 0, size = leaves.size(); i < size; ++i)
+  {
+    CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(
+        !leaves[i].isNull(), "leaf term", leaves[i], i)
+        << "non-null term";
+    CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(
+        this == leaves[i].d_solver, "leaf term", leaves[i], i)
+        << "a leaf term associated to this solver object";
+  }
+  // check the operators once, and compute the bounds on the number of
+  // children of their records
+  std::vector<uint32_t> minChildren;
+  std::vector<uint32_t> maxChildren;
+  std::vector<bool> expands;
+  for (size_t i = 0, size = ops.size(); i < size; ++i)
+  {
+    const Op& op = ops[i];
+    CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(!op.isNull(), "operator", op, i)
+        << "non-null operator";
+    CVC4_API_SOLVER_CHECK_OP(op);
+    CVC4_API_KIND_CHECK(op.d_kind);
+    CVC4::Kind k = extToIntKind(op.d_kind);
+    if (op.isIndexedHelper())
+    {
+      minChildren.push_back(CVC4::ExprManager::minArity(k));
+      maxChildren.push_back(CVC4::ExprManager::maxArity(k));
+      expands.push_back(false);
+      continue;
+    }
+    const CVC4::kind::MetaKind mk = kind::metaKindOf(k);
+    CVC4_API_KIND_CHECK_EXPECTED(
+        mk == kind::metakind::PARAMETERIZED || mk == kind::metakind::OPERATOR,
+        op.d_kind)
+        << "an operator-style kind, as for mkTerm()";
+    // a parameterized term has at least its operator as child
+    minChildren.push_back(std::max<uint32_t>(
+        minArity(op.d_kind), mk == kind::metakind::PARAMETERIZED ? 1 : 0));
+    maxChildren.push_back(maxArity(op.d_kind));
+    expands.push_back(isLeftAssociative(op.d_kind) || op.d_kind == IMPLIES
+                      || isChainable(op.d_kind) || kind::isAssociative(k));
+  }
+  // check the structure of the DAG
+  const size_t nleaves = leaves.size();
+  size_t offset = 0;
+  for (size_t i = 0, size = records.size(); i < size; ++i)
+  {
+    const TermRecord& r = records[i];
+    CVC4_API_CHECK(r.d_op < ops.size())
+        << "Invalid operator index " << r.d_op << " in record " << i
+        << ", expected an index less than " << ops.size();
+    uint32_t n = r.d_numChildren;
+    CVC4_API_CHECK(
+        n >= minChildren[r.d_op]
+        && (n <= maxChildren[r.d_op] || (n > 2 && expands[r.d_op])))
+        << "Invalid number of children " << n << " in record " << i
+        << " with operator " << ops[r.d_op] << ", expected at least "
+        << minChildren[r.d_op] << " and at most " << maxChildren[r.d_op];
+    CVC4_API_CHECK(children.size() - offset >= n)
+        << "Too few children for record " << i;
+    for (size_t j = offset, end = offset + n; j < end; ++j)
+    {
+      CVC4_API_CHECK(children[j] < nleaves + i)
+          << "Invalid child " << children[j] << " of record " << i
+          << ", expected a node that precedes it";
+    }
+    offset += n;
+  }
+  CVC4_API_CHECK(offset == children.size())
+      << "Too many children for the records, expected " << offset;
+  for (size_t i = 0, size = roots.size(); i < size; ++i)
+  {
+    CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(
+        roots[i] < nleaves + records.size(), "root", roots[i], i)
+        << "the index of a node";
+  }
+
+  // create the nodes directly, the children are type checked before their
+  // parents
+  NodeManager* nm = getNodeManager();
+  NodeManagerScope nms(nm);
+  std::vector<Node> nodes;
+  nodes.reserve(nleaves + records.size());
+  for (const Term& t : leaves)
+  {
+    nodes.push_back(*t.d_node);
+  }
+  std::vector<Node> cnodes;
+  offset = 0;
+  for (size_t i = 0, size = records.size(); i < size; ++i)
+  {
+    const Op& op = ops[records[i].d_op];
+    cnodes.clear();
+    if (op.isIndexedHelper())
+    {
+      cnodes.push_back(Node::fromExpr(*op.d_expr));
+    }
+    for (size_t j = offset, end = offset + records[i].d_numChildren; j < end;
+         ++j)
+    {
+      cnodes.push_back(nodes[children[j]]);
+    }
+    offset += records[i].d_numChildren;
+    try
+    {
+      Node n = op.isIndexedHelper()
+                   ? nm->mkNode(extToIntKind(op.d_kind), cnodes)
+                   : mkNodeHelper(nm, op.d_kind, cnodes);
+      (void)n.getType(true); /* kick off type checking */
+      nodes.push_back(n);
+    }
+    catch (const TypeCheckingExceptionPrivate& e)
+    {
+      // the exception holds a node, hence it must not leave the scope of the
+      // node manager
+      throw CVC4ApiException("Ill-typed term in record "
+                             + std::to_string(i) + ": " + e.getMessage());
+    }
+  }
+  std::vector<Term> res;
+  for (uint32_t root : roots)
+  {
+    res.push_back(Term(this, nodes[root]));
+  }
+  return res;
+
+  CVC4_API_SOLVER_TRY_CATCH_END;
+}
+
 Term Solver::mkTuple(const std::vector<Sort>& sorts,
                      const std::vector<Term>& terms) const
 {
@@ -3812,13 +4371,13 @@ Term Solver::mkTuple(const std::vector<Sort>& sorts,
     CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(
         this == sorts[i].d_solver, "child sort", sorts[i], i)
         << "child sort associated to this solver object";
-    args.push_back(*(ensureTermSort(terms[i], sorts[i])).d_expr);
+    args.push_back(ensureTermSort(terms[i], sorts[i]).getExpr());
   }
 
   Sort s = mkTupleSort(sorts);
   Datatype dt = s.getDatatype();
   Expr res = d_exprMgr->mkExpr(extToIntKind(APPLY_CONSTRUCTOR),
-                               *dt[0].getConstructorTerm().d_expr,
+                               dt[0].getConstructorTerm().getExpr(),
                                args);
   (void)res.getType(true); /* kick off type checking */
   return Term(this, res);
@@ -3850,7 +4409,7 @@ Op Solver::mkOp(Kind kind, const std::string& arg) const
     res = Op(
         this,
         kind,
-        *mkValHelper<CVC4::RecordUpdate>(CVC4::RecordUpdate(arg)).d_expr.get());
+        mkValHelper<CVC4::RecordUpdate>(CVC4::RecordUpdate(arg)).getExpr());
   }
   else
   {
@@ -3861,8 +4420,8 @@ Op Solver::mkOp(Kind kind, const std::string& arg) const
         << "a string representing an integer, real or rational value.";
     res = Op(this,
              kind,
-             *mkValHelper<CVC4::Divisible>(CVC4::Divisible(CVC4::Integer(arg)))
-                  .d_expr.get());
+             mkValHelper<CVC4::Divisible>(CVC4::Divisible(CVC4::Integer(arg)))
+                 .getExpr());
   }
   return res;
 
@@ -3881,73 +4440,73 @@ Op Solver::mkOp(Kind kind, uint32_t arg) const
       res =
           Op(this,
              kind,
-             *mkValHelper<CVC4::Divisible>(CVC4::Divisible(arg)).d_expr.get());
+             mkValHelper<CVC4::Divisible>(CVC4::Divisible(arg)).getExpr());
       break;
     case BITVECTOR_REPEAT:
       res = Op(this,
                kind,
-               *mkValHelper<CVC4::BitVectorRepeat>(CVC4::BitVectorRepeat(arg))
-                    .d_expr.get());
+               mkValHelper<CVC4::BitVectorRepeat>(CVC4::BitVectorRepeat(arg))
+                   .getExpr());
       break;
     case BITVECTOR_ZERO_EXTEND:
       res = Op(this,
                kind,
-               *mkValHelper<CVC4::BitVectorZeroExtend>(
-                    CVC4::BitVectorZeroExtend(arg))
-                    .d_expr.get());
+               mkValHelper<CVC4::BitVectorZeroExtend>(
+                   CVC4::BitVectorZeroExtend(arg))
+                   .getExpr());
       break;
     case BITVECTOR_SIGN_EXTEND:
       res = Op(this,
                kind,
-               *mkValHelper<CVC4::BitVectorSignExtend>(
-                    CVC4::BitVectorSignExtend(arg))
-                    .d_expr.get());
+               mkValHelper<CVC4::BitVectorSignExtend>(
+                   CVC4::BitVectorSignExtend(arg))
+                   .getExpr());
       break;
     case BITVECTOR_ROTATE_LEFT:
       res = Op(this,
                kind,
-               *mkValHelper<CVC4::BitVectorRotateLeft>(
-                    CVC4::BitVectorRotateLeft(arg))
-                    .d_expr.get());
+               mkValHelper<CVC4::BitVectorRotateLeft>(
+                   CVC4::BitVectorRotateLeft(arg))
+                   .getExpr());
       break;
     case BITVECTOR_ROTATE_RIGHT:
       res = Op(this,
                kind,
-               *mkValHelper<CVC4::BitVectorRotateRight>(
-                    CVC4::BitVectorRotateRight(arg))
-                    .d_expr.get());
+               mkValHelper<CVC4::BitVectorRotateRight>(
+                   CVC4::BitVectorRotateRight(arg))
+                   .getExpr());
       break;
     case INT_TO_BITVECTOR:
       res = Op(this,
                kind,
-               *mkValHelper<CVC4::IntToBitVector>(CVC4::IntToBitVector(arg))
-                    .d_expr.get());
+               mkValHelper<CVC4::IntToBitVector>(CVC4::IntToBitVector(arg))
+                   .getExpr());
       break;
     case FLOATINGPOINT_TO_UBV:
       res = Op(
           this,
           kind,
-          *mkValHelper<CVC4::FloatingPointToUBV>(CVC4::FloatingPointToUBV(arg))
-               .d_expr.get());
+          mkValHelper<CVC4::FloatingPointToUBV>(CVC4::FloatingPointToUBV(arg))
+              .getExpr());
       break;
     case FLOATINGPOINT_TO_SBV:
       res = Op(
           this,
           kind,
-          *mkValHelper<CVC4::FloatingPointToSBV>(CVC4::FloatingPointToSBV(arg))
-               .d_expr.get());
+          mkValHelper<CVC4::FloatingPointToSBV>(CVC4::FloatingPointToSBV(arg))
+              .getExpr());
       break;
     case TUPLE_UPDATE:
       res = Op(
           this,
           kind,
-          *mkValHelper<CVC4::TupleUpdate>(CVC4::TupleUpdate(arg)).d_expr.get());
+          mkValHelper<CVC4::TupleUpdate>(CVC4::TupleUpdate(arg)).getExpr());
       break;
     case REGEXP_REPEAT:
       res = Op(this,
                kind,
-               *mkValHelper<CVC4::RegExpRepeat>(CVC4::RegExpRepeat(arg))
-                    .d_expr.get());
+               mkValHelper<CVC4::RegExpRepeat>(CVC4::RegExpRepeat(arg))
+                   .getExpr());
       break;
     default:
       CVC4_API_KIND_CHECK_EXPECTED(false, kind)
@@ -3970,57 +4529,57 @@ Op Solver::mkOp(Kind kind, uint32_t arg1, uint32_t arg2) const
     case BITVECTOR_EXTRACT:
       res = Op(this,
                kind,
-               *mkValHelper<CVC4::BitVectorExtract>(
-                    CVC4::BitVectorExtract(arg1, arg2))
-                    .d_expr.get());
+               mkValHelper<CVC4::BitVectorExtract>(
+                   CVC4::BitVectorExtract(arg1, arg2))
+                   .getExpr());
       break;
     case FLOATINGPOINT_TO_FP_IEEE_BITVECTOR:
       res = Op(this,
                kind,
-               *mkValHelper<CVC4::FloatingPointToFPIEEEBitVector>(
-                    CVC4::FloatingPointToFPIEEEBitVector(arg1, arg2))
-                    .d_expr.get());
+               mkValHelper<CVC4::FloatingPointToFPIEEEBitVector>(
+                   CVC4::FloatingPointToFPIEEEBitVector(arg1, arg2))
+                   .getExpr());
       break;
     case FLOATINGPOINT_TO_FP_FLOATINGPOINT:
       res = Op(this,
                kind,
-               *mkValHelper<CVC4::FloatingPointToFPFloatingPoint>(
-                    CVC4::FloatingPointToFPFloatingPoint(arg1, arg2))
-                    .d_expr.get());
+               mkValHelper<CVC4::FloatingPointToFPFloatingPoint>(
+                   CVC4::FloatingPointToFPFloatingPoint(arg1, arg2))
+                   .getExpr());
       break;
     case FLOATINGPOINT_TO_FP_REAL:
       res = Op(this,
                kind,
-               *mkValHelper<CVC4::FloatingPointToFPReal>(
-                    CVC4::FloatingPointToFPReal(arg1, arg2))
-                    .d_expr.get());
+               mkValHelper<CVC4::FloatingPointToFPReal>(
+                   CVC4::FloatingPointToFPReal(arg1, arg2))
+                   .getExpr());
       break;
     case FLOATINGPOINT_TO_FP_SIGNED_BITVECTOR:
       res = Op(this,
                kind,
-               *mkValHelper<CVC4::FloatingPointToFPSignedBitVector>(
-                    CVC4::FloatingPointToFPSignedBitVector(arg1, arg2))
-                    .d_expr.get());
+               mkValHelper<CVC4::FloatingPointToFPSignedBitVector>(
+                   CVC4::FloatingPointToFPSignedBitVector(arg1, arg2))
+                   .getExpr());
       break;
     case FLOATINGPOINT_TO_FP_UNSIGNED_BITVECTOR:
       res = Op(this,
                kind,
-               *mkValHelper<CVC4::FloatingPointToFPUnsignedBitVector>(
-                    CVC4::FloatingPointToFPUnsignedBitVector(arg1, arg2))
-                    .d_expr.get());
+               mkValHelper<CVC4::FloatingPointToFPUnsignedBitVector>(
+                   CVC4::FloatingPointToFPUnsignedBitVector(arg1, arg2))
+                   .getExpr());
       break;
     case FLOATINGPOINT_TO_FP_GENERIC:
       res = Op(this,
                kind,
-               *mkValHelper<CVC4::FloatingPointToFPGeneric>(
-                    CVC4::FloatingPointToFPGeneric(arg1, arg2))
-                    .d_expr.get());
+               mkValHelper<CVC4::FloatingPointToFPGeneric>(
+                   CVC4::FloatingPointToFPGeneric(arg1, arg2))
+                   .getExpr());
       break;
     case REGEXP_LOOP:
       res = Op(this,
                kind,
-               *mkValHelper<CVC4::RegExpLoop>(CVC4::RegExpLoop(arg1, arg2))
-                    .d_expr.get());
+               mkValHelper<CVC4::RegExpLoop>(CVC4::RegExpLoop(arg1, arg2))
+                   .getExpr());
       break;
     default:
       CVC4_API_KIND_CHECK_EXPECTED(false, kind)
@@ -4038,10 +4597,11 @@ Op Solver::mkOp(Kind kind, uint32_t arg1, uint32_t arg2) const
 Term Solver::simplify(const Term& term)
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   CVC4_API_ARG_CHECK_NOT_NULL(term);
   CVC4_API_SOLVER_CHECK_TERM(term);
 
-  return Term(this, d_smtEngine->simplify(*term.d_expr));
+  return Term(this, d_smtEngine->simplify(term.getExpr()));
 
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
@@ -4050,6 +4610,7 @@ Result Solver::checkEntailed(Term term) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
   CVC4::ExprManagerScope exmgrs(*(d_exprMgr.get()));
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   CVC4_API_CHECK(!d_smtEngine->isQueryMade()
                  || CVC4::options::incrementalSolving())
       << "Cannot make multiple queries unless incremental solving is enabled "
@@ -4057,7 +4618,7 @@ Result Solver::checkEntailed(Term term) const
   CVC4_API_ARG_CHECK_NOT_NULL(term);
   CVC4_API_SOLVER_CHECK_TERM(term);
 
-  CVC4::Result r = d_smtEngine->checkEntailed(*term.d_expr);
+  CVC4::Result r = d_smtEngine->checkEntailed(term.getExpr());
   return Result(r);
 
   CVC4_API_SOLVER_TRY_CATCH_END;
@@ -4067,6 +4628,7 @@ Result Solver::checkEntailed(const std::vector<Term>& terms) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
   CVC4::ExprManagerScope exmgrs(*(d_exprMgr.get()));
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   CVC4_API_CHECK(!d_smtEngine->isQueryMade()
                  || CVC4::options::incrementalSolving())
       << "Cannot make multiple queries unless incremental solving is enabled "
@@ -4093,9 +4655,10 @@ Result Solver::checkEntailed(const std::vector<Term>& terms) const
 void Solver::assertFormula(Term term) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   CVC4_API_SOLVER_CHECK_TERM(term);
   CVC4_API_ARG_CHECK_NOT_NULL(term);
-  d_smtEngine->assertFormula(*term.d_expr);
+  d_smtEngine->assertFormula(term.getExpr());
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
 
@@ -4106,6 +4669,7 @@ Result Solver::checkSat(void) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
   CVC4::ExprManagerScope exmgrs(*(d_exprMgr.get()));
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   CVC4_API_CHECK(!d_smtEngine->isQueryMade()
                  || CVC4::options::incrementalSolving())
       << "Cannot make multiple queries unless incremental solving is enabled "
@@ -4122,12 +4686,13 @@ Result Solver::checkSatAssuming(Term assumption) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
   CVC4::ExprManagerScope exmgrs(*(d_exprMgr.get()));
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   CVC4_API_CHECK(!d_smtEngine->isQueryMade()
                  || CVC4::options::incrementalSolving())
       << "Cannot make multiple queries unless incremental solving is enabled "
          "(try --incremental)";
   CVC4_API_SOLVER_CHECK_TERM(assumption);
-  CVC4::Result r = d_smtEngine->checkSat(*assumption.d_expr);
+  CVC4::Result r = d_smtEngine->checkSat(assumption.getExpr());
   return Result(r);
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
@@ -4139,6 +4704,7 @@ Result Solver::checkSatAssuming(const std::vector<Term>& assumptions) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
   CVC4::ExprManagerScope exmgrs(*(d_exprMgr.get()));
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   CVC4_API_CHECK(!d_smtEngine->isQueryMade() || assumptions.size() == 0
                  || CVC4::options::incrementalSolving())
       << "Cannot make multiple queries unless incremental solving is enabled "
@@ -4154,6 +4720,72 @@ Result Solver::checkSatAssuming(const std::vector<Term>& assumptions) const
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
 
+AsyncResult Solver::checkSatAsync(
+    const std::vector<Term>& assumptions,
+    std::function<void(const CheckProgress&)> progress,
+    uint64_t periodMillis) const
+{
+  CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4::ExprManagerScope exmgrs(*(d_exprMgr.get()));
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
+  CVC4_API_CHECK(!d_smtEngine->isQueryMade() || assumptions.size() == 0
+                 || CVC4::options::incrementalSolving())
+      << "Cannot make multiple queries unless incremental solving is enabled "
+         "(try --incremental)";
+  for (const Term& term : assumptions)
+  {
+    CVC4_API_SOLVER_CHECK_TERM(term);
+    CVC4_API_ARG_CHECK_NOT_NULL(term);
+  }
+  CVC4_API_ARG_CHECK_EXPECTED(progress == nullptr || periodMillis > 0,
+                              periodMillis)
+      << "a positive period";
+  if (d_asyncCheck != nullptr)
+  {
+    d_asyncCheck->join();
+  }
+
+  ExprManager* em = d_exprMgr.get();
+  SmtEngine* smt = d_smtEngine.get();
+  ResourceManager* rm = getNodeManager()->getResourceManager();
+  std::shared_ptr<AsyncCheck> check = std::make_shared<AsyncCheck>(rm);
+  AsyncCheck* c = check.get();
+  std::vector<Expr> eassumptions = termVectorToExprs(assumptions);
+  c->d_thread = std::thread([=]() {
+    CVC4::Result r;
+    std::exception_ptr e;
+    {
+      CVC4::ExprManagerScope scope(*em);
+      // the registration owns the listener
+      std::unique_ptr<ListenerCollection::Registration> registration;
+      if (progress != nullptr)
+      {
+        registration.reset(rm->registerProgressListener(
+            new ProgressListener(rm, progress)));
+        rm->setProgressPeriod(periodMillis);
+      }
+      try
+      {
+        r = smt->checkSat(eassumptions);
+      }
+      catch (const CVC4::Exception& ex)
+      {
+        e = std::make_exception_ptr(CVC4ApiException(ex.getMessage()));
+      }
+      catch (...)
+      {
+        e = std::current_exception();
+      }
+      rm->setProgressPeriod(0);
+    }
+    c->finish(r, e);
+  });
+  d_asyncCheck = check;
+  return AsyncResult(check);
+
+  CVC4_API_SOLVER_TRY_CATCH_END;
+}
+
 /**
  *  ( declare-datatype <symbol> <datatype_decl> )
  */
@@ -4162,6 +4794,7 @@ Sort Solver::declareDatatype(
     const std::vector<DatatypeConstructorDecl>& ctors) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   CVC4_API_ARG_CHECK_EXPECTED(ctors.size() > 0, ctors)
       << "a datatype declaration with at least one constructor";
   DatatypeDecl dtdecl(this, symbol);
@@ -4186,6 +4819,7 @@ Term Solver::declareFun(const std::string& symbol,
                         Sort sort) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   for (size_t i = 0, size = sorts.size(); i < size; ++i)
   {
     CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(
@@ -4199,7 +4833,7 @@ Term Solver::declareFun(const std::string& symbol,
       << "first-class sort as function codomain sort";
   CVC4_API_SOLVER_CHECK_SORT(sort);
   Assert(!sort.isFunction()); /* A function sort is not first-class. */
-  Type type = *sort.d_type;
+  Type type = sort.getType();
   if (!sorts.empty())
   {
     std::vector<Type> types = sortVectorToTypes(sorts);
@@ -4215,6 +4849,7 @@ Term Solver::declareFun(const std::string& symbol,
 Sort Solver::declareSort(const std::string& symbol, uint32_t arity) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   if (arity == 0) return Sort(this, d_exprMgr->mkSort(symbol));
   return Sort(this, d_exprMgr->mkSortConstructor(symbol, arity));
   CVC4_API_SOLVER_TRY_CATCH_END;
@@ -4230,6 +4865,7 @@ Term Solver::defineFun(const std::string& symbol,
                        bool global) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   CVC4_API_ARG_CHECK_EXPECTED(sort.isFirstClass(), sort)
       << "first-class sort as codomain sort for function sort";
   std::vector<Type> domain_types;
@@ -4239,12 +4875,12 @@ Term Solver::defineFun(const std::string& symbol,
         this == bound_vars[i].d_solver, "bound variable", bound_vars[i], i)
         << "bound variable associated to this solver object";
     CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(
-        bound_vars[i].d_expr->getKind() == CVC4::Kind::BOUND_VARIABLE,
+        bound_vars[i].getExpr().getKind() == CVC4::Kind::BOUND_VARIABLE,
         "bound variable",
         bound_vars[i],
         i)
         << "a bound variable";
-    CVC4::Type t = bound_vars[i].d_expr->getType();
+    CVC4::Type t = bound_vars[i].getExpr().getType();
     CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(
         t.isFirstClass(), "sort of parameter", bound_vars[i], i)
         << "first-class sort of parameter of defined function";
@@ -4254,14 +4890,14 @@ Term Solver::defineFun(const std::string& symbol,
   CVC4_API_CHECK(sort == term.getSort())
       << "Invalid sort of function body '" << term << "', expected '" << sort
       << "'";
-  Type type = *sort.d_type;
+  Type type = sort.getType();
   if (!domain_types.empty())
   {
     type = d_exprMgr->mkFunctionType(domain_types, type);
   }
   Expr fun = d_exprMgr->mkVar(symbol, type);
   std::vector<Expr> ebound_vars = termVectorToExprs(bound_vars);
-  d_smtEngine->defineFunction(fun, ebound_vars, *term.d_expr, global);
+  d_smtEngine->defineFunction(fun, ebound_vars, term.getExpr(), global);
   return Term(this, fun);
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
@@ -4272,6 +4908,7 @@ Term Solver::defineFun(Term fun,
                        bool global) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
 
   if (fun.getSort().isFunction())
   {
@@ -4285,7 +4922,7 @@ Term Solver::defineFun(Term fun,
           this == bound_vars[i].d_solver, "bound variable", bound_vars[i], i)
           << "bound variable associated to this solver object";
       CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(
-          bound_vars[i].d_expr->getKind() == CVC4::Kind::BOUND_VARIABLE,
+          bound_vars[i].getExpr().getKind() == CVC4::Kind::BOUND_VARIABLE,
           "bound variable",
           bound_vars[i],
           i)
@@ -4311,7 +4948,8 @@ Term Solver::defineFun(Term fun,
   CVC4_API_SOLVER_CHECK_TERM(term);
 
   std::vector<Expr> ebound_vars = termVectorToExprs(bound_vars);
-  d_smtEngine->defineFunction(*fun.d_expr, ebound_vars, *term.d_expr, global);
+  d_smtEngine->defineFunction(
+      fun.getExpr(), ebound_vars, term.getExpr(), global);
   return fun;
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
@@ -4326,6 +4964,7 @@ Term Solver::defineFunRec(const std::string& symbol,
                           bool global) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
 
   CVC4_API_CHECK(d_smtEngine->getUserLogicInfo().isQuantified())
       << "recursive function definitions require a logic with quantifiers";
@@ -4344,12 +4983,12 @@ Term Solver::defineFunRec(const std::string& symbol,
         this == bound_vars[i].d_solver, "bound variable", bound_vars[i], i)
         << "bound variable associated to this solver object";
     CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(
-        bound_vars[i].d_expr->getKind() == CVC4::Kind::BOUND_VARIABLE,
+        bound_vars[i].getExpr().getKind() == CVC4::Kind::BOUND_VARIABLE,
         "bound variable",
         bound_vars[i],
         i)
         << "a bound variable";
-    CVC4::Type t = bound_vars[i].d_expr->getType();
+    CVC4::Type t = bound_vars[i].getExpr().getType();
     CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(
         t.isFirstClass(), "sort of parameter", bound_vars[i], i)
         << "first-class sort of parameter of defined function";
@@ -4360,14 +4999,14 @@ Term Solver::defineFunRec(const std::string& symbol,
       << "Invalid sort of function body '" << term << "', expected '" << sort
       << "'";
   CVC4_API_SOLVER_CHECK_TERM(term);
-  Type type = *sort.d_type;
+  Type type = sort.getType();
   if (!domain_types.empty())
   {
     type = d_exprMgr->mkFunctionType(domain_types, type);
   }
   Expr fun = d_exprMgr->mkVar(symbol, type);
   std::vector<Expr> ebound_vars = termVectorToExprs(bound_vars);
-  d_smtEngine->defineFunctionRec(fun, ebound_vars, *term.d_expr, global);
+  d_smtEngine->defineFunctionRec(fun, ebound_vars, term.getExpr(), global);
   return Term(this, fun);
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
@@ -4378,6 +5017,7 @@ Term Solver::defineFunRec(Term fun,
                           bool global) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
 
   CVC4_API_CHECK(d_smtEngine->getUserLogicInfo().isQuantified())
       << "recursive function definitions require a logic with quantifiers";
@@ -4398,7 +5038,7 @@ Term Solver::defineFunRec(Term fun,
           this == bound_vars[i].d_solver, "bound variable", bound_vars[i], i)
           << "bound variable associated to this solver object";
       CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(
-          bound_vars[i].d_expr->getKind() == CVC4::Kind::BOUND_VARIABLE,
+          bound_vars[i].getExpr().getKind() == CVC4::Kind::BOUND_VARIABLE,
           "bound variable",
           bound_vars[i],
           i)
@@ -4424,7 +5064,7 @@ Term Solver::defineFunRec(Term fun,
   CVC4_API_SOLVER_CHECK_TERM(term);
   std::vector<Expr> ebound_vars = termVectorToExprs(bound_vars);
   d_smtEngine->defineFunctionRec(
-      *fun.d_expr, ebound_vars, *term.d_expr, global);
+      fun.getExpr(), ebound_vars, term.getExpr(), global);
   return fun;
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
@@ -4438,6 +5078,7 @@ void Solver::defineFunsRec(const std::vector<Term>& funs,
                            bool global) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
 
   CVC4_API_CHECK(d_smtEngine->getUserLogicInfo().isQuantified())
       << "recursive function definitions require a logic with quantifiers";
@@ -4474,7 +5115,7 @@ void Solver::defineFunsRec(const std::vector<Term>& funs,
               this == bvars[k].d_solver, "bound variable", bvars[k], k)
               << "bound variable associated to this solver object";
           CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(
-              bvars[k].d_expr->getKind() == CVC4::Kind::BOUND_VARIABLE,
+              bvars[k].getExpr().getKind() == CVC4::Kind::BOUND_VARIABLE,
               "bound variable",
               bvars[k],
               k)
@@ -4524,6 +5165,7 @@ void Solver::echo(std::ostream& out, const std::string& str) const
 std::vector<Term> Solver::getAssertions(void) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   std::vector<Expr> assertions = d_smtEngine->getAssertions();
   /* Can not use
    *   return std::vector<Term>(assertions.begin(), assertions.end());
@@ -4544,6 +5186,7 @@ std::vector<std::pair<Term, Term>> Solver::getAssignment(void) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
   CVC4::ExprManagerScope exmgrs(*(d_exprMgr.get()));
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   CVC4_API_CHECK(CVC4::options::produceAssignments())
       << "Cannot get assignment unless assignment generation is enabled "
          "(try --produce-assignments)";
@@ -4563,6 +5206,7 @@ std::vector<std::pair<Term, Term>> Solver::getAssignment(void) const
 std::string Solver::getInfo(const std::string& flag) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   CVC4_API_CHECK(d_smtEngine->isValidGetInfoFlag(flag))
       << "Unrecognized flag for getInfo.";
 
@@ -4576,6 +5220,7 @@ std::string Solver::getInfo(const std::string& flag) const
 std::string Solver::getOption(const std::string& option) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   SExpr res = d_smtEngine->getOption(option);
   return res.toString();
   CVC4_API_SOLVER_TRY_CATCH_END;
@@ -4588,6 +5233,7 @@ std::vector<Term> Solver::getUnsatAssumptions(void) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
   CVC4::ExprManagerScope exmgrs(*(d_exprMgr.get()));
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   CVC4_API_CHECK(CVC4::options::incrementalSolving())
       << "Cannot get unsat assumptions unless incremental solving is enabled "
          "(try --incremental)";
@@ -4618,6 +5264,7 @@ std::vector<Term> Solver::getUnsatCore(void) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
   CVC4::ExprManagerScope exmgrs(*(d_exprMgr.get()));
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   CVC4_API_CHECK(CVC4::options::unsatCores())
       << "Cannot get unsat core unless explicitly enabled "
          "(try --produce-unsat-cores)";
@@ -4643,8 +5290,9 @@ std::vector<Term> Solver::getUnsatCore(void) const
 Term Solver::getValue(Term term) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   CVC4_API_SOLVER_CHECK_TERM(term);
-  return Term(this, d_smtEngine->getValue(*term.d_expr));
+  return Term(this, d_smtEngine->getValue(term.getExpr()));
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
 
@@ -4655,6 +5303,7 @@ std::vector<Term> Solver::getValue(const std::vector<Term>& terms) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
   CVC4::ExprManagerScope exmgrs(*(d_exprMgr.get()));
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   CVC4_API_CHECK(CVC4::options::produceModels())
       << "Cannot get value unless model generation is enabled "
          "(try --produce-models)";
@@ -4668,7 +5317,7 @@ std::vector<Term> Solver::getValue(const std::vector<Term>& terms) const
         this == terms[i].d_solver, "term", terms[i], i)
         << "term associated to this solver object";
     /* Can not use emplace_back here since constructor is private. */
-    res.push_back(Term(this, d_smtEngine->getValue(*terms[i].d_expr)));
+    res.push_back(Term(this, d_smtEngine->getValue(terms[i].getExpr())));
   }
   return res;
   CVC4_API_SOLVER_TRY_CATCH_END;
@@ -4677,6 +5326,7 @@ std::vector<Term> Solver::getValue(const std::vector<Term>& terms) const
 Term Solver::getSeparationHeap() const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   CVC4_API_CHECK(
       d_smtEngine->getLogicInfo().isTheoryEnabled(theory::THEORY_SEP))
       << "Cannot obtain separation logic expressions if not using the "
@@ -4702,6 +5352,7 @@ Term Solver::getSeparationHeap() const
 Term Solver::getSeparationNilTerm() const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   CVC4_API_CHECK(
       d_smtEngine->getLogicInfo().isTheoryEnabled(theory::THEORY_SEP))
       << "Cannot obtain separation logic expressions if not using the "
@@ -4731,6 +5382,7 @@ void Solver::pop(uint32_t nscopes) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
   CVC4::ExprManagerScope exmgrs(*(d_exprMgr.get()));
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   CVC4_API_CHECK(CVC4::options::incrementalSolving())
       << "Cannot pop when not solving incrementally (use --incremental)";
   CVC4_API_CHECK(nscopes <= d_smtEngine->getNumUserLevels())
@@ -4748,6 +5400,7 @@ void Solver::printModel(std::ostream& out) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
   CVC4::ExprManagerScope exmgrs(*(d_exprMgr.get()));
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   CVC4_API_CHECK(CVC4::options::produceModels())
       << "Cannot get value unless model generation is enabled "
          "(try --produce-models)";
@@ -4765,6 +5418,7 @@ void Solver::push(uint32_t nscopes) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
   CVC4::ExprManagerScope exmgrs(*(d_exprMgr.get()));
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   CVC4_API_CHECK(CVC4::options::incrementalSolving())
       << "Cannot push when not solving incrementally (use --incremental)";
 
@@ -4782,6 +5436,7 @@ void Solver::push(uint32_t nscopes) const
 void Solver::resetAssertions(void) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   d_smtEngine->resetAssertions();
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
@@ -4792,6 +5447,7 @@ void Solver::resetAssertions(void) const
 void Solver::setInfo(const std::string& keyword, const std::string& value) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   CVC4_API_ARG_CHECK_EXPECTED(
       keyword == "source" || keyword == "category" || keyword == "difficulty"
           || keyword == "filename" || keyword == "license" || keyword == "name"
@@ -4820,6 +5476,7 @@ void Solver::setInfo(const std::string& keyword, const std::string& value) const
 void Solver::setLogic(const std::string& logic) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   CVC4_API_CHECK(!d_smtEngine->isFullyInited())
       << "Invalid call to 'setLogic', solver is already fully initialized";
   CVC4::LogicInfo logic_info(logic);
@@ -4834,6 +5491,7 @@ void Solver::setOption(const std::string& option,
                        const std::string& value) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   CVC4_API_CHECK(!d_smtEngine->isFullyInited())
       << "Invalid call to 'setOption', solver is already fully initialized";
   d_smtEngine->setOption(option, value);
@@ -4863,7 +5521,7 @@ Term Solver::ensureTermSort(const Term& term, const Sort& sort) const
     // in the theory.
     res = Term(this,
                d_exprMgr->mkExpr(extToIntKind(DIVISION),
-                                 *res.d_expr,
+                                 res.getExpr(),
                                  d_exprMgr->mkConst(CVC4::Rational(1))));
   }
   Assert(res.getSort() == sort);
@@ -4873,13 +5531,14 @@ Term Solver::ensureTermSort(const Term& term, const Sort& sort) const
 Term Solver::mkSygusVar(Sort sort, const std::string& symbol) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   CVC4_API_ARG_CHECK_NOT_NULL(sort);
   CVC4_API_SOLVER_CHECK_SORT(sort);
 
-  Expr res = d_exprMgr->mkBoundVar(symbol, *sort.d_type);
+  Expr res = d_exprMgr->mkBoundVar(symbol, sort.getType());
   (void)res.getType(true); /* kick off type checking */
 
-  d_smtEngine->declareSygusVar(symbol, res, *sort.d_type);
+  d_smtEngine->declareSygusVar(symbol, res, sort.getType());
 
   return Term(this, res);
 
@@ -4899,7 +5558,7 @@ Grammar Solver::mkSygusGrammar(const std::vector<Term>& boundVars,
         this == boundVars[i].d_solver, "bound variable", boundVars[i], i)
         << "bound variable associated to this solver object";
     CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(
-        boundVars[i].d_expr->getKind() == CVC4::Kind::BOUND_VARIABLE,
+        boundVars[i].getExpr().getKind() == CVC4::Kind::BOUND_VARIABLE,
         "bound variable",
         boundVars[i],
         i)
@@ -4915,7 +5574,7 @@ Grammar Solver::mkSygusGrammar(const std::vector<Term>& boundVars,
         this == ntSymbols[i].d_solver, "term", ntSymbols[i], i)
         << "term associated to this solver object";
     CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(
-        ntSymbols[i].d_expr->getKind() == CVC4::Kind::BOUND_VARIABLE,
+        ntSymbols[i].getExpr().getKind() == CVC4::Kind::BOUND_VARIABLE,
         "bound variable",
         ntSymbols[i],
         i)
@@ -4966,9 +5625,10 @@ Term Solver::synthFunHelper(const std::string& symbol,
                             Grammar* g) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   CVC4_API_ARG_CHECK_NOT_NULL(sort);
 
-  CVC4_API_ARG_CHECK_EXPECTED(sort.d_type->isFirstClass(), sort)
+  CVC4_API_ARG_CHECK_EXPECTED(sort.isFirstClass(), sort)
       << "first-class sort as codomain sort for function sort";
 
   std::vector<Type> varTypes;
@@ -4978,7 +5638,7 @@ Term Solver::synthFunHelper(const std::string& symbol,
         this == boundVars[i].d_solver, "bound variable", boundVars[i], i)
         << "bound variable associated to this solver object";
     CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(
-        boundVars[i].d_expr->getKind() == CVC4::Kind::BOUND_VARIABLE,
+        boundVars[i].getExpr().getKind() == CVC4::Kind::BOUND_VARIABLE,
         "bound variable",
         boundVars[i],
         i)
@@ -4986,27 +5646,27 @@ Term Solver::synthFunHelper(const std::string& symbol,
     CVC4_API_ARG_AT_INDEX_CHECK_EXPECTED(
         !boundVars[i].isNull(), "parameter term", boundVars[i], i)
         << "non-null term";
-    varTypes.push_back(boundVars[i].d_expr->getType());
+    varTypes.push_back(boundVars[i].getExpr().getType());
   }
   CVC4_API_SOLVER_CHECK_SORT(sort);
 
   if (g != nullptr)
   {
-    CVC4_API_CHECK(g->d_ntSyms[0].d_expr->getType() == *sort.d_type)
+    CVC4_API_CHECK(g->d_ntSyms[0].getExpr().getType() == sort.getType())
         << "Invalid Start symbol for Grammar g, Expected Start's sort to be "
-        << *sort.d_type;
+        << sort.getType();
   }
 
   Type funType = varTypes.empty()
-                     ? *sort.d_type
-                     : d_exprMgr->mkFunctionType(varTypes, *sort.d_type);
+                     ? sort.getType()
+                     : d_exprMgr->mkFunctionType(varTypes, sort.getType());
 
   Expr fun = d_exprMgr->mkBoundVar(symbol, funType);
   (void)fun.getType(true); /* kick off type checking */
 
   d_smtEngine->declareSynthFun(symbol,
                                fun,
-                               g == nullptr ? funType : *g->resolve().d_type,
+                               g == nullptr ? funType : g->resolve().getType(),
                                isInv,
                                termVectorToExprs(boundVars));
 
@@ -5018,13 +5678,14 @@ Term Solver::synthFunHelper(const std::string& symbol,
 void Solver::addSygusConstraint(Term term) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   CVC4_API_ARG_CHECK_NOT_NULL(term);
   CVC4_API_SOLVER_CHECK_TERM(term);
   CVC4_API_ARG_CHECK_EXPECTED(
-      term.d_expr->getType() == d_exprMgr->booleanType(), term)
+      term.getExpr().getType() == d_exprMgr->booleanType(), term)
       << "boolean term";
 
-  d_smtEngine->assertSygusConstraint(*term.d_expr);
+  d_smtEngine->assertSygusConstraint(term.getExpr());
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
 
@@ -5034,6 +5695,7 @@ void Solver::addSygusInvConstraint(Term inv,
                                    Term post) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   CVC4_API_ARG_CHECK_NOT_NULL(inv);
   CVC4_API_SOLVER_CHECK_TERM(inv);
   CVC4_API_ARG_CHECK_NOT_NULL(pre);
@@ -5043,18 +5705,18 @@ void Solver::addSygusInvConstraint(Term inv,
   CVC4_API_ARG_CHECK_NOT_NULL(post);
   CVC4_API_SOLVER_CHECK_TERM(post);
 
-  CVC4_API_ARG_CHECK_EXPECTED(inv.d_expr->getType().isFunction(), inv)
+  CVC4_API_ARG_CHECK_EXPECTED(inv.getExpr().getType().isFunction(), inv)
       << "a function";
 
-  FunctionType invType = inv.d_expr->getType();
+  FunctionType invType = inv.getExpr().getType();
 
   CVC4_API_ARG_CHECK_EXPECTED(invType.getRangeType().isBoolean(), inv)
       << "boolean range";
 
-  CVC4_API_CHECK(pre.d_expr->getType() == invType)
+  CVC4_API_CHECK(pre.getExpr().getType() == invType)
       << "Expected inv and pre to have the same sort";
 
-  CVC4_API_CHECK(post.d_expr->getType() == invType)
+  CVC4_API_CHECK(post.getExpr().getType() == invType)
       << "Expected inv and post to have the same sort";
 
   const std::vector<Type>& invArgTypes = invType.getArgTypes();
@@ -5071,17 +5733,18 @@ void Solver::addSygusInvConstraint(Term inv,
   expectedTypes.push_back(invType.getRangeType());
   FunctionType expectedTransType = d_exprMgr->mkFunctionType(expectedTypes);
 
-  CVC4_API_CHECK(trans.d_expr->getType() == expectedTransType)
+  CVC4_API_CHECK(trans.getExpr().getType() == expectedTransType)
       << "Expected trans's sort to be " << invType;
 
   d_smtEngine->assertSygusInvConstraint(
-      *inv.d_expr, *pre.d_expr, *trans.d_expr, *post.d_expr);
+      inv.getExpr(), pre.getExpr(), trans.getExpr(), post.getExpr());
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
 
 Result Solver::checkSynth() const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   return d_smtEngine->checkSynth();
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
@@ -5089,6 +5752,7 @@ Result Solver::checkSynth() const
 Term Solver::getSynthSolution(Term term) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   CVC4_API_ARG_CHECK_NOT_NULL(term);
   CVC4_API_SOLVER_CHECK_TERM(term);
 
@@ -5097,7 +5761,8 @@ Term Solver::getSynthSolution(Term term) const
       << "The solver is not in a state immediately preceeded by a "
          "successful call to checkSynth";
 
-  std::map<CVC4::Expr, CVC4::Expr>::const_iterator it = map.find(*term.d_expr);
+  std::map<CVC4::Expr, CVC4::Expr>::const_iterator it =
+      map.find(term.getExpr());
 
   CVC4_API_CHECK(it != map.cend()) << "Synth solution not found for given term";
 
@@ -5109,6 +5774,7 @@ std::vector<Term> Solver::getSynthSolutions(
     const std::vector<Term>& terms) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   CVC4_API_ARG_SIZE_CHECK_EXPECTED(!terms.empty(), terms) << "non-empty vector";
 
   for (size_t i = 0, n = terms.size(); i < n; ++i)
@@ -5132,7 +5798,7 @@ std::vector<Term> Solver::getSynthSolutions(
   for (size_t i = 0, n = terms.size(); i < n; ++i)
   {
     std::map<CVC4::Expr, CVC4::Expr>::const_iterator it =
-        map.find(*terms[i].d_expr);
+        map.find(terms[i].getExpr());
 
     CVC4_API_CHECK(it != map.cend())
         << "Synth solution not found for term at index " << i;
@@ -5147,6 +5813,7 @@ std::vector<Term> Solver::getSynthSolutions(
 void Solver::printSynthSolution(std::ostream& out) const
 {
   CVC4_API_SOLVER_TRY_CATCH_BEGIN;
+  CVC4_API_SOLVER_CHECK_NO_ASYNC_CHECK;
   d_smtEngine->printSynthSolution(out);
   CVC4_API_SOLVER_TRY_CATCH_END;
 }
@@ -5157,6 +5824,11 @@ void Solver::printSynthSolution(std::ostream& out) const
  */
 ExprManager* Solver::getExprManager(void) const { return d_exprMgr.get(); }
 
+NodeManager* Solver::getNodeManager(void) const
+{
+  return NodeManager::fromExprManager(d_exprMgr.get());
+}
+
 /**
  * !!! This is only temporarily available until the parser is fully migrated to
  * the new API. !!!
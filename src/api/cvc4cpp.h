@@ -25,6 +25,7 @@
 #include "expr/kind.h"
 // !!!
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <set>
@@ -41,12 +42,18 @@ class Datatype;
 class DatatypeConstructor;
 class DatatypeConstructorArg;
 class ExprManager;
+class NodeManager;
 class SmtEngine;
 class Type;
+class TypeNode;
 class Options;
 class Random;
 class Result;
 
+template <bool ref_count>
+class NodeTemplate;
+typedef NodeTemplate<true> Node;
+
 namespace api {
 
 class Solver;
@@ -177,6 +184,95 @@ class CVC4_PUBLIC Result
  */
 std::ostream& operator<<(std::ostream& out, const Result& r) CVC4_PUBLIC;
 
+/* -------------------------------------------------------------------------- */
+/* AsyncResult                                                                */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * The progress of a satisfiability check that is run by
+ * Solver::checkSatAsync(), as reported to its progress callback. The counts
+ * are cumulative over all the checks of the solver, and they are also kept in
+ * builds without statistics.
+ */
+struct CVC4_PUBLIC CheckProgress
+{
+  /** The number of decisions. */
+  uint64_t d_decisions;
+  /** The number of conflict steps of the SAT solver. */
+  uint64_t d_conflicts;
+  /** The number of lemmas. */
+  uint64_t d_lemmas;
+  /** The number of resource units spent. */
+  uint64_t d_resourceUnits;
+  /** The milliseconds of wall time since the start of the check. */
+  uint64_t d_millis;
+};
+
+class AsyncCheck;
+
+/**
+ * A handle to a satisfiability check that is run by Solver::checkSatAsync()
+ * on a thread of its own. Handles are copied by sharing the check, and they
+ * may be used from any thread.
+ */
+class CVC4_PUBLIC AsyncResult
+{
+  friend class Solver;
+
+ public:
+  /** Constructor. */
+  AsyncResult();
+
+  /**
+   * @return true if this is a null handle, i.e., it was not returned by
+   * Solver::checkSatAsync()
+   */
+  bool isNull() const;
+
+  /** @return true if the check is finished. */
+  bool isReady() const;
+
+  /** Wait until the check is finished. */
+  void wait() const;
+
+  /**
+   * Wait until the check is finished, for at most the given time.
+   * @param millis the time to wait for, in milliseconds
+   * @return true if the check is finished
+   */
+  bool waitFor(uint64_t millis) const;
+
+  /**
+   * Wait until the check is finished, and get its result.
+   * If the check failed, this throws the exception it failed with.
+   * @return the result of the check
+   */
+  Result getResult() const;
+
+  /**
+   * Cancel the check. The check stops the next time the solver spends a
+   * resource, with an unknown result that is explained by INTERRUPTED, unless
+   * it is finished before. This does not wait for the check to stop.
+   */
+  void cancel() const;
+
+ private:
+  /**
+   * Constructor.
+   * @param check the check that is referred to by this handle
+   */
+  AsyncResult(const std::shared_ptr<AsyncCheck>& check);
+
+  /**
+   * Helper for isNull checks. This prevents calling an API function with
+   * CVC4_API_CHECK_NOT_NULL
+   */
+  bool isNullHelper() const;
+
+  /** The check that is referred to by this handle. */
+  std::shared_ptr<AsyncCheck> d_check;
+};
+
 /* -------------------------------------------------------------------------- */
 /* Sort                                                                       */
 /* -------------------------------------------------------------------------- */
@@ -597,12 +693,20 @@ class CVC4_PUBLIC Sort
   const Solver* d_solver;
 
   /**
-   * The interal type wrapped by this sort.
-   * This is a shared_ptr rather than a unique_ptr to avoid overhead due to
-   * memory allocation (CVC4::Type is already ref counted, so this could be
-   * a unique_ptr instead).
+   * Constructor.
+   * @param slv the associated solver object
+   * @param t the internal type node that is to be wrapped by this sort
+   * @return the Sort
    */
-  std::shared_ptr<CVC4::Type> d_type;
+  Sort(const Solver* slv, const CVC4::TypeNode& t);
+
+  /**
+   * The internal type node wrapped by this sort.
+   * This is a shared_ptr since TypeNode is not part of the public interface.
+   * Sorts are copied by sharing it, and it is released in the scope of the
+   * node manager of the associated solver.
+   */
+  std::shared_ptr<CVC4::TypeNode> d_type;
 };
 
 /**
@@ -979,11 +1083,11 @@ class CVC4_PUBLIC Term
     /**
      * Constructor
      * @param slv the associated solver object
-     * @param e a shared pointer to the expression that we're iterating over
+     * @param n a shared pointer to the node that we're iterating over
      * @param p the position of the iterator (e.g. which child it's on)
      */
     const_iterator(const Solver* slv,
-                   const std::shared_ptr<CVC4::Expr>& e,
+                   const std::shared_ptr<CVC4::Node>& n,
                    uint32_t p);
 
     /**
@@ -1035,8 +1139,8 @@ class CVC4_PUBLIC Term
      * The associated solver object.
      */
     const Solver* d_solver;
-    /* The original expression to be iterated over */
-    std::shared_ptr<CVC4::Expr> d_orig_expr;
+    /* The original node to be iterated over */
+    std::shared_ptr<CVC4::Node> d_origNode;
     /* Keeps track of the iteration position */
     uint32_t d_pos;
   };
@@ -1069,12 +1173,20 @@ class CVC4_PUBLIC Term
   bool isNullHelper() const;
 
   /**
-   * The internal expression wrapped by this term.
-   * This is a shared_ptr rather than a unique_ptr to avoid overhead due to
-   * memory allocation (CVC4::Expr is already ref counted, so this could be
-   * a unique_ptr instead).
+   * Constructor.
+   * @param slv the associated solver object
+   * @param n the internal node that is to be wrapped by this term
+   * @return the Term
    */
-  std::shared_ptr<CVC4::Expr> d_expr;
+  Term(const Solver* slv, const CVC4::Node& n);
+
+  /**
+   * The internal node wrapped by this term.
+   * This is a shared_ptr since Node is not part of the public interface.
+   * Terms are copied by sharing it, and it is released in the scope of the
+   * node manager of the associated solver.
+   */
+  std::shared_ptr<CVC4::Node> d_node;
 };
 
 /**
@@ -1085,6 +1197,23 @@ struct CVC4_PUBLIC TermHashFunction
   size_t operator()(const Term& t) const;
 };
 
+/**
+ * A term of a DAG that is created by Solver::mkTerms(), given by the index
+ * of its operator and its number of children.
+ */
+struct CVC4_PUBLIC TermRecord
+{
+  TermRecord() : d_op(0), d_numChildren(0) {}
+  TermRecord(uint32_t op, uint32_t numChildren)
+      : d_op(op), d_numChildren(numChildren)
+  {
+  }
+  /** The index of the operator of the term. */
+  uint32_t d_op;
+  /** The number of children of the term. */
+  uint32_t d_numChildren;
+};
+
 /**
  * Serialize a term to given stream.
  * @param out the output stream
@@ -2019,6 +2148,9 @@ struct CVC4_PUBLIC RoundingModeHashFunction
  */
 class CVC4_PUBLIC Solver
 {
+  friend class Sort;
+  friend class Term;
+
  public:
   /* .................................................................... */
   /* Constructors/Destructors                                             */
@@ -2302,6 +2434,32 @@ class CVC4_PUBLIC Solver
    */
   Term mkTerm(Op op, const std::vector<Term>& children) const;
 
+  /**
+   * Create the terms of a DAG in one call. This is much faster than creating
+   * them one by one with mkTerm(), since the arguments are checked once and
+   * the intermediate terms are never converted.
+   *
+   * The nodes of the DAG are numbered: the leaves first, from 0, then the
+   * records. Record i denotes the term whose operator is ops[records[i].d_op]
+   * and whose children are the next records[i].d_numChildren nodes listed in
+   * children. The children of a record must precede it. A record whose
+   * operator is not indexed is created as by
+   * mkTerm(Kind, const std::vector<Term>&), hence it may have more children
+   * than its kind allows, e.g. a chain of equalities.
+   *
+   * @param leaves the terms the DAG is built on
+   * @param ops the operators of the records
+   * @param records the records of the DAG, children before parents
+   * @param children the children of the records, one record after the other
+   * @param roots the nodes whose terms are returned
+   * @return the terms of the roots
+   */
+  std::vector<Term> mkTerms(const std::vector<Term>& leaves,
+                            const std::vector<Op>& ops,
+                            const std::vector<TermRecord>& records,
+                            const std::vector<uint32_t>& children,
+                            const std::vector<uint32_t>& roots) const;
+
   /**
    * Create a tuple term. Terms are automatically converted if sorts are
    * compatible.
@@ -2807,6 +2965,29 @@ class CVC4_PUBLIC Solver
    */
   Result checkSatAssuming(const std::vector<Term>& assumptions) const;
 
+  /**
+   * Check satisfiability assuming the given formulas, on a thread of its own.
+   * No other method of this solver may be called, and its terms and sorts may
+   * not be used, until the check is finished. The methods that use the SMT
+   * engine of this solver check this and throw an exception. The returned
+   * handle may be used from any thread to wait for the result, or to cancel
+   * the check. A solver that is destroyed cancels its unfinished check and
+   * waits for it.
+   *
+   * If a progress callback is given, it is called on the thread of the check,
+   * at most once per given period, while the check spends resources. It may
+   * not call the methods of this solver, and it may not throw.
+   *
+   * @param assumptions the formulas to assume
+   * @param progress the progress callback, if any
+   * @param periodMillis the period of the progress callback, in milliseconds
+   * @return a handle to the check
+   */
+  AsyncResult checkSatAsync(
+      const std::vector<Term>& assumptions = std::vector<Term>(),
+      std::function<void(const CheckProgress&)> progress = nullptr,
+      uint64_t periodMillis = 100) const;
+
   /**
    * Check entailment of the given formula w.r.t. the current set of assertions.
    * @param term the formula to check entailment for
@@ -3200,6 +3381,8 @@ class CVC4_PUBLIC Solver
   SmtEngine* getSmtEngine(void) const;
 
  private:
+  /* @return the node manager of this solver. */
+  NodeManager* getNodeManager(void) const;
   /* Helper to convert a vector of internal types to sorts. */
   std::vector<Type> sortVectorToTypes(const std::vector<Sort>& vector) const;
   /* Helper to convert a vector of sorts to internal types. */
@@ -3277,6 +3460,8 @@ class CVC4_PUBLIC Solver
   std::unique_ptr<SmtEngine> d_smtEngine;
   /* The random number generator of this solver. */
   std::unique_ptr<Random> d_rng;
+  /* The last check that was started by checkSatAsync(), if any. */
+  mutable std::shared_ptr<AsyncCheck> d_asyncCheck;
 };
 
 // !!! Only temporarily public until the parser is fully migrated to the
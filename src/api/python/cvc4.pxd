@@ -127,6 +127,10 @@ cdef extern from "api/cvc4cpp.h" namespace "CVC4::api":
         Sort mkTupleSort(const vector[Sort]& sorts) except +
         Term mkTerm(Op op) except +
         Term mkTerm(Op op, const vector[Term]& children) except +
+        vector[Term] mkTerms(const vector[Term]& leaves, const vector[Op]& ops,
+                             const vector[TermRecord]& records,
+                             const vector[uint32_t]& children,
+                             const vector[uint32_t]& roots) except +
         Op mkOp(Kind kind) except +
         Op mkOp(Kind kind, Kind k) except +
         Op mkOp(Kind kind, const string& arg) except +
@@ -173,9 +177,10 @@ cdef extern from "api/cvc4cpp.h" namespace "CVC4::api":
         Term mkVar(Sort sort) except +
         Term simplify(const Term& t) except +
         void assertFormula(Term term) except +
-        Result checkSat() except +
-        Result checkSatAssuming(const vector[Term]& assumptions) except +
-        Result checkEntailed(const vector[Term]& assumptions) except +
+        # the checks are called without the GIL
+        Result checkSat() except + nogil
+        Result checkSatAssuming(const vector[Term]& assumptions) except + nogil
+        Result checkEntailed(const vector[Term]& assumptions) except + nogil
         Sort declareDatatype(const string& symbol, const vector[DatatypeConstructorDecl]& ctors)
         Term declareFun(const string& symbol, Sort sort) except +
         Term declareFun(const string& symbol, const vector[Sort]& sorts, Sort sort) except +
@@ -275,6 +280,12 @@ cdef extern from "api/cvc4cpp.h" namespace "CVC4::api":
         TermHashFunction() except +
         size_t operator()(const Term & t) except +
 
+    cdef cppclass TermRecord:
+        TermRecord() except +
+        TermRecord(uint32_t op, uint32_t numChildren) except +
+        uint32_t d_op
+        uint32_t d_numChildren
+
 
 cdef extern from "api/cvc4cpp.h" namespace "CVC4::api::RoundingMode":
     cdef RoundingMode ROUND_NEAREST_TIES_TO_EVEN,
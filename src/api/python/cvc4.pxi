@@ -23,6 +23,7 @@ from cvc4 cimport ROUND_NEAREST_TIES_TO_EVEN, ROUND_TOWARD_POSITIVE
 from cvc4 cimport ROUND_TOWARD_ZERO, ROUND_NEAREST_TIES_TO_AWAY
 from cvc4 cimport Term as c_Term
 from cvc4 cimport TermHashFunction as c_TermHashFunction
+from cvc4 cimport TermRecord as c_TermRecord
 
 from cvc4kinds cimport Kind as c_Kind
 
@@ -60,11 +61,70 @@ cdef c_SortHashFunction csorthash = c_SortHashFunction()
 cdef c_TermHashFunction ctermhash = c_TermHashFunction()
 
 
+## Objects released while a check runs
+# Releasing a term, sort or other object of the API may free nodes of its
+# solver, which is not thread-safe while the solver runs a check without the
+# GIL. Objects collected during a check are therefore kept here and released
+# once no check runs anymore. These are only accessed while holding the GIL.
+cdef int checks_running = 0
+cdef vector[c_Datatype] deferred_datatypes
+cdef vector[c_DatatypeConstructor] deferred_dtconstructors
+cdef vector[c_DatatypeConstructorDecl] deferred_dtconstructordecls
+cdef vector[c_DatatypeDecl] deferred_dtdecls
+cdef vector[c_DatatypeSelector] deferred_dtselectors
+cdef vector[c_Op] deferred_ops
+cdef vector[c_Sort] deferred_sorts
+cdef vector[c_Term] deferred_terms
+
+cdef void begin_check():
+    global checks_running
+    checks_running += 1
+
+cdef void end_check():
+    global checks_running
+    checks_running -= 1
+    if checks_running == 0:
+        deferred_datatypes.clear()
+        deferred_dtconstructors.clear()
+        deferred_dtconstructordecls.clear()
+        deferred_dtdecls.clear()
+        deferred_dtselectors.clear()
+        deferred_ops.clear()
+        deferred_sorts.clear()
+        deferred_terms.clear()
+
+
+## Conversion of the arguments of the vectorized methods
+cdef vector[uint32_t] uint32_vector(values) except *:
+    '''
+    Converts a buffer of uint32 values, e.g. a NumPy array of dtype uint32,
+    without going through Python objects, or any other sequence of ints.
+    '''
+    cdef vector[uint32_t] v
+    cdef const uint32_t[:] buf
+    cdef Py_ssize_t i
+    try:
+        buf = values
+    except (TypeError, ValueError):
+        # not a buffer of uint32 values, e.g., a list
+        for x in values:
+            v.push_back(x)
+        return v
+    v.reserve(buf.shape[0])
+    for i in range(buf.shape[0]):
+        v.push_back(buf[i])
+    return v
+
+
 cdef class Datatype:
     cdef c_Datatype cd
     def __cinit__(self):
         pass
 
+    def __dealloc__(self):
+        if checks_running > 0:
+            deferred_datatypes.push_back(self.cd)
+
     def __getitem__(self, str name):
         cdef DatatypeConstructor dc = DatatypeConstructor()
         dc.cdc = self.cd[name.encode()]
@@ -104,6 +164,10 @@ cdef class DatatypeConstructor:
     def __cinit__(self):
         self.cdc = c_DatatypeConstructor()
 
+    def __dealloc__(self):
+        if checks_running > 0:
+            deferred_dtconstructors.push_back(self.cdc)
+
     def __getitem__(self, str name):
         cdef DatatypeSelector ds = DatatypeSelector()
         ds.cds = self.cdc[name.encode()]
@@ -138,6 +202,10 @@ cdef class DatatypeConstructorDecl:
     def __cinit__(self):
       pass
 
+    def __dealloc__(self):
+        if checks_running > 0:
+            deferred_dtconstructordecls.push_back(self.cddc)
+
     def addSelector(self, str name, Sort sort):
         self.cddc.addSelector(name.encode(), sort.csort)
 
@@ -156,6 +224,10 @@ cdef class DatatypeDecl:
     def __cinit__(self):
         pass
 
+    def __dealloc__(self):
+        if checks_running > 0:
+            deferred_dtdecls.push_back(self.cdd)
+
     def addConstructor(self, DatatypeConstructorDecl ctor):
         self.cdd.addConstructor(ctor.cddc)
 
@@ -174,6 +246,10 @@ cdef class DatatypeSelector:
     def __cinit__(self):
         self.cds = c_DatatypeSelector()
 
+    def __dealloc__(self):
+        if checks_running > 0:
+            deferred_dtselectors.push_back(self.cds)
+
     def __str__(self):
         return self.cds.toString().decode()
 
@@ -186,6 +262,10 @@ cdef class Op:
     def __cinit__(self):
         self.cop = c_Op()
 
+    def __dealloc__(self):
+        if checks_running > 0:
+            deferred_ops.push_back(self.cop)
+
     def __eq__(self, Op other):
         return self.cop == other.cop
 
@@ -468,6 +548,50 @@ cdef class Solver:
             term.cterm = self.csolver.mkTerm((<Op?> op).cop, v)
         return term
 
+    def mkTerms(self, leaves, ops, records, children, roots):
+        '''
+            Supports the following arguments:
+                 List[Term] mkTerms(List[Term] leaves, List[Op] ops,
+                                    records, children, roots)
+
+                 Creates the terms of a DAG in one call, see Solver::mkTerms
+                 in the C++ API. The kinds in ops are converted to operators.
+                 records lists the index of the operator and the number of
+                 children of each record, one record after the other.
+                 records, children and roots are sequences of ints, or
+                 buffers of uint32 values (e.g. NumPy arrays), which are
+                 converted without going through Python objects
+        '''
+        cdef vector[c_Term] cleaves
+        cdef vector[c_Op] cops
+        cdef vector[uint32_t] crecords = uint32_vector(records)
+        cdef vector[c_TermRecord] v
+        cdef vector[c_Term] cterms
+        cdef Term term
+        cdef size_t i
+
+        if crecords.size() % 2 != 0:
+            raise ValueError("Expecting pairs of an operator and a number "
+                             "of children in records")
+        for l in leaves:
+            cleaves.push_back((<Term?> l).cterm)
+        for o in ops:
+            if isinstance(o, kind):
+                o = self.mkOp(o)
+            cops.push_back((<Op?> o).cop)
+        v.reserve(crecords.size() // 2)
+        for i in range(0, crecords.size(), 2):
+            v.push_back(c_TermRecord(crecords[i], crecords[i + 1]))
+        cterms = self.csolver.mkTerms(cleaves, cops, v,
+                                      uint32_vector(children),
+                                      uint32_vector(roots))
+        terms = []
+        for i in range(cterms.size()):
+            term = Term()
+            term.cterm = cterms[i]
+            terms.append(term)
+        return terms
+
     def mkOp(self, kind k, arg0=None, arg1 = None):
         '''
         Supports the following uses:
@@ -660,6 +784,30 @@ cdef class Solver:
                                             (<str?> symbol).encode())
         return term
 
+    def mkConsts(self, Sort sort, symbols):
+        '''
+            Supports the following arguments:
+                 List[Term] mkConsts(Sort sort, List[str] symbols)
+                 List[Term] mkConsts(Sort sort, int n)
+
+                 Creates a constant of the given sort for each of the given
+                 symbols, or n constants without symbols
+        '''
+        cdef Term term
+        terms = []
+        if isinstance(symbols, int):
+            for _ in range(symbols):
+                term = Term()
+                term.cterm = self.csolver.mkConst(sort.csort)
+                terms.append(term)
+        else:
+            for symbol in symbols:
+                term = Term()
+                term.cterm = self.csolver.mkConst(sort.csort,
+                                                (<str?> symbol).encode())
+                terms.append(term)
+        return terms
+
     def mkVar(self, Sort sort, symbol=None):
         cdef Term term = Term()
         if symbol is None:
@@ -726,9 +874,32 @@ cdef class Solver:
     def assertFormula(self, Term term):
         self.csolver.assertFormula(term.cterm)
 
+    @expand_list_arg(num_req_args=0)
+    def assertFormulas(self, *terms):
+        '''
+            Supports the following arguments:
+                 void assertFormulas(List[Term] terms)
+
+                 where terms can also be comma-separated arguments of
+                 type (boolean) Term
+        '''
+        for t in terms:
+            self.csolver.assertFormula((<Term?> t).cterm)
+
+    # The checks release the GIL, hence several solvers may check
+    # satisfiability concurrently, on threads of their own. A solver may not
+    # be used by other threads while it runs a check. Objects of the API that
+    # are garbage collected meanwhile are released after the check.
     def checkSat(self):
         cdef Result r = Result()
-        r.cr = self.csolver.checkSat()
+        cdef c_Result cr
+        begin_check()
+        try:
+            with nogil:
+                cr = self.csolver.checkSat()
+        finally:
+            end_check()
+        r.cr = cr
         return r
 
     @expand_list_arg(num_req_args=0)
@@ -741,11 +912,18 @@ cdef class Solver:
                  type (boolean) Term
         '''
         cdef Result r = Result()
+        cdef c_Result cr
         # used if assumptions is a list of terms
         cdef vector[c_Term] v
         for a in assumptions:
             v.push_back((<Term?> a).cterm)
-        r.cr = self.csolver.checkSatAssuming(<const vector[c_Term]&> v)
+        begin_check()
+        try:
+            with nogil:
+                cr = self.csolver.checkSatAssuming(<const vector[c_Term]&> v)
+        finally:
+            end_check()
+        r.cr = cr
         return r
 
     @expand_list_arg(num_req_args=0)
@@ -758,11 +936,18 @@ cdef class Solver:
                  type (boolean) Term
         '''
         cdef Result r = Result()
+        cdef c_Result cr
         # used if assumptions is a list of terms
         cdef vector[c_Term] v
         for a in assumptions:
             v.push_back((<Term?> a).cterm)
-        r.cr = self.csolver.checkEntailed(<const vector[c_Term]&> v)
+        begin_check()
+        try:
+            with nogil:
+                cr = self.csolver.checkEntailed(<const vector[c_Term]&> v)
+        finally:
+            end_check()
+        r.cr = cr
         return r
 
     @expand_list_arg(num_req_args=1)
@@ -955,6 +1140,10 @@ cdef class Sort:
         # csort always set by Solver
         pass
 
+    def __dealloc__(self):
+        if checks_running > 0:
+            deferred_sorts.push_back(self.csort)
+
     def __eq__(self, Sort other):
         return self.csort == other.csort
 
@@ -1053,6 +1242,10 @@ cdef class Term:
         # cterm always set in the Solver object
         pass
 
+    def __dealloc__(self):
+        if checks_running > 0:
+            deferred_terms.push_back(self.cterm)
+
     def __eq__(self, Term other):
         return self.cterm == other.cterm
 
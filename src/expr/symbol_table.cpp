@@ -21,20 +21,18 @@
 #include <ostream>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
-#include "context/cdhashmap.h"
-#include "context/cdhashset.h"
-#include "context/context.h"
+#include "base/check.h"
 #include "expr/expr.h"
 #include "expr/expr_manager_scope.h"
+#include "expr/node_manager.h"
 #include "expr/type.h"
+#include "util/hash.h"
 
 namespace CVC4 {
 
-using ::CVC4::context::CDHashMap;
-using ::CVC4::context::CDHashSet;
-using ::CVC4::context::Context;
 using ::std::copy;
 using ::std::endl;
 using ::std::ostream_iterator;
@@ -42,11 +40,216 @@ using ::std::pair;
 using ::std::string;
 using ::std::vector;
 
+/**
+ * The names of the symbols of a symbol table, interned as consecutive ids.
+ *
+ * The names are stored in a flat hash table with linear probing, whose slots
+ * hold ids, together with the hashes of the names, so that probing compares
+ * strings only when their hashes are equal. Names are never removed, hence
+ * the ids index the flat arrays of the symbol table.
+ */
+class SymbolNames
+{
+ public:
+  /** The id of names that are not interned */
+  static const uint32_t NONE = static_cast<uint32_t>(-1);
+
+  SymbolNames() : d_slots(16, NONE) {}
+
+  /** Get the id of name, or NONE if it is not interned */
+  uint32_t find(const string& name) const
+  {
+    size_t hash = std::hash<string>()(name);
+    size_t mask = d_slots.size() - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask)
+    {
+      uint32_t id = d_slots[i];
+      if (id == NONE || (d_hashes[id] == hash && d_names[id] == name))
+      {
+        return id;
+      }
+    }
+  }
+
+  /** Get the id of name, interning it if needed */
+  uint32_t intern(const string& name)
+  {
+    size_t hash = std::hash<string>()(name);
+    size_t mask = d_slots.size() - 1;
+    size_t i = hash & mask;
+    for (; d_slots[i] != NONE; i = (i + 1) & mask)
+    {
+      uint32_t id = d_slots[i];
+      if (d_hashes[id] == hash && d_names[id] == name)
+      {
+        return id;
+      }
+    }
+    uint32_t id = static_cast<uint32_t>(d_names.size());
+    d_names.push_back(name);
+    d_hashes.push_back(hash);
+    d_slots[i] = id;
+    // keep the load factor below 1/2
+    if (2 * d_names.size() > d_slots.size())
+    {
+      grow();
+    }
+    return id;
+  }
+
+  /** Get the name of the symbol with the given id */
+  const string& getName(uint32_t id) const { return d_names[id]; }
+
+  /** Get the number of interned names */
+  size_t size() const { return d_names.size(); }
+
+ private:
+  /** Double the number of slots, and reinsert the ids */
+  void grow()
+  {
+    d_slots.assign(2 * d_slots.size(), NONE);
+    size_t mask = d_slots.size() - 1;
+    for (uint32_t id = 0, size = d_names.size(); id < size; id++)
+    {
+      size_t i = d_hashes[id] & mask;
+      while (d_slots[i] != NONE)
+      {
+        i = (i + 1) & mask;
+      }
+      d_slots[i] = id;
+    }
+  }
+
+  /** The interned names, indexed by their ids */
+  vector<string> d_names;
+  /** The hashes of the interned names, indexed by their ids */
+  vector<size_t> d_hashes;
+  /** The slots of the hash table, whose size is a power of two */
+  vector<uint32_t> d_slots;
+}; /* class SymbolNames */
+
+const uint32_t SymbolNames::NONE;
+
+/**
+ * A scoped map from symbol ids to values.
+ *
+ * The current value of each symbol is stored in a flat array indexed by its
+ * id, so that lookups do not probe. Overwriting a binding inside a scope
+ * records the previous one in an undo log, and popping a scope restores the
+ * bindings recorded since it was pushed, in reverse order. Hence the cost of
+ * popping a scope is linear in the number of bindings made in it, and
+ * bindings at level 0 cost nothing to scope.
+ */
+template <class T>
+class ScopedSymbolMap
+{
+ public:
+  /** Get the value bound to id, or nullptr if it is not bound */
+  const T* find(uint32_t id) const
+  {
+    if (id >= d_entries.size() || !d_entries[id].d_bound)
+    {
+      return nullptr;
+    }
+    return &d_entries[id].d_value;
+  }
+
+  /**
+   * Bind id to value in the current scope. If levelZero is true, the binding
+   * is also the one restored when all scopes are popped.
+   */
+  void insert(uint32_t id, const T& value, bool levelZero)
+  {
+    if (id >= d_entries.size())
+    {
+      d_entries.resize(id + 1);
+    }
+    Entry& e = d_entries[id];
+    if (levelZero)
+    {
+      // the binding that is restored after popping all scopes is the one
+      // saved by the first log entry for id, if any
+      if (e.d_firstUndo != NONE)
+      {
+        d_undo[e.d_firstUndo].d_bound = true;
+        d_undo[e.d_firstUndo].d_value = value;
+      }
+    }
+    else if (!d_scopes.empty())
+    {
+      if (e.d_firstUndo == NONE)
+      {
+        e.d_firstUndo = d_undo.size();
+      }
+      d_undo.push_back(UndoEntry{id, e.d_bound, e.d_value});
+    }
+    e.d_bound = true;
+    e.d_value = value;
+  }
+
+  void pushScope() { d_scopes.push_back(d_undo.size()); }
+
+  /** Remove all bindings and scopes */
+  void clear()
+  {
+    d_entries.clear();
+    d_undo.clear();
+    d_scopes.clear();
+  }
+
+  void popScope()
+  {
+    Assert(!d_scopes.empty());
+    for (size_t i = d_undo.size(); i-- > d_scopes.back();)
+    {
+      UndoEntry& u = d_undo[i];
+      Entry& e = d_entries[u.d_id];
+      e.d_bound = u.d_bound;
+      e.d_value = std::move(u.d_value);
+      if (e.d_firstUndo == i)
+      {
+        e.d_firstUndo = NONE;
+      }
+    }
+    d_undo.resize(d_scopes.back());
+    d_scopes.pop_back();
+  }
+
+ private:
+  static const size_t NONE = static_cast<size_t>(-1);
+  /** The current binding of a symbol */
+  struct Entry
+  {
+    Entry() : d_bound(false), d_value(), d_firstUndo(NONE) {}
+    bool d_bound;
+    T d_value;
+    /** The index of the first log entry that saves this binding, if any */
+    size_t d_firstUndo;
+  };
+  /** A binding that is restored when popping a scope */
+  struct UndoEntry
+  {
+    uint32_t d_id;
+    bool d_bound;
+    T d_value;
+  };
+  /** The current bindings, indexed by symbol id */
+  vector<Entry> d_entries;
+  /** The log of the bindings to restore */
+  vector<UndoEntry> d_undo;
+  /** The size of the log when each of the current scopes was pushed */
+  vector<size_t> d_scopes;
+}; /* class ScopedSymbolMap */
+
 /** Overloaded type trie.
  *
  * This data structure stores a trie of expressions with
  * the same name, and must be distinguished by their argument types.
- * It is context-dependent.
+ * It is scoped like the symbol table that owns it.
+ *
+ * The trie is stored flat: its nodes are numbered, the root of each
+ * overloaded symbol is found by its symbol id, and the edges are kept in a
+ * single hash table keyed by the parent node and the id of the argument type.
  *
  * Using the argument allowFunVariants,
  * it may either be configured to allow function variants or not,
@@ -93,33 +296,39 @@ using ::std::vector;
  */
 class OverloadedTypeTrie {
  public:
-  OverloadedTypeTrie(Context* c, bool allowFunVariants = false)
-      : d_overloaded_symbols(new (true) CDHashSet<Expr, ExprHashFunction>(c)),
-        d_allowFunctionVariants(allowFunVariants)
+  OverloadedTypeTrie(bool allowFunVariants = false)
+      : d_allowFunctionVariants(allowFunVariants)
   {
   }
-  ~OverloadedTypeTrie() { d_overloaded_symbols->deleteSelf(); }
 
   /** is this function overloaded? */
-  bool isOverloadedFunction(Expr fun) const;
+  bool isOverloadedFunction(const Expr& fun) const;
 
   /** Get overloaded constant for type.
-   * If possible, it returns a defined symbol with name
+   * If possible, it returns a defined symbol with the given symbol id
    * that has type t. Otherwise returns null expression.
    */
-  Expr getOverloadedConstantForType(const std::string& name, Type t) const;
+  Expr getOverloadedConstantForType(uint32_t symbol, Type t) const;
 
   /**
-   * If possible, returns a defined function for a name
+   * If possible, returns a defined function for a symbol id
    * and a vector of expected argument types. Otherwise returns
    * null expression.
    */
-  Expr getOverloadedFunctionForTypes(const std::string& name,
+  Expr getOverloadedFunctionForTypes(uint32_t symbol,
                                      const std::vector<Type>& argTypes) const;
   /** called when obj is bound to name, and prev_bound_obj was already bound to
-   * name Returns false if the binding is invalid.
+   * name Returns false if the binding is invalid. If levelZero is true, the
+   * symbols remain overloaded when popping scopes.
    */
-  bool bind(const string& name, Expr prev_bound_obj, Expr obj);
+  bool bind(const string& name,
+            uint32_t symbol,
+            Expr prev_bound_obj,
+            Expr obj,
+            bool levelZero);
+
+  void pushScope() { d_scopes.push_back(d_activated.size()); }
+  void popScope();
 
  private:
   /** Marks expression obj with name as overloaded.
@@ -137,54 +346,76 @@ class OverloadedTypeTrie {
    * These are put in the same place in the trie but do not have identical type,
    * hence we return false.
    */
-  bool markOverloaded(const string& name, Expr obj);
+  bool markOverloaded(const string& name,
+                      uint32_t symbol,
+                      Expr obj,
+                      bool levelZero);
   /** the null expression */
   Expr d_nullExpr;
-  // The (context-independent) trie storing that maps expected argument
+  /** The index of trie nodes that do not exist */
+  static const uint32_t NONE = static_cast<uint32_t>(-1);
+  // The (scope-independent) trie storing that maps expected argument
   // vectors to symbols. All expressions stored in d_symbols are only
-  // interpreted as active if they also appear in the context-dependent
-  // set d_overloaded_symbols.
-  class TypeArgTrie {
-   public:
-    // children of this node
-    std::map<Type, TypeArgTrie> d_children;
-    // symbols at this node
-    std::map<Type, Expr> d_symbols;
-  };
-  /** for each string with operator overloading, this stores the data structure
-   * above. */
-  std::unordered_map<std::string, TypeArgTrie> d_overload_type_arg_trie;
+  // interpreted as active if they also appear in the scoped set
+  // d_overloaded_symbols.
+  /** The root of the trie of each symbol, indexed by symbol id, or NONE */
+  std::vector<uint32_t> d_roots;
+  /** The children of the trie nodes, keyed by node and argument type id */
+  std::unordered_map<std::pair<uint32_t, uint64_t>,
+                     uint32_t,
+                     PairHashFunction<uint32_t, uint64_t>>
+      d_children;
+  /** The symbols at each trie node, with their range types */
+  std::vector<std::vector<std::pair<Type, Expr>>> d_symbols;
   /** The set of overloaded symbols. */
-  CDHashSet<Expr, ExprHashFunction>* d_overloaded_symbols;
+  std::unordered_set<Expr, ExprHashFunction> d_overloaded_symbols;
+  /** The symbols made overloaded in the current scopes, in order */
+  std::vector<Expr> d_activated;
+  /** The size of d_activated when each of the current scopes was pushed */
+  std::vector<size_t> d_scopes;
   /** allow function variants
    * This is true if we allow overloading (non-constant) functions that expect
    * the same argument types.
    */
   bool d_allowFunctionVariants;
+  /** Get the child of trie node for the type t, or NONE */
+  uint32_t getChild(uint32_t node, Type t) const;
   /** get unique overloaded function
-  * If tat->d_symbols contains an active overloaded function, it
+  * If the trie node contains an active overloaded function, it
   * returns that function, where that function must be unique 
   * if reqUnique=true.
   * Otherwise, it returns the null expression.
   */
-  Expr getOverloadedFunctionAt(const TypeArgTrie* tat, bool reqUnique=true) const;
+  Expr getOverloadedFunctionAt(uint32_t node, bool reqUnique = true) const;
 };
 
-bool OverloadedTypeTrie::isOverloadedFunction(Expr fun) const {
-  return d_overloaded_symbols->find(fun) != d_overloaded_symbols->end();
+const uint32_t OverloadedTypeTrie::NONE;
+
+bool OverloadedTypeTrie::isOverloadedFunction(const Expr& fun) const {
+  // hashing an expression is not free, and overloading is rare
+  return !d_overloaded_symbols.empty()
+         && d_overloaded_symbols.find(fun) != d_overloaded_symbols.end();
 }
 
-Expr OverloadedTypeTrie::getOverloadedConstantForType(const std::string& name,
+uint32_t OverloadedTypeTrie::getChild(uint32_t node, Type t) const
+{
+  std::unordered_map<std::pair<uint32_t, uint64_t>,
+                     uint32_t,
+                     PairHashFunction<uint32_t, uint64_t>>::const_iterator it =
+      d_children.find(std::make_pair(node, TypeNode::fromType(t).getId()));
+  return it == d_children.end() ? NONE : it->second;
+}
+
+Expr OverloadedTypeTrie::getOverloadedConstantForType(uint32_t symbol,
                                                       Type t) const {
-  std::unordered_map<std::string, TypeArgTrie>::const_iterator it =
-      d_overload_type_arg_trie.find(name);
-  if (it != d_overload_type_arg_trie.end()) {
-    std::map<Type, Expr>::const_iterator its = it->second.d_symbols.find(t);
-    if (its != it->second.d_symbols.end()) {
-      Expr expr = its->second;
+  if (symbol < d_roots.size() && d_roots[symbol] != NONE)
+  {
+    for (const std::pair<Type, Expr>& s : d_symbols[d_roots[symbol]])
+    {
       // must be an active symbol
-      if (isOverloadedFunction(expr)) {
-        return expr;
+      if (s.first == t && isOverloadedFunction(s.second))
+      {
+        return s.second;
       }
     }
   }
@@ -192,63 +423,65 @@ Expr OverloadedTypeTrie::getOverloadedConstantForType(const std::string& name,
 }
 
 Expr OverloadedTypeTrie::getOverloadedFunctionForTypes(
-    const std::string& name, const std::vector<Type>& argTypes) const {
-  std::unordered_map<std::string, TypeArgTrie>::const_iterator it =
-      d_overload_type_arg_trie.find(name);
-  if (it != d_overload_type_arg_trie.end()) {
-    const TypeArgTrie* tat = &it->second;
+    uint32_t symbol, const std::vector<Type>& argTypes) const {
+  if (symbol < d_roots.size() && d_roots[symbol] != NONE)
+  {
+    uint32_t node = d_roots[symbol];
     for (unsigned i = 0; i < argTypes.size(); i++) {
-      std::map<Type, TypeArgTrie>::const_iterator itc =
-          tat->d_children.find(argTypes[i]);
-      if (itc != tat->d_children.end()) {
-        tat = &itc->second;
-      } else {
+      uint32_t child = getChild(node, argTypes[i]);
+      if (child == NONE)
+      {
         Trace("parser-overloading")
-            << "Could not find overloaded function " << name << std::endl;
+            << "Could not find overloaded function with symbol id " << symbol
+            << std::endl;
         // it may be a parametric datatype
         TypeNode tna = TypeNode::fromType(argTypes[i]);
         if (tna.isParametricDatatype())
         {
           Trace("parser-overloading")
-              << "Parametric overloaded datatype selector " << name << " "
-              << tna << std::endl;
+              << "Parametric overloaded datatype selector with symbol id "
+              << symbol << " " << tna << std::endl;
           DatatypeType tnd = static_cast<DatatypeType>(argTypes[i]);
           const Datatype& dt = tnd.getDatatype();
           // tng is the "generalized" version of the instantiated parametric
           // type tna
           Type tng = dt.getDatatypeType();
-          itc = tat->d_children.find(tng);
-          if (itc != tat->d_children.end())
-          {
-            tat = &itc->second;
-          }
-        }
-        if (tat == nullptr)
-        {
-          // no functions match
-          return d_nullExpr;
+          child = getChild(node, tng);
         }
       }
+      // as before, an argument type that matches no child is skipped
+      if (child != NONE)
+      {
+        node = child;
+      }
     }
     // we ensure that there is *only* one active symbol at this node
-    return getOverloadedFunctionAt(tat);
+    return getOverloadedFunctionAt(node);
   }
   return d_nullExpr;
 }
 
-bool OverloadedTypeTrie::bind(const string& name, Expr prev_bound_obj,
-                              Expr obj) {
+bool OverloadedTypeTrie::bind(const string& name,
+                              uint32_t symbol,
+                              Expr prev_bound_obj,
+                              Expr obj,
+                              bool levelZero)
+{
   bool retprev = true;
   if (!isOverloadedFunction(prev_bound_obj)) {
     // mark previous as overloaded
-    retprev = markOverloaded(name, prev_bound_obj);
+    retprev = markOverloaded(name, symbol, prev_bound_obj, levelZero);
   }
   // mark this as overloaded
-  bool retobj = markOverloaded(name, obj);
+  bool retobj = markOverloaded(name, symbol, obj, levelZero);
   return retprev && retobj;
 }
 
-bool OverloadedTypeTrie::markOverloaded(const string& name, Expr obj) {
+bool OverloadedTypeTrie::markOverloaded(const string& name,
+                                        uint32_t symbol,
+                                        Expr obj,
+                                        bool levelZero)
+{
   Trace("parser-overloading") << "Overloaded function : " << name;
   Trace("parser-overloading") << " with type " << obj.getType() << std::endl;
   // get the argument types
@@ -269,23 +502,48 @@ bool OverloadedTypeTrie::markOverloaded(const string& name, Expr obj) {
     rangeType = static_cast<SelectorType>(t).getRangeType();
   }
   // add to the trie
-  TypeArgTrie* tat = &d_overload_type_arg_trie[name];
+  if (symbol >= d_roots.size())
+  {
+    d_roots.resize(symbol + 1, NONE);
+  }
+  if (d_roots[symbol] == NONE)
+  {
+    d_roots[symbol] = d_symbols.size();
+    d_symbols.emplace_back();
+  }
+  uint32_t node = d_roots[symbol];
   for (unsigned i = 0; i < argTypes.size(); i++) {
-    tat = &(tat->d_children[argTypes[i]]);
+    std::pair<std::unordered_map<std::pair<uint32_t, uint64_t>,
+                                 uint32_t,
+                                 PairHashFunction<uint32_t, uint64_t>>::iterator,
+              bool>
+        it = d_children.emplace(
+            std::make_pair(node, TypeNode::fromType(argTypes[i]).getId()),
+            d_symbols.size());
+    if (it.second)
+    {
+      d_symbols.emplace_back();
+    }
+    node = it.first->second;
   }
 
+  // the symbols at this node, which are few
+  std::vector<std::pair<Type, Expr>>& symbols = d_symbols[node];
+  std::vector<std::pair<Type, Expr>>::iterator its = symbols.begin();
+  while (its != symbols.end() && its->first != rangeType)
+  {
+    ++its;
+  }
   // check if function variants are allowed here
   if (d_allowFunctionVariants || argTypes.empty())
   {
     // they are allowed, check for redefinition
-    std::map<Type, Expr>::iterator it = tat->d_symbols.find(rangeType);
-    if (it != tat->d_symbols.end())
+    if (its != symbols.end())
     {
-      Expr prev_obj = it->second;
       // if there is already an active function with the same name and expects
       // the same argument types and has the same return type, we reject the 
       // re-declaration here.
-      if (isOverloadedFunction(prev_obj))
+      if (isOverloadedFunction(its->second))
       {
         return false;
       }
@@ -294,7 +552,7 @@ bool OverloadedTypeTrie::markOverloaded(const string& name, Expr obj) {
   else
   {
     // they are not allowed, we cannot have any function defined here.
-    Expr existingFun = getOverloadedFunctionAt(tat, false);
+    Expr existingFun = getOverloadedFunctionAt(node, false);
     if (!existingFun.isNull())
     {
       return false;
@@ -302,20 +560,40 @@ bool OverloadedTypeTrie::markOverloaded(const string& name, Expr obj) {
   }
 
   // otherwise, update the symbols
-  d_overloaded_symbols->insert(obj);
-  tat->d_symbols[rangeType] = obj;
+  if (d_overloaded_symbols.insert(obj).second && !levelZero
+      && !d_scopes.empty())
+  {
+    d_activated.push_back(obj);
+  }
+  if (its != symbols.end())
+  {
+    its->second = obj;
+  }
+  else
+  {
+    symbols.emplace_back(rangeType, obj);
+  }
   return true;
 }
 
-Expr OverloadedTypeTrie::getOverloadedFunctionAt(
-    const OverloadedTypeTrie::TypeArgTrie* tat, bool reqUnique) const
+void OverloadedTypeTrie::popScope()
+{
+  Assert(!d_scopes.empty());
+  for (size_t i = d_scopes.back(), size = d_activated.size(); i < size; i++)
+  {
+    d_overloaded_symbols.erase(d_activated[i]);
+  }
+  d_activated.resize(d_scopes.back());
+  d_scopes.pop_back();
+}
+
+Expr OverloadedTypeTrie::getOverloadedFunctionAt(uint32_t node,
+                                                 bool reqUnique) const
 {
   Expr retExpr;
-  for (std::map<Type, Expr>::const_iterator its = tat->d_symbols.begin();
-       its != tat->d_symbols.end();
-       ++its)
+  for (const std::pair<Type, Expr>& s : d_symbols[node])
   {
-    Expr expr = its->second;
+    Expr expr = s.second;
     if (isOverloadedFunction(expr))
     {
       if (retExpr.isNull())
@@ -341,21 +619,13 @@ Expr OverloadedTypeTrie::getOverloadedFunctionAt(
 
 class SymbolTable::Implementation {
  public:
-  Implementation()
-      : d_context(),
-        d_exprMap(new (true) CDHashMap<string, Expr>(&d_context)),
-        d_typeMap(new (true) TypeMap(&d_context))
-  {
-    d_overload_trie = new OverloadedTypeTrie(&d_context);
-  }
+  Implementation() : d_level(0), d_nodeManager(nullptr) {}
+  ~Implementation();
 
-  ~Implementation() {
-    d_exprMap->deleteSelf();
-    d_typeMap->deleteSelf();
-    delete d_overload_trie;
-  }
-
-  bool bind(const string& name, Expr obj, bool levelZero, bool doOverload);
+  bool bind(const string& name,
+            const Expr& obj,
+            bool levelZero,
+            bool doOverload);
   void bindType(const string& name, Type t, bool levelZero = false);
   void bindType(const string& name, const vector<Type>& params, Type t,
                 bool levelZero = false);
@@ -381,55 +651,80 @@ class SymbolTable::Implementation {
                                      const std::vector<Type>& argTypes) const;
   //------------------------ end operator overloading
  private:
-  /** The context manager for the scope maps. */
-  Context d_context;
+  /** The number of scopes pushed. */
+  size_t d_level;
+
+  /** The interned names of the symbols. */
+  SymbolNames d_names;
 
-  /** A map for expressions. */
-  CDHashMap<string, Expr>* d_exprMap;
+  /**
+   * The node manager of the bound expressions, which is null until the first
+   * one is bound. All bound expressions must belong to it.
+   */
+  NodeManager* d_nodeManager;
+
+  /**
+   * A map for expressions. They are stored as nodes, whose copies only update
+   * a reference count, and converted to expressions when looked up.
+   */
+  ScopedSymbolMap<Node> d_exprMap;
 
   /** A map for types. */
-  using TypeMap = CDHashMap<string, std::pair<vector<Type>, Type>>;
-  TypeMap* d_typeMap;
+  using TypeMap = ScopedSymbolMap<std::pair<vector<Type>, Type>>;
+  TypeMap d_typeMap;
+
+  /** Get the binding of name in the type map, which must exist. */
+  const std::pair<vector<Type>, Type>& getTypeBinding(const string& name) const;
 
   //------------------------ operator overloading
   // the null expression
   Expr d_nullExpr;
   // overloaded type trie, stores all information regarding overloading
-  OverloadedTypeTrie* d_overload_trie;
+  OverloadedTypeTrie d_overload_trie;
   /** bind with overloading
    * This is called whenever obj is bound to name where overloading symbols is
    * allowed. If a symbol is previously bound to that name, it marks both as
    * overloaded. Returns false if the binding was invalid.
    */
-  bool bindWithOverloading(const string& name, Expr obj);
+  bool bindWithOverloading(const string& name,
+                           uint32_t symbol,
+                           const Expr& obj,
+                           bool levelZero);
   //------------------------ end operator overloading
 }; /* SymbolTable::Implementation */
 
-bool SymbolTable::Implementation::bind(const string& name, Expr obj,
+bool SymbolTable::Implementation::bind(const string& name, const Expr& obj,
                                        bool levelZero, bool doOverload) {
   PrettyCheckArgument(!obj.isNull(), obj, "cannot bind to a null Expr");
   ExprManagerScope ems(obj);
+  if (d_nodeManager == nullptr)
+  {
+    d_nodeManager = NodeManager::currentNM();
+  }
+  PrettyCheckArgument(d_nodeManager == NodeManager::currentNM(),
+                      obj,
+                      "cannot bind Exprs of different ExprManagers");
+  uint32_t symbol = d_names.intern(name);
   if (doOverload) {
-    if (!bindWithOverloading(name, obj)) {
+    if (!bindWithOverloading(name, symbol, obj, levelZero))
+    {
       return false;
     }
   }
-  if (levelZero) {
-    d_exprMap->insertAtContextLevelZero(name, obj);
-  } else {
-    d_exprMap->insert(name, obj);
-  }
+  d_exprMap.insert(symbol, Node::fromExpr(obj), levelZero);
   return true;
 }
 
 bool SymbolTable::Implementation::isBound(const string& name) const {
-  return d_exprMap->find(name) != d_exprMap->end();
+  return d_exprMap.find(d_names.find(name)) != nullptr;
 }
 
 Expr SymbolTable::Implementation::lookup(const string& name) const {
-  Assert(isBound(name));
-  Expr expr = (*d_exprMap->find(name)).second;
-  if (isOverloadedFunction(expr)) {
+  const Node* n = d_exprMap.find(d_names.find(name));
+  Assert(n != nullptr);
+  NodeManagerScope nms(d_nodeManager);
+  Expr expr = d_nodeManager->toExpr(*n);
+  if (d_overload_trie.isOverloadedFunction(expr)) {
     return d_nullExpr;
   } else {
     return expr;
@@ -438,11 +733,8 @@ Expr SymbolTable::Implementation::lookup(const string& name) const {
 
 void SymbolTable::Implementation::bindType(const string& name, Type t,
                                            bool levelZero) {
-  if (levelZero) {
-    d_typeMap->insertAtContextLevelZero(name, make_pair(vector<Type>(), t));
-  } else {
-    d_typeMap->insert(name, make_pair(vector<Type>(), t));
-  }
+  d_typeMap.insert(
+      d_names.intern(name), make_pair(vector<Type>(), t), levelZero);
 }
 
 void SymbolTable::Implementation::bindType(const string& name,
@@ -457,19 +749,23 @@ void SymbolTable::Implementation::bindType(const string& name,
     }
     Debug("sort") << "], " << t << ")" << endl;
   }
-  if (levelZero) {
-    d_typeMap->insertAtContextLevelZero(name, make_pair(params, t));
-  } else {
-    d_typeMap->insert(name, make_pair(params, t));
-  }
+  d_typeMap.insert(d_names.intern(name), make_pair(params, t), levelZero);
 }
 
 bool SymbolTable::Implementation::isBoundType(const string& name) const {
-  return d_typeMap->find(name) != d_typeMap->end();
+  return d_typeMap.find(d_names.find(name)) != nullptr;
+}
+
+const std::pair<vector<Type>, Type>&
+SymbolTable::Implementation::getTypeBinding(const string& name) const
+{
+  const std::pair<vector<Type>, Type>* p = d_typeMap.find(d_names.find(name));
+  Assert(p != nullptr);
+  return *p;
 }
 
 Type SymbolTable::Implementation::lookupType(const string& name) const {
-  pair<vector<Type>, Type> p = (*d_typeMap->find(name)).second;
+  const pair<vector<Type>, Type>& p = getTypeBinding(name);
   PrettyCheckArgument(p.first.size() == 0, name,
                       "type constructor arity is wrong: "
                       "`%s' requires %u parameters but was provided 0",
@@ -479,7 +775,7 @@ Type SymbolTable::Implementation::lookupType(const string& name) const {
 
 Type SymbolTable::Implementation::lookupType(const string& name,
                                              const vector<Type>& params) const {
-  pair<vector<Type>, Type> p = (*d_typeMap->find(name)).second;
+  const pair<vector<Type>, Type>& p = getTypeBinding(name);
   PrettyCheckArgument(p.first.size() == params.size(), params,
                       "type constructor arity is wrong: "
                       "`%s' requires %u parameters but was provided %u",
@@ -534,21 +830,36 @@ Type SymbolTable::Implementation::lookupType(const string& name,
 }
 
 size_t SymbolTable::Implementation::lookupArity(const string& name) {
-  pair<vector<Type>, Type> p = (*d_typeMap->find(name)).second;
+  const pair<vector<Type>, Type>& p = getTypeBinding(name);
   return p.first.size();
 }
 
 void SymbolTable::Implementation::popScope() {
-  if (d_context.getLevel() == 0) {
+  if (d_level == 0) {
     throw ScopeException();
   }
-  d_context.pop();
+  // the nodes bound in the scope may be released
+  NodeManagerScope nms(d_nodeManager);
+  d_exprMap.popScope();
+  d_typeMap.popScope();
+  d_overload_trie.popScope();
+  d_level--;
+}
+
+void SymbolTable::Implementation::pushScope() {
+  d_exprMap.pushScope();
+  d_typeMap.pushScope();
+  d_overload_trie.pushScope();
+  d_level++;
 }
 
-void SymbolTable::Implementation::pushScope() { d_context.push(); }
+size_t SymbolTable::Implementation::getLevel() const { return d_level; }
 
-size_t SymbolTable::Implementation::getLevel() const {
-  return d_context.getLevel();
+SymbolTable::Implementation::~Implementation()
+{
+  // the nodes must be released in the scope of their node manager
+  NodeManagerScope nms(d_nodeManager);
+  d_exprMap.clear();
 }
 
 void SymbolTable::Implementation::reset() {
@@ -557,27 +868,30 @@ void SymbolTable::Implementation::reset() {
 }
 
 bool SymbolTable::Implementation::isOverloadedFunction(Expr fun) const {
-  return d_overload_trie->isOverloadedFunction(fun);
+  return d_overload_trie.isOverloadedFunction(fun);
 }
 
 Expr SymbolTable::Implementation::getOverloadedConstantForType(
     const std::string& name, Type t) const {
-  return d_overload_trie->getOverloadedConstantForType(name, t);
+  return d_overload_trie.getOverloadedConstantForType(d_names.find(name), t);
 }
 
 Expr SymbolTable::Implementation::getOverloadedFunctionForTypes(
     const std::string& name, const std::vector<Type>& argTypes) const {
-  return d_overload_trie->getOverloadedFunctionForTypes(name, argTypes);
+  return d_overload_trie.getOverloadedFunctionForTypes(d_names.find(name),
+                                                       argTypes);
 }
 
 bool SymbolTable::Implementation::bindWithOverloading(const string& name,
-                                                      Expr obj) {
-  CDHashMap<string, Expr>::const_iterator it = d_exprMap->find(name);
-  if (it != d_exprMap->end()) {
-    const Expr& prev_bound_obj = (*it).second;
-    if (prev_bound_obj != obj) {
-      return d_overload_trie->bind(name, prev_bound_obj, obj);
-    }
+                                                      uint32_t symbol,
+                                                      const Expr& obj,
+                                                      bool levelZero)
+{
+  const Node* prev_bound_obj = d_exprMap.find(symbol);
+  if (prev_bound_obj != nullptr && *prev_bound_obj != Node::fromExpr(obj))
+  {
+    return d_overload_trie.bind(
+        name, symbol, d_nodeManager->toExpr(*prev_bound_obj), obj, levelZero);
   }
   return true;
 }
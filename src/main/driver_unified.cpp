@@ -159,6 +159,8 @@ int runCvc4(int argc, char* argv[], Options& opts) {
                 || (len >= 3 && !strcmp(".sl", filename + len - 3))) {
         // version 2 sygus is the default
         opts.setInputLanguage(language::input::LANG_SYGUS_V2);
+      } else if(len >= 6 && !strcmp(".cvc4b", filename + len - 6)) {
+        opts.setInputLanguage(language::input::LANG_BINARY);
       }
     }
   }
@@ -83,6 +83,7 @@ InputLanguage toInputLanguage(OutputLanguage language) {
   case output::LANG_TPTP:
   case output::LANG_CVC4:
   case output::LANG_SYGUS_V2:
+  case output::LANG_BINARY:
     // these entries directly correspond (by design)
     return InputLanguage(int(language));
 
@@ -106,6 +107,10 @@ OutputLanguage toOutputLanguage(InputLanguage language) {
     // these entries directly correspond (by design)
     return OutputLanguage(int(language));
 
+  case input::LANG_BINARY:
+    // responses to binary scripts are printed in SMT-LIB
+    return output::LANG_SMTLIB_V2_6;
+
   default:
     // Revert to the default (AST) language.
     //
@@ -155,6 +160,10 @@ OutputLanguage toOutputLanguage(std::string language) {
   {
     return output::LANG_AST;
   }
+  else if (language == "binary" || language == "LANG_BINARY")
+  {
+    return output::LANG_BINARY;
+  }
   else if (language == "auto" || language == "LANG_AUTO")
   {
     return output::LANG_AUTO;
@@ -186,6 +195,10 @@ InputLanguage toInputLanguage(std::string language) {
   {
     return input::LANG_SYGUS_V2;
   }
+  else if (language == "binary" || language == "LANG_BINARY")
+  {
+    return input::LANG_BINARY;
+  }
   else if (language == "auto" || language == "LANG_AUTO")
   {
     return input::LANG_AUTO;
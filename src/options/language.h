@@ -58,6 +58,8 @@ enum CVC4_PUBLIC Language
   LANG_CVC4,
   /** The SyGuS input language version 2.0 */
   LANG_SYGUS_V2,
+  /** The binary format of CVC4 */
+  LANG_BINARY,
 
   // START OUTPUT-ONLY LANGUAGES AT ENUM VALUE 10
   // THESE ARE IN PRINCIPLE NOT POSSIBLE INPUT LANGUAGES
@@ -88,6 +90,7 @@ inline std::ostream& operator<<(std::ostream& out, Language lang) {
     out << "LANG_CVC4";
     break;
   case LANG_SYGUS_V2: out << "LANG_SYGUS_V2"; break;
+  case LANG_BINARY: out << "LANG_BINARY"; break;
   default:
     out << "undefined_input_language";
   }
@@ -126,6 +129,8 @@ enum CVC4_PUBLIC Language
   LANG_CVC4 = input::LANG_CVC4,
   /** The sygus output language version 2.0 */
   LANG_SYGUS_V2 = input::LANG_SYGUS_V2,
+  /** The binary format of CVC4 */
+  LANG_BINARY = input::LANG_BINARY,
 
   // START OUTPUT-ONLY LANGUAGES AT ENUM VALUE 10
   // THESE ARE IN PRINCIPLE NOT POSSIBLE INPUT LANGUAGES
@@ -156,6 +161,7 @@ inline std::ostream& operator<<(std::ostream& out, Language lang) {
     out << "LANG_CVC4";
     break;
   case LANG_SYGUS_V2: out << "LANG_SYGUS_V2"; break;
+  case LANG_BINARY: out << "LANG_BINARY"; break;
   case LANG_AST:
     out << "LANG_AST";
     break;
@@ -27,6 +27,7 @@
 
 #include "lib/strtok_r.h"
 #include "options/parser_options.h"
+#include "util/ostream_util.h"
 
 namespace CVC4 {
 
@@ -54,13 +55,14 @@ std::pair< bool, std::ostream* > OstreamOpener::open(const std::string& optarg)
     throw OptionException(std::string("Filesystem access not permitted"));
   } else {
     errno = 0;
-    std::ostream* outStream;
-    outStream = new std::ofstream(optarg.c_str(),
-                                    std::ofstream::out | std::ofstream::trunc);
+    // files receive the dumps and models, which may be large, hence they are
+    // written without the overhead of a std::filebuf
+    std::ostream* outStream = new FdOstream(optarg);
     if(outStream == NULL || !*outStream) {
       std::stringstream ss;
       ss << "Cannot open " << d_channelName << " file: `"
          << optarg << "': " << cvc4_errno_failreason();
+      delete outStream;
       throw OptionException(ss.str());
     }
     return make_pair(true, outStream);
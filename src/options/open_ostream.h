@@ -42,7 +42,7 @@ class OstreamOpener {
    * If name == "std::cerr", this return <false, &cerr>.
    * If none of the previous conditions hold and !options::filesystemAccess(),
    *   this throws an OptionException.
-   * Otherwise, this attempts to open a ofstream using the filename, name.
+   * Otherwise, this attempts to open an FdOstream using the filename, name.
    *   If this fails, this throws and OptionException. If this succeeds, this
    *   returns <true, stream> where stream is a ostream allocated by new.
    *   The caller is in this case the owner of the allocated memory.
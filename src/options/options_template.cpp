@@ -419,6 +419,7 @@ Languages currently supported as arguments to the -L / --lang option:\n\
   smt2.6 | smtlib2.6             SMT-LIB format 2.6 with support for the strings standard\n\
   tptp                           TPTP format (cnf, fof and tff)\n\
   sygus | sygus2                 SyGuS version 2.0\n\
+  binary                         CVC4 binary format\n\
 \n\
 Languages currently supported as arguments to the --output-lang option:\n\
   auto                           match output language to input language\n\
@@ -430,6 +431,7 @@ Languages currently supported as arguments to the --output-lang option:\n\
   smt2.6 | smtlib2.6             SMT-LIB format 2.6 with support for the strings standard\n\
   tptp                           TPTP format\n\
   ast                            internal format (simple syntax trees)\n\
+  binary                         CVC4 binary format (responses in SMT-LIB 2.6)\n\
 ";
 
 std::string Options::getDescription() const {
@@ -223,7 +223,13 @@ AntlrInputStream::newStringInputStream(const std::string& input,
   assert(input_size <= std::numeric_limits<uint32_t>::max());
 
   // Ownership of input_duplicate  is transferred to the AntlrInputStream.
-  pANTLR3_UINT8 input_duplicate = (pANTLR3_UINT8) strdup(input.c_str());
+  // The input is copied with its size rather than with strdup(), since it may
+  // contain null characters, e.g. in the binary format.
+  pANTLR3_UINT8 input_duplicate = (pANTLR3_UINT8)malloc(input_size + 1);
+  if (input_duplicate != NULL)
+  {
+    memcpy(input_duplicate, input.c_str(), input_size + 1);
+  }
 
   if( input_duplicate == NULL ) {
     throw InputStreamException("Couldn't initialize string input: '" + input + "'");
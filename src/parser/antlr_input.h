@@ -170,6 +170,15 @@ public:
   /** Retrieve the text associated with a token. */
   static std::string tokenText(pANTLR3_COMMON_TOKEN token);
 
+  /** Retrieve the text associated with a token without copying it.
+   *
+   * @param token the token, which should not be EOF
+   * @param n set to the number of characters of the token text
+   * @return a pointer to the token text in the input buffer, which is valid
+   * as long as the input is
+   */
+  static const char* tokenBuffer(pANTLR3_COMMON_TOKEN token, size_t& n);
+
   /** Retrieve a substring of the text associated with a token.
    *
    * @param token the token
@@ -247,6 +256,16 @@ inline std::string AntlrInput::tokenText(pANTLR3_COMMON_TOKEN token) {
   return txt;
 }
 
+inline const char* AntlrInput::tokenBuffer(pANTLR3_COMMON_TOKEN token,
+                                           size_t& n)
+{
+  assert(token->type != ANTLR3_TOKEN_EOF);
+  ANTLR3_MARKER start = token->getStartIndex(token);
+  ANTLR3_MARKER end = token->getStopIndex(token);
+  n = end - start + 1;
+  return (const char*)start;
+}
+
 inline std::string AntlrInput::tokenTextSubstr(pANTLR3_COMMON_TOKEN token,
                                                size_t index,
                                                size_t n) {
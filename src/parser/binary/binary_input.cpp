@@ -0,0 +1,85 @@
+/*********************                                                        */
+/*! \file binary_input.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The input for the binary format
+ **
+ ** The input for the binary format of terms and commands.
+ **/
+
+#include "parser/binary/binary_input.h"
+
+#include "base/exception.h"
+#include "base/output.h"
+#include "parser/parser.h"
+#include "parser/parser_exception.h"
+#include "smt/command.h"
+
+namespace CVC4 {
+namespace parser {
+
+BinaryInput::BinaryInput(AntlrInputStream& inputStream)
+    : Input(inputStream), d_solver(nullptr)
+{
+  pANTLR3_INPUT_STREAM input = inputStream.getAntlr3InputStream();
+  assert(input != NULL);
+  d_data = static_cast<const char*>(input->data);
+  d_size = input->sizeBuf;
+}
+
+BinaryInput::~BinaryInput() {}
+
+void BinaryInput::setParser(Parser& parser)
+{
+  d_solver = parser.getSolver();
+  d_reader.reset(new printer::binary::BinaryReader(
+      d_solver->getExprManager(), d_data, d_size));
+}
+
+void BinaryInput::warning(const std::string& msg)
+{
+  Warning() << getInputStream()->getName() << ": " << msg << std::endl;
+}
+
+void BinaryInput::parseError(const std::string& msg, bool eofException)
+{
+  if (eofException)
+  {
+    throw ParserEndOfFileException(msg, getInputStream()->getName(), 0, 0);
+  }
+  throw ParserException(msg, getInputStream()->getName(), 0, 0);
+}
+
+Command* BinaryInput::parseCommand()
+{
+  try
+  {
+    return d_reader->readCommand();
+  }
+  catch (Exception& e)
+  {
+    parseError(e.getMessage());
+  }
+  return nullptr;
+}
+
+api::Term BinaryInput::parseExpr()
+{
+  try
+  {
+    return api::Term(d_solver, d_reader->readTerm());
+  }
+  catch (Exception& e)
+  {
+    parseError(e.getMessage());
+  }
+  return api::Term();
+}
+
+}  // namespace parser
+}  // namespace CVC4
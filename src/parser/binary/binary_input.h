@@ -0,0 +1,91 @@
+/*********************                                                        */
+/*! \file binary_input.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The input for the binary format
+ **
+ ** The input for the binary format of terms and commands.
+ **/
+
+#include "cvc4parser_private.h"
+
+#ifndef CVC4__PARSER__BINARY__BINARY_INPUT_H
+#define CVC4__PARSER__BINARY__BINARY_INPUT_H
+
+#include <memory>
+#include <string>
+
+#include "api/cvc4cpp.h"
+#include "parser/antlr_input.h"
+#include "parser/input.h"
+#include "printer/binary/binary_reader.h"
+
+namespace CVC4 {
+
+class Command;
+
+namespace parser {
+
+/**
+ * An input in the binary format, which is written by the printer for the
+ * binary output language. The buffer of the input stream is read in place by
+ * a printer::binary::BinaryReader, hence files should be memory-mapped.
+ */
+class BinaryInput : public Input
+{
+ public:
+  /**
+   * Create an input. The input stream must not be line-buffered, since this
+   * input reads the entire buffer of the stream.
+   *
+   * @param inputStream the input stream to use
+   */
+  BinaryInput(AntlrInputStream& inputStream);
+  ~BinaryInput();
+
+ protected:
+  /**
+   * Read a command from the input. Returns <code>NULL</code> if there is no
+   * command there to read.
+   *
+   * @throws ParserException if the input is malformed.
+   */
+  Command* parseCommand() override;
+
+  /**
+   * Read an expression from the input. Returns a null term if there is no
+   * expression there to read.
+   *
+   * @throws ParserException if the input is malformed.
+   */
+  api::Term parseExpr() override;
+
+  /** Issue a warning, with the name of the input. */
+  void warning(const std::string& msg) override;
+
+  /** Throws a ParserException with the given message. */
+  void parseError(const std::string& msg, bool eofException = false) override;
+
+  /** Set the Parser object for this input. */
+  void setParser(Parser& parser) override;
+
+ private:
+  /** The buffer of the input stream */
+  const char* d_data;
+  /** The size of the buffer */
+  size_t d_size;
+  /** The solver of the parser */
+  api::Solver* d_solver;
+  /** The reader of the buffer, which is created by setParser */
+  std::unique_ptr<printer::binary::BinaryReader> d_reader;
+}; /* class BinaryInput */
+
+}  // namespace parser
+}  // namespace CVC4
+
+#endif /* CVC4__PARSER__BINARY__BINARY_INPUT_H */
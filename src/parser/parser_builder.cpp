@@ -22,6 +22,7 @@
 #include <string>
 
 #include "api/cvc4cpp.h"
+#include "binary/binary_input.h"
 #include "cvc/cvc.h"
 #include "expr/expr_manager.h"
 #include "options/options.h"
@@ -67,21 +68,49 @@ void ParserBuilder::init(api::Solver* solver, const std::string& filename)
 Parser* ParserBuilder::build()
 {
   Input* input = NULL;
-  switch( d_inputType ) {
-  case FILE_INPUT:
-    input = Input::newFileInput(d_lang, d_filename, d_mmap);
-    break;
-  case LINE_BUFFERED_STREAM_INPUT:
-    assert( d_streamInput != NULL );
-    input = Input::newStreamInput(d_lang, *d_streamInput, d_filename, true);
-    break;
-  case STREAM_INPUT:
-    assert( d_streamInput != NULL );
-    input = Input::newStreamInput(d_lang, *d_streamInput, d_filename);
-    break;
-  case STRING_INPUT:
-    input = Input::newStringInput(d_lang, d_stringInput, d_filename);
-    break;
+  bool binary = d_lang == language::input::LANG_BINARY;
+  if (binary)
+  {
+    AntlrInputStream* inputStream = NULL;
+    switch (d_inputType)
+    {
+      case FILE_INPUT:
+        // binary files are always read in place
+        inputStream = AntlrInputStream::newFileInputStream(d_filename, true);
+        break;
+      case LINE_BUFFERED_STREAM_INPUT:
+      case STREAM_INPUT:
+        assert(d_streamInput != NULL);
+        inputStream =
+            AntlrInputStream::newStreamInputStream(*d_streamInput, d_filename);
+        break;
+      default:
+        assert(d_inputType == STRING_INPUT);
+        inputStream =
+            AntlrInputStream::newStringInputStream(d_stringInput, d_filename);
+        break;
+    }
+    input = new BinaryInput(*inputStream);
+  }
+  else
+  {
+    switch (d_inputType)
+    {
+      case FILE_INPUT:
+        input = Input::newFileInput(d_lang, d_filename, d_mmap);
+        break;
+      case LINE_BUFFERED_STREAM_INPUT:
+        assert(d_streamInput != NULL);
+        input = Input::newStreamInput(d_lang, *d_streamInput, d_filename, true);
+        break;
+      case STREAM_INPUT:
+        assert(d_streamInput != NULL);
+        input = Input::newStreamInput(d_lang, *d_streamInput, d_filename);
+        break;
+      case STRING_INPUT:
+        input = Input::newStringInput(d_lang, d_stringInput, d_filename);
+        break;
+    }
   }
 
   assert(input != NULL);
@@ -95,6 +124,10 @@ Parser* ParserBuilder::build()
     case language::input::LANG_TPTP:
       parser = new Tptp(d_solver, input, d_strictMode, d_parseOnly);
       break;
+    case language::input::LANG_BINARY:
+      // the binary format has no symbols, hence it needs no parser state
+      parser = new Parser(d_solver, input, d_strictMode, d_parseOnly);
+      break;
     default:
       if (language::isInputLang_smt2(d_lang))
       {
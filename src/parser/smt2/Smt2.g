@@ -1828,7 +1828,13 @@ termAtomic[CVC4::api::Term& atomTerm]
       atomTerm = SOLVER->mkBitVector(binStr, 2);
     }
 
-  // String constant
+  // String constant, decoded in place for SMT-LIB 2.6
+  | { PARSER_STATE->v2_6() }?=> STRING_LITERAL
+    {
+      size_t n;
+      const char* txt = AntlrInput::tokenBuffer($STRING_LITERAL, n);
+      atomTerm = PARSER_STATE->mkStringLiteral(txt, n);
+    }
   | str[s,false] { atomTerm = PARSER_STATE->mkStringConstant(s); }
 
   // NOTE: Theory constants go here
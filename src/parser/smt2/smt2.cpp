@@ -16,6 +16,8 @@
 #include "parser/smt2/smt2.h"
 
 #include <algorithm>
+#include <cctype>
+#include <cstring>
 
 #include "base/check.h"
 #include "expr/type.h"
@@ -25,6 +27,7 @@
 #include "parser/smt2/smt2_input.h"
 #include "printer/sygus_print_callback.h"
 #include "util/bitvector.h"
+#include "util/string.h"
 
 // ANTLR defines these, which is really bad!
 #undef true
@@ -883,6 +886,55 @@ api::Term Smt2::mkAbstractValue(const std::string& name)
   return d_solver->mkAbstractValue(name.substr(1));
 }
 
+api::Term Smt2::mkStringLiteral(const char* s, size_t n)
+{
+  assert(v2_6() && n >= 2 && s[0] == '"' && s[n - 1] == '"');
+  // strip off the quotes
+  const char* end = s + n - 1;
+  ++s;
+  for (const char* p = s; p < end; ++p)
+  {
+    // same check as in the str rule of Smt2.g
+    unsigned char c = static_cast<unsigned char>(*p);
+    if (c > 127 && !isprint(c))
+    {
+      parseError(
+          "Extended/unprintable characters are not "
+          "part of SMT-LIB, and they must be encoded "
+          "as escape sequences");
+    }
+  }
+  std::vector<unsigned> str;
+  str.reserve(end - s);
+  try
+  {
+    // the lexer ensures that double quotes in the literal come in pairs, each
+    // of which denotes a single double quote
+    while (s < end)
+    {
+      const char* q = static_cast<const char*>(memchr(s, '"', end - s));
+      if (q == nullptr)
+      {
+        q = end;
+      }
+      String::appendInternal(s, q - s, true, str);
+      if (q == end)
+      {
+        break;
+      }
+      assert(q + 1 < end && q[1] == '"');
+      str.push_back(static_cast<unsigned>('"'));
+      s = q + 2;
+    }
+  }
+  catch (const CVC4::Exception& e)
+  {
+    parseError(e.getMessage());
+  }
+  ExprManager* em = d_solver->getExprManager();
+  return api::Term(d_solver, em->mkConst(String(std::move(str))));
+}
+
 
 void Smt2::addSygusConstructorTerm(
     api::DatatypeDecl& dt,
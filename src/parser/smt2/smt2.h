@@ -345,6 +345,14 @@ class Smt2 : public Parser
    */
   api::Term mkAbstractValue(const std::string& name);
 
+  /**
+   * Make the string constant for the SMT-LIB 2.6 string literal given by the
+   * n characters starting at s, including the enclosing double quotes. This
+   * decodes the escape sequences "" and \\u{...} directly from the input
+   * buffer, which avoids copying long literals several times.
+   */
+  api::Term mkStringLiteral(const char* s, size_t n);
+
   /**
    * Adds a constructor to sygus datatype dt whose sygus operator is term.
    *
@@ -0,0 +1,341 @@
+/*********************                                                        */
+/*! \file strings_len_abs.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of the strings length abstraction preprocessing pass
+ **/
+
+#include "preprocessing/passes/strings_len_abs.h"
+
+#include "options/strings_options.h"
+#include "theory/rewriter.h"
+#include "theory/smt_engine_subsolver.h"
+#include "theory/strings/regexp_entail.h"
+#include "theory/strings/theory_strings.h"
+#include "theory/strings/word.h"
+#include "theory/theory_engine.h"
+
+using namespace CVC4::kind;
+using namespace CVC4::theory;
+
+namespace CVC4 {
+namespace preprocessing {
+namespace passes {
+
+const unsigned StringsLenAbs::s_maxBoundChecks = 8;
+
+StringsLenAbs::StringsLenAbs(PreprocessingPassContext* preprocContext)
+    : PreprocessingPass(preprocContext, "strings-len-abs"),
+      d_hasStrings(false)
+{
+}
+
+Node StringsLenAbs::mkFresh(const char* prefix, TypeNode tn)
+{
+  return NodeManager::currentNM()->mkSkolem(
+      prefix, tn, "created by the strings length abstraction");
+}
+
+Node StringsLenAbs::abstractFormula(TNode n)
+{
+  NodeNodeMap::iterator it = d_fcache.find(n);
+  if (it != d_fcache.end())
+  {
+    return it->second;
+  }
+  NodeManager* nm = NodeManager::currentNM();
+  Kind k = n.getKind();
+  Node ret;
+  if (n.isConst())
+  {
+    ret = n;
+  }
+  else if (k == NOT || k == AND || k == OR || k == IMPLIES || k == XOR
+           || (k == ITE && n.getType().isBoolean())
+           || (k == EQUAL && n[0].getType().isBoolean()))
+  {
+    std::vector<Node> children;
+    for (const Node& nc : n)
+    {
+      children.push_back(abstractFormula(nc));
+    }
+    ret = nm->mkNode(k, children);
+  }
+  else if ((k == EQUAL && n[0].getType().isReal()) || k == LT || k == LEQ
+           || k == GT || k == GEQ)
+  {
+    ret = nm->mkNode(k, abstractTerm(n[0]), abstractTerm(n[1]));
+  }
+  else
+  {
+    ret = mkFresh("lab", n.getType());
+    // side constraints on the lengths of the arguments of string atoms
+    Node lc;
+    if (k == EQUAL && n[0].getType().isStringLike())
+    {
+      lc = abstractLength(n[0]).eqNode(abstractLength(n[1]));
+    }
+    else if (k == STRING_IN_REGEXP)
+    {
+      Node fl = theory::strings::RegExpEntail::getFixedLengthForRegexp(n[1]);
+      lc = fl.isNull() ? nm->mkConst(true) : abstractLength(n[0]).eqNode(fl);
+    }
+    else if (k == STRING_PREFIX || k == STRING_SUFFIX)
+    {
+      lc = nm->mkNode(LEQ, abstractLength(n[0]), abstractLength(n[1]));
+    }
+    else if (k == STRING_STRCTN)
+    {
+      lc = nm->mkNode(LEQ, abstractLength(n[1]), abstractLength(n[0]));
+    }
+    if (!lc.isNull())
+    {
+      d_hasStrings = true;
+      d_side.push_back(ret.impNode(lc));
+    }
+  }
+  d_fcache[n] = ret;
+  return ret;
+}
+
+Node StringsLenAbs::abstractTerm(TNode n)
+{
+  NodeNodeMap::iterator it = d_tcache.find(n);
+  if (it != d_tcache.end())
+  {
+    return it->second;
+  }
+  NodeManager* nm = NodeManager::currentNM();
+  Kind k = n.getKind();
+  Node ret;
+  size_t nconst = 0;
+  if (k == MULT)
+  {
+    for (const Node& nc : n)
+    {
+      nconst += nc.isConst() ? 1 : 0;
+    }
+  }
+  if (n.isConst() || n.isVar())
+  {
+    ret = n;
+  }
+  else if (k == STRING_LENGTH)
+  {
+    ret = abstractLength(n[0]);
+  }
+  else if (k == PLUS || k == MINUS || k == UMINUS
+           || (k == MULT && nconst + 1 >= n.getNumChildren()))
+  {
+    std::vector<Node> children;
+    for (const Node& nc : n)
+    {
+      children.push_back(abstractTerm(nc));
+    }
+    ret = nm->mkNode(k, children);
+  }
+  else if (k == ITE)
+  {
+    ret = nm->mkNode(ITE,
+                     abstractFormula(n[0]),
+                     abstractTerm(n[1]),
+                     abstractTerm(n[2]));
+  }
+  else
+  {
+    ret = mkFresh("lat", n.getType());
+    Node negOne = nm->mkConst(Rational(-1));
+    if (k == STRING_STRIDOF)
+    {
+      // -1 <= indexof(s, t, i) <= len(s)
+      d_hasStrings = true;
+      d_side.push_back(nm->mkNode(LEQ, negOne, ret));
+      d_side.push_back(nm->mkNode(LEQ, ret, abstractLength(n[0])));
+    }
+    else if (k == STRING_STOI || k == STRING_TO_CODE)
+    {
+      d_side.push_back(nm->mkNode(LEQ, negOne, ret));
+    }
+  }
+  d_tcache[n] = ret;
+  return ret;
+}
+
+Node StringsLenAbs::abstractLength(TNode s)
+{
+  NodeNodeMap::iterator it = d_lcache.find(s);
+  if (it != d_lcache.end())
+  {
+    return it->second;
+  }
+  d_hasStrings = true;
+  NodeManager* nm = NodeManager::currentNM();
+  Kind k = s.getKind();
+  Node ret;
+  if (s.isConst())
+  {
+    ret = nm->mkConst(Rational(theory::strings::Word::getLength(s)));
+  }
+  else if (k == STRING_CONCAT)
+  {
+    std::vector<Node> children;
+    for (const Node& sc : s)
+    {
+      children.push_back(abstractLength(sc));
+    }
+    ret = nm->mkNode(PLUS, children);
+  }
+  else
+  {
+    // the rewriter may express the length of s in terms of smaller terms,
+    // e.g. len(str.from_code(n)) or len(str.replace(s, "a", "b"))
+    Node len = nm->mkNode(STRING_LENGTH, s);
+    Node lenr = Rewriter::rewrite(len);
+    if (lenr != len)
+    {
+      ret = abstractTerm(lenr);
+    }
+    else
+    {
+      ret = mkFresh("lal", nm->integerType());
+      d_side.push_back(nm->mkNode(GEQ, ret, nm->mkConst(Rational(0))));
+      // The decision strategy of --strings-fmf does not minimize the
+      // lengths of the skolems of the theory of strings, hence the lower
+      // bound is only computed for the lengths of user variables.
+      if (k == VARIABLE)
+      {
+        d_varLengths.push_back(ret);
+      }
+      else if (k == STRING_SUBSTR)
+      {
+        d_side.push_back(nm->mkNode(LEQ, ret, abstractLength(s[0])));
+      }
+    }
+  }
+  d_lcache[s] = ret;
+  return ret;
+}
+
+Result StringsLenAbs::check(Node q,
+                            const std::vector<Node>& vars,
+                            std::vector<Node>& vals)
+{
+  unsigned long timeout = options::stringLenAbsTimeout();
+  if (timeout > 0)
+  {
+    // the calls of one application of this pass share the time limit
+    uint64_t elapsed = d_timer.elapsed();
+    if (elapsed >= timeout)
+    {
+      Trace("strings-len-abs") << "...out of time" << std::endl;
+      return Result(Result::SAT_UNKNOWN, Result::TIMEOUT);
+    }
+    timeout -= elapsed;
+  }
+  Result r = checkWithSubsolver(q, vars, vals, timeout > 0, timeout);
+  Trace("strings-len-abs") << "...subsolver returned " << r << std::endl;
+  return r.asSatisfiabilityResult();
+}
+
+Rational StringsLenAbs::computeLowerBound(Node abs, Node sum, Rational hi)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  // all values of sum less than lo are infeasible
+  Rational lo(0);
+  std::vector<Node> vars;
+  for (unsigned i = 0; i < s_maxBoundChecks && lo < hi; i++)
+  {
+    Rational mid(((lo + hi) / Rational(2)).floor());
+    Node q = nm->mkNode(AND, abs, nm->mkNode(LEQ, sum, nm->mkConst(mid)));
+    std::vector<Node> vals;
+    Result r = check(q, vars, vals);
+    if (r.isSat() == Result::UNSAT)
+    {
+      lo = mid + Rational(1);
+    }
+    else if (r.isSat() == Result::SAT)
+    {
+      hi = mid;
+    }
+    else
+    {
+      break;
+    }
+  }
+  return lo;
+}
+
+PreprocessingPassResult StringsLenAbs::applyInternal(
+    AssertionPipeline* assertionsToPreprocess)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  d_timer.set(options::stringLenAbsTimeout());
+  d_fcache.clear();
+  d_tcache.clear();
+  d_lcache.clear();
+  d_side.clear();
+  d_varLengths.clear();
+  d_hasStrings = false;
+  std::vector<Node> conj;
+  for (const Node& a : assertionsToPreprocess->ref())
+  {
+    conj.push_back(abstractFormula(a));
+  }
+  if (!d_hasStrings)
+  {
+    return PreprocessingPassResult::NO_CONFLICT;
+  }
+  conj.insert(conj.end(), d_side.begin(), d_side.end());
+  Node abs = conj.size() == 1 ? conj[0] : nm->mkNode(AND, conj);
+  Trace("strings-len-abs") << "Length abstraction: " << abs << std::endl;
+  std::vector<Node> vals;
+  Result r = check(abs, d_varLengths, vals);
+  if (r.isSat() == Result::UNSAT)
+  {
+    Trace("strings-len-abs") << "...conflict" << std::endl;
+    Node falseNode = nm->mkConst(false);
+    Node trueNode = nm->mkConst(true);
+    for (size_t i = 0, size = assertionsToPreprocess->size(); i < size; ++i)
+    {
+      assertionsToPreprocess->replace(i, i == 0 ? falseNode : trueNode);
+    }
+    return PreprocessingPassResult::CONFLICT;
+  }
+  if (r.isSat() != Result::SAT || !options::stringFMF() || d_varLengths.empty()
+      || vals.size() != d_varLengths.size())
+  {
+    return PreprocessingPassResult::NO_CONFLICT;
+  }
+  // the sum of the lengths in the model is an upper bound for the minimum
+  Rational hi(0);
+  for (const Node& v : vals)
+  {
+    if (!v.isConst())
+    {
+      return PreprocessingPassResult::NO_CONFLICT;
+    }
+    hi += v.getConst<Rational>();
+  }
+  Node sum = d_varLengths.size() == 1 ? d_varLengths[0]
+                                      : nm->mkNode(PLUS, d_varLengths);
+  Rational lb = computeLowerBound(abs, sum, hi);
+  Trace("strings-len-abs") << "...lower bound " << lb << std::endl;
+  if (lb.sgn() > 0)
+  {
+    TheoryEngine* te = d_preprocContext->getTheoryEngine();
+    theory::strings::TheoryStrings* ts =
+        static_cast<theory::strings::TheoryStrings*>(
+            te->theoryOf(THEORY_STRINGS));
+    ts->notifyLengthLowerBound(lb);
+  }
+  return PreprocessingPassResult::NO_CONFLICT;
+}
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace CVC4
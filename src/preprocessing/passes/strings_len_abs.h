@@ -0,0 +1,102 @@
+/*********************                                                        */
+/*! \file strings_len_abs.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The strings length abstraction preprocessing pass
+ **
+ ** Checks the length abstraction of the string constraints in the assertions
+ ** with an arithmetic subsolver, before the theory of strings starts. If the
+ ** abstraction is unsatisfiable, so are the assertions. Otherwise, a lower
+ ** bound on the sum of the lengths of the string variables is computed and
+ ** given to the theory of strings, where it seeds the decision strategy of
+ ** --strings-fmf.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__PREPROCESSING__PASSES__STRINGS_LEN_ABS_H
+#define CVC4__PREPROCESSING__PASSES__STRINGS_LEN_ABS_H
+
+#include <unordered_map>
+#include <vector>
+
+#include "expr/node.h"
+#include "preprocessing/preprocessing_pass.h"
+#include "preprocessing/preprocessing_pass_context.h"
+#include "util/rational.h"
+#include "util/resource_manager.h"
+
+namespace CVC4 {
+namespace preprocessing {
+namespace passes {
+
+/**
+ * The length abstraction of a formula F is a formula over integers and
+ * Booleans that is implied by F (modulo fresh variables), where:
+ * - Boolean connectives and arithmetic atoms are kept, where len(s) is
+ *   replaced by the length of s, which is a sum of integer variables and
+ *   constants (one variable for each string term that is not a constant or
+ *   concatenation),
+ * - string atoms are replaced by fresh Boolean variables b, with side
+ *   constraints b => C, where C is a necessary condition on the lengths of
+ *   the arguments of the atom, e.g. len(s) = len(t) for s = t,
+ * - all other atoms and terms are replaced by fresh variables.
+ */
+class StringsLenAbs : public PreprocessingPass
+{
+  typedef std::unordered_map<Node, Node, NodeHashFunction> NodeNodeMap;
+
+ public:
+  StringsLenAbs(PreprocessingPassContext* preprocContext);
+
+ protected:
+  PreprocessingPassResult applyInternal(
+      AssertionPipeline* assertionsToPreprocess) override;
+
+ private:
+  /** The maximal number of subsolver calls for computing the lower bound */
+  static const unsigned s_maxBoundChecks;
+  /** Get the abstraction of formula n */
+  Node abstractFormula(TNode n);
+  /** Get the abstraction of arithmetic term n */
+  Node abstractTerm(TNode n);
+  /** Get the abstraction of the length of string term s */
+  Node abstractLength(TNode s);
+  /** Make a fresh variable of type tn */
+  Node mkFresh(const char* prefix, TypeNode tn);
+  /**
+   * Check the satisfiability of q with the subsolver, where vars and vals
+   * are as in theory::checkWithSubsolver. All calls of one application of
+   * this pass share the time limit given by --strings-len-abs-timeout, and
+   * return unknown once it is spent.
+   */
+  Result check(Node q, const std::vector<Node>& vars, std::vector<Node>& vals);
+  /**
+   * Compute a lower bound for sum in the models of abs, by bisection between
+   * 0 and the value of sum in a model of abs.
+   */
+  Rational computeLowerBound(Node abs, Node sum, Rational hi);
+  /** Caches for the methods above */
+  NodeNodeMap d_fcache;
+  NodeNodeMap d_tcache;
+  NodeNodeMap d_lcache;
+  /** The side constraints of the abstraction */
+  std::vector<Node> d_side;
+  /** The lengths of the string variables declared by the user */
+  std::vector<Node> d_varLengths;
+  /** Whether the abstraction contains string atoms or terms */
+  bool d_hasStrings;
+  /** The timer for the time limit of the subsolver calls */
+  Timer d_timer;
+};
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace CVC4
+
+#endif /* CVC4__PREPROCESSING__PASSES__STRINGS_LEN_ABS_H */
@@ -0,0 +1,152 @@
+/*********************                                                        */
+/*! \file binary_format.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Definitions of the binary format for terms and commands
+ **
+ ** A file in the binary format starts with a header consisting of the magic
+ ** string "CVC4BIN", the version of the format and the number of kinds of the
+ ** build that wrote it, since kinds are written by their ids. The header is
+ ** followed by a sequence of records, each of which starts with a tag.
+ **
+ ** Types and terms are hash-consed: each of them is written once, as a
+ ** record that defines it in terms of the types and terms before it, and is
+ ** referred to by its index in the table of types or terms afterwards. An
+ ** index i is written as the distance n - i of i to the number n of entries
+ ** of its table, which keeps references to recent entries short. Hence a
+ ** reader rebuilds all terms in one pass over the records.
+ **
+ ** Numbers are written as unsigned LEB128 varints, and strings as their
+ ** length followed by their bytes. Newline characters between records are
+ ** ignored, since streams of commands are often separated by newlines.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__PRINTER__BINARY__BINARY_FORMAT_H
+#define CVC4__PRINTER__BINARY__BINARY_FORMAT_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace CVC4 {
+namespace printer {
+namespace binary {
+
+/** The magic string at the start of a file, including its terminator */
+const char MAGIC[] = "CVC4BIN";
+/** The size of the magic string, including its terminator */
+const size_t MAGIC_SIZE = sizeof(MAGIC);
+/** The version of the format */
+const uint64_t FORMAT_VERSION = 1;
+/**
+ * The maximal nesting depth of s-expressions and of command sequences that
+ * are read, which bounds the recursion of the reader
+ */
+const unsigned MAX_NESTING_DEPTH = 1024;
+
+/** The tags of records */
+enum RecordTag : uint8_t
+{
+  //-------------------------------------- types
+  /** A constant type: kind, payload */
+  TAG_TYPE_CONSTANT = 1,
+  /** An uninterpreted sort: name, arity */
+  TAG_TYPE_SORT = 2,
+  /** An instance of a sort constructor: constructor, #args, args */
+  TAG_TYPE_SORT_INSTANCE = 3,
+  /** Any other type: kind, #children, children */
+  TAG_TYPE_NODE = 4,
+  //-------------------------------------- terms
+  /** A variable: kind, name, type */
+  TAG_TERM_VARIABLE = 5,
+  /** A constant: kind, payload */
+  TAG_TERM_CONSTANT = 6,
+  /** A nullary operator: kind, type */
+  TAG_TERM_NULLARY = 7,
+  /** Any other term: kind, [operator,] #children, children */
+  TAG_TERM_NODE = 8,
+  /** A term that was printed on its own: term */
+  TAG_TERM = 9,
+  // 10 is the newline character, which separates records
+  //-------------------------------------- commands
+  TAG_CMD_ASSERT = 16,
+  TAG_CMD_CHECK_SAT,
+  TAG_CMD_CHECK_SAT_ASSUMING,
+  TAG_CMD_QUERY,
+  TAG_CMD_PUSH,
+  TAG_CMD_POP,
+  TAG_CMD_RESET,
+  TAG_CMD_RESET_ASSERTIONS,
+  TAG_CMD_QUIT,
+  TAG_CMD_DECLARE_FUN,
+  TAG_CMD_DECLARE_SORT,
+  TAG_CMD_DEFINE_SORT,
+  TAG_CMD_DEFINE_FUN,
+  TAG_CMD_DEFINE_NAMED_FUN,
+  TAG_CMD_SET_EXPRESSION_NAME,
+  TAG_CMD_SIMPLIFY,
+  TAG_CMD_GET_VALUE,
+  TAG_CMD_GET_ASSIGNMENT,
+  TAG_CMD_GET_MODEL,
+  TAG_CMD_GET_PROOF,
+  TAG_CMD_GET_UNSAT_ASSUMPTIONS,
+  TAG_CMD_GET_UNSAT_CORE,
+  TAG_CMD_GET_ASSERTIONS,
+  TAG_CMD_SET_BENCHMARK_STATUS,
+  TAG_CMD_SET_BENCHMARK_LOGIC,
+  TAG_CMD_SET_INFO,
+  TAG_CMD_GET_INFO,
+  TAG_CMD_SET_OPTION,
+  TAG_CMD_GET_OPTION,
+  TAG_CMD_ECHO,
+  TAG_CMD_COMMENT,
+  TAG_CMD_EMPTY,
+  /** A command sequence: #commands, followed by the commands */
+  TAG_CMD_SEQUENCE,
+  /** A declaration sequence, like a command sequence */
+  TAG_CMD_DECLARATION_SEQUENCE
+}; /* enum RecordTag */
+
+/** The tags of s-expressions in set-info and set-option commands */
+enum SExprTag : uint8_t
+{
+  SEXPR_STRING = 0,
+  SEXPR_KEYWORD,
+  SEXPR_INTEGER,
+  SEXPR_RATIONAL,
+  SEXPR_LIST
+}; /* enum SExprTag */
+
+/** Write n as a varint */
+inline void writeVarint(std::ostream& out, uint64_t n)
+{
+  char buf[10];
+  size_t i = 0;
+  while (n >= 0x80)
+  {
+    buf[i++] = static_cast<char>((n & 0x7f) | 0x80);
+    n >>= 7;
+  }
+  buf[i++] = static_cast<char>(n);
+  out.write(buf, i);
+}
+
+/** Write s as its length followed by its bytes */
+inline void writeString(std::ostream& out, const std::string& s)
+{
+  writeVarint(out, s.size());
+  out.write(s.data(), s.size());
+}
+
+}  // namespace binary
+}  // namespace printer
+}  // namespace CVC4
+
+#endif /* CVC4__PRINTER__BINARY__BINARY_FORMAT_H */
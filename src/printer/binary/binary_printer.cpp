@@ -0,0 +1,956 @@
+/*********************                                                        */
+/*! \file binary_printer.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The printer for the binary output language
+ **
+ ** The printer for the binary output language.
+ **/
+
+#include "printer/binary/binary_printer.h"
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "base/exception.h"
+#include "expr/array_store_all.h"
+#include "expr/emptyset.h"
+#include "expr/expr_manager_scope.h"
+#include "expr/node_manager.h"
+#include "expr/node_manager_attributes.h"
+#include "expr/expr_sequence.h"
+#include "expr/sequence.h"
+#include "expr/uninterpreted_constant.h"
+#include "printer/binary/binary_format.h"
+#include "smt/command.h"
+#include "util/bitvector.h"
+#include "util/divisible.h"
+#include "util/floatingpoint.h"
+#include "util/regexp.h"
+#include "util/string.h"
+
+using namespace std;
+
+namespace CVC4 {
+namespace printer {
+namespace binary {
+
+namespace {
+
+/**
+ * The types and terms written to a stream so far. They are identified by
+ * their ids, which are never reused by a node manager.
+ */
+struct WriterState
+{
+  WriterState() : d_nm(nullptr), d_numTypes(0), d_numTerms(0) {}
+
+  /** The node manager of the types and terms, if any were written */
+  NodeManager* d_nm;
+  /** Maps the ids of the types written so far to their indices */
+  unordered_map<uint64_t, uint64_t> d_types;
+  /** Maps the ids of the sort tags written so far to their indices */
+  unordered_map<uint64_t, uint64_t> d_sortTags;
+  /** Maps the ids of the terms written so far to their indices */
+  unordered_map<uint64_t, uint64_t> d_terms;
+  /** The number of entries of the table of types */
+  uint64_t d_numTypes;
+  /** The number of entries of the table of terms */
+  uint64_t d_numTerms;
+}; /* struct WriterState */
+
+/** The index of the writer state in the extensible arrays of streams */
+const int s_stateIndex = ios_base::xalloc();
+
+void stateCallback(ios_base::event ev, ios_base& ios, int index)
+{
+  void*& p = ios.pword(index);
+  if (ev == ios_base::erase_event)
+  {
+    delete static_cast<WriterState*>(p);
+    p = nullptr;
+  }
+  else if (ev == ios_base::copyfmt_event)
+  {
+    // the copy did not see the records written to the original stream
+    p = nullptr;
+  }
+}
+
+/**
+ * Writes types, terms and commands to a stream. The types and terms they
+ * depend on are written first, unless they were already written to the
+ * stream.
+ */
+class Writer
+{
+ public:
+  Writer(ostream& out) : d_out(out), d_state(getState(out)) {}
+
+  /** Write the definitions of e and its subterms, return the index of e */
+  uint64_t define(const Expr& e)
+  {
+    ExprManagerScope ems(e);
+    checkNodeManager();
+    return define(TNode(Node::fromExpr(e)));
+  }
+  /** Write the definitions of t and its subtypes, return the index of t */
+  uint64_t define(const Type& t)
+  {
+    ExprManagerScope ems(t);
+    checkNodeManager();
+    return define(TypeNode::fromType(t));
+  }
+  /**
+   * Write the definitions of n and its subterms, return the index of n. The
+   * node manager of n must be the current one.
+   */
+  uint64_t define(TNode n);
+  /** Like above, for types */
+  uint64_t define(TypeNode tn);
+  /**
+   * Check that the current node manager is the one of the types and terms
+   * written to the stream before.
+   */
+  void checkNodeManager();
+
+  void tag(uint8_t t) { d_out.put(static_cast<char>(t)); }
+  void varint(uint64_t n) { writeVarint(d_out, n); }
+  void string(const std::string& s) { writeString(d_out, s); }
+  void sexpr(const SExpr& e);
+  /** Write a reference to the term with index i */
+  void termRef(uint64_t i) { varint(d_state->d_numTerms - i); }
+  /** Write a reference to the type with index i */
+  void typeRef(uint64_t i) { varint(d_state->d_numTypes - i); }
+
+ private:
+  /** Get the state of out, writing the header if it is new */
+  static WriterState* getState(ostream& out);
+  /** Write the record of n, whose children were written already */
+  void writeTerm(TNode n);
+  /** Write the payload of the constant n */
+  void writeConstant(TNode n);
+  /** Write the sort constructor with tag tag, return its index */
+  uint64_t defineSortConstructor(TNode tag,
+                                 const std::string& name,
+                                 uint64_t arity);
+
+  template <class T>
+  void writeConvertSort(TNode n)
+  {
+    const FloatingPointSize& t = n.getConst<T>().t;
+    varint(t.exponent());
+    varint(t.significand());
+  }
+
+  ostream& d_out;
+  WriterState* d_state;
+}; /* class Writer */
+
+WriterState* Writer::getState(ostream& out)
+{
+  void*& p = out.pword(s_stateIndex);
+  if (p == nullptr)
+  {
+    p = new WriterState();
+    out.register_callback(stateCallback, s_stateIndex);
+    out.write(MAGIC, MAGIC_SIZE);
+    writeVarint(out, FORMAT_VERSION);
+    writeVarint(out, kind::LAST_KIND);
+  }
+  return static_cast<WriterState*>(p);
+}
+
+void Writer::checkNodeManager()
+{
+  NodeManager* nm = NodeManager::currentNM();
+  if (d_state->d_nm == nullptr)
+  {
+    d_state->d_nm = nm;
+  }
+  else if (d_state->d_nm != nm)
+  {
+    throw Exception(
+        "cannot write the terms of several expression managers to one "
+        "binary stream");
+  }
+}
+
+uint64_t Writer::define(TypeNode tn)
+{
+  unordered_map<uint64_t, uint64_t>::const_iterator it =
+      d_state->d_types.find(tn.getId());
+  if (it != d_state->d_types.end())
+  {
+    return it->second;
+  }
+  Kind k = tn.getKind();
+  if (k == kind::SORT_TYPE)
+  {
+    std::string name = tn.getAttribute(expr::VarNameAttr());
+    if (tn.getNumChildren() == 0)
+    {
+      uint64_t arity = 0;
+      tn.getAttribute(expr::SortArityAttr(), arity);
+      uint64_t index = defineSortConstructor(tn.getOperator(), name, arity);
+      d_state->d_types[tn.getId()] = index;
+      return index;
+    }
+    uint64_t cons =
+        defineSortConstructor(tn.getOperator(), name, tn.getNumChildren());
+    vector<uint64_t> children;
+    for (const TypeNode& c : tn)
+    {
+      children.push_back(define(c));
+    }
+    tag(TAG_TYPE_SORT_INSTANCE);
+    typeRef(cons);
+    varint(children.size());
+    for (uint64_t c : children)
+    {
+      typeRef(c);
+    }
+  }
+  else if (k == kind::TYPE_CONSTANT)
+  {
+    tag(TAG_TYPE_CONSTANT);
+    varint(k);
+    varint(tn.getConst<TypeConstant>());
+  }
+  else if (k == kind::BITVECTOR_TYPE)
+  {
+    tag(TAG_TYPE_CONSTANT);
+    varint(k);
+    varint(tn.getConst<BitVectorSize>());
+  }
+  else if (k == kind::FLOATINGPOINT_TYPE)
+  {
+    const FloatingPointSize& fps = tn.getConst<FloatingPointSize>();
+    tag(TAG_TYPE_CONSTANT);
+    varint(k);
+    varint(fps.exponent());
+    varint(fps.significand());
+  }
+  else if (tn.getMetaKind() == kind::metakind::OPERATOR)
+  {
+    vector<uint64_t> children;
+    for (const TypeNode& c : tn)
+    {
+      children.push_back(define(c));
+    }
+    tag(TAG_TYPE_NODE);
+    varint(k);
+    varint(children.size());
+    for (uint64_t c : children)
+    {
+      typeRef(c);
+    }
+  }
+  else
+  {
+    stringstream ss;
+    ss << "the type " << tn << " is not supported by the binary format";
+    throw Exception(ss.str());
+  }
+  uint64_t index = d_state->d_numTypes++;
+  d_state->d_types[tn.getId()] = index;
+  return index;
+}
+
+uint64_t Writer::defineSortConstructor(TNode tag,
+                                       const std::string& name,
+                                       uint64_t arity)
+{
+  unordered_map<uint64_t, uint64_t>::const_iterator it =
+      d_state->d_sortTags.find(tag.getId());
+  if (it != d_state->d_sortTags.end())
+  {
+    return it->second;
+  }
+  this->tag(TAG_TYPE_SORT);
+  string(name);
+  varint(arity);
+  uint64_t index = d_state->d_numTypes++;
+  d_state->d_sortTags[tag.getId()] = index;
+  return index;
+}
+
+uint64_t Writer::define(TNode root)
+{
+  // visit the subterms in post-order, the boolean is true if the children of
+  // the term were pushed already
+  vector<pair<TNode, bool> > visit;
+  visit.push_back(make_pair(root, false));
+  while (!visit.empty())
+  {
+    TNode n = visit.back().first;
+    if (d_state->d_terms.find(n.getId()) != d_state->d_terms.end())
+    {
+      visit.pop_back();
+    }
+    else if (!visit.back().second)
+    {
+      visit.back().second = true;
+      if (n.getMetaKind() == kind::metakind::PARAMETERIZED)
+      {
+        visit.push_back(make_pair(n.getOperator(), false));
+      }
+      for (TNode::iterator it = n.begin(), end = n.end(); it != end; ++it)
+      {
+        visit.push_back(make_pair(*it, false));
+      }
+    }
+    else
+    {
+      visit.pop_back();
+      writeTerm(n);
+    }
+  }
+  return d_state->d_terms[root.getId()];
+}
+
+void Writer::writeTerm(TNode n)
+{
+  Kind k = n.getKind();
+  switch (n.getMetaKind())
+  {
+    case kind::metakind::VARIABLE:
+    {
+      if (k != kind::VARIABLE && k != kind::BOUND_VARIABLE)
+      {
+        stringstream ss;
+        ss << "the variable " << n << " of kind " << k
+           << " is not supported by the binary format";
+        throw Exception(ss.str());
+      }
+      uint64_t type = define(n.getType());
+      std::string name;
+      n.getAttribute(expr::VarNameAttr(), name);
+      tag(TAG_TERM_VARIABLE);
+      varint(k);
+      string(name);
+      typeRef(type);
+      break;
+    }
+    case kind::metakind::NULLARY_OPERATOR:
+    {
+      uint64_t type = define(n.getType());
+      tag(TAG_TERM_NULLARY);
+      varint(k);
+      typeRef(type);
+      break;
+    }
+    case kind::metakind::CONSTANT: writeConstant(n); break;
+    default:
+    {
+      tag(TAG_TERM_NODE);
+      varint(k);
+      if (n.getMetaKind() == kind::metakind::PARAMETERIZED)
+      {
+        termRef(d_state->d_terms[n.getOperator().getId()]);
+      }
+      varint(n.getNumChildren());
+      for (TNode::iterator it = n.begin(), end = n.end(); it != end; ++it)
+      {
+        termRef(d_state->d_terms[(*it).getId()]);
+      }
+      break;
+    }
+  }
+  d_state->d_terms[n.getId()] = d_state->d_numTerms++;
+}
+
+void Writer::writeConstant(TNode n)
+{
+  Kind k = n.getKind();
+  // the types and terms a constant refers to are written before its tag
+  uint64_t type = 0;
+  vector<uint64_t> terms;
+  switch (k)
+  {
+    case kind::STORE_ALL:
+    {
+      const ArrayStoreAll& asa = n.getConst<ArrayStoreAll>();
+      type = define(asa.getType());
+      terms.push_back(define(asa.getExpr()));
+      break;
+    }
+    case kind::EMPTYSET:
+      type = define(n.getConst<EmptySet>().getType());
+      break;
+    case kind::UNINTERPRETED_CONSTANT:
+      type = define(n.getConst<UninterpretedConstant>().getType());
+      break;
+    case kind::CONST_SEQUENCE:
+    {
+      const Sequence& s = n.getConst<ExprSequence>().getSequence();
+      type = define(s.getType());
+      for (const Node& c : s.getVec())
+      {
+        terms.push_back(define(c));
+      }
+      break;
+    }
+    default: break;
+  }
+
+  tag(TAG_TERM_CONSTANT);
+  varint(k);
+  switch (k)
+  {
+    case kind::CONST_BOOLEAN: varint(n.getConst<bool>()); break;
+    case kind::CONST_RATIONAL:
+      string(n.getConst<Rational>().toString(16));
+      break;
+    case kind::CONST_BITVECTOR:
+    {
+      const BitVector& bv = n.getConst<BitVector>();
+      varint(bv.getSize());
+      string(bv.getValue().toString(16));
+      break;
+    }
+    case kind::CONST_STRING:
+    {
+      const std::vector<unsigned>& vec = n.getConst<String>().getVec();
+      varint(vec.size());
+      for (unsigned c : vec)
+      {
+        varint(c);
+      }
+      break;
+    }
+    case kind::CONST_ROUNDINGMODE:
+      varint(n.getConst<RoundingMode>());
+      break;
+    case kind::CONST_FLOATINGPOINT:
+    {
+      const FloatingPoint& fp = n.getConst<FloatingPoint>();
+      varint(fp.t.exponent());
+      varint(fp.t.significand());
+      string(fp.pack().getValue().toString(16));
+      break;
+    }
+    case kind::BUILTIN: varint(n.getConst<Kind>()); break;
+    case kind::DIVISIBLE_OP:
+      string(n.getConst<Divisible>().k.toString(16));
+      break;
+    case kind::BITVECTOR_EXTRACT_OP:
+    {
+      const BitVectorExtract& ext = n.getConst<BitVectorExtract>();
+      varint(ext.d_high);
+      varint(ext.d_low);
+      break;
+    }
+    case kind::BITVECTOR_REPEAT_OP:
+      varint(n.getConst<BitVectorRepeat>());
+      break;
+    case kind::BITVECTOR_ZERO_EXTEND_OP:
+      varint(n.getConst<BitVectorZeroExtend>());
+      break;
+    case kind::BITVECTOR_SIGN_EXTEND_OP:
+      varint(n.getConst<BitVectorSignExtend>());
+      break;
+    case kind::BITVECTOR_ROTATE_LEFT_OP:
+      varint(n.getConst<BitVectorRotateLeft>());
+      break;
+    case kind::BITVECTOR_ROTATE_RIGHT_OP:
+      varint(n.getConst<BitVectorRotateRight>());
+      break;
+    case kind::INT_TO_BITVECTOR_OP:
+      varint(n.getConst<IntToBitVector>());
+      break;
+    case kind::FLOATINGPOINT_TO_FP_IEEE_BITVECTOR_OP:
+      writeConvertSort<FloatingPointToFPIEEEBitVector>(n);
+      break;
+    case kind::FLOATINGPOINT_TO_FP_FLOATINGPOINT_OP:
+      writeConvertSort<FloatingPointToFPFloatingPoint>(n);
+      break;
+    case kind::FLOATINGPOINT_TO_FP_REAL_OP:
+      writeConvertSort<FloatingPointToFPReal>(n);
+      break;
+    case kind::FLOATINGPOINT_TO_FP_SIGNED_BITVECTOR_OP:
+      writeConvertSort<FloatingPointToFPSignedBitVector>(n);
+      break;
+    case kind::FLOATINGPOINT_TO_FP_UNSIGNED_BITVECTOR_OP:
+      writeConvertSort<FloatingPointToFPUnsignedBitVector>(n);
+      break;
+    case kind::FLOATINGPOINT_TO_FP_GENERIC_OP:
+      writeConvertSort<FloatingPointToFPGeneric>(n);
+      break;
+    case kind::FLOATINGPOINT_TO_UBV_OP:
+      varint(n.getConst<FloatingPointToUBV>().bvs);
+      break;
+    case kind::FLOATINGPOINT_TO_UBV_TOTAL_OP:
+      varint(n.getConst<FloatingPointToUBVTotal>().bvs);
+      break;
+    case kind::FLOATINGPOINT_TO_SBV_OP:
+      varint(n.getConst<FloatingPointToSBV>().bvs);
+      break;
+    case kind::FLOATINGPOINT_TO_SBV_TOTAL_OP:
+      varint(n.getConst<FloatingPointToSBVTotal>().bvs);
+      break;
+    case kind::REGEXP_REPEAT_OP:
+      varint(n.getConst<RegExpRepeat>().d_repeatAmount);
+      break;
+    case kind::REGEXP_LOOP_OP:
+    {
+      const RegExpLoop& loop = n.getConst<RegExpLoop>();
+      varint(loop.d_loopMinOcc);
+      varint(loop.d_loopMaxOcc);
+      break;
+    }
+    case kind::STORE_ALL:
+      typeRef(type);
+      termRef(terms[0]);
+      break;
+    case kind::EMPTYSET: typeRef(type); break;
+    case kind::UNINTERPRETED_CONSTANT:
+      typeRef(type);
+      string(n.getConst<UninterpretedConstant>().getIndex().toString(16));
+      break;
+    case kind::CONST_SEQUENCE:
+      typeRef(type);
+      varint(terms.size());
+      for (uint64_t t : terms)
+      {
+        termRef(t);
+      }
+      break;
+    default:
+    {
+      stringstream ss;
+      ss << "the constant " << n << " of kind " << k
+         << " is not supported by the binary format";
+      throw Exception(ss.str());
+    }
+  }
+}
+
+void Writer::sexpr(const SExpr& e)
+{
+  if (e.isKeyword())
+  {
+    tag(SEXPR_KEYWORD);
+    string(e.getValue());
+  }
+  else if (e.isString())
+  {
+    tag(SEXPR_STRING);
+    string(e.getValue());
+  }
+  else if (e.isInteger())
+  {
+    tag(SEXPR_INTEGER);
+    string(e.getIntegerValue().toString(16));
+  }
+  else if (e.isRational())
+  {
+    tag(SEXPR_RATIONAL);
+    string(e.getRationalValue().toString(16));
+  }
+  else
+  {
+    const vector<SExpr>& children = e.getChildren();
+    tag(SEXPR_LIST);
+    varint(children.size());
+    for (const SExpr& c : children)
+    {
+      sexpr(c);
+    }
+  }
+}
+
+/** Write the definitions of the terms es, return their indices */
+vector<uint64_t> defineAll(Writer& w, const vector<Expr>& es)
+{
+  vector<uint64_t> indices;
+  for (const Expr& e : es)
+  {
+    indices.push_back(w.define(e));
+  }
+  return indices;
+}
+
+/** Write the references to the terms with indices is */
+void termRefs(Writer& w, const vector<uint64_t>& is)
+{
+  w.varint(is.size());
+  for (uint64_t i : is)
+  {
+    w.termRef(i);
+  }
+}
+
+}  // namespace
+
+void BinaryPrinter::toStream(
+    std::ostream& out, TNode n, int toDepth, bool types, size_t dag) const
+{
+  Writer w(out);
+  w.checkNodeManager();
+  uint64_t i = w.define(n);
+  w.tag(TAG_TERM);
+  w.termRef(i);
+}
+
+template <class T>
+static bool tryToStream(std::ostream& out, const Command* c);
+
+void BinaryPrinter::toStream(std::ostream& out,
+                             const Command* c,
+                             int toDepth,
+                             bool types,
+                             size_t dag) const
+{
+  if (tryToStream<AssertCommand>(out, c) || tryToStream<PushCommand>(out, c)
+      || tryToStream<PopCommand>(out, c) || tryToStream<CheckSatCommand>(out, c)
+      || tryToStream<CheckSatAssumingCommand>(out, c)
+      || tryToStream<QueryCommand>(out, c)
+      || tryToStream<ResetCommand>(out, c)
+      || tryToStream<ResetAssertionsCommand>(out, c)
+      || tryToStream<QuitCommand>(out, c)
+      || tryToStream<DeclarationSequence>(out, c)
+      || tryToStream<CommandSequence>(out, c)
+      || tryToStream<DeclareFunctionCommand>(out, c)
+      || tryToStream<DeclareTypeCommand>(out, c)
+      || tryToStream<DefineTypeCommand>(out, c)
+      || tryToStream<DefineNamedFunctionCommand>(out, c)
+      || tryToStream<DefineFunctionCommand>(out, c)
+      || tryToStream<SetExpressionNameCommand>(out, c)
+      || tryToStream<SimplifyCommand>(out, c)
+      || tryToStream<GetValueCommand>(out, c)
+      || tryToStream<GetModelCommand>(out, c)
+      || tryToStream<GetAssignmentCommand>(out, c)
+      || tryToStream<GetAssertionsCommand>(out, c)
+      || tryToStream<GetProofCommand>(out, c)
+      || tryToStream<GetUnsatAssumptionsCommand>(out, c)
+      || tryToStream<GetUnsatCoreCommand>(out, c)
+      || tryToStream<SetBenchmarkStatusCommand>(out, c)
+      || tryToStream<SetBenchmarkLogicCommand>(out, c)
+      || tryToStream<SetInfoCommand>(out, c)
+      || tryToStream<GetInfoCommand>(out, c)
+      || tryToStream<SetOptionCommand>(out, c)
+      || tryToStream<GetOptionCommand>(out, c)
+      || tryToStream<CommentCommand>(out, c)
+      || tryToStream<EmptyCommand>(out, c)
+      || tryToStream<EchoCommand>(out, c))
+  {
+    return;
+  }
+  throw Exception("the command " + c->getCommandName()
+                  + " is not supported by the binary format");
+}
+
+void BinaryPrinter::toStream(std::ostream& out, const CommandStatus* s) const
+{
+  getPrinter(language::output::LANG_SMTLIB_V2_6)->toStream(out, s);
+}
+
+void BinaryPrinter::toStream(std::ostream& out, const Model& m) const
+{
+  getPrinter(language::output::LANG_SMTLIB_V2_6)->toStream(out, m);
+}
+
+void BinaryPrinter::toStream(std::ostream& out,
+                             const Model& m,
+                             const Command* c) const
+{
+  toStreamUsing(language::output::LANG_SMTLIB_V2_6, out, m, c);
+}
+
+static void toStream(std::ostream& out, const AssertCommand* c)
+{
+  Writer w(out);
+  uint64_t e = w.define(c->getExpr());
+  w.tag(TAG_CMD_ASSERT);
+  w.termRef(e);
+}
+
+static void toStream(std::ostream& out, const PushCommand* c)
+{
+  Writer(out).tag(TAG_CMD_PUSH);
+}
+
+static void toStream(std::ostream& out, const PopCommand* c)
+{
+  Writer(out).tag(TAG_CMD_POP);
+}
+
+static void toStream(std::ostream& out, const CheckSatCommand* c)
+{
+  Writer w(out);
+  Expr e = c->getExpr();
+  if (e.isNull())
+  {
+    w.tag(TAG_CMD_CHECK_SAT);
+    w.varint(0);
+    return;
+  }
+  uint64_t i = w.define(e);
+  w.tag(TAG_CMD_CHECK_SAT);
+  w.varint(1);
+  w.termRef(i);
+}
+
+static void toStream(std::ostream& out, const CheckSatAssumingCommand* c)
+{
+  Writer w(out);
+  vector<uint64_t> terms = defineAll(w, c->getTerms());
+  w.tag(TAG_CMD_CHECK_SAT_ASSUMING);
+  termRefs(w, terms);
+}
+
+static void toStream(std::ostream& out, const QueryCommand* c)
+{
+  Writer w(out);
+  uint64_t e = w.define(c->getExpr());
+  w.tag(TAG_CMD_QUERY);
+  w.termRef(e);
+}
+
+static void toStream(std::ostream& out, const ResetCommand* c)
+{
+  Writer(out).tag(TAG_CMD_RESET);
+}
+
+static void toStream(std::ostream& out, const ResetAssertionsCommand* c)
+{
+  Writer(out).tag(TAG_CMD_RESET_ASSERTIONS);
+}
+
+static void toStream(std::ostream& out, const QuitCommand* c)
+{
+  Writer(out).tag(TAG_CMD_QUIT);
+}
+
+static void toStream(std::ostream& out, const CommandSequence* c, uint8_t tag)
+{
+  Writer w(out);
+  w.tag(tag);
+  w.varint(c->end() - c->begin());
+  for (CommandSequence::const_iterator i = c->begin(); i != c->end(); ++i)
+  {
+    (*i)->toStream(out, -1, false, 0, language::output::LANG_BINARY);
+  }
+}
+
+static void toStream(std::ostream& out, const DeclarationSequence* c)
+{
+  toStream(out, c, TAG_CMD_DECLARATION_SEQUENCE);
+}
+
+static void toStream(std::ostream& out, const CommandSequence* c)
+{
+  toStream(out, c, TAG_CMD_SEQUENCE);
+}
+
+static void toStream(std::ostream& out, const DeclareFunctionCommand* c)
+{
+  Writer w(out);
+  uint64_t func = w.define(c->getFunction());
+  uint64_t type = w.define(c->getType());
+  w.tag(TAG_CMD_DECLARE_FUN);
+  w.string(c->getSymbol());
+  w.termRef(func);
+  w.typeRef(type);
+}
+
+static void toStream(std::ostream& out, const DeclareTypeCommand* c)
+{
+  Writer w(out);
+  uint64_t type = w.define(c->getType());
+  w.tag(TAG_CMD_DECLARE_SORT);
+  w.string(c->getSymbol());
+  w.varint(c->getArity());
+  w.typeRef(type);
+}
+
+static void toStream(std::ostream& out, const DefineTypeCommand* c)
+{
+  Writer w(out);
+  vector<uint64_t> params;
+  for (const Type& t : c->getParameters())
+  {
+    params.push_back(w.define(t));
+  }
+  uint64_t type = w.define(c->getType());
+  w.tag(TAG_CMD_DEFINE_SORT);
+  w.string(c->getSymbol());
+  w.varint(params.size());
+  for (uint64_t p : params)
+  {
+    w.typeRef(p);
+  }
+  w.typeRef(type);
+}
+
+static void toStream(std::ostream& out,
+                     const DefineFunctionCommand* c,
+                     uint8_t tag)
+{
+  Writer w(out);
+  uint64_t func = w.define(c->getFunction());
+  vector<uint64_t> formals = defineAll(w, c->getFormals());
+  uint64_t formula = w.define(c->getFormula());
+  w.tag(tag);
+  w.string(c->getSymbol());
+  w.termRef(func);
+  termRefs(w, formals);
+  w.termRef(formula);
+  w.varint(c->isGlobal());
+}
+
+static void toStream(std::ostream& out, const DefineNamedFunctionCommand* c)
+{
+  toStream(out, c, TAG_CMD_DEFINE_NAMED_FUN);
+}
+
+static void toStream(std::ostream& out, const DefineFunctionCommand* c)
+{
+  toStream(out, c, TAG_CMD_DEFINE_FUN);
+}
+
+static void toStream(std::ostream& out, const SetExpressionNameCommand* c)
+{
+  Writer w(out);
+  uint64_t e = w.define(c->getExpr());
+  w.tag(TAG_CMD_SET_EXPRESSION_NAME);
+  w.termRef(e);
+  w.string(c->getName());
+}
+
+static void toStream(std::ostream& out, const SimplifyCommand* c)
+{
+  Writer w(out);
+  uint64_t e = w.define(c->getTerm());
+  w.tag(TAG_CMD_SIMPLIFY);
+  w.termRef(e);
+}
+
+static void toStream(std::ostream& out, const GetValueCommand* c)
+{
+  Writer w(out);
+  vector<uint64_t> terms = defineAll(w, c->getTerms());
+  w.tag(TAG_CMD_GET_VALUE);
+  termRefs(w, terms);
+}
+
+static void toStream(std::ostream& out, const GetModelCommand* c)
+{
+  Writer(out).tag(TAG_CMD_GET_MODEL);
+}
+
+static void toStream(std::ostream& out, const GetAssignmentCommand* c)
+{
+  Writer(out).tag(TAG_CMD_GET_ASSIGNMENT);
+}
+
+static void toStream(std::ostream& out, const GetAssertionsCommand* c)
+{
+  Writer(out).tag(TAG_CMD_GET_ASSERTIONS);
+}
+
+static void toStream(std::ostream& out, const GetProofCommand* c)
+{
+  Writer(out).tag(TAG_CMD_GET_PROOF);
+}
+
+static void toStream(std::ostream& out, const GetUnsatAssumptionsCommand* c)
+{
+  Writer(out).tag(TAG_CMD_GET_UNSAT_ASSUMPTIONS);
+}
+
+static void toStream(std::ostream& out, const GetUnsatCoreCommand* c)
+{
+  Writer(out).tag(TAG_CMD_GET_UNSAT_CORE);
+}
+
+static void toStream(std::ostream& out, const SetBenchmarkStatusCommand* c)
+{
+  Writer w(out);
+  w.tag(TAG_CMD_SET_BENCHMARK_STATUS);
+  w.varint(c->getStatus());
+}
+
+static void toStream(std::ostream& out, const SetBenchmarkLogicCommand* c)
+{
+  Writer w(out);
+  w.tag(TAG_CMD_SET_BENCHMARK_LOGIC);
+  w.string(c->getLogic());
+}
+
+static void toStream(std::ostream& out, const SetInfoCommand* c)
+{
+  Writer w(out);
+  w.tag(TAG_CMD_SET_INFO);
+  w.string(c->getFlag());
+  w.sexpr(c->getSExpr());
+}
+
+static void toStream(std::ostream& out, const GetInfoCommand* c)
+{
+  Writer w(out);
+  w.tag(TAG_CMD_GET_INFO);
+  w.string(c->getFlag());
+}
+
+static void toStream(std::ostream& out, const SetOptionCommand* c)
+{
+  Writer w(out);
+  w.tag(TAG_CMD_SET_OPTION);
+  w.string(c->getFlag());
+  w.sexpr(c->getSExpr());
+}
+
+static void toStream(std::ostream& out, const GetOptionCommand* c)
+{
+  Writer w(out);
+  w.tag(TAG_CMD_GET_OPTION);
+  w.string(c->getFlag());
+}
+
+static void toStream(std::ostream& out, const CommentCommand* c)
+{
+  Writer w(out);
+  w.tag(TAG_CMD_COMMENT);
+  w.string(c->getComment());
+}
+
+static void toStream(std::ostream& out, const EmptyCommand* c)
+{
+  Writer w(out);
+  w.tag(TAG_CMD_EMPTY);
+  w.string(c->getName());
+}
+
+static void toStream(std::ostream& out, const EchoCommand* c)
+{
+  Writer w(out);
+  w.tag(TAG_CMD_ECHO);
+  w.string(c->getOutput());
+}
+
+template <class T>
+static bool tryToStream(std::ostream& out, const Command* c)
+{
+  if (typeid(*c) == typeid(T))
+  {
+    toStream(out, dynamic_cast<const T*>(c));
+    return true;
+  }
+  return false;
+}
+
+}  // namespace binary
+}  // namespace printer
+}  // namespace CVC4
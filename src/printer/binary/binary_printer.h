@@ -0,0 +1,66 @@
+/*********************                                                        */
+/*! \file binary_printer.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief The printer for the binary output language
+ **
+ ** The printer for the binary output language, which writes terms and
+ ** commands in the format described in binary_format.h.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__PRINTER__BINARY__BINARY_PRINTER_H
+#define CVC4__PRINTER__BINARY__BINARY_PRINTER_H
+
+#include <iostream>
+
+#include "printer/printer.h"
+
+namespace CVC4 {
+namespace printer {
+namespace binary {
+
+/**
+ * The printer for the binary format. The types and terms written to a stream
+ * are remembered in the stream (see std::ios_base::pword), so that each of
+ * them is written only once per stream, even if it is shared by several
+ * commands. The header of the format is written before the first record
+ * written to a stream.
+ *
+ * Responses of the solver, i.e. command statuses and models, are printed in
+ * SMT-LIB 2.6 instead, since they are not part of a script.
+ */
+class BinaryPrinter : public CVC4::Printer
+{
+ public:
+  using CVC4::Printer::toStream;
+  void toStream(std::ostream& out,
+                TNode n,
+                int toDepth,
+                bool types,
+                size_t dag) const override;
+  void toStream(std::ostream& out,
+                const Command* c,
+                int toDepth,
+                bool types,
+                size_t dag) const override;
+  void toStream(std::ostream& out, const CommandStatus* s) const override;
+  void toStream(std::ostream& out, const Model& m) const override;
+
+ private:
+  void toStream(std::ostream& out,
+                const Model& m,
+                const Command* c) const override;
+}; /* class BinaryPrinter */
+
+}  // namespace binary
+}  // namespace printer
+}  // namespace CVC4
+
+#endif /* CVC4__PRINTER__BINARY__BINARY_PRINTER_H */
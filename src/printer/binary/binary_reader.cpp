@@ -0,0 +1,794 @@
+/*********************                                                        */
+/*! \file binary_reader.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A reader for the binary format of terms and commands
+ **
+ ** A reader for the binary format of terms and commands.
+ **/
+
+#include "printer/binary/binary_reader.h"
+
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "base/exception.h"
+#include "expr/array_store_all.h"
+#include "expr/emptyset.h"
+#include "expr/expr_manager.h"
+#include "expr/expr_sequence.h"
+#include "expr/kind.h"
+#include "expr/node_builder.h"
+#include "expr/node_manager.h"
+#include "expr/uninterpreted_constant.h"
+#include "printer/binary/binary_format.h"
+#include "smt/command.h"
+#include "util/bitvector.h"
+#include "util/divisible.h"
+#include "util/floatingpoint.h"
+#include "util/regexp.h"
+#include "util/string.h"
+
+namespace CVC4 {
+namespace printer {
+namespace binary {
+
+class BinaryReaderPrivate
+{
+ public:
+  BinaryReaderPrivate(ExprManager* em, const char* data, size_t size)
+      : d_em(em),
+        d_nm(NodeManager::fromExprManager(em)),
+        d_data(data),
+        d_size(size),
+        d_pos(0),
+        d_headerRead(false)
+  {
+  }
+  ~BinaryReaderPrivate()
+  {
+    // the nodes must be released in the scope of their node manager
+    NodeManagerScope nms(d_nm);
+    d_terms.clear();
+    d_types.clear();
+  }
+
+  Command* readCommand();
+  Expr readTerm();
+
+ private:
+  /**
+   * Read the records up to the next one that does not define a type or a
+   * term, and read its tag into tag. Returns false at the end of the buffer.
+   */
+  bool nextTag(uint8_t& tag);
+  /** Read and check the header */
+  void readHeader();
+  /**
+   * Read the command with tag tag, which is nested in depth command
+   * sequences
+   */
+  Command* readCommand(uint8_t tag, unsigned depth);
+  /** Read the record of a type with tag tag */
+  void defineType(uint8_t tag);
+  /** Read the record of a term with tag tag */
+  void defineTerm(uint8_t tag);
+  /** Read the payload of a constant of kind k */
+  Node readConstant(Kind k);
+
+  uint8_t byte();
+  uint64_t varint();
+  /** Read a varint that fits into an unsigned */
+  unsigned uvarint();
+  std::string string();
+  Integer integer() { return Integer(string(), 16); }
+  Kind kind();
+  /** Read an s-expression, which is nested in depth lists */
+  SExpr sexpr(unsigned depth = 0);
+  /** Read a reference to a type */
+  TypeNode typeRef();
+  /** Read a reference to a term */
+  Node termRef();
+  /** Read a number of references to terms */
+  std::vector<Expr> termRefs();
+  /** Read the children of a node of kind k */
+  template <class T>
+  void children(Kind k, std::vector<T>& c, T (BinaryReaderPrivate::*ref)());
+
+  Expr toExpr(TNode n) { return d_nm->toExpr(n); }
+  Type toType(TypeNode tn) { return d_nm->toType(tn); }
+
+  /** Raise an error at the current offset */
+  [[noreturn]] void error(const std::string& msg) const;
+
+  /** The expression manager the terms are built with */
+  ExprManager* d_em;
+  /** The node manager of d_em */
+  NodeManager* d_nm;
+  /** The buffer */
+  const char* d_data;
+  /** The size of the buffer */
+  size_t d_size;
+  /** The current offset */
+  size_t d_pos;
+  /** Whether the header was read */
+  bool d_headerRead;
+  /** The types read so far */
+  std::vector<TypeNode> d_types;
+  /** The terms read so far */
+  std::vector<Node> d_terms;
+}; /* class BinaryReaderPrivate */
+
+void BinaryReaderPrivate::error(const std::string& msg) const
+{
+  std::stringstream ss;
+  ss << "binary input, offset " << d_pos << ": " << msg;
+  throw Exception(ss.str());
+}
+
+uint8_t BinaryReaderPrivate::byte()
+{
+  if (d_pos >= d_size)
+  {
+    error("unexpected end of input");
+  }
+  return static_cast<uint8_t>(d_data[d_pos++]);
+}
+
+uint64_t BinaryReaderPrivate::varint()
+{
+  uint64_t n = 0;
+  for (unsigned shift = 0; shift < 64; shift += 7)
+  {
+    uint8_t b = byte();
+    n |= static_cast<uint64_t>(b & 0x7f) << shift;
+    if ((b & 0x80) == 0)
+    {
+      return n;
+    }
+  }
+  error("varint too long");
+}
+
+unsigned BinaryReaderPrivate::uvarint()
+{
+  uint64_t n = varint();
+  if (n > std::numeric_limits<unsigned>::max())
+  {
+    error("number too large");
+  }
+  return static_cast<unsigned>(n);
+}
+
+std::string BinaryReaderPrivate::string()
+{
+  uint64_t n = varint();
+  if (n > d_size - d_pos)
+  {
+    error("unexpected end of input");
+  }
+  std::string s(d_data + d_pos, n);
+  d_pos += n;
+  return s;
+}
+
+Kind BinaryReaderPrivate::kind()
+{
+  uint64_t k = varint();
+  if (k >= kind::LAST_KIND)
+  {
+    error("bad kind");
+  }
+  return static_cast<Kind>(k);
+}
+
+TypeNode BinaryReaderPrivate::typeRef()
+{
+  uint64_t d = varint();
+  if (d == 0 || d > d_types.size())
+  {
+    error("bad type reference");
+  }
+  return d_types[d_types.size() - d];
+}
+
+Node BinaryReaderPrivate::termRef()
+{
+  uint64_t d = varint();
+  if (d == 0 || d > d_terms.size())
+  {
+    error("bad term reference");
+  }
+  return d_terms[d_terms.size() - d];
+}
+
+std::vector<Expr> BinaryReaderPrivate::termRefs()
+{
+  uint64_t n = varint();
+  std::vector<Expr> terms;
+  for (uint64_t i = 0; i < n; ++i)
+  {
+    terms.push_back(toExpr(termRef()));
+  }
+  return terms;
+}
+
+template <class T>
+void BinaryReaderPrivate::children(Kind k,
+                                   std::vector<T>& c,
+                                   T (BinaryReaderPrivate::*ref)())
+{
+  uint64_t n = varint();
+  if (n < kind::metakind::getLowerBoundForKind(k)
+      || n > kind::metakind::getUpperBoundForKind(k))
+  {
+    error("bad number of children");
+  }
+  // each child is a reference of at least one byte, which bounds the
+  // allocation below by the size of the input
+  if (n > d_size - d_pos)
+  {
+    error("unexpected end of input");
+  }
+  c.reserve(n);
+  for (uint64_t i = 0; i < n; ++i)
+  {
+    c.push_back((this->*ref)());
+  }
+}
+
+SExpr BinaryReaderPrivate::sexpr(unsigned depth)
+{
+  switch (byte())
+  {
+    case SEXPR_STRING: return SExpr(string());
+    case SEXPR_KEYWORD: return SExpr(SExpr::Keyword(string()));
+    case SEXPR_INTEGER: return SExpr(integer());
+    case SEXPR_RATIONAL: return SExpr(Rational(string(), 16));
+    case SEXPR_LIST:
+    {
+      if (depth >= MAX_NESTING_DEPTH)
+      {
+        error("s-expression nested too deeply");
+      }
+      uint64_t n = varint();
+      std::vector<SExpr> children;
+      for (uint64_t i = 0; i < n; ++i)
+      {
+        children.push_back(sexpr(depth + 1));
+      }
+      return SExpr(children);
+    }
+    default: error("bad s-expression");
+  }
+}
+
+void BinaryReaderPrivate::readHeader()
+{
+  if (d_size < MAGIC_SIZE || std::memcmp(d_data, MAGIC, MAGIC_SIZE) != 0)
+  {
+    error("not in the binary format");
+  }
+  d_pos = MAGIC_SIZE;
+  if (varint() != FORMAT_VERSION)
+  {
+    error("unsupported version of the binary format");
+  }
+  if (varint() != kind::LAST_KIND)
+  {
+    error("written by an incompatible version of CVC4");
+  }
+  d_headerRead = true;
+}
+
+bool BinaryReaderPrivate::nextTag(uint8_t& tag)
+{
+  if (!d_headerRead)
+  {
+    if (d_size == 0)
+    {
+      return false;
+    }
+    readHeader();
+  }
+  while (d_pos < d_size)
+  {
+    uint8_t t = byte();
+    if (t >= TAG_TYPE_CONSTANT && t <= TAG_TYPE_NODE)
+    {
+      defineType(t);
+    }
+    else if (t >= TAG_TERM_VARIABLE && t <= TAG_TERM_NODE)
+    {
+      defineTerm(t);
+    }
+    else if (t != '\n')
+    {
+      tag = t;
+      return true;
+    }
+  }
+  return false;
+}
+
+void BinaryReaderPrivate::defineType(uint8_t tag)
+{
+  TypeNode tn;
+  switch (tag)
+  {
+    case TAG_TYPE_CONSTANT:
+    {
+      Kind k = kind();
+      if (k == kind::TYPE_CONSTANT)
+      {
+        uint64_t tc = varint();
+        if (tc >= LAST_TYPE)
+        {
+          error("bad type constant");
+        }
+        tn = d_nm->mkTypeConst(static_cast<TypeConstant>(tc));
+      }
+      else if (k == kind::BITVECTOR_TYPE)
+      {
+        unsigned size = uvarint();
+        if (size == 0)
+        {
+          error("bad bit-vector size");
+        }
+        tn = d_nm->mkBitVectorType(size);
+      }
+      else if (k == kind::FLOATINGPOINT_TYPE)
+      {
+        unsigned e = uvarint();
+        unsigned s = uvarint();
+        tn = d_nm->mkFloatingPointType(e, s);
+      }
+      else
+      {
+        error("bad constant type");
+      }
+      break;
+    }
+    case TAG_TYPE_SORT:
+    {
+      std::string name = string();
+      uint64_t arity = varint();
+      tn = arity == 0 ? d_nm->mkSort(name)
+                      : d_nm->mkSortConstructor(name, arity);
+      break;
+    }
+    case TAG_TYPE_SORT_INSTANCE:
+    {
+      TypeNode cons = typeRef();
+      if (!cons.isSortConstructor())
+      {
+        error("expected a sort constructor");
+      }
+      std::vector<TypeNode> params;
+      uint64_t n = varint();
+      if (n != cons.getSortConstructorArity())
+      {
+        error("bad number of sort parameters");
+      }
+      for (uint64_t i = 0; i < n; ++i)
+      {
+        params.push_back(typeRef());
+      }
+      tn = d_nm->mkSort(cons, params);
+      break;
+    }
+    default:
+    {
+      Kind k = kind();
+      if (kind::metaKindOf(k) != kind::metakind::OPERATOR)
+      {
+        error("bad type kind");
+      }
+      std::vector<TypeNode> c;
+      children(k, c, &BinaryReaderPrivate::typeRef);
+      tn = d_nm->mkTypeNode(k, c);
+      break;
+    }
+  }
+  d_types.push_back(tn);
+}
+
+void BinaryReaderPrivate::defineTerm(uint8_t tag)
+{
+  Node n;
+  Kind k = kind();
+  switch (tag)
+  {
+    case TAG_TERM_VARIABLE:
+    {
+      std::string name = string();
+      TypeNode tn = typeRef();
+      if (k == kind::VARIABLE)
+      {
+        n = Node::fromExpr(d_em->mkVar(name, toType(tn)));
+      }
+      else if (k == kind::BOUND_VARIABLE)
+      {
+        n = d_nm->mkBoundVar(name, tn);
+      }
+      else
+      {
+        error("bad variable kind");
+      }
+      break;
+    }
+    case TAG_TERM_CONSTANT:
+      if (kind::metaKindOf(k) != kind::metakind::CONSTANT)
+      {
+        error("bad constant kind");
+      }
+      n = readConstant(k);
+      break;
+    case TAG_TERM_NULLARY:
+      if (kind::metaKindOf(k) != kind::metakind::NULLARY_OPERATOR)
+      {
+        error("bad nullary operator");
+      }
+      n = d_nm->mkNullaryOperator(typeRef(), k);
+      break;
+    default:
+    {
+      kind::MetaKind mk = kind::metaKindOf(k);
+      if (mk != kind::metakind::OPERATOR && mk != kind::metakind::PARAMETERIZED)
+      {
+        error("bad term kind");
+      }
+      NodeBuilder<> nb(d_nm, k);
+      if (mk == kind::metakind::PARAMETERIZED)
+      {
+        nb << termRef();
+      }
+      std::vector<Node> c;
+      children(k, c, &BinaryReaderPrivate::termRef);
+      nb.append(c);
+      n = nb.constructNode();
+      // the children are already type checked, hence this only checks n
+      try
+      {
+        n.getType(true);
+      }
+      catch (const TypeCheckingExceptionPrivate& e)
+      {
+        error(e.getMessage());
+      }
+      break;
+    }
+  }
+  d_terms.push_back(n);
+}
+
+Node BinaryReaderPrivate::readConstant(Kind k)
+{
+  switch (k)
+  {
+    case kind::CONST_BOOLEAN: return d_nm->mkConst(varint() != 0);
+    case kind::CONST_RATIONAL: return d_nm->mkConst(Rational(string(), 16));
+    case kind::CONST_BITVECTOR:
+    {
+      unsigned size = uvarint();
+      return d_nm->mkConst(BitVector(size, integer()));
+    }
+    case kind::CONST_STRING:
+    {
+      uint64_t n = varint();
+      std::vector<unsigned> vec;
+      for (uint64_t i = 0; i < n; ++i)
+      {
+        unsigned c = uvarint();
+        if (c >= String::num_codes())
+        {
+          error("bad character");
+        }
+        vec.push_back(c);
+      }
+      return d_nm->mkConst(String(vec));
+    }
+    case kind::CONST_ROUNDINGMODE:
+    {
+      unsigned rm = uvarint();
+      if (rm != roundNearestTiesToEven && rm != roundTowardPositive
+          && rm != roundTowardNegative && rm != roundTowardZero
+          && rm != roundNearestTiesToAway)
+      {
+        error("bad rounding mode");
+      }
+      return d_nm->mkConst(static_cast<RoundingMode>(rm));
+    }
+    case kind::CONST_FLOATINGPOINT:
+    {
+      unsigned e = uvarint();
+      unsigned s = uvarint();
+      return d_nm->mkConst(FloatingPoint(e, s, BitVector(e + s, integer())));
+    }
+    case kind::BUILTIN: return d_nm->operatorOf(kind());
+    case kind::DIVISIBLE_OP: return d_nm->mkConst(Divisible(integer()));
+    case kind::BITVECTOR_EXTRACT_OP:
+    {
+      unsigned high = uvarint();
+      unsigned low = uvarint();
+      return d_nm->mkConst(BitVectorExtract(high, low));
+    }
+    case kind::BITVECTOR_REPEAT_OP:
+      return d_nm->mkConst(BitVectorRepeat(uvarint()));
+    case kind::BITVECTOR_ZERO_EXTEND_OP:
+      return d_nm->mkConst(BitVectorZeroExtend(uvarint()));
+    case kind::BITVECTOR_SIGN_EXTEND_OP:
+      return d_nm->mkConst(BitVectorSignExtend(uvarint()));
+    case kind::BITVECTOR_ROTATE_LEFT_OP:
+      return d_nm->mkConst(BitVectorRotateLeft(uvarint()));
+    case kind::BITVECTOR_ROTATE_RIGHT_OP:
+      return d_nm->mkConst(BitVectorRotateRight(uvarint()));
+    case kind::INT_TO_BITVECTOR_OP:
+      return d_nm->mkConst(IntToBitVector(uvarint()));
+    case kind::FLOATINGPOINT_TO_FP_IEEE_BITVECTOR_OP:
+    {
+      unsigned e = uvarint();
+      unsigned s = uvarint();
+      return d_nm->mkConst(FloatingPointToFPIEEEBitVector(e, s));
+    }
+    case kind::FLOATINGPOINT_TO_FP_FLOATINGPOINT_OP:
+    {
+      unsigned e = uvarint();
+      unsigned s = uvarint();
+      return d_nm->mkConst(FloatingPointToFPFloatingPoint(e, s));
+    }
+    case kind::FLOATINGPOINT_TO_FP_REAL_OP:
+    {
+      unsigned e = uvarint();
+      unsigned s = uvarint();
+      return d_nm->mkConst(FloatingPointToFPReal(e, s));
+    }
+    case kind::FLOATINGPOINT_TO_FP_SIGNED_BITVECTOR_OP:
+    {
+      unsigned e = uvarint();
+      unsigned s = uvarint();
+      return d_nm->mkConst(FloatingPointToFPSignedBitVector(e, s));
+    }
+    case kind::FLOATINGPOINT_TO_FP_UNSIGNED_BITVECTOR_OP:
+    {
+      unsigned e = uvarint();
+      unsigned s = uvarint();
+      return d_nm->mkConst(FloatingPointToFPUnsignedBitVector(e, s));
+    }
+    case kind::FLOATINGPOINT_TO_FP_GENERIC_OP:
+    {
+      unsigned e = uvarint();
+      unsigned s = uvarint();
+      return d_nm->mkConst(FloatingPointToFPGeneric(e, s));
+    }
+    case kind::FLOATINGPOINT_TO_UBV_OP:
+      return d_nm->mkConst(FloatingPointToUBV(uvarint()));
+    case kind::FLOATINGPOINT_TO_UBV_TOTAL_OP:
+      return d_nm->mkConst(FloatingPointToUBVTotal(uvarint()));
+    case kind::FLOATINGPOINT_TO_SBV_OP:
+      return d_nm->mkConst(FloatingPointToSBV(uvarint()));
+    case kind::FLOATINGPOINT_TO_SBV_TOTAL_OP:
+      return d_nm->mkConst(FloatingPointToSBVTotal(uvarint()));
+    case kind::REGEXP_REPEAT_OP:
+      return d_nm->mkConst(RegExpRepeat(uvarint()));
+    case kind::REGEXP_LOOP_OP:
+    {
+      unsigned min = uvarint();
+      unsigned max = uvarint();
+      return d_nm->mkConst(RegExpLoop(min, max));
+    }
+    case kind::STORE_ALL:
+    {
+      TypeNode tn = typeRef();
+      Node value = termRef();
+      if (!tn.isArray())
+      {
+        error("expected an array type");
+      }
+      return d_nm->mkConst(
+          ArrayStoreAll(ArrayType(toType(tn)), toExpr(value)));
+    }
+    case kind::EMPTYSET:
+    {
+      TypeNode tn = typeRef();
+      if (!tn.isSet())
+      {
+        error("expected a set type");
+      }
+      return d_nm->mkConst(EmptySet(SetType(toType(tn))));
+    }
+    case kind::UNINTERPRETED_CONSTANT:
+    {
+      TypeNode tn = typeRef();
+      return d_nm->mkConst(UninterpretedConstant(toType(tn), integer()));
+    }
+    case kind::CONST_SEQUENCE:
+    {
+      TypeNode tn = typeRef();
+      uint64_t n = varint();
+      std::vector<Expr> elements;
+      for (uint64_t i = 0; i < n; ++i)
+      {
+        elements.push_back(toExpr(termRef()));
+      }
+      return d_nm->mkConst(ExprSequence(toType(tn), elements));
+    }
+    default: error("unsupported constant kind");
+  }
+}
+
+Command* BinaryReaderPrivate::readCommand(uint8_t tag, unsigned depth)
+{
+  switch (tag)
+  {
+    case TAG_CMD_ASSERT: return new AssertCommand(toExpr(termRef()));
+    case TAG_CMD_CHECK_SAT:
+      if (varint() == 0)
+      {
+        return new CheckSatCommand();
+      }
+      return new CheckSatCommand(toExpr(termRef()));
+    case TAG_CMD_CHECK_SAT_ASSUMING:
+      return new CheckSatAssumingCommand(termRefs());
+    case TAG_CMD_QUERY: return new QueryCommand(toExpr(termRef()));
+    case TAG_CMD_PUSH: return new PushCommand();
+    case TAG_CMD_POP: return new PopCommand();
+    case TAG_CMD_RESET: return new ResetCommand();
+    case TAG_CMD_RESET_ASSERTIONS: return new ResetAssertionsCommand();
+    case TAG_CMD_QUIT: return new QuitCommand();
+    case TAG_CMD_DECLARE_FUN:
+    {
+      std::string symbol = string();
+      Expr func = toExpr(termRef());
+      Type type = toType(typeRef());
+      return new DeclareFunctionCommand(symbol, func, type);
+    }
+    case TAG_CMD_DECLARE_SORT:
+    {
+      std::string symbol = string();
+      size_t arity = varint();
+      Type type = toType(typeRef());
+      return new DeclareTypeCommand(symbol, arity, type);
+    }
+    case TAG_CMD_DEFINE_SORT:
+    {
+      std::string symbol = string();
+      uint64_t n = varint();
+      std::vector<Type> params;
+      for (uint64_t i = 0; i < n; ++i)
+      {
+        params.push_back(toType(typeRef()));
+      }
+      Type type = toType(typeRef());
+      return new DefineTypeCommand(symbol, params, type);
+    }
+    case TAG_CMD_DEFINE_FUN:
+    case TAG_CMD_DEFINE_NAMED_FUN:
+    {
+      std::string symbol = string();
+      Expr func = toExpr(termRef());
+      std::vector<Expr> formals = termRefs();
+      Expr formula = toExpr(termRef());
+      bool global = varint() != 0;
+      if (tag == TAG_CMD_DEFINE_NAMED_FUN)
+      {
+        return new DefineNamedFunctionCommand(
+            symbol, func, formals, formula, global);
+      }
+      return new DefineFunctionCommand(symbol, func, formals, formula, global);
+    }
+    case TAG_CMD_SET_EXPRESSION_NAME:
+    {
+      Expr e = toExpr(termRef());
+      return new SetExpressionNameCommand(e, string());
+    }
+    case TAG_CMD_SIMPLIFY: return new SimplifyCommand(toExpr(termRef()));
+    case TAG_CMD_GET_VALUE: return new GetValueCommand(termRefs());
+    case TAG_CMD_GET_ASSIGNMENT: return new GetAssignmentCommand();
+    case TAG_CMD_GET_MODEL: return new GetModelCommand();
+    case TAG_CMD_GET_PROOF: return new GetProofCommand();
+    case TAG_CMD_GET_UNSAT_ASSUMPTIONS: return new GetUnsatAssumptionsCommand();
+    case TAG_CMD_GET_UNSAT_CORE: return new GetUnsatCoreCommand();
+    case TAG_CMD_GET_ASSERTIONS: return new GetAssertionsCommand();
+    case TAG_CMD_SET_BENCHMARK_STATUS:
+    {
+      uint64_t status = varint();
+      if (status > SMT_UNKNOWN)
+      {
+        error("bad benchmark status");
+      }
+      return new SetBenchmarkStatusCommand(
+          static_cast<BenchmarkStatus>(status));
+    }
+    case TAG_CMD_SET_BENCHMARK_LOGIC:
+      return new SetBenchmarkLogicCommand(string());
+    case TAG_CMD_SET_INFO:
+    {
+      std::string flag = string();
+      return new SetInfoCommand(flag, sexpr());
+    }
+    case TAG_CMD_GET_INFO: return new GetInfoCommand(string());
+    case TAG_CMD_SET_OPTION:
+    {
+      std::string flag = string();
+      return new SetOptionCommand(flag, sexpr());
+    }
+    case TAG_CMD_GET_OPTION: return new GetOptionCommand(string());
+    case TAG_CMD_ECHO: return new EchoCommand(string());
+    case TAG_CMD_COMMENT: return new CommentCommand(string());
+    case TAG_CMD_EMPTY: return new EmptyCommand(string());
+    case TAG_CMD_SEQUENCE:
+    case TAG_CMD_DECLARATION_SEQUENCE:
+    {
+      if (depth >= MAX_NESTING_DEPTH)
+      {
+        error("command sequence nested too deeply");
+      }
+      std::unique_ptr<CommandSequence> seq(tag == TAG_CMD_SEQUENCE
+                                               ? new CommandSequence()
+                                               : new DeclarationSequence());
+      uint64_t n = varint();
+      for (uint64_t i = 0; i < n; ++i)
+      {
+        uint8_t t;
+        if (!nextTag(t))
+        {
+          error("unexpected end of input");
+        }
+        seq->addCommand(readCommand(t, depth + 1));
+      }
+      return seq.release();
+    }
+    default: error("bad command");
+  }
+}
+
+Command* BinaryReaderPrivate::readCommand()
+{
+  NodeManagerScope nms(d_nm);
+  uint8_t tag;
+  if (!nextTag(tag))
+  {
+    return nullptr;
+  }
+  return readCommand(tag, 0);
+}
+
+Expr BinaryReaderPrivate::readTerm()
+{
+  NodeManagerScope nms(d_nm);
+  uint8_t tag;
+  if (!nextTag(tag))
+  {
+    return Expr();
+  }
+  if (tag != TAG_TERM)
+  {
+    error("expected a term");
+  }
+  return toExpr(termRef());
+}
+
+BinaryReader::BinaryReader(ExprManager* em, const char* data, size_t size)
+    : d_private(new BinaryReaderPrivate(em, data, size))
+{
+}
+
+BinaryReader::~BinaryReader() {}
+
+Command* BinaryReader::readCommand() { return d_private->readCommand(); }
+
+Expr BinaryReader::readTerm() { return d_private->readTerm(); }
+
+}  // namespace binary
+}  // namespace printer
+}  // namespace CVC4
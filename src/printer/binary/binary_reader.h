@@ -0,0 +1,70 @@
+/*********************                                                        */
+/*! \file binary_reader.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A reader for the binary format of terms and commands
+ **
+ ** A reader for the binary format of terms and commands, which is written by
+ ** the printer for the binary output language.
+ **/
+
+#include "cvc4_public.h"
+
+#ifndef CVC4__PRINTER__BINARY__BINARY_READER_H
+#define CVC4__PRINTER__BINARY__BINARY_READER_H
+
+#include <cstddef>
+#include <memory>
+
+#include "expr/expr.h"
+
+namespace CVC4 {
+
+class Command;
+class ExprManager;
+
+namespace printer {
+namespace binary {
+
+class BinaryReaderPrivate;
+
+/**
+ * Reads the commands and terms of a buffer in the binary format. The terms
+ * are built with the node manager of an expression manager, in a single pass
+ * over the buffer: each record refers only to the types and terms before it.
+ *
+ * The buffer is not copied, it must outlive the reader. Errors in the buffer
+ * raise an Exception with the offset of the error.
+ */
+class CVC4_PUBLIC BinaryReader
+{
+ public:
+  /**
+   * Create a reader for the size bytes at data, which builds its terms with
+   * em.
+   */
+  BinaryReader(ExprManager* em, const char* data, size_t size);
+  ~BinaryReader();
+
+  /**
+   * Read the next command. The caller owns the command. Returns nullptr at
+   * the end of the buffer.
+   */
+  Command* readCommand();
+  /** Read the next term. Returns the null expression at the end of the buffer */
+  Expr readTerm();
+
+ private:
+  std::unique_ptr<BinaryReaderPrivate> d_private;
+}; /* class BinaryReader */
+
+}  // namespace binary
+}  // namespace printer
+}  // namespace CVC4
+
+#endif /* CVC4__PRINTER__BINARY__BINARY_READER_H */
@@ -0,0 +1,209 @@
+/*********************                                                        */
+/*! \file let_binding.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of a let binding utility for printers
+ **
+ ** Implementation of a let binding utility for printers.
+ **/
+
+#include "printer/let_binding.h"
+
+#include <algorithm>
+
+#include "base/check.h"
+#include "expr/node_manager_attributes.h"
+
+namespace CVC4 {
+namespace printer {
+
+LetBinding::LetBinding(uint32_t threshold, const std::string& prefix)
+    : d_threshold(threshold), d_prefix(prefix), d_nextIndex(0)
+{
+  // 0 doesn't make sense
+  AlwaysAssertArgument(threshold > 0, threshold);
+}
+
+bool LetBinding::isTrivial(TNode n)
+{
+  if (n.isVar() || n.getMetaKind() == kind::metakind::CONSTANT
+      || n.getNumChildren() == 0)
+  {
+    return true;
+  }
+  Kind k = n.getKind();
+  if (k == kind::NOT || k == kind::UMINUS)
+  {
+    return n[0].isVar() || n[0].getMetaKind() == kind::metakind::CONSTANT;
+  }
+  // the variables and patterns of binders are never let-bound
+  return k == kind::SORT_TYPE || k == kind::BOUND_VAR_LIST
+         || k == kind::INST_PATTERN_LIST;
+}
+
+void LetBinding::reserveNames(TNode n)
+{
+  std::unordered_set<TNode, TNodeHashFunction> visited;
+  std::vector<TNode> visit;
+  visit.push_back(n);
+  do
+  {
+    TNode cur = visit.back();
+    visit.pop_back();
+    if (!visited.insert(cur).second)
+    {
+      continue;
+    }
+    if (cur.isVar())
+    {
+      const std::string& name = cur.getAttribute(expr::VarNameAttr());
+      if (name.compare(0, d_prefix.size(), d_prefix) == 0)
+      {
+        d_reserved.insert(name);
+      }
+      continue;
+    }
+    visit.insert(visit.end(), cur.begin(), cur.end());
+  } while (!visit.empty());
+}
+
+void LetBinding::pushScope(TNode n, std::vector<Node>& lets)
+{
+  if (d_scopes.empty())
+  {
+    reserveNames(n);
+  }
+  d_scopes.push_back(d_bound.size());
+  if (isTrivial(n) || d_names.find(n) != d_names.end())
+  {
+    return;
+  }
+
+  // Collect the subterms of n that may be let-bound in this scope, children
+  // before parents. The bodies of binders are not traversed, since they are
+  // letified in scopes of their own, and neither are the terms that are
+  // already bound by name.
+  std::unordered_map<TNode, bool, TNodeHashFunction> visited;
+  std::vector<TNode> order;
+  std::vector<TNode> visit;
+  visit.push_back(n);
+  do
+  {
+    TNode cur = visit.back();
+    std::unordered_map<TNode, bool, TNodeHashFunction>::iterator it =
+        visited.find(cur);
+    if (it == visited.end())
+    {
+      visited[cur] = false;
+      if (!cur.isClosure())
+      {
+        // visit the children from left to right, so that the terms are
+        // defined in the order in which they occur
+        for (size_t i = cur.getNumChildren(); i-- > 0;)
+        {
+          TNode cn = cur[i];
+          if (!isTrivial(cn) && d_names.find(cn) == d_names.end())
+          {
+            visit.push_back(cn);
+          }
+        }
+      }
+    }
+    else
+    {
+      if (!it->second)
+      {
+        it->second = true;
+        order.push_back(cur);
+      }
+      visit.pop_back();
+    }
+  } while (!visit.empty());
+
+  // Count the occurrences of the subterms in the printed term, parents before
+  // children. A let-bound term is printed once, in its definition, hence its
+  // children occur once per occurrence in it. The counts are capped at the
+  // threshold + 1, since they may be exponential in the size of the DAG.
+  std::unordered_map<TNode, uint32_t, TNodeHashFunction> count;
+  count[n] = 1;
+  std::vector<bool> isBound(order.size(), false);
+  for (size_t i = order.size(); i-- > 0;)
+  {
+    TNode cur = order[i];
+    uint64_t c = count[cur];
+    if (c > d_threshold)
+    {
+      isBound[i] = true;
+      c = 1;
+    }
+    if (cur.isClosure())
+    {
+      continue;
+    }
+    for (TNode cn : cur)
+    {
+      if (visited.find(cn) != visited.end())
+      {
+        uint32_t& ccount = count[cn];
+        ccount = static_cast<uint32_t>(
+            std::min<uint64_t>(ccount + c, uint64_t(d_threshold) + 1));
+      }
+    }
+  }
+  for (size_t i = 0, size = order.size(); i < size; i++)
+  {
+    if (isBound[i])
+    {
+      lets.push_back(order[i]);
+    }
+  }
+}
+
+void LetBinding::popScope()
+{
+  Assert(!d_scopes.empty());
+  for (size_t i = d_scopes.back(), size = d_bound.size(); i < size; i++)
+  {
+    d_names.erase(d_bound[i]);
+  }
+  d_bound.resize(d_scopes.back());
+  d_scopes.pop_back();
+}
+
+std::string LetBinding::makeName()
+{
+  std::string name;
+  do
+  {
+    name = d_prefix + std::to_string(d_nextIndex++);
+  } while (d_reserved.find(name) != d_reserved.end());
+  return name;
+}
+
+void LetBinding::bind(TNode n, const std::string& name)
+{
+  Assert(!d_scopes.empty());
+  Assert(d_names.find(n) == d_names.end());
+  d_names[n] = name;
+  d_bound.push_back(n);
+}
+
+bool LetBinding::getName(TNode n, std::string& name) const
+{
+  std::unordered_map<TNode, std::string, TNodeHashFunction>::const_iterator it =
+      d_names.find(n);
+  if (it == d_names.end())
+  {
+    return false;
+  }
+  name = it->second;
+  return true;
+}
+
+}  // namespace printer
+}  // namespace CVC4
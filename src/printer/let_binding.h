@@ -0,0 +1,105 @@
+/*********************                                                        */
+/*! \file let_binding.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief A let binding utility for printers
+ **
+ ** A let binding utility for printers, which decides the subterms of a term
+ ** that are printed as let bindings.
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__PRINTER__LET_BINDING_H
+#define CVC4__PRINTER__LET_BINDING_H
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "expr/node.h"
+
+namespace CVC4 {
+namespace printer {
+
+/**
+ * The let bindings of a term that is printed. A subterm is let-bound if it
+ * would occur more than threshold times in the printed term, where the
+ * occurrences below a let-bound term count once, i.e. in its definition.
+ * Variables, constants, and negations of those are never let-bound.
+ *
+ * The bindings are organized in scopes: the printer opens a scope for the
+ * top-level term and for the body of each binder it prints. The bindings of
+ * a binder body are computed when it is printed, so that they may refer to
+ * its bound variables, whereas the terms bound in an enclosing scope are
+ * printed by their names. The subterms of a term are counted in a single
+ * iterative pass, hence the bindings of a scope are computed in time linear
+ * in the size of its DAG, without rebuilding the term.
+ *
+ * The names of the bindings are the prefix followed by a number. They are
+ * unique over all scopes, and never clash with the names of the variables in
+ * the top-level term.
+ */
+class LetBinding
+{
+ public:
+  /**
+   * Construct a let binding with the given threshold and prefix.
+   *
+   * @param threshold the threshold for let bindings (must be > 0)
+   * @param prefix the prefix for the names of let bindings
+   */
+  LetBinding(uint32_t threshold, const std::string& prefix = "_let_");
+
+  /**
+   * Open a scope for printing n, and store in lets the subterms of n that are
+   * let-bound in this scope, in the order in which they are to be defined.
+   */
+  void pushScope(TNode n, std::vector<Node>& lets);
+  /** Close the last scope, and forget its bindings */
+  void popScope();
+  /**
+   * Make a fresh name for the let-bound term n. The name is not visible until
+   * bind(n, name) is called, so that the definition of n can be printed.
+   */
+  std::string makeName();
+  /** Make n visible by name in the current scope */
+  void bind(TNode n, const std::string& name);
+  /**
+   * Get the name of n if it is visible in the current scope, or return false
+   * otherwise.
+   */
+  bool getName(TNode n, std::string& name) const;
+
+ private:
+  /** Whether n is never let-bound, and its subterms are not counted */
+  static bool isTrivial(TNode n);
+  /** Reserve the names of the variables of n that start with the prefix */
+  void reserveNames(TNode n);
+
+  /** The threshold for let bindings */
+  const uint32_t d_threshold;
+  /** The prefix for the names of let bindings */
+  const std::string d_prefix;
+  /** The index of the next name */
+  uint32_t d_nextIndex;
+  /** The names of variables that start with the prefix */
+  std::unordered_set<std::string> d_reserved;
+  /** The names of the visible let-bound terms */
+  std::unordered_map<TNode, std::string, TNodeHashFunction> d_names;
+  /** The visible let-bound terms, in the order of their binding */
+  std::vector<Node> d_bound;
+  /** The size of d_bound when each of the current scopes was opened */
+  std::vector<size_t> d_scopes;
+}; /* class LetBinding */
+
+}  // namespace printer
+}  // namespace CVC4
+
+#endif /* CVC4__PRINTER__LET_BINDING_H */
@@ -20,6 +20,7 @@
 #include "options/base_options.h"
 #include "options/language.h"
 #include "printer/ast/ast_printer.h"
+#include "printer/binary/binary_printer.h"
 #include "printer/cvc/cvc_printer.h"
 #include "printer/smt2/smt2_printer.h"
 #include "printer/tptp/tptp_printer.h"
@@ -58,6 +59,9 @@ unique_ptr<Printer> Printer::makePrinter(OutputLanguage lang)
     return unique_ptr<Printer>(
         new printer::smt2::Smt2Printer(printer::smt2::smt2_6_variant));
 
+  case LANG_BINARY:
+    return unique_ptr<Printer>(new printer::binary::BinaryPrinter());
+
   case LANG_AST:
     return unique_ptr<Printer>(new printer::ast::AstPrinter());
 
@@ -24,17 +24,15 @@
 #include "api/cvc4cpp.h"
 #include "expr/dtype.h"
 #include "expr/node_manager_attributes.h"
-#include "expr/node_visitor.h"
 #include "options/bv_options.h"
 #include "options/language.h"
 #include "options/printer_options.h"
 #include "options/smt_options.h"
-#include "printer/dagification_visitor.h"
+#include "printer/let_binding.h"
 #include "smt/smt_engine.h"
 #include "smt_util/boolean_simplification.h"
 #include "theory/arrays/theory_arrays_rewriter.h"
 #include "theory/quantifiers/quantifiers_attributes.h"
-#include "theory/substitutions.h"
 #include "theory/theory_model.h"
 #include "util/smt2_quote_string.h"
 
@@ -59,36 +57,57 @@ static void toStreamRational(std::ostream& out,
 void Smt2Printer::toStream(
     std::ostream& out, TNode n, int toDepth, bool types, size_t dag) const
 {
-  if(dag != 0) {
-    DagificationVisitor dv(dag);
-    NodeVisitor<DagificationVisitor> visitor;
-    visitor.run(dv, n);
-    const theory::SubstitutionMap& lets = dv.getLets();
-    if(!lets.empty()) {
-      theory::SubstitutionMap::const_iterator i = lets.begin();
-      theory::SubstitutionMap::const_iterator i_end = lets.end();
-      for(; i != i_end; ++ i) {
-        out << "(let ((";
-        toStream(out, (*i).second, toDepth, types, TypeNode::null());
-        out << ' ';
-        toStream(out, (*i).first, toDepth, types, TypeNode::null());
-        out << ")) ";
-      }
-    }
-    Node body = dv.getDagifiedBody();
-    toStream(out, body, toDepth, types, TypeNode::null());
-    if(!lets.empty()) {
-      theory::SubstitutionMap::const_iterator i = lets.begin();
-      theory::SubstitutionMap::const_iterator i_end = lets.end();
-      for(; i != i_end; ++ i) {
-        out << ")";
-      }
-    }
-  } else {
-    toStream(out, n, toDepth, types, TypeNode::null());
+  if (dag != 0)
+  {
+    LetBinding lbind(dag);
+    toStreamWithLetify(out, n, toDepth, types, &lbind);
+  }
+  else
+  {
+    toStream(out, n, toDepth, types, TypeNode::null(), nullptr);
   }
 }
 
+void Smt2Printer::toStreamWithLetify(std::ostream& out,
+                                     TNode n,
+                                     int toDepth,
+                                     bool types,
+                                     LetBinding* lbind) const
+{
+  std::vector<Node> lets;
+  lbind->pushScope(n, lets);
+  for (const Node& l : lets)
+  {
+    std::string name = lbind->makeName();
+    out << "(let ((" << name << ' ';
+    toStream(out, l, toDepth, types, TypeNode::null(), lbind);
+    out << ")) ";
+    lbind->bind(l, name);
+  }
+  toStream(out, n, toDepth, types, TypeNode::null(), lbind);
+  for (size_t i = 0, nlets = lets.size(); i < nlets; i++)
+  {
+    out << ")";
+  }
+  lbind->popScope();
+}
+
+void Smt2Printer::toStreamBody(std::ostream& out,
+                               TNode n,
+                               int toDepth,
+                               bool types,
+                               LetBinding* lbind) const
+{
+  if (lbind == nullptr)
+  {
+    toStream(out, n, toDepth, types, TypeNode::null(), nullptr);
+    return;
+  }
+  // the body of a binder has let bindings of its own, which may refer to the
+  // bound variables
+  toStreamWithLetify(out, n, toDepth, types, lbind);
+}
+
 static bool stringifyRegexp(Node n, stringstream& ss) {
   if(n.getKind() == kind::STRING_TO_REGEXP) {
     ss << n[0].getConst<String>().toString(true);
@@ -109,7 +128,8 @@ void Smt2Printer::toStream(std::ostream& out,
                            TNode n,
                            int toDepth,
                            bool types,
-                           TypeNode force_nt) const
+                           TypeNode force_nt,
+                           LetBinding* lbind) const
 {
   // null
   if(n.getKind() == kind::NULL_EXPR) {
@@ -356,7 +376,7 @@ void Smt2Printer::toStream(std::ostream& out,
     if(n.getNumChildren() != 0) {
       for(unsigned i = 0; i < n.getNumChildren(); ++i) {
 	      out << ' ';
-	      toStream(out, n[i], toDepth, types, TypeNode::null());
+	      toStream(out, n[i], toDepth, types, TypeNode::null(), lbind);
       }
       out << ')';
     }
@@ -389,7 +409,7 @@ void Smt2Printer::toStream(std::ostream& out,
           << smtKindString(is_int ? kind::TO_INTEGER : kind::DIVISION,
                            d_variant)
           << " ";
-      toStream(out, type_asc_arg, toDepth, types, TypeNode::null());
+      toStream(out, type_asc_arg, toDepth, types, TypeNode::null(), lbind);
       if (!is_int)
       {
         out << " 1";
@@ -404,12 +424,24 @@ void Smt2Printer::toStream(std::ostream& out,
                type_asc_arg,
                toDepth < 0 ? toDepth : toDepth - 1,
                types,
-               TypeNode::null());
+               TypeNode::null(),
+               lbind);
       out << " " << force_nt << ")";
     }
     return;
   }
 
+  // let-bound term
+  if (lbind != nullptr)
+  {
+    string name;
+    if (lbind->getName(n, name))
+    {
+      out << name;
+      return;
+    }
+  }
+
   // variable
   if (n.isVar())
   {
@@ -464,7 +496,7 @@ void Smt2Printer::toStream(std::ostream& out,
     for (Node nc : n)
     {
       out << " ";
-      toStream(out, nc, toDepth, types, TypeNode::null());
+      toStream(out, nc, toDepth, types, TypeNode::null(), lbind);
     }
     out << ")";
     return;
@@ -501,11 +533,11 @@ void Smt2Printer::toStream(std::ostream& out,
         args.insert(args.begin(), head[1]);
         head = head[0];
       }
-      toStream(out, head, toDepth, types, TypeNode::null());
+      toStream(out, head, toDepth, types, TypeNode::null(), lbind);
       for (unsigned i = 0, size = args.size(); i < size; ++i)
       {
         out << " ";
-        toStream(out, args[i], toDepth, types, TypeNode::null());
+        toStream(out, args[i], toDepth, types, TypeNode::null(), lbind);
       }
       out << ")";
     }
@@ -514,7 +546,7 @@ void Smt2Printer::toStream(std::ostream& out,
   case kind::LAMBDA: out << smtKindString(k, d_variant) << " "; break;
   case kind::MATCH:
     out << smtKindString(k, d_variant) << " ";
-    toStream(out, n[0], toDepth, types, TypeNode::null());
+    toStream(out, n[0], toDepth, types, TypeNode::null(), lbind);
     out << " (";
     for (size_t i = 1, nchild = n.getNumChildren(); i < nchild; i++)
     {
@@ -522,15 +554,15 @@ void Smt2Printer::toStream(std::ostream& out,
       {
         out << " ";
       }
-      toStream(out, n[i], toDepth, types, TypeNode::null());
+      toStream(out, n[i], toDepth, types, TypeNode::null(), lbind);
     }
     out << "))";
     return;
   case kind::MATCH_BIND_CASE:
     // ignore the binder
-    toStream(out, n[1], toDepth, types, TypeNode::null());
+    toStream(out, n[1], toDepth, types, TypeNode::null(), lbind);
     out << " ";
-    toStream(out, n[2], toDepth, types, TypeNode::null());
+    toStream(out, n[2], toDepth, types, TypeNode::null(), lbind);
     out << ")";
     return;
   case kind::MATCH_CASE:
@@ -600,6 +632,9 @@ void Smt2Printer::toStream(std::ostream& out,
     out << smtKindString(k, d_variant) << " ";
     break;
   }
+  case kind::STRING_UPDATE:
+    out << (n.getType().isString() ? "str.update " : "seq.update ");
+    break;
   case kind::STRING_LENGTH:
   case kind::STRING_SUBSTR:
   case kind::STRING_CHARAT:
@@ -612,6 +647,7 @@ void Smt2Printer::toStream(std::ostream& out,
   case kind::STRING_TOLOWER:
   case kind::STRING_TOUPPER:
   case kind::STRING_REV:
+  case kind::SEQ_NTH:
   case kind::STRING_PREFIX:
   case kind::STRING_SUFFIX:
   case kind::STRING_LEQ:
@@ -802,17 +838,17 @@ void Smt2Printer::toStream(std::ostream& out,
     {
       out << "exists ";
     }
-    for (unsigned i = 0; i < 2; i++)
+    toStream(out, n[0], toDepth, types, TypeNode::null(), lbind);
+    out << " ";
+    if (n.getNumChildren() == 3)
     {
-      out << n[i] << " ";
-      if (i == 0 && n.getNumChildren() == 3)
-      {
-        out << "(! ";
-      }
+      out << "(! ";
     }
+    toStreamBody(out, n[1], toDepth, types, lbind);
+    out << " ";
     if (n.getNumChildren() == 3)
     {
-      out << n[2];
+      toStream(out, n[2], toDepth, types, TypeNode::null(), lbind);
       out << ")";
     }
     out << ")";
@@ -825,7 +861,12 @@ void Smt2Printer::toStream(std::ostream& out,
     for (TNode::iterator i = n.begin(), iend = n.end(); i != iend;)
     {
       out << '(';
-      toStream(out, *i, toDepth < 0 ? toDepth : toDepth - 1, types, 0);
+      toStream(out,
+               *i,
+               toDepth < 0 ? toDepth : toDepth - 1,
+               types,
+               TypeNode::null(),
+               lbind);
       out << ' ';
       out << (*i).getType();
       out << ')';
@@ -845,11 +886,13 @@ void Smt2Printer::toStream(std::ostream& out,
     {
       if (nc.getKind() == kind::INST_PATTERN)
       {
-        out << ":pattern " << nc;
+        out << ":pattern ";
+        toStream(out, nc, toDepth, types, TypeNode::null(), lbind);
       }
       else if (nc.getKind() == kind::INST_NO_PATTERN)
       {
-        out << ":no-pattern " << nc[0];
+        out << ":no-pattern ";
+        toStream(out, nc[0], toDepth, types, TypeNode::null(), lbind);
       }
     }
     return;
@@ -871,14 +914,14 @@ void Smt2Printer::toStream(std::ostream& out,
         if (isVariant_2_6(d_variant))
         {
           out << "(_ is ";
-          toStream(out, Node::fromExpr(dt[cindex].getConstructor()), toDepth < 0 ? toDepth : toDepth - 1, types, TypeNode::null());
+          toStream(out, Node::fromExpr(dt[cindex].getConstructor()), toDepth < 0 ? toDepth : toDepth - 1, types, TypeNode::null(), lbind);
           out << ")";
         }else{
           out << "is-";
-          toStream(out, Node::fromExpr(dt[cindex].getConstructor()), toDepth < 0 ? toDepth : toDepth - 1, types, TypeNode::null());
+          toStream(out, Node::fromExpr(dt[cindex].getConstructor()), toDepth < 0 ? toDepth : toDepth - 1, types, TypeNode::null(), lbind);
         }
       }else{
-        toStream(out, n.getOperator(), toDepth < 0 ? toDepth : toDepth - 1, types, TypeNode::null());
+        toStream(out, n.getOperator(), toDepth < 0 ? toDepth : toDepth - 1, types, TypeNode::null(), lbind);
       }
     } else {
       out << "(...)";
@@ -952,10 +995,15 @@ void Smt2Printer::toStream(std::ostream& out,
     if(toDepth != 0) {
       Node cn = n[i];
       std::map< unsigned, TypeNode >::iterator itfc = force_child_type.find( i );
-      if( itfc!=force_child_type.end() ){
-        toStream(out, cn, toDepth < 0 ? toDepth : toDepth - c, types, itfc->second);
+      if (i == 1 && n.isClosure())
+      {
+        toStreamBody(
+            out, cn, toDepth < 0 ? toDepth : toDepth - c, types, lbind);
+      }
+      else if( itfc!=force_child_type.end() ){
+        toStream(out, cn, toDepth < 0 ? toDepth : toDepth - c, types, itfc->second, lbind);
       }else{
-        toStream(out, cn, toDepth < 0 ? toDepth : toDepth - c, types, TypeNode::null());
+        toStream(out, cn, toDepth < 0 ? toDepth : toDepth - c, types, TypeNode::null(), lbind);
       }
     } else {
       out << "(...)";
@@ -1175,6 +1223,8 @@ static string smtKindString(Kind k, Variant v)
   case kind::STRING_TOLOWER: return "str.tolower";
   case kind::STRING_TOUPPER: return "str.toupper";
   case kind::STRING_REV: return "str.rev";
+  case kind::STRING_UPDATE: return "seq.update";
+  case kind::SEQ_NTH: return "seq.nth";
   case kind::STRING_PREFIX: return "str.prefixof" ;
   case kind::STRING_SUFFIX: return "str.suffixof" ;
   case kind::STRING_LEQ: return "str.<=";
@@ -1324,21 +1374,22 @@ void Smt2Printer::toStream(std::ostream& out, const Model& m) const
   m.getComments( c );
   std::string ln;
   while( std::getline( c, ln ) ){
-    out << "; " << ln << std::endl;
+    out << "; " << ln << '\n';
   }
   //print the model
-  out << "(model" << endl;
+  out << "(model\n";
   // don't need to print approximations since they are built into choice
   // functions in the values of variables.
   this->Printer::toStream(out, m);
+  // the lines of the model are flushed at once
   out << ")" << endl;
   //print the heap model, if it exists
   Expr h, neq;
   if( m.getHeapModel( h, neq ) ){
     // description of the heap+what nil is equal to fully describes model
-    out << "(heap" << endl;
-    out << h << endl;
-    out << neq << endl;
+    out << "(heap\n";
+    out << h << '\n';
+    out << neq << '\n';
     out << ")" << std::endl;
   }
 }
@@ -1357,7 +1408,7 @@ void Smt2Printer::toStream(std::ostream& out,
     Type t = (*dtc).getType();
     if (!t.isSort())
     {
-      out << (*dtc) << endl;
+      out << (*dtc) << '\n';
     }
     else
     {
@@ -1376,25 +1427,24 @@ void Smt2Printer::toStream(std::ostream& out,
         {
           out << "(" << type_ref << ")";
         }
-        out << ")))" << endl;
+        out << ")))\n";
       }
       else
       {
         // print the cardinality
-        out << "; cardinality of " << t << " is " << elements.size() << endl;
-        out << (*dtc) << endl;
+        out << "; cardinality of " << t << " is " << elements.size() << '\n';
+        out << (*dtc) << '\n';
         // print the representatives
         for (const Expr& type_ref : elements)
         {
           Node trn = Node::fromExpr(type_ref);
           if (trn.isVar())
           {
-            out << "(declare-fun " << quoteSymbol(trn) << " () " << t << ")"
-                << endl;
+            out << "(declare-fun " << quoteSymbol(trn) << " () " << t << ")\n";
           }
           else
           {
-            out << "; rep: " << trn << endl;
+            out << "; rep: " << trn << '\n';
           }
         }
       }
@@ -1424,8 +1474,8 @@ void Smt2Printer::toStream(std::ostream& out,
       out << "(define-fun " << n << " " << val[0] << " "
           << n.getType().getRangeType() << " ";
       // call toStream and force its type to be proper
-      toStream(out, val[1], -1, false, n.getType().getRangeType());
-      out << ")" << endl;
+      toStream(out, val[1], -1, false, n.getType().getRangeType(), nullptr);
+      out << ")\n";
     }
     else
     {
@@ -1443,8 +1493,8 @@ void Smt2Printer::toStream(std::ostream& out,
       }
       out << "(define-fun " << n << " () " << n.getType() << " ";
       // call toStream and force its type to be proper
-      toStream(out, val, -1, false, n.getType());
-      out << ")" << endl;
+      toStream(out, val, -1, false, n.getType(), nullptr);
+      out << ")\n";
     }
   }
   else if (const DatatypeDeclarationCommand* datatype_declaration_command =
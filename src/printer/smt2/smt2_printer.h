@@ -25,6 +25,9 @@
 
 namespace CVC4 {
 namespace printer {
+
+class LetBinding;
+
 namespace smt2 {
 
 enum Variant
@@ -64,8 +67,32 @@ class Smt2Printer : public CVC4::Printer {
   void toStreamSygus(std::ostream& out, TNode n) const override;
 
  private:
-  void toStream(
-      std::ostream& out, TNode n, int toDepth, bool types, TypeNode nt) const;
+  /**
+   * Write n to out, where n must be printed with type nt if it is non-null.
+   * The subterms of n that are bound in lbind are printed by their names, if
+   * lbind is non-null.
+   */
+  void toStream(std::ostream& out,
+                TNode n,
+                int toDepth,
+                bool types,
+                TypeNode nt,
+                LetBinding* lbind) const;
+  /**
+   * Write n to out in a new scope of lbind, i.e. preceded by the let bindings
+   * of its subterms.
+   */
+  void toStreamWithLetify(std::ostream& out,
+                          TNode n,
+                          int toDepth,
+                          bool types,
+                          LetBinding* lbind) const;
+  /** Write the body n of a binder to out, in a new scope of lbind if any */
+  void toStreamBody(std::ostream& out,
+                    TNode n,
+                    int toDepth,
+                    bool types,
+                    LetBinding* lbind) const;
   void toStream(std::ostream& out,
                 const Model& m,
                 const Command* c) const override;
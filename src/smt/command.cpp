@@ -1262,6 +1262,7 @@ const std::vector<Expr>& DefineFunctionCommand::getFormals() const
 }
 
 Expr DefineFunctionCommand::getFormula() const { return d_formula; }
+bool DefineFunctionCommand::isGlobal() const { return d_global; }
 void DefineFunctionCommand::invoke(SmtEngine* smtEngine)
 {
   try
@@ -2716,6 +2717,9 @@ SetExpressionNameCommand::SetExpressionNameCommand(Expr expr, std::string name)
 {
 }
 
+Expr SetExpressionNameCommand::getExpr() const { return d_expr; }
+std::string SetExpressionNameCommand::getName() const { return d_name; }
+
 void SetExpressionNameCommand::invoke(SmtEngine* smtEngine)
 {
   smtEngine->setExpressionName(d_expr, d_name);
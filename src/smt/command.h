@@ -458,6 +458,7 @@ class CVC4_PUBLIC DefineFunctionCommand : public DeclarationDefinitionCommand
   Expr getFunction() const;
   const std::vector<Expr>& getFormals() const;
   Expr getFormula() const;
+  bool isGlobal() const;
 
   void invoke(SmtEngine* smtEngine) override;
   Command* exportTo(ExprManager* exprManager,
@@ -1289,6 +1290,9 @@ class CVC4_PUBLIC SetExpressionNameCommand : public Command
  public:
   SetExpressionNameCommand(Expr expr, std::string name);
 
+  Expr getExpr() const;
+  std::string getName() const;
+
   void invoke(SmtEngine* smtEngine) override;
   Command* exportTo(ExprManager* exprManager,
                     ExprManagerMapCollection& variableMap) override;
@@ -25,6 +25,7 @@
 #include "options/quantifiers_options.h"
 #include "options/sep_options.h"
 #include "options/smt_options.h"
+#include "options/strings_options.h"
 #include "options/uf_options.h"
 #include "preprocessing/assertion_pipeline.h"
 #include "preprocessing/preprocessing_pass_registry.h"
@@ -217,6 +218,14 @@ bool ProcessAssertions::apply(AssertionPipeline& assertions)
   // Assertions MUST BE guaranteed to be rewritten by this point
   d_passes["rewrite"]->apply(&assertions);
 
+  // Since this pass may replace the assertions by false, it is not applied
+  // if we are doing unsat core computation
+  if (options::stringLenAbs() && !options::unsatCores()
+      && d_smt.d_logic.isTheoryEnabled(THEORY_STRINGS))
+  {
+    d_passes["strings-len-abs"]->apply(&assertions);
+  }
+
   // Lift bit-vectors of size 1 to bool
   if (options::bitvectorToBool())
   {
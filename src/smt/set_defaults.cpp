@@ -203,6 +203,19 @@ void setDefaults(SmtEngine& smte, LogicInfo& logic)
     options::ackermann.set(false);
   }
 
+  // lazy model building relies on the default model builder, which is not
+  // used when quantified formulas are present
+  if (options::lazyModelBuild() && (logic.isQuantified() || options::ufHo()))
+  {
+    if (options::lazyModelBuild.wasSetByUser())
+    {
+      Notice() << "SmtEngine: turning off lazy model building to support "
+                  "quantified formulas and higher-order"
+               << std::endl;
+    }
+    options::lazyModelBuild.set(false);
+  }
+
   if (options::ackermann())
   {
     if (options::incrementalSolving())
@@ -27,6 +27,7 @@
 #include "theory/quantifiers/term_util.h"
 #include "theory/quantifiers_engine.h"
 #include "theory/theory_engine.h"
+#include "theory/uf/equality_engine.h"
 
 using namespace CVC4::kind;
 using namespace std;
@@ -1842,8 +1843,20 @@ QuantConflictFind::QuantConflictFind(QuantifiersEngine* qe, context::Context* c)
       d_conflict(c, false),
       d_true(NodeManager::currentNM()->mkConst<bool>(true)),
       d_false(NodeManager::currentNM()->mkConst<bool>(false)),
-      d_effort(EFFORT_INVALID)
+      d_effort(EFFORT_INVALID),
+      d_stamp(0),
+      d_checkStamp(0),
+      d_typeStamp(c),
+      d_opStamp(c),
+      d_qSat(c)
 {
+  // Delta matching relies on all information used by the matching procedure
+  // being reflected in the master equality engine, which is not the case if
+  // the term database filters terms or if we use theory-specific entailment
+  // checks.
+  d_deltaMatch = options::qcfDeltaMatch()
+                 && options::termDbMode() == options::TermDbMode::ALL
+                 && !options::qcfTConstraint();
 }
 
 //-------------------------------------------------- registration
@@ -1860,6 +1873,10 @@ void QuantConflictFind::registerQuantifier( Node q ) {
     //make QcfNode structure
     Trace("qcf-qregister") << "- Get relevant equality/disequality pairs, calculate flattening..." << std::endl;
     d_qinfo[q].initialize( this, q, q[1] );
+    if (d_deltaMatch)
+    {
+      computeRelevanceKeys(q);
+    }
 
     //debug print
     if( Trace.isOn("qcf-qregister") ){
@@ -1896,6 +1913,210 @@ bool QuantConflictFind::areMatchDisequal( TNode n1, TNode n2 ) {
   //}
 }
 
+//-------------------------------------------------- delta matching
+
+void QuantConflictFind::computeRelevanceKeys(Node q)
+{
+  TermDb* tdb = getTermDatabase();
+  std::unordered_set<TypeNode, TypeNodeHashFunction> types;
+  std::unordered_set<Node, NodeHashFunction> ops;
+  // visited sets for nodes in formula and term positions respectively
+  std::unordered_set<TNode, TNodeHashFunction> visited[2];
+  // stack of (node, is in term position)
+  std::vector<std::pair<TNode, bool> > visit;
+  for (const Node& v : q[0])
+  {
+    visit.push_back(std::pair<TNode, bool>(v, true));
+  }
+  visit.push_back(std::pair<TNode, bool>(q[1], false));
+  do
+  {
+    TNode cur = visit.back().first;
+    bool termPos = visit.back().second;
+    visit.pop_back();
+    if (!visited[termPos ? 1 : 0].insert(cur).second)
+    {
+      continue;
+    }
+    TypeNode tn = cur.getType();
+    bool childTermPos = true;
+    if (!tn.isBoolean())
+    {
+      types.insert(getRelevanceKeyType(tn));
+    }
+    else if (termPos || cur.getKind() == BOUND_VARIABLE)
+    {
+      types.insert(tn);
+    }
+    else if (TermUtil::isBoolConnectiveTerm(cur))
+    {
+      childTermPos = false;
+    }
+    else if (!cur.isConst())
+    {
+      Node op = tdb->getMatchOperator(cur);
+      if (!op.isNull())
+      {
+        ops.insert(op);
+      }
+      else if (cur.getKind() != EQUAL)
+      {
+        // not indexed by the term database, any change to Boolean terms
+        // may affect whether it is entailed
+        types.insert(tn);
+      }
+    }
+    if (cur.getKind() == FORALL)
+    {
+      // visit the variables and body, but not the instantiation patterns
+      for (const Node& v : cur[0])
+      {
+        visit.push_back(std::pair<TNode, bool>(v, true));
+      }
+      visit.push_back(std::pair<TNode, bool>(cur[1], false));
+      continue;
+    }
+    for (const Node& cn : cur)
+    {
+      visit.push_back(std::pair<TNode, bool>(cn, childTermPos));
+    }
+  } while (!visit.empty());
+  d_qKeyTypes[q].insert(d_qKeyTypes[q].end(), types.begin(), types.end());
+  d_qKeyOps[q].insert(d_qKeyOps[q].end(), ops.begin(), ops.end());
+  Trace("qcf-delta") << "Relevance keys for " << q << " : " << types.size()
+                     << " types, " << ops.size() << " operators" << std::endl;
+}
+
+TypeNode QuantConflictFind::getRelevanceKeyType(TypeNode tn) const
+{
+  // integer and real terms may be equal, hence they share a key
+  return tn.isReal() ? NodeManager::currentNM()->realType() : tn;
+}
+
+void QuantConflictFind::touch(TNode t)
+{
+  TypeNode tn = t.getType();
+  if (!tn.isBoolean())
+  {
+    d_typeStamp[getRelevanceKeyType(tn)] = ++d_stamp;
+    return;
+  }
+  if (t.isConst())
+  {
+    return;
+  }
+  Node op = getTermDatabase()->getMatchOperator(t);
+  if (!op.isNull())
+  {
+    d_opStamp[op] = ++d_stamp;
+  }
+  else if (t.getKind() == EQUAL)
+  {
+    // the change is also reflected in the classes of its arguments
+    touch(t[0]);
+    touch(t[1]);
+    return;
+  }
+  // Boolean terms in term positions may be affected by any change
+  d_typeStamp[tn] = ++d_stamp;
+}
+
+void QuantConflictFind::touchEqc(TNode r)
+{
+  if (!r.getType().isBoolean())
+  {
+    // all terms in the equivalence class have the same relevance key
+    touch(r);
+    return;
+  }
+  eq::EqualityEngine* ee = d_quantEngine->getMasterEqualityEngine();
+  eq::EqClassIterator eqc_i(r, ee);
+  while (!eqc_i.isFinished())
+  {
+    touch(*eqc_i);
+    ++eqc_i;
+  }
+}
+
+void QuantConflictFind::eqNotifyNewClass(TNode t)
+{
+  if (d_deltaMatch)
+  {
+    touch(t);
+  }
+}
+
+void QuantConflictFind::eqNotifyPreMerge(TNode t1, TNode t2)
+{
+  if (!d_deltaMatch)
+  {
+    return;
+  }
+  // If one side is a Boolean constant, only the terms of the other side
+  // change their entailed value. This avoids traversing the (typically large)
+  // classes of true and false.
+  if (!t1.isConst() || !t1.getType().isBoolean())
+  {
+    touchEqc(t1);
+  }
+  if (!t2.isConst() || !t2.getType().isBoolean())
+  {
+    touchEqc(t2);
+  }
+}
+
+void QuantConflictFind::eqNotifyDisequal(TNode t1, TNode t2)
+{
+  if (d_deltaMatch)
+  {
+    touchEqc(t1);
+    touchEqc(t2);
+  }
+}
+
+bool QuantConflictFind::isSaturated(Node q) const
+{
+  NodeSatMap::const_iterator it = d_qSat.find(q);
+  if (it == d_qSat.end() || (*it).second.second <= d_effort)
+  {
+    return false;
+  }
+  uint64_t sstamp = (*it).second.first;
+  std::map<Node, std::vector<TypeNode> >::const_iterator itt =
+      d_qKeyTypes.find(q);
+  if (itt != d_qKeyTypes.end())
+  {
+    for (const TypeNode& tn : itt->second)
+    {
+      TypeStampMap::const_iterator its = d_typeStamp.find(tn);
+      if (its != d_typeStamp.end() && (*its).second > sstamp)
+      {
+        return false;
+      }
+    }
+  }
+  std::map<Node, std::vector<Node> >::const_iterator ito = d_qKeyOps.find(q);
+  if (ito != d_qKeyOps.end())
+  {
+    for (const Node& op : ito->second)
+    {
+      NodeStampMap::const_iterator its = d_opStamp.find(op);
+      if (its != d_opStamp.end() && (*its).second > sstamp)
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void QuantConflictFind::setSaturated(Node q)
+{
+  // q was either checked or saturated at all efforts before the current one
+  // in this round, hence we may use the current stamp for all of them.
+  d_qSat[q] = std::pair<uint64_t, unsigned>(d_checkStamp, d_effort + 1);
+}
+
 //-------------------------------------------------- check function
 
 bool QuantConflictFind::needsCheck( Theory::Effort level ) {
@@ -1998,6 +2219,7 @@ void QuantConflictFind::check(Theory::Effort level, QEffort quant_e)
   // reset the round-specific information
   d_irr_func.clear();
   d_irr_quant.clear();
+  d_checkStamp = d_stamp;
 
   if (Trace.isOn("qcf-debug"))
   {
@@ -2023,12 +2245,24 @@ void QuantConflictFind::check(Theory::Effort level, QEffort quant_e)
           && d_irr_quant.find(q) == d_irr_quant.end()
           && fm->isQuantifierActive(q))
       {
+        if (d_deltaMatch && isSaturated(q))
+        {
+          Trace("qcf-delta") << "Reuse saturation of " << q << std::endl;
+          ++(d_statistics.d_quant_checks_reused);
+          continue;
+        }
+        ++(d_statistics.d_quant_checks);
         // check this quantified formula
-        checkQuantifiedFormula(q, isConflict, addedLemmas);
+        unsigned prevAddedLemmas = addedLemmas;
+        bool exhausted = checkQuantifiedFormula(q, isConflict, addedLemmas);
         if (d_conflict || d_quantEngine->inConflict())
         {
           break;
         }
+        if (d_deltaMatch && exhausted && addedLemmas == prevAddedLemmas)
+        {
+          setSaturated(q);
+        }
       }
     }
     // We are done if we added a lemma, or discovered a conflict in another
@@ -2068,7 +2302,7 @@ void QuantConflictFind::check(Theory::Effort level, QEffort quant_e)
   Trace("qcf-check2") << "QCF : finished check : " << level << std::endl;
 }
 
-void QuantConflictFind::checkQuantifiedFormula(Node q,
+bool QuantConflictFind::checkQuantifiedFormula(Node q,
                                                bool& isConflict,
                                                unsigned& addedLemmas)
 {
@@ -2077,7 +2311,7 @@ void QuantConflictFind::checkQuantifiedFormula(Node q,
   if (!qi->matchGeneratorIsValid())
   {
     // quantified formula is not properly set up for matching
-    return;
+    return true;
   }
   if (Trace.isOn("qcf-check"))
   {
@@ -2091,7 +2325,7 @@ void QuantConflictFind::checkQuantifiedFormula(Node q,
   {
     // it is typically the case that another conflict (e.g. in the term
     // database) was discovered if we fail here.
-    return;
+    return false;
   }
   // try to make a matches making the body false or propagating
   Trace("qcf-check-debug") << "Get next match..." << std::endl;
@@ -2104,7 +2338,7 @@ void QuantConflictFind::checkQuantifiedFormula(Node q,
       Trace("qcf-check") << "probably related to disequal congruent terms in "
                             "master equality engine"
                          << std::endl;
-      return;
+      return false;
     }
     if (Trace.isOn("qcf-inst"))
     {
@@ -2158,7 +2392,7 @@ void QuantConflictFind::checkQuantifiedFormula(Node q,
         // This should only happen if the algorithm generates the same
         // propagating instance twice this round. In this case, return
         // to avoid exponential behavior.
-        return;
+        return false;
       }
       Trace("qcf-check") << "   ... Added instantiation" << std::endl;
       if (Trace.isOn("qcf-inst"))
@@ -2185,7 +2419,7 @@ void QuantConflictFind::checkQuantifiedFormula(Node q,
         {
           d_conflict.set(true);
         }
-        return;
+        return false;
       }
       else if (d_effort == EFFORT_PROP_EQ)
       {
@@ -2198,6 +2432,7 @@ void QuantConflictFind::checkQuantifiedFormula(Node q,
     d_tempCache.clear();
   }
   Trace("qcf-check") << "Done, conflict = " << d_conflict << std::endl;
+  return true;
 }
 
 //-------------------------------------------------- debugging
@@ -2251,15 +2486,21 @@ void QuantConflictFind::debugPrintQuantBody( const char * c, Node q, Node n, boo
 
 QuantConflictFind::Statistics::Statistics():
   d_inst_rounds("QuantConflictFind::Inst_Rounds", 0),
-  d_entailment_checks("QuantConflictFind::Entailment_Checks",0)
+  d_entailment_checks("QuantConflictFind::Entailment_Checks",0),
+  d_quant_checks("QuantConflictFind::Quant_Checks", 0),
+  d_quant_checks_reused("QuantConflictFind::Quant_Checks_Reused", 0)
 {
   smtStatisticsRegistry()->registerStat(&d_inst_rounds);
   smtStatisticsRegistry()->registerStat(&d_entailment_checks);
+  smtStatisticsRegistry()->registerStat(&d_quant_checks);
+  smtStatisticsRegistry()->registerStat(&d_quant_checks_reused);
 }
 
 QuantConflictFind::Statistics::~Statistics(){
   smtStatisticsRegistry()->unregisterStat(&d_inst_rounds);
   smtStatisticsRegistry()->unregisterStat(&d_entailment_checks);
+  smtStatisticsRegistry()->unregisterStat(&d_quant_checks);
+  smtStatisticsRegistry()->unregisterStat(&d_quant_checks_reused);
 }
 
 TNode QuantConflictFind::getZero( Kind k ) {
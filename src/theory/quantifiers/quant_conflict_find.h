@@ -189,6 +189,13 @@ class QuantConflictFind : public QuantifiersModule
   friend class MatchGen;
   friend class QuantInfo;
   typedef context::CDHashMap<Node, bool, NodeHashFunction> NodeBoolMap;
+  typedef context::CDHashMap<Node, uint64_t, NodeHashFunction> NodeStampMap;
+  typedef context::CDHashMap<TypeNode, uint64_t, TypeNodeHashFunction>
+      TypeStampMap;
+  typedef context::
+      CDHashMap<Node, std::pair<uint64_t, unsigned>, NodeHashFunction>
+          NodeSatMap;
+
 private:
   context::CDO< bool > d_conflict;
   std::map< Kind, Node > d_zero;
@@ -236,6 +243,16 @@ public:
   /** register quantifier */
   void registerQuantifier(Node q) override;
 
+  //------------------------------ delta matching
+  /** notification when a new class is created in the master equality engine */
+  void eqNotifyNewClass(TNode t);
+  /** notification before t1 and t2 are merged in the master equality engine */
+  void eqNotifyPreMerge(TNode t1, TNode t2);
+  /** notification when t1 and t2 become disequal in the master equality engine
+   */
+  void eqNotifyDisequal(TNode t1, TNode t2);
+  //------------------------------ end delta matching
+
  public:
   /** needs check */
   bool needsCheck(Theory::Effort level) override;
@@ -261,8 +278,56 @@ public:
    * in which we continuing adding all conflicts.
    * addedLemmas: tracks the total number of lemmas added, and is incremented by
    * this method when applicable.
+   *
+   * This method returns true if all matches for q were exhausted.
+   */
+  bool checkQuantifiedFormula(Node q, bool& isConflict, unsigned& addedLemmas);
+
+  //------------------------------ delta matching
+  /**
+   * The following implements --qcf-delta-match. A quantified formula q whose
+   * check at some effort level exhausted all matches without producing an
+   * instance is marked as saturated at that effort. Its saturation remains
+   * valid until the master equality engine modifies an equivalence class that
+   * q could match against, which we track by "relevance keys": the
+   * (non-Boolean) types of subterms of q, the match operators of the Boolean
+   * atoms of q and, if q has Boolean subterms in term positions or atoms that
+   * are not indexed by the term database, the Boolean type.
+   *
+   * All bookkeeping is SAT-context dependent, so that backtracking restores
+   * both the stamps of the relevance keys and the saturation marks.
+   */
+  /** is the delta matching optimization enabled? */
+  bool d_deltaMatch;
+  /** counter incremented for each modification of the equality engine */
+  uint64_t d_stamp;
+  /** the value of d_stamp at the beginning of the current check */
+  uint64_t d_checkStamp;
+  /** the stamp of the last modification of each relevant type */
+  TypeStampMap d_typeStamp;
+  /** the stamp of the last modification of each relevant match operator */
+  NodeStampMap d_opStamp;
+  /**
+   * Maps quantified formulas to a pair (s, n), indicating q was saturated for
+   * all efforts < n in the state with stamp s.
    */
-  void checkQuantifiedFormula(Node q, bool& isConflict, unsigned& addedLemmas);
+  NodeSatMap d_qSat;
+  /** the relevance keys for each registered quantified formula */
+  std::map<Node, std::vector<TypeNode> > d_qKeyTypes;
+  std::map<Node, std::vector<Node> > d_qKeyOps;
+  /** compute the relevance keys of quantified formula q */
+  void computeRelevanceKeys(Node q);
+  /** get the key we use for type tn */
+  TypeNode getRelevanceKeyType(TypeNode tn) const;
+  /** mark the relevance keys of t as modified */
+  void touch(TNode t);
+  /** mark the relevance keys of all terms in the equivalence class of r */
+  void touchEqc(TNode r);
+  /** is q saturated at the current effort? */
+  bool isSaturated(Node q) const;
+  /** mark q as saturated at the current effort */
+  void setSaturated(Node q);
+  //------------------------------ end delta matching
 
  private:
   void debugPrint( const char * c );
@@ -277,6 +342,10 @@ public:
   public:
     IntStat d_inst_rounds;
     IntStat d_entailment_checks;
+    /** number of quantified formulas checked */
+    IntStat d_quant_checks;
+    /** number of quantified formula checks skipped due to delta matching */
+    IntStat d_quant_checks_reused;
     Statistics();
     ~Statistics();
   };
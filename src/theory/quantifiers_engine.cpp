@@ -1002,6 +1002,26 @@ void QuantifiersEngine::addTermToDatabase( Node n, bool withinQuant, bool within
 
 void QuantifiersEngine::eqNotifyNewClass(TNode t) {
   addTermToDatabase( t );
+  if (d_private->d_qcf != nullptr)
+  {
+    d_private->d_qcf->eqNotifyNewClass(t);
+  }
+}
+
+void QuantifiersEngine::eqNotifyPreMerge(TNode t1, TNode t2)
+{
+  if (d_private->d_qcf != nullptr)
+  {
+    d_private->d_qcf->eqNotifyPreMerge(t1, t2);
+  }
+}
+
+void QuantifiersEngine::eqNotifyDisequal(TNode t1, TNode t2)
+{
+  if (d_private->d_qcf != nullptr)
+  {
+    d_private->d_qcf->eqNotifyDisequal(t1, t2);
+  }
 }
 
 bool QuantifiersEngine::addLemma( Node lem, bool doCache, bool doRewrite ){
@@ -0,0 +1,236 @@
+/*********************                                                        */
+/*! \file array_solver.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of the array-style solver for seq.nth and
+ ** seq.update
+ **/
+
+#include "theory/strings/array_solver.h"
+
+#include "expr/sequence.h"
+#include "theory/rewriter.h"
+
+using namespace CVC4::context;
+using namespace CVC4::kind;
+
+namespace CVC4 {
+namespace theory {
+namespace strings {
+
+const unsigned ArraySolver::s_maxDepth = 2;
+
+ArraySolver::ArraySolver(context::UserContext* u,
+                         SolverState& s,
+                         InferenceManager& im,
+                         TermRegistry& tr)
+    : d_state(s), d_im(im), d_termReg(tr), d_processed(u), d_depth(u)
+{
+}
+
+ArraySolver::~ArraySolver() {}
+
+void ArraySolver::checkArray()
+{
+  // the reads, grouped by the representative of the sequence they read
+  std::map<Node, std::vector<Node> > reads;
+  std::vector<Node> updates;
+  const context::CDList<TNode>& fterms = d_termReg.getFunctionTerms();
+  for (const TNode& t : fterms)
+  {
+    Kind k = t.getKind();
+    if (k == SEQ_NTH)
+    {
+      reads[d_state.getRepresentative(t[0])].push_back(t);
+    }
+    else if (k == STRING_UPDATE)
+    {
+      updates.push_back(t);
+    }
+  }
+  if (reads.empty())
+  {
+    return;
+  }
+  Trace("strings-array") << "ArraySolver::checkArray: " << reads.size()
+                         << " sequences read, " << updates.size()
+                         << " updates" << std::endl;
+  eq::EqualityEngine* ee = d_state.getEqualityEngine();
+  // read over write
+  for (const std::pair<const Node, std::vector<Node> >& rp : reads)
+  {
+    std::vector<Node> arrs;
+    if (ee->hasTerm(rp.first))
+    {
+      eq::EqClassIterator eqc_i = eq::EqClassIterator(rp.first, ee);
+      while (!eqc_i.isFinished())
+      {
+        Node n = *eqc_i;
+        Kind k = n.getKind();
+        if (k == STRING_UPDATE || k == STRING_CONCAT || k == SEQ_UNIT
+            || n.isConst())
+        {
+          arrs.push_back(n);
+        }
+        ++eqc_i;
+      }
+    }
+    for (const Node& r : rp.second)
+    {
+      for (const Node& u : arrs)
+      {
+        sendReadLemma(u, r, getDepth(r));
+        if (d_state.isInConflict())
+        {
+          return;
+        }
+      }
+    }
+  }
+  // write over read
+  for (const Node& u : updates)
+  {
+    std::map<Node, std::vector<Node> >::iterator it =
+        reads.find(d_state.getRepresentative(u[0]));
+    if (it == reads.end())
+    {
+      continue;
+    }
+    for (const Node& r : it->second)
+    {
+      Node ru = NodeManager::currentNM()->mkNode(SEQ_NTH, u, r[1]);
+      setDepth(ru, getDepth(r));
+      sendReadLemma(u, ru, getDepth(r));
+      if (d_state.isInConflict())
+      {
+        return;
+      }
+    }
+  }
+}
+
+void ArraySolver::sendReadLemma(Node u, Node r, unsigned depth)
+{
+  std::pair<Node, Node> ru(r, u);
+  if (d_processed.find(ru) != d_processed.end())
+  {
+    return;
+  }
+  d_processed.insert(ru);
+  NodeManager* nm = NodeManager::currentNM();
+  Node j = r[1];
+  Node zero = nm->mkConst(Rational(0));
+  std::vector<Node> conj;
+  Inference infer;
+  Kind k = u.getKind();
+  if (k == STRING_UPDATE)
+  {
+    infer = Inference::ARRAY_NTH_UPDATE;
+    Node s = u[0];
+    Node i = u[1];
+    Node t = u[2];
+    Node ls = nm->mkNode(STRING_LENGTH, s);
+    Node inBounds =
+        nm->mkNode(AND, nm->mkNode(GEQ, j, zero), nm->mkNode(LT, j, ls));
+    std::vector<Node> wconds;
+    wconds.push_back(nm->mkNode(GEQ, i, zero));
+    wconds.push_back(nm->mkNode(LT, i, ls));
+    wconds.push_back(nm->mkNode(LEQ, i, j));
+    wconds.push_back(
+        nm->mkNode(LT, j, nm->mkNode(PLUS, i, nm->mkNode(STRING_LENGTH, t))));
+    // j is in the range written by the update
+    Node written = nm->mkNode(AND, wconds);
+    // nth( u, j ) = nth( s, j ) if j is in bounds but was not written
+    Node rs = nm->mkNode(SEQ_NTH, s, j);
+    setDepth(rs, depth);
+    conj.push_back(nm->mkNode(
+        IMPLIES, nm->mkNode(AND, inBounds, written.negate()), r.eqNode(rs)));
+    // nth( u, j ) = nth( t, j - i ) if j was written
+    Node ji = Rewriter::rewrite(nm->mkNode(MINUS, j, i));
+    unsigned tdepth = ji == j ? depth : depth + 1;
+    if (tdepth <= s_maxDepth)
+    {
+      Node rt = nm->mkNode(SEQ_NTH, t, ji);
+      setDepth(rt, tdepth);
+      conj.push_back(nm->mkNode(
+          IMPLIES, nm->mkNode(AND, inBounds, written), r.eqNode(rt)));
+    }
+  }
+  else if (k == STRING_CONCAT)
+  {
+    infer = Inference::ARRAY_NTH_CONCAT;
+    Node off = zero;
+    for (const Node& x : u)
+    {
+      Node end = Rewriter::rewrite(
+          nm->mkNode(PLUS, off, nm->mkNode(STRING_LENGTH, x)));
+      Node jo = Rewriter::rewrite(nm->mkNode(MINUS, j, off));
+      // the read of the first component has the same index, but it is still
+      // deeper, since its reduction introduces a concatenation again
+      unsigned xdepth = depth + 1;
+      if (xdepth <= s_maxDepth)
+      {
+        Node rx = nm->mkNode(SEQ_NTH, x, jo);
+        setDepth(rx, xdepth);
+        Node cond =
+            nm->mkNode(AND, nm->mkNode(LEQ, off, j), nm->mkNode(LT, j, end));
+        conj.push_back(nm->mkNode(IMPLIES, cond, r.eqNode(rx)));
+      }
+      off = end;
+    }
+  }
+  else if (k == SEQ_UNIT)
+  {
+    infer = Inference::ARRAY_NTH_UNIT;
+    conj.push_back(nm->mkNode(IMPLIES, j.eqNode(zero), r.eqNode(u[0])));
+  }
+  else
+  {
+    Assert(u.isConst());
+    infer = Inference::ARRAY_NTH_UNIT;
+    const std::vector<Node>& vec =
+        u.getConst<ExprSequence>().getSequence().getVec();
+    for (size_t i = 0, size = vec.size(); i < size; i++)
+    {
+      Node ci = nm->mkConst(Rational(i));
+      conj.push_back(nm->mkNode(IMPLIES, j.eqNode(ci), r.eqNode(vec[i])));
+    }
+  }
+  if (conj.empty())
+  {
+    return;
+  }
+  Node lem = conj.size() == 1 ? conj[0] : nm->mkNode(AND, conj);
+  Trace("strings-array") << "...lemma " << infer << " : " << lem << std::endl;
+  // the lemma is about r rather than nth( u, j ), which avoids introducing
+  // reads of the concatenations that the reductions of reads introduce
+  std::vector<Node> exp;
+  if (r[0] != u)
+  {
+    exp.push_back(r[0].eqNode(u));
+  }
+  d_im.sendInference(exp, lem, infer, true);
+}
+
+unsigned ArraySolver::getDepth(Node r) const
+{
+  NodeUIntMap::const_iterator it = d_depth.find(r);
+  return it == d_depth.end() ? 0 : (*it).second;
+}
+
+void ArraySolver::setDepth(Node r, unsigned depth)
+{
+  if (d_depth.find(r) == d_depth.end())
+  {
+    d_depth[r] = depth;
+  }
+}
+
+}  // namespace strings
+}  // namespace theory
+}  // namespace CVC4
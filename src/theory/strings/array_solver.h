@@ -0,0 +1,99 @@
+/*********************                                                        */
+/*! \file array_solver.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Array-style solver for seq.nth and seq.update
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__STRINGS__ARRAY_SOLVER_H
+#define CVC4__THEORY__STRINGS__ARRAY_SOLVER_H
+
+#include <utility>
+
+#include "context/cdhashmap.h"
+#include "context/cdhashset.h"
+#include "theory/strings/inference_manager.h"
+#include "theory/strings/solver_state.h"
+#include "theory/strings/term_registry.h"
+
+namespace CVC4 {
+namespace theory {
+namespace strings {
+
+/** The array solver for sequences
+ *
+ * This treats sequences as arrays indexed by integers, and reasons about
+ * reads nth( a, j ) in the style of the theory of arrays. For each read
+ * nth( a, j ) and each term u in the equivalence class of a that is an
+ * update, a concatenation, a unit or a constant, it adds a lemma that
+ * expresses nth( a, j ) in terms of the arguments of u, explained by a = u
+ * (read over write). For each update u = update( s, i, t ) and each read
+ * nth( b, j ) with b = s, it adds the valid lemma that expresses nth( u, j )
+ * in terms of the arguments of u (write over read). These lemmas are sent
+ * before the extended function solver reduces seq.nth and seq.update to
+ * concatenations, which is often not necessary when sequences are used as
+ * arrays.
+ *
+ * The lemmas introduce reads nth( t, j - i ) at new indices, and reads of the
+ * components of concatenations, which the reduction of seq.nth introduces in
+ * turn. To ensure termination, the number of times a read is shifted or
+ * descends into a concatenation is bounded.
+ */
+class ArraySolver
+{
+  typedef context::CDHashSet<
+      std::pair<Node, Node>,
+      PairHashFunction<Node, Node, NodeHashFunction, NodeHashFunction> >
+      NodePairSet;
+  typedef context::CDHashMap<Node, unsigned, NodeHashFunction> NodeUIntMap;
+
+ public:
+  ArraySolver(context::UserContext* u,
+              SolverState& s,
+              InferenceManager& im,
+              TermRegistry& tr);
+  ~ArraySolver();
+
+  /**
+   * Check the reads and updates of the current context, which may send
+   * lemmas on the inference manager.
+   */
+  void checkArray();
+
+ private:
+  /** The maximal number of index shifts and descents of reads */
+  static const unsigned s_maxDepth;
+  /**
+   * Send the lemma for the read r = nth( a, j ), where u is an update, a
+   * concatenation, a unit or a constant that is equal to a in the current
+   * context, and depth is the depth of r.
+   */
+  void sendReadLemma(Node u, Node r, unsigned depth);
+  /** Get the depth of the index of read r */
+  unsigned getDepth(Node r) const;
+  /** Set the depth of the index of read r, if it is not already set */
+  void setDepth(Node r, unsigned depth);
+  /** The solver state object */
+  SolverState& d_state;
+  /** The (custom) output channel of the theory of strings */
+  InferenceManager& d_im;
+  /** The term registry of the theory of strings */
+  TermRegistry& d_termReg;
+  /** The pairs of reads and terms u for which we have sent a lemma */
+  NodePairSet d_processed;
+  /** The depths of reads introduced by lemmas */
+  NodeUIntMap d_depth;
+};
+
+}  // namespace strings
+}  // namespace theory
+}  // namespace CVC4
+
+#endif /* CVC4__THEORY__STRINGS__ARRAY_SOLVER_H */
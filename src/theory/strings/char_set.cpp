@@ -0,0 +1,131 @@
+/*********************                                                        */
+/*! \file char_set.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of sets of code points represented by intervals
+ **/
+
+#include "theory/strings/char_set.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+#include "base/check.h"
+
+namespace CVC4 {
+namespace theory {
+namespace strings {
+
+void CharSet::insertRange(unsigned lo, unsigned hi)
+{
+  Assert(lo <= hi);
+  Assert(hi < std::numeric_limits<unsigned>::max());
+  // the first interval that ends at lo - 1 or later, which is the first
+  // interval that may be merged with [lo, hi]
+  std::vector<Interval>::iterator first = std::lower_bound(
+      d_intervals.begin(),
+      d_intervals.end(),
+      lo,
+      [](const Interval& i, unsigned c) { return i.second + 1 < c; });
+  // the intervals after last start after hi + 1
+  std::vector<Interval>::iterator last = first;
+  while (last != d_intervals.end() && last->first <= hi + 1)
+  {
+    lo = std::min(lo, last->first);
+    hi = std::max(hi, last->second);
+    ++last;
+  }
+  if (first == last)
+  {
+    d_intervals.insert(first, Interval(lo, hi));
+    return;
+  }
+  *first = Interval(lo, hi);
+  d_intervals.erase(first + 1, last);
+}
+
+void CharSet::insertAll(const CharSet& cs)
+{
+  if (d_intervals.empty())
+  {
+    d_intervals = cs.d_intervals;
+    return;
+  }
+  for (const Interval& i : cs.d_intervals)
+  {
+    insertRange(i.first, i.second);
+  }
+}
+
+CharSet CharSet::intersect(const CharSet& cs) const
+{
+  CharSet ret;
+  std::vector<Interval>::const_iterator it1 = d_intervals.begin();
+  std::vector<Interval>::const_iterator it2 = cs.d_intervals.begin();
+  while (it1 != d_intervals.end() && it2 != cs.d_intervals.end())
+  {
+    unsigned lo = std::max(it1->first, it2->first);
+    unsigned hi = std::min(it1->second, it2->second);
+    if (lo <= hi)
+    {
+      // the intersections are disjoint and non-adjacent, since the intervals
+      // of both sets are
+      ret.d_intervals.push_back(Interval(lo, hi));
+    }
+    if (it1->second < it2->second)
+    {
+      ++it1;
+    }
+    else
+    {
+      ++it2;
+    }
+  }
+  return ret;
+}
+
+bool CharSet::contains(unsigned c) const
+{
+  std::vector<Interval>::const_iterator it = std::lower_bound(
+      d_intervals.begin(),
+      d_intervals.end(),
+      c,
+      [](const Interval& i, unsigned cc) { return i.second < cc; });
+  return it != d_intervals.end() && it->first <= c;
+}
+
+size_t CharSet::size() const
+{
+  size_t ret = 0;
+  for (const Interval& i : d_intervals)
+  {
+    ret += i.second - i.first + 1;
+  }
+  return ret;
+}
+
+std::ostream& operator<<(std::ostream& out, const CharSet& cs)
+{
+  out << "{";
+  bool first = true;
+  for (const CharSet::Interval& i : cs.getIntervals())
+  {
+    out << (first ? "" : ", ") << i.first;
+    if (i.first != i.second)
+    {
+      out << "-" << i.second;
+    }
+    first = false;
+  }
+  return out << "}";
+}
+
+}  // namespace strings
+}  // namespace theory
+}  // namespace CVC4
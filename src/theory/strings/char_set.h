@@ -0,0 +1,75 @@
+/*********************                                                        */
+/*! \file char_set.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Sets of code points represented by intervals
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__STRINGS__CHAR_SET_H
+#define CVC4__THEORY__STRINGS__CHAR_SET_H
+
+#include <iosfwd>
+#include <utility>
+#include <vector>
+
+namespace CVC4 {
+namespace theory {
+namespace strings {
+
+/**
+ * A set of code points, represented by a sorted list of disjoint intervals
+ * [lo, hi] of code points. Intervals are not adjacent, i.e. the next
+ * interval after [lo, hi] starts at hi + 2 or later, so that the
+ * representation of each set is unique. The size of this representation is
+ * linear in the number of intervals, not in the number of code points, which
+ * matters for sets like re.allchar or ranges of the Unicode alphabet.
+ */
+class CharSet
+{
+ public:
+  typedef std::pair<unsigned, unsigned> Interval;
+
+  CharSet() {}
+
+  /** Add the code point c to this set */
+  void insert(unsigned c) { insertRange(c, c); }
+  /** Add the code points lo, ..., hi to this set */
+  void insertRange(unsigned lo, unsigned hi);
+  /** Add the code points of cs to this set */
+  void insertAll(const CharSet& cs);
+  /** Return the intersection of this set and cs */
+  CharSet intersect(const CharSet& cs) const;
+  /** Does this set contain code point c? */
+  bool contains(unsigned c) const;
+  /** Is this set empty? */
+  bool empty() const { return d_intervals.empty(); }
+  /** Get the number of code points in this set */
+  size_t size() const;
+  /** Get the intervals of this set */
+  const std::vector<Interval>& getIntervals() const { return d_intervals; }
+  bool operator==(const CharSet& cs) const
+  {
+    return d_intervals == cs.d_intervals;
+  }
+  bool operator!=(const CharSet& cs) const { return !(*this == cs); }
+
+ private:
+  /** The sorted list of disjoint, non-adjacent intervals of this set */
+  std::vector<Interval> d_intervals;
+};
+
+/** Print cs to out, as a list of intervals */
+std::ostream& operator<<(std::ostream& out, const CharSet& cs);
+
+}  // namespace strings
+}  // namespace theory
+}  // namespace CVC4
+
+#endif /* CVC4__THEORY__STRINGS__CHAR_SET_H */
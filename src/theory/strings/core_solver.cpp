@@ -37,8 +37,15 @@ CoreSolver::CoreSolver(context::Context* c,
                        SolverState& s,
                        InferenceManager& im,
                        TermRegistry& tr,
-                       BaseSolver& bs)
-    : d_state(s), d_im(im), d_termReg(tr), d_bsolver(bs), d_nfPairs(c)
+                       BaseSolver& bs,
+                       SequencesStatistics& stats)
+    : d_state(s),
+      d_im(im),
+      d_termReg(tr),
+      d_bsolver(bs),
+      d_statistics(stats),
+      d_nfVersion(0),
+      d_nfPairs(c)
 {
   d_zero = NodeManager::currentNM()->mkConst( Rational( 0 ) );
   d_one = NodeManager::currentNM()->mkConst( Rational( 1 ) );
@@ -528,6 +535,25 @@ void CoreSolver::checkNormalFormsEq()
   // calculate normal forms for each equivalence class, possibly adding
   // splitting lemmas
   d_normal_form.clear();
+  if (options::stringIncNormalForms())
+  {
+    // Only the normal forms of the current equivalence classes can be
+    // reused, hence we remove the others from the cache.
+    std::unordered_set<Node, NodeHashFunction> eqcs(d_strings_eqc.begin(),
+                                                    d_strings_eqc.end());
+    std::map<Node, NormalFormCacheEntry>::iterator itc = d_nf_cache.begin();
+    while (itc != d_nf_cache.end())
+    {
+      if (eqcs.find(itc->first) == eqcs.end())
+      {
+        itc = d_nf_cache.erase(itc);
+      }
+      else
+      {
+        ++itc;
+      }
+    }
+  }
   std::map<Node, Node> nf_to_eqc;
   std::map<Node, Node> eqc_to_nf;
   std::map<Node, Node> eqc_to_exp;
@@ -588,6 +614,29 @@ void CoreSolver::checkNormalFormsEq()
 void CoreSolver::normalizeEquivalenceClass(Node eqc, TypeNode stype)
 {
   Trace("strings-process-debug") << "Process equivalence class " << eqc << std::endl;
+  // should not have computed the normal form of this equivalence class yet
+  Assert(d_normal_form.find(eqc) == d_normal_form.end());
+  std::vector<Node> sig;
+  std::vector<uint64_t> deps;
+  if (options::stringIncNormalForms())
+  {
+    getNormalFormSignature(eqc, sig, deps);
+    std::map<Node, NormalFormCacheEntry>::iterator itc = d_nf_cache.find(eqc);
+    if (itc != d_nf_cache.end() && itc->second.d_reusable
+        && itc->second.d_sig == sig && itc->second.d_deps == deps)
+    {
+      // nothing changed since the normal form was computed
+      Trace("strings-process-debug")
+          << "Return process equivalence class " << eqc << " : reused."
+          << std::endl;
+      d_normal_form[eqc] = itc->second.d_nf;
+      ++(d_statistics.d_normalFormsReused);
+      return;
+    }
+  }
+  ++(d_statistics.d_normalFormsComputed);
+  // whether all terms in the equivalence class have the same normal form
+  bool reusable = true;
   Node emp = Word::mkEmptyWord(stype);
   if (d_state.areEqual(eqc, emp))
   {
@@ -605,8 +654,6 @@ void CoreSolver::normalizeEquivalenceClass(Node eqc, TypeNode stype)
   }
   else
   {
-    // should not have computed the normal form of this equivalence class yet
-    Assert(d_normal_form.find(eqc) == d_normal_form.end());
     // Normal forms for the relevant terms in the equivalence class of eqc
     std::vector<NormalForm> normal_forms;
     // map each term to its index in the above vector
@@ -640,6 +687,63 @@ void CoreSolver::normalizeEquivalenceClass(Node eqc, TypeNode stype)
         << "Return process equivalence class " << eqc
         << " : returned, size = " << d_normal_form[eqc].d_nf.size()
         << std::endl;
+    // If the normal forms differ, processNEqc may have relied on the
+    // current context (e.g. normal form pairs) to not infer anything, hence
+    // we do not reuse the normal form.
+    for (const NormalForm& nf : normal_forms)
+    {
+      if (nf.d_nf != normal_forms[0].d_nf)
+      {
+        reusable = false;
+        break;
+      }
+    }
+  }
+  if (options::stringIncNormalForms())
+  {
+    NormalFormCacheEntry& entry = d_nf_cache[eqc];
+    entry.d_sig = sig;
+    entry.d_deps = deps;
+    entry.d_nf = d_normal_form[eqc];
+    entry.d_version = ++d_nfVersion;
+    entry.d_reusable = reusable;
+  }
+}
+
+void CoreSolver::getNormalFormSignature(Node eqc,
+                                        std::vector<Node>& sig,
+                                        std::vector<uint64_t>& deps)
+{
+  // whether the equivalence class is empty is determined by its terms,
+  // except for the empty word itself, which we add in this case
+  TypeNode stype = eqc.getType();
+  Node emp = Word::mkEmptyWord(stype);
+  if (d_state.areEqual(eqc, emp))
+  {
+    sig.push_back(emp);
+  }
+  eq::EqualityEngine* ee = d_state.getEqualityEngine();
+  eq::EqClassIterator eqc_i = eq::EqClassIterator(eqc, ee);
+  while (!eqc_i.isFinished())
+  {
+    Node n = (*eqc_i);
+    ++eqc_i;
+    if (d_bsolver.isCongruent(n))
+    {
+      continue;
+    }
+    sig.push_back(n);
+    if (n.getKind() != STRING_CONCAT)
+    {
+      continue;
+    }
+    for (const Node& nc : n)
+    {
+      Node nr = ee->getRepresentative(nc);
+      sig.push_back(nr);
+      std::map<Node, NormalFormCacheEntry>::iterator itc = d_nf_cache.find(nr);
+      deps.push_back(itc == d_nf_cache.end() ? 0 : itc->second.d_version);
+    }
   }
 }
 
@@ -24,6 +24,7 @@
 #include "theory/strings/infer_info.h"
 #include "theory/strings/inference_manager.h"
 #include "theory/strings/normal_form.h"
+#include "theory/strings/sequences_stats.h"
 #include "theory/strings/solver_state.h"
 #include "theory/strings/term_registry.h"
 
@@ -86,7 +87,8 @@ class CoreSolver
              SolverState& s,
              InferenceManager& im,
              TermRegistry& tr,
-             BaseSolver& bs);
+             BaseSolver& bs,
+             SequencesStatistics& stats);
   ~CoreSolver();
 
   //-----------------------inference steps
@@ -416,6 +418,8 @@ class CoreSolver
   TermRegistry& d_termReg;
   /** reference to the base solver, used for certain queries */
   BaseSolver& d_bsolver;
+  /** Reference to the statistics for the theory of strings/sequences. */
+  SequencesStatistics& d_statistics;
   /** Commonly used constants */
   Node d_true;
   Node d_false;
@@ -431,6 +435,48 @@ class CoreSolver
   std::vector<Node> d_strings_eqc;
   /** map from terms to their normal forms */
   std::map<Node, NormalForm> d_normal_form;
+  /**
+   * A normal form computed for an equivalence class in a previous check,
+   * along with the inputs it was computed from.
+   */
+  struct NormalFormCacheEntry
+  {
+    NormalFormCacheEntry() : d_version(0), d_reusable(false) {}
+    /** The terms of the equivalence class, see getNormalFormSignature */
+    std::vector<Node> d_sig;
+    /** The versions of the normal forms of the components of d_sig */
+    std::vector<uint64_t> d_deps;
+    /** The normal form */
+    NormalForm d_nf;
+    /** The version of the normal form, which is unique to this computation */
+    uint64_t d_version;
+    /**
+     * Whether the normal form can be reused, which is the case if all terms
+     * of the equivalence class had the same normal form.
+     */
+    bool d_reusable;
+  };
+  /**
+   * The normal forms of the equivalence classes computed in previous checks.
+   * This cache is independent of the context; its entries are only reused
+   * if their signature is the one of the equivalence class in the current
+   * context. The entries of terms that are no longer representatives of
+   * equivalence classes are removed at the start of checkNormalFormsEq.
+   */
+  std::map<Node, NormalFormCacheEntry> d_nf_cache;
+  /** The last version assigned to an entry of d_nf_cache */
+  uint64_t d_nfVersion;
+  /**
+   * Get the signature of equivalence class eqc, which is used to decide
+   * whether the normal form computed for eqc in a previous check can be
+   * reused. The signature sig consists of the non-congruent terms of eqc,
+   * followed by the representatives of the components of its concatenation
+   * terms. The vector deps stores the versions of the normal forms of these
+   * representatives, which are computed before the normal form of eqc.
+   */
+  void getNormalFormSignature(Node eqc,
+                              std::vector<Node>& sig,
+                              std::vector<uint64_t>& deps);
   /**
    * In certain cases, we know that two terms are equivalent despite
    * not having to verify their normal forms are identical. For example,
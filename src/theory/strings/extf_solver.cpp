@@ -65,6 +65,8 @@ ExtfSolver::ExtfSolver(context::Context* c,
   d_extt.addFunctionKind(kind::STRING_TOLOWER);
   d_extt.addFunctionKind(kind::STRING_TOUPPER);
   d_extt.addFunctionKind(kind::STRING_REV);
+  d_extt.addFunctionKind(kind::STRING_UPDATE);
+  d_extt.addFunctionKind(kind::SEQ_NTH);
 
   d_true = NodeManager::currentNM()->mkConst(true);
   d_false = NodeManager::currentNM()->mkConst(false);
@@ -184,7 +186,8 @@ bool ExtfSolver::doReduction(int effort, Node n)
            || k == STRING_ITOS || k == STRING_STOI || k == STRING_STRREPL
            || k == STRING_STRREPLALL || k == STRING_REPLACE_RE
            || k == STRING_REPLACE_RE_ALL || k == STRING_LEQ
-           || k == STRING_TOLOWER || k == STRING_TOUPPER || k == STRING_REV);
+           || k == STRING_TOLOWER || k == STRING_TOUPPER || k == STRING_REV
+           || k == STRING_UPDATE || k == SEQ_NTH);
     std::vector<Node> new_nodes;
     Node res = d_preproc.simplify(n, new_nodes);
     Assert(res != n);
@@ -235,52 +238,31 @@ void ExtfSolver::checkExtfEval(int effort)
   Trace("strings-extf-list")
       << "Active extended functions, effort=" << effort << " : " << std::endl;
   d_extfInfoTmp.clear();
-  NodeManager* nm = NodeManager::currentNM();
   bool has_nreduce = false;
   std::vector<Node> terms = d_extt.getActive();
+  // the context-dependent simplified forms of terms, computed at once
+  std::vector<Node> sterms;
+  std::vector<Node> srterms;
+  computeSimplifiedForms(effort, terms, sterms, srterms);
   // the set of terms we have done extf inferences for
   std::unordered_set<Node, NodeHashFunction> inferProcessed;
-  for (const Node& n : terms)
+  for (size_t i = 0, nterms = terms.size(); i < nterms; i++)
   {
-    // Setup information about n, including if it is equal to a constant.
+    const Node& n = terms[i];
     ExtfInfoTmp& einfo = d_extfInfoTmp[n];
     Node r = d_state.getRepresentative(n);
     einfo.d_const = d_bsolver.getConstantEqc(r);
-    // Get the current values of the children of n.
-    // Notice that we look up the value of the direct children of n, and not
-    // their free variables. In other words, given a term:
-    //   t = (str.replace "B" (str.replace x "A" "B") "C")
-    // we may build the explanation that:
-    //   ((str.replace x "A" "B") = "B") => t = (str.replace "B" "B" "C")
-    // instead of basing this on the free variable x:
-    //   (x = "A") => t = (str.replace "B" (str.replace "A" "A" "B") "C")
-    // Although both allow us to infer t = "C", it is important to use the
-    // first kind of inference since it ensures that its subterms have the
-    // expected values. Otherwise, we may in rare cases fail to realize that
-    // the subterm (str.replace x "A" "B") does not currently have the correct
-    // value, say in this example that (str.replace x "A" "B") != "B".
-    std::vector<Node> exp;
-    std::vector<Node> schildren;
-    bool schanged = false;
-    for (const Node& nc : n)
-    {
-      Node sc = getCurrentSubstitutionFor(effort, nc, exp);
-      schildren.push_back(sc);
-      schanged = schanged || sc != nc;
-    }
     // If there is information involving the children, attempt to do an
     // inference and/or mark n as reduced.
     Node to_reduce;
-    if (schanged)
+    if (!sterms[i].isNull())
     {
-      Node sn = nm->mkNode(n.getKind(), schildren);
+      const Node& sn = sterms[i];
       Trace("strings-extf-debug")
           << "Check extf " << n << " == " << sn
           << ", constant = " << einfo.d_const << ", effort=" << effort << "..."
           << std::endl;
-      einfo.d_exp.insert(einfo.d_exp.end(), exp.begin(), exp.end());
-      // inference is rewriting the substituted node
-      Node nrc = Rewriter::rewrite(sn);
+      const Node& nrc = srterms[i];
       // if rewrites to a constant, then do the inference and mark as reduced
       if (nrc.isConst())
       {
@@ -465,6 +447,68 @@ void ExtfSolver::checkExtfEval(int effort)
   d_hasExtf = has_nreduce;
 }
 
+void ExtfSolver::computeSimplifiedForms(int effort,
+                                        const std::vector<Node>& terms,
+                                        std::vector<Node>& sterms,
+                                        std::vector<Node>& srterms)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  // Many active extended functions share children, e.g. the string variables
+  // x in contains( x, "A" ), contains( x, "B" ) and so on, hence we compute
+  // the current substitution for each child, and its explanation, once.
+  std::unordered_map<Node,
+                     std::pair<Node, std::vector<Node> >,
+                     NodeHashFunction>
+      subs;
+  for (const Node& n : terms)
+  {
+    // Get the current values of the children of n.
+    // Notice that we look up the value of the direct children of n, and not
+    // their free variables. In other words, given a term:
+    //   t = (str.replace "B" (str.replace x "A" "B") "C")
+    // we may build the explanation that:
+    //   ((str.replace x "A" "B") = "B") => t = (str.replace "B" "B" "C")
+    // instead of basing this on the free variable x:
+    //   (x = "A") => t = (str.replace "B" (str.replace "A" "A" "B") "C")
+    // Although both allow us to infer t = "C", it is important to use the
+    // first kind of inference since it ensures that its subterms have the
+    // expected values. Otherwise, we may in rare cases fail to realize that
+    // the subterm (str.replace x "A" "B") does not currently have the correct
+    // value, say in this example that (str.replace x "A" "B") != "B".
+    std::vector<Node> exp;
+    std::vector<Node> schildren;
+    bool schanged = false;
+    for (const Node& nc : n)
+    {
+      std::unordered_map<Node,
+                         std::pair<Node, std::vector<Node> >,
+                         NodeHashFunction>::iterator it = subs.find(nc);
+      if (it == subs.end())
+      {
+        std::vector<Node> expc;
+        Node scc = getCurrentSubstitutionFor(effort, nc, expc);
+        it = subs.emplace(nc, std::make_pair(scc, expc)).first;
+      }
+      const Node& sc = it->second.first;
+      exp.insert(exp.end(), it->second.second.begin(), it->second.second.end());
+      schildren.push_back(sc);
+      schanged = schanged || sc != nc;
+    }
+    if (!schanged)
+    {
+      sterms.push_back(Node::null());
+      srterms.push_back(Node::null());
+      continue;
+    }
+    Node sn = nm->mkNode(n.getKind(), schildren);
+    d_extfInfoTmp[n].d_exp.insert(
+        d_extfInfoTmp[n].d_exp.end(), exp.begin(), exp.end());
+    // the simplified form of n is the rewritten form of sn
+    sterms.push_back(sn);
+    srterms.push_back(Rewriter::rewrite(sn));
+  }
+}
+
 void ExtfSolver::checkExtfInference(Node n,
                                     Node nr,
                                     ExtfInfoTmp& in,
@@ -168,6 +168,19 @@ class ExtfSolver
    * checkExtfReductions.
    */
   bool doReduction(int effort, Node n);
+  /**
+   * Compute the context-dependent simplified forms of the extended functions
+   * terms for the given effort (see checkExtfEval). For each term n in terms,
+   * this adds to sterms the term obtained by replacing the children of n by
+   * their current substitution (see getCurrentSubstitutionFor), and to
+   * srterms its rewritten form, or the null node to both if no child of n
+   * has a substitution. The explanations are added to the information
+   * objects of the terms.
+   */
+  void computeSimplifiedForms(int effort,
+                              const std::vector<Node>& terms,
+                              std::vector<Node>& sterms,
+                              std::vector<Node>& srterms);
   /** check extended function inferences
    *
    * This function makes additional inferences for n that do not contribute
@@ -70,6 +70,7 @@ const char* toString(Inference i)
     case Inference::RE_INTER_INCLUDE: return "RE_INTER_INCLUDE";
     case Inference::RE_INTER_CONF: return "RE_INTER_CONF";
     case Inference::RE_INTER_INFER: return "RE_INTER_INFER";
+    case Inference::RE_INTER_AUTOMATA_CONF: return "RE_INTER_AUTOMATA_CONF";
     case Inference::RE_DELTA: return "RE_DELTA";
     case Inference::RE_DELTA_CONF: return "RE_DELTA_CONF";
     case Inference::RE_DERIVE: return "RE_DERIVE";
@@ -83,6 +84,9 @@ const char* toString(Inference i)
     case Inference::CTN_NEG_EQUAL: return "CTN_NEG_EQUAL";
     case Inference::CTN_POS: return "CTN_POS";
     case Inference::REDUCTION: return "REDUCTION";
+    case Inference::ARRAY_NTH_UPDATE: return "ARRAY_NTH_UPDATE";
+    case Inference::ARRAY_NTH_CONCAT: return "ARRAY_NTH_CONCAT";
+    case Inference::ARRAY_NTH_UNIT: return "ARRAY_NTH_UNIT";
     default: return "?";
   }
 }
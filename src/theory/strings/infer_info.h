@@ -234,6 +234,11 @@ enum class Inference : uint32_t
   // intersection inference
   //   (x in R1 ^ y in R2 ^ x = y) => (x in re.inter(R1,R2))
   RE_INTER_INFER,
+  // intersection conflict, using automata for constant regular expressions
+  //   (x1 in R1 ^ ... ^ xn in Rn ^ ~ y1 in S1 ^ ... ^ ~ ym in Sm) => false
+  // where x1 = ... = xn = y1 = ... = ym and the product of the automata for
+  // R1 ... Rn and the complements of S1 ... Sm has no accepting state.
+  RE_INTER_AUTOMATA_CONF,
   // regular expression delta
   //   (x = "" ^ x in R) => C
   // where "" in R holds if and only if C holds.
@@ -291,6 +296,18 @@ enum class Inference : uint32_t
   // (see theory_strings_preprocess).
   REDUCTION,
   //-------------------------------------- end extended function solver
+  //-------------------------------------- sequences array solver
+  // read over update, where u = update( s, i, t ) and 0 <= j < len( s ):
+  //   i <= j < i + len( t ) => nth( u, j ) = nth( t, j - i ), and
+  //   otherwise nth( u, j ) = nth( s, j ).
+  ARRAY_NTH_UPDATE,
+  // read over concatenation, where c = x1 ++ ... ++ xn:
+  //   len( x1 ++ ... ++ xk-1 ) <= j < len( x1 ++ ... ++ xk ) =>
+  //     nth( c, j ) = nth( xk, j - len( x1 ++ ... ++ xk-1 ) )
+  ARRAY_NTH_CONCAT,
+  // read over units and constants, e.g. j = 0 => nth( unit( x ), j ) = x
+  ARRAY_NTH_UNIT,
+  //-------------------------------------- end sequences array solver
   NONE,
 };
 
@@ -0,0 +1,574 @@
+/*********************                                                        */
+/*! \file regexp_dfa.cpp
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Implementation of automata for constant regular expressions
+ **/
+
+#include "theory/strings/regexp_dfa.h"
+
+#include <algorithm>
+#include <limits>
+#include <set>
+
+#include "theory/strings/theory_strings_utils.h"
+
+using namespace CVC4::kind;
+
+namespace CVC4 {
+namespace theory {
+namespace strings {
+
+const uint32_t RegExpDfa::s_none = std::numeric_limits<uint32_t>::max();
+const size_t RegExpDfa::s_maxNfaStates = 1 << 16;
+const size_t RegExpDfa::s_maxDfaStates = 1 << 12;
+const size_t RegExpDfa::s_maxWitnessSteps = 1 << 16;
+const size_t RegExpDfaCache::s_maxDfas = 1 << 8;
+
+RegExpDfa::RegExpDfa() : d_nfaAccept(s_none) {}
+
+std::unique_ptr<RegExpDfa> RegExpDfa::compile(TNode r)
+{
+  std::unique_ptr<RegExpDfa> dfa(new RegExpDfa);
+  uint32_t start, end;
+  if (!dfa->compileInternal(r, start, end))
+  {
+    Trace("regexp-dfa") << "RegExpDfa: cannot compile " << r << std::endl;
+    return nullptr;
+  }
+  dfa->d_nfaAccept = end;
+  // compute the character classes
+  std::set<unsigned> classes;
+  classes.insert(0);
+  for (const NfaState& ns : dfa->d_nfa)
+  {
+    if (ns.d_next != s_none)
+    {
+      classes.insert(ns.d_lo);
+      if (ns.d_hi + 1 < String::num_codes())
+      {
+        classes.insert(ns.d_hi + 1);
+      }
+    }
+  }
+  dfa->d_classes.assign(classes.begin(), classes.end());
+  dfa->d_mark.resize(dfa->d_nfa.size(), false);
+  // the initial state of the DFA
+  std::vector<uint32_t> init;
+  init.push_back(start);
+  dfa->closure(init);
+  dfa->mkDfaState(init);
+  Trace("regexp-dfa") << "RegExpDfa: compiled " << r << ", "
+                      << dfa->d_nfa.size() << " NFA states, "
+                      << dfa->d_classes.size() << " character classes"
+                      << std::endl;
+  return dfa;
+}
+
+uint32_t RegExpDfa::mkNfaState()
+{
+  if (d_nfa.size() >= s_maxNfaStates)
+  {
+    return s_none;
+  }
+  d_nfa.push_back(NfaState());
+  return d_nfa.size() - 1;
+}
+
+bool RegExpDfa::compileInternal(TNode r, uint32_t& start, uint32_t& end)
+{
+  Kind k = r.getKind();
+  if (k == REGEXP_CONCAT)
+  {
+    start = s_none;
+    for (const Node& rc : r)
+    {
+      uint32_t cstart, cend;
+      if (!compileInternal(rc, cstart, cend))
+      {
+        return false;
+      }
+      if (start == s_none)
+      {
+        start = cstart;
+      }
+      else
+      {
+        d_nfa[end].d_eps.push_back(cstart);
+      }
+      end = cend;
+    }
+    return true;
+  }
+  start = mkNfaState();
+  end = mkNfaState();
+  if (end == s_none)
+  {
+    return false;
+  }
+  switch (k)
+  {
+    case STRING_TO_REGEXP:
+    {
+      if (!r[0].isConst())
+      {
+        return false;
+      }
+      uint32_t curr = start;
+      for (unsigned c : r[0].getConst<String>().getVec())
+      {
+        uint32_t next = mkNfaState();
+        if (next == s_none)
+        {
+          return false;
+        }
+        d_nfa[curr].d_lo = c;
+        d_nfa[curr].d_hi = c;
+        d_nfa[curr].d_next = next;
+        curr = next;
+      }
+      d_nfa[curr].d_eps.push_back(end);
+      return true;
+    }
+    case REGEXP_UNION:
+    {
+      for (const Node& rc : r)
+      {
+        uint32_t cstart, cend;
+        if (!compileInternal(rc, cstart, cend))
+        {
+          return false;
+        }
+        d_nfa[start].d_eps.push_back(cstart);
+        d_nfa[cend].d_eps.push_back(end);
+      }
+      return true;
+    }
+    case REGEXP_STAR:
+    {
+      uint32_t cstart, cend;
+      if (!compileInternal(r[0], cstart, cend))
+      {
+        return false;
+      }
+      d_nfa[start].d_eps.push_back(cstart);
+      d_nfa[start].d_eps.push_back(end);
+      d_nfa[cend].d_eps.push_back(cstart);
+      d_nfa[cend].d_eps.push_back(end);
+      return true;
+    }
+    case REGEXP_LOOP:
+    {
+      uint32_t l = utils::getLoopMinOccurrences(r);
+      uint32_t u = utils::getLoopMaxOccurrences(r);
+      // l mandatory copies of r[0], followed by u-l optional ones
+      uint32_t curr = start;
+      for (uint32_t i = 0; i < u; i++)
+      {
+        uint32_t cstart, cend;
+        if (!compileInternal(r[0], cstart, cend))
+        {
+          return false;
+        }
+        d_nfa[curr].d_eps.push_back(cstart);
+        if (i >= l)
+        {
+          d_nfa[curr].d_eps.push_back(end);
+        }
+        curr = cend;
+      }
+      if (l <= u)
+      {
+        d_nfa[curr].d_eps.push_back(end);
+      }
+      return true;
+    }
+    case REGEXP_SIGMA:
+    {
+      d_nfa[start].d_lo = 0;
+      d_nfa[start].d_hi = String::num_codes() - 1;
+      d_nfa[start].d_next = end;
+      return true;
+    }
+    case REGEXP_RANGE:
+    {
+      if (!r[0].isConst() || !r[1].isConst()
+          || r[0].getConst<String>().size() != 1
+          || r[1].getConst<String>().size() != 1)
+      {
+        return false;
+      }
+      unsigned a = r[0].getConst<String>().front();
+      unsigned b = r[1].getConst<String>().front();
+      if (a <= b)
+      {
+        d_nfa[start].d_lo = a;
+        d_nfa[start].d_hi = b;
+        d_nfa[start].d_next = end;
+      }
+      return true;
+    }
+    case REGEXP_EMPTY:
+    {
+      return true;
+    }
+    default:
+    {
+      // intersection, complement, or kinds that are eliminated by rewriting
+      return false;
+    }
+  }
+}
+
+size_t RegExpDfa::getCharClass(unsigned c) const
+{
+  return std::upper_bound(d_classes.begin(), d_classes.end(), c)
+         - d_classes.begin() - 1;
+}
+
+void RegExpDfa::closure(std::vector<uint32_t>& set)
+{
+  std::vector<uint32_t> visit(set.begin(), set.end());
+  std::vector<uint32_t> visited;
+  set.clear();
+  while (!visit.empty())
+  {
+    uint32_t curr = visit.back();
+    visit.pop_back();
+    if (d_mark[curr])
+    {
+      continue;
+    }
+    d_mark[curr] = true;
+    visited.push_back(curr);
+    const NfaState& ns = d_nfa[curr];
+    // only states that have character transitions or are accepting
+    // distinguish sets of states
+    if (ns.d_next != s_none || curr == d_nfaAccept)
+    {
+      set.push_back(curr);
+    }
+    visit.insert(visit.end(), ns.d_eps.begin(), ns.d_eps.end());
+  }
+  for (uint32_t v : visited)
+  {
+    d_mark[v] = false;
+  }
+  std::sort(set.begin(), set.end());
+}
+
+std::vector<uint32_t> RegExpDfa::step(const std::vector<uint32_t>& set,
+                                      unsigned c)
+{
+  std::vector<uint32_t> next;
+  for (uint32_t s : set)
+  {
+    const NfaState& ns = d_nfa[s];
+    if (ns.d_next != s_none && ns.d_lo <= c && c <= ns.d_hi)
+    {
+      next.push_back(ns.d_next);
+    }
+  }
+  closure(next);
+  return next;
+}
+
+uint32_t RegExpDfa::mkDfaState(const std::vector<uint32_t>& set)
+{
+  std::map<std::vector<uint32_t>, uint32_t>::iterator it =
+      d_dstateId.find(set);
+  if (it != d_dstateId.end())
+  {
+    return it->second;
+  }
+  uint32_t id = d_dstates.size();
+  d_dstateId[set] = id;
+  d_dstates.push_back(set);
+  d_daccept.push_back(std::binary_search(set.begin(), set.end(), d_nfaAccept));
+  d_dtrans.resize(d_dtrans.size() + d_classes.size(), s_none);
+  return id;
+}
+
+uint32_t RegExpDfa::getNextState(uint32_t s, unsigned c)
+{
+  size_t k = getCharClass(c);
+  size_t index = s * d_classes.size() + k;
+  if (d_dtrans[index] == s_none)
+  {
+    std::vector<uint32_t> next = step(d_dstates[s], d_classes[k]);
+    // mkDfaState resizes d_dtrans
+    uint32_t ns = mkDfaState(next);
+    d_dtrans[index] = ns;
+  }
+  return d_dtrans[index];
+}
+
+bool RegExpDfa::accepts(const String& s, size_t start)
+{
+  const std::vector<unsigned>& vec = s.getVec();
+  size_t i = start;
+  size_t size = vec.size();
+  uint32_t curr = getInitialState();
+  for (; i < size && d_dstates.size() < s_maxDfaStates; i++)
+  {
+    if (isDead(curr))
+    {
+      return false;
+    }
+    curr = getNextState(curr, vec[i]);
+  }
+  if (i == size)
+  {
+    return isAccepting(curr);
+  }
+  // too many states to cache, simulate the NFA on the rest of the string
+  std::vector<uint32_t> set = d_dstates[curr];
+  for (; i < size && !set.empty(); i++)
+  {
+    set = step(set, vec[i]);
+  }
+  return std::binary_search(set.begin(), set.end(), d_nfaAccept);
+}
+
+int RegExpDfa::shortestMatch(const String& s, size_t start)
+{
+  const std::vector<unsigned>& vec = s.getVec();
+  size_t i = start;
+  size_t size = vec.size();
+  uint32_t curr = getInitialState();
+  for (; d_dstates.size() < s_maxDfaStates; i++)
+  {
+    if (isAccepting(curr))
+    {
+      return i - start;
+    }
+    if (i == size || isDead(curr))
+    {
+      return -1;
+    }
+    curr = getNextState(curr, vec[i]);
+  }
+  // too many states to cache, simulate the NFA on the rest of the string
+  std::vector<uint32_t> set = d_dstates[curr];
+  for (; !set.empty(); i++)
+  {
+    if (std::binary_search(set.begin(), set.end(), d_nfaAccept))
+    {
+      return i - start;
+    }
+    if (i == size)
+    {
+      break;
+    }
+    set = step(set, vec[i]);
+  }
+  return -1;
+}
+
+int RegExpDfa::hasWitness(RegExpDfa& a, RegExpDfa& b, bool complementB)
+{
+  std::vector<RegExpDfa*> dfas = {&a, &b};
+  std::vector<bool> complement = {false, complementB};
+  return hasWitness(dfas, complement);
+}
+
+int RegExpDfa::hasWitness(const std::vector<RegExpDfa*>& dfas,
+                          const std::vector<bool>& complement)
+{
+  Assert(dfas.size() == complement.size());
+  size_t n = dfas.size();
+  // the character classes of the product
+  std::set<unsigned> cset;
+  for (RegExpDfa* d : dfas)
+  {
+    cset.insert(d->d_classes.begin(), d->d_classes.end());
+  }
+  std::vector<unsigned> classes(cset.begin(), cset.end());
+  // the states of the product are tuples of states of dfas, which we explore
+  // depth-first, pruning tuples with a dead state that is not complemented
+  std::set<std::vector<uint32_t>> visited;
+  std::vector<std::vector<uint32_t>> visit;
+  std::vector<uint32_t> init;
+  for (RegExpDfa* d : dfas)
+  {
+    init.push_back(d->getInitialState());
+  }
+  visited.insert(init);
+  visit.push_back(init);
+  while (!visit.empty())
+  {
+    std::vector<uint32_t> curr = visit.back();
+    visit.pop_back();
+    bool accept = true;
+    for (size_t i = 0; i < n && accept; i++)
+    {
+      accept = dfas[i]->isAccepting(curr[i]) != complement[i];
+    }
+    if (accept)
+    {
+      return 1;
+    }
+    if (visited.size() > s_maxDfaStates)
+    {
+      return -1;
+    }
+    for (unsigned c : classes)
+    {
+      std::vector<uint32_t> next(n);
+      bool dead = false;
+      for (size_t i = 0; i < n && !dead; i++)
+      {
+        next[i] = dfas[i]->getNextState(curr[i], c);
+        dead = !complement[i] && dfas[i]->isDead(next[i]);
+      }
+      if (!dead && visited.insert(next).second)
+      {
+        visit.push_back(next);
+      }
+    }
+  }
+  return 0;
+}
+
+int RegExpDfa::getWitness(const std::vector<RegExpDfa*>& dfas,
+                          const std::vector<bool>& complement,
+                          size_t len,
+                          unsigned card,
+                          const std::set<String>& exclude,
+                          String& w)
+{
+  Assert(dfas.size() == complement.size());
+  size_t n = dfas.size();
+  // the character classes of the product
+  std::set<unsigned> cset;
+  for (RegExpDfa* d : dfas)
+  {
+    cset.insert(d->d_classes.begin(), d->d_classes.end());
+  }
+  std::vector<unsigned> classes(cset.begin(), cset.end());
+  // The tuples of states and remaining lengths for which no string is
+  // accepted. We do not add tuples for which the only accepted strings were
+  // excluded, since their siblings in the same character class may lead to
+  // strings that are not excluded.
+  std::set<std::pair<std::vector<uint32_t>, size_t>> noWitness;
+  // the stack of the search, where states[d] is the tuple of states after
+  // reading the prefix word[0], ..., word[d-1], next[d] is the next
+  // character to try at depth d, and excluded[d] is whether an excluded
+  // string was found below depth d
+  std::vector<std::vector<uint32_t>> states;
+  std::vector<unsigned> word;
+  std::vector<unsigned> next;
+  std::vector<bool> excluded;
+  std::vector<uint32_t> init;
+  for (RegExpDfa* d : dfas)
+  {
+    init.push_back(d->getInitialState());
+  }
+  states.push_back(init);
+  next.push_back(0);
+  excluded.push_back(false);
+  size_t steps = 0;
+  while (!states.empty())
+  {
+    size_t depth = word.size();
+    const std::vector<uint32_t>& curr = states.back();
+    unsigned c = next.back();
+    if (depth == len || c >= card)
+    {
+      if (depth == len)
+      {
+        bool accept = true;
+        for (size_t i = 0; i < n && accept; i++)
+        {
+          accept = dfas[i]->isAccepting(curr[i]) != complement[i];
+        }
+        if (accept)
+        {
+          String s(word);
+          if (exclude.find(s) == exclude.end())
+          {
+            w = s;
+            return 1;
+          }
+          excluded.back() = true;
+        }
+      }
+      if (!excluded.back())
+      {
+        noWitness.insert(
+            std::pair<std::vector<uint32_t>, size_t>(curr, len - depth));
+      }
+      // backtrack
+      bool ex = excluded.back();
+      states.pop_back();
+      next.pop_back();
+      excluded.pop_back();
+      if (!word.empty())
+      {
+        word.pop_back();
+        excluded.back() = excluded.back() || ex;
+      }
+      continue;
+    }
+    if (++steps > s_maxWitnessSteps)
+    {
+      return -1;
+    }
+    // the last character of the class of c
+    size_t k = std::upper_bound(classes.begin(), classes.end(), c)
+               - classes.begin();
+    unsigned hi = k < classes.size() ? classes[k] - 1 : card - 1;
+    hi = std::min(hi, card - 1);
+    std::vector<uint32_t> succ(n);
+    bool dead = false;
+    for (size_t i = 0; i < n && !dead; i++)
+    {
+      succ[i] = dfas[i]->getNextState(curr[i], c);
+      dead = !complement[i] && dfas[i]->isDead(succ[i]);
+    }
+    if (dead
+        || noWitness.find(std::pair<std::vector<uint32_t>, size_t>(
+               succ, len - depth - 1))
+               != noWitness.end())
+    {
+      // no other character of this class leads to a witness either
+      next.back() = hi + 1;
+      continue;
+    }
+    next.back() = c + 1;
+    states.push_back(succ);
+    word.push_back(c);
+    next.push_back(0);
+    excluded.push_back(false);
+  }
+  return 0;
+}
+
+std::shared_ptr<RegExpDfa> RegExpDfaCache::getDfa(TNode r)
+{
+  std::unordered_map<Node, CacheEntry, NodeHashFunction>::iterator it =
+      d_dfas.find(r);
+  if (it != d_dfas.end())
+  {
+    d_lru.splice(d_lru.begin(), d_lru, it->second.second);
+    return it->second.first;
+  }
+  if (d_dfas.size() >= s_maxDfas)
+  {
+    d_dfas.erase(d_lru.back());
+    d_lru.pop_back();
+  }
+  std::shared_ptr<RegExpDfa> dfa = RegExpDfa::compile(r);
+  d_lru.push_front(r);
+  d_dfas[r] = CacheEntry(dfa, d_lru.begin());
+  return dfa;
+}
+
+}  // namespace strings
+}  // namespace theory
+}  // namespace CVC4
@@ -0,0 +1,206 @@
+/*********************                                                        */
+/*! \file regexp_dfa.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Automata for constant regular expressions
+ **/
+
+#include "cvc4_private.h"
+
+#ifndef CVC4__THEORY__STRINGS__REGEXP_DFA_H
+#define CVC4__THEORY__STRINGS__REGEXP_DFA_H
+
+#include <list>
+#include <map>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "expr/node.h"
+#include "util/string.h"
+
+namespace CVC4 {
+namespace theory {
+namespace strings {
+
+/**
+ * An automaton for a constant regular expression.
+ *
+ * A regular expression is compiled to a (Thompson) NFA whose transitions are
+ * labeled by intervals of characters. The alphabet is partitioned into
+ * character classes, which are the maximal intervals of characters that no
+ * transition of the NFA distinguishes. A DFA over the character classes is
+ * constructed lazily from the NFA by the subset construction, that is, the
+ * states and transitions of the DFA are computed when they are first needed
+ * and cached.
+ *
+ * This class does not store nodes, and is independent of the regular
+ * expression it was compiled from after construction.
+ */
+class RegExpDfa
+{
+ public:
+  /**
+   * Compile constant regular expression r. This returns null if r cannot be
+   * compiled, which is the case if r contains intersections or complements,
+   * non-constant strings, or kinds that are eliminated by rewriting, or if
+   * the automaton for r is too large.
+   */
+  static std::unique_ptr<RegExpDfa> compile(TNode r);
+  /** Is the suffix of s starting at index start in the language? */
+  bool accepts(const String& s, size_t start = 0);
+  /**
+   * Returns the length of the shortest prefix of the suffix of s starting at
+   * index start that is in the language, or -1 if none exists.
+   */
+  int shortestMatch(const String& s, size_t start = 0);
+
+  //------------------------------ DFA interface
+  /** Get the initial state of the DFA */
+  uint32_t getInitialState() const { return 0; }
+  /** Get the state reached from state s by reading character c */
+  uint32_t getNextState(uint32_t s, unsigned c);
+  /** Is s an accepting state? */
+  bool isAccepting(uint32_t s) const { return d_daccept[s]; }
+  /** Is s the state from which no string is accepted? */
+  bool isDead(uint32_t s) const { return d_dstates[s].empty(); }
+  /** Get the number of states of the DFA computed so far */
+  size_t getNumStates() const { return d_dstates.size(); }
+  /**
+   * Get the character classes of this automaton, given as the (sorted) list
+   * of the smallest character of each class.
+   */
+  const std::vector<unsigned>& getCharClasses() const { return d_classes; }
+  //------------------------------ end DFA interface
+
+  /**
+   * Is there a string that is accepted by a and accepted by b (if complementB
+   * is false) or rejected by b (if complementB is true)? Returns 1 if there
+   * is, 0 if there is not, and -1 if the product of a and b is too large to
+   * be explored.
+   */
+  static int hasWitness(RegExpDfa& a, RegExpDfa& b, bool complementB);
+  /**
+   * Is there a string that is accepted by all dfas[i] for which complement[i]
+   * is false, and rejected by all dfas[i] for which complement[i] is true?
+   * Returns 1, 0 or -1 as above.
+   */
+  static int hasWitness(const std::vector<RegExpDfa*>& dfas,
+                        const std::vector<bool>& complement);
+  /**
+   * Find a string w of length len over the characters 0, ..., card - 1 that
+   * is accepted by all dfas[i] for which complement[i] is false, rejected by
+   * all dfas[i] for which complement[i] is true, and is not in exclude. This
+   * is a backtracking search over the product automaton, which skips the
+   * character classes that lead to tuples of states from which no string of
+   * the remaining length is accepted. Returns 1 if such a w was found, 0 if
+   * none exists, and -1 if the search was exhausted before either is known.
+   */
+  static int getWitness(const std::vector<RegExpDfa*>& dfas,
+                        const std::vector<bool>& complement,
+                        size_t len,
+                        unsigned card,
+                        const std::set<String>& exclude,
+                        String& w);
+
+ private:
+  RegExpDfa();
+  /** A state of the NFA */
+  struct NfaState
+  {
+    NfaState() : d_lo(0), d_hi(0), d_next(s_none) {}
+    /** The epsilon transitions */
+    std::vector<uint32_t> d_eps;
+    /**
+     * The characters [d_lo, d_hi] lead to state d_next, if d_next is not
+     * s_none.
+     */
+    unsigned d_lo;
+    unsigned d_hi;
+    uint32_t d_next;
+  };
+  /** The null state and transition */
+  static const uint32_t s_none;
+  /** The maximal number of states of NFAs */
+  static const size_t s_maxNfaStates;
+  /** The maximal number of states of DFAs that are cached */
+  static const size_t s_maxDfaStates;
+  /** The maximal number of transitions taken by getWitness */
+  static const size_t s_maxWitnessSteps;
+  /** The states of the NFA */
+  std::vector<NfaState> d_nfa;
+  /** The accepting state of the NFA */
+  uint32_t d_nfaAccept;
+  /** Make a new NFA state, returns s_none if the NFA is too large */
+  uint32_t mkNfaState();
+  /**
+   * Add the NFA for r to d_nfa, whose initial and accepting states are
+   * stored in start and end. Returns false if r cannot be compiled.
+   */
+  bool compileInternal(TNode r, uint32_t& start, uint32_t& end);
+  /** The smallest characters of the character classes */
+  std::vector<unsigned> d_classes;
+  /** Get the character class of c */
+  size_t getCharClass(unsigned c) const;
+  /**
+   * Compute the epsilon closure of set, which is sorted and contains the
+   * NFA states that have character transitions or are accepting.
+   */
+  void closure(std::vector<uint32_t>& set);
+  /** Get the set of NFA states reached from set by reading c */
+  std::vector<uint32_t> step(const std::vector<uint32_t>& set, unsigned c);
+  /** Mark for computing closures */
+  std::vector<bool> d_mark;
+  /** The states of the DFA, which are sets of NFA states */
+  std::vector<std::vector<uint32_t>> d_dstates;
+  /** Whether the states of the DFA are accepting */
+  std::vector<bool> d_daccept;
+  /** The identifiers of the states of the DFA */
+  std::map<std::vector<uint32_t>, uint32_t> d_dstateId;
+  /**
+   * The transitions of the DFA, where the transition of state s for
+   * character class k is d_dtrans[s * d_classes.size() + k], or s_none if it
+   * was not computed.
+   */
+  std::vector<uint32_t> d_dtrans;
+  /** Get the DFA state for set, which is closed */
+  uint32_t mkDfaState(const std::vector<uint32_t>& set);
+};
+
+/**
+ * A cache of the automata for constant regular expressions. It keeps the
+ * automata of the s_maxDfas regular expressions that were used last.
+ */
+class RegExpDfaCache
+{
+ public:
+  /**
+   * Get the automaton for constant regular expression r, or null if r cannot
+   * be compiled (see RegExpDfa::compile). The automaton may be evicted from
+   * the cache by later calls, hence the caller shares its ownership.
+   */
+  std::shared_ptr<RegExpDfa> getDfa(TNode r);
+
+ private:
+  /** The maximal number of regular expressions whose automata are cached */
+  static const size_t s_maxDfas;
+  /** The cached regular expressions, the one used last first */
+  std::list<Node> d_lru;
+  /** The automaton of a cached regular expression and its position in d_lru */
+  typedef std::pair<std::shared_ptr<RegExpDfa>, std::list<Node>::iterator>
+      CacheEntry;
+  /** Maps regular expressions to their automata */
+  std::unordered_map<Node, CacheEntry, NodeHashFunction> d_dfas;
+};
+
+}  // namespace strings
+}  // namespace theory
+}  // namespace CVC4
+
+#endif /* CVC4__THEORY__STRINGS__REGEXP_DFA_H */
@@ -589,6 +589,50 @@ bool RegExpEntail::testConstStringInRegExp(CVC4::String& s,
   }
 }
 
+bool RegExpEntail::testConstStringInRegExp(CVC4::String& s,
+                                           unsigned index_start,
+                                           TNode r,
+                                           RegExpDfaCache& cache)
+{
+  Assert(index_start <= s.size());
+  std::shared_ptr<RegExpDfa> dfa = cache.getDfa(r);
+  if (dfa != nullptr)
+  {
+    return dfa->accepts(s, index_start);
+  }
+  switch (r.getKind())
+  {
+    case REGEXP_UNION:
+    {
+      for (const Node& rc : r)
+      {
+        if (testConstStringInRegExp(s, index_start, rc, cache))
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+    case REGEXP_INTER:
+    {
+      for (const Node& rc : r)
+      {
+        if (!testConstStringInRegExp(s, index_start, rc, cache))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+    case REGEXP_COMPLEMENT:
+    {
+      return !testConstStringInRegExp(s, index_start, r[0], cache);
+    }
+    default: break;
+  }
+  return testConstStringInRegExp(s, index_start, r);
+}
+
 bool RegExpEntail::hasEpsilonNode(TNode node)
 {
   for (const Node& nc : node)
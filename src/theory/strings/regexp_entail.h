@@ -22,6 +22,7 @@
 #include <vector>
 
 #include "expr/attribute.h"
+#include "theory/strings/regexp_dfa.h"
 #include "theory/strings/rewrites.h"
 #include "theory/theory_rewriter.h"
 #include "theory/type_enumerator.h"
@@ -100,6 +101,17 @@ class RegExpEntail
   static bool testConstStringInRegExp(CVC4::String& s,
                                       unsigned index_start,
                                       TNode r);
+  /**
+   * Same as above, but uses the automata in cache for the regular expressions
+   * that can be compiled (see RegExpDfa::compile), which takes time linear in
+   * the length of s. Unions, intersections and complements of such regular
+   * expressions are handled by recursion, other regular expressions by the
+   * method above.
+   */
+  static bool testConstStringInRegExp(CVC4::String& s,
+                                      unsigned index_start,
+                                      TNode r,
+                                      RegExpDfaCache& cache);
   /** Does regular expression node have (str.to.re "") as a child? */
   static bool hasEpsilonNode(TNode node);
   /** get length for regular expression
@@ -709,17 +709,17 @@ Node RegExpOpr::derivativeSingle( Node r, CVC4::String c ) {
   return retNode;
 }
 
-void RegExpOpr::firstChars(Node r, std::set<unsigned> &pcset, SetNodes &pvset)
+void RegExpOpr::firstChars(Node r, CharSet& pcset, SetNodes& pvset)
 {
   Trace("regexp-fset") << "Start FSET(" << mkString(r) << ")" << std::endl;
-  std::map<Node, std::pair<std::set<unsigned>, SetNodes> >::const_iterator itr =
+  std::map<Node, std::pair<CharSet, SetNodes> >::const_iterator itr =
       d_fset_cache.find(r);
   if(itr != d_fset_cache.end()) {
-    pcset.insert((itr->second).first.begin(), (itr->second).first.end());
+    pcset.insertAll((itr->second).first);
     pvset.insert((itr->second).second.begin(), (itr->second).second.end());
   } else {
     // cset is code points
-    std::set<unsigned> cset;
+    CharSet cset;
     SetNodes vset;
     Kind k = r.getKind();
     switch( k ) {
@@ -730,11 +730,7 @@ void RegExpOpr::firstChars(Node r, std::set<unsigned> &pcset, SetNodes &pvset)
         unsigned a = r[0].getConst<String>().front();
         unsigned b = r[1].getConst<String>().front();
         Assert(a < b);
-        Assert(b < std::numeric_limits<unsigned>::max());
-        for (unsigned c = a; c <= b; c++)
-        {
-          cset.insert(c);
-        }
+        cset.insertRange(a, b);
         break;
       }
       case kind::STRING_TO_REGEXP: {
@@ -805,34 +801,55 @@ void RegExpOpr::firstChars(Node r, std::set<unsigned> &pcset, SetNodes &pvset)
         // regular expression can begin with any character.
         Assert(utils::isRegExpKind(k));
         // can start with any character
-        Assert(d_lastchar < std::numeric_limits<unsigned>::max());
-        for (unsigned i = 0; i <= d_lastchar; i++)
-        {
-          cset.insert(i);
-        }
+        cset.insertRange(0, d_lastchar);
         break;
       }
     }
-    pcset.insert(cset.begin(), cset.end());
+    pcset.insertAll(cset);
     pvset.insert(vset.begin(), vset.end());
-    std::pair<std::set<unsigned>, SetNodes> p(cset, vset);
+    std::pair<CharSet, SetNodes> p(cset, vset);
     d_fset_cache[r] = p;
   }
+  Trace("regexp-fset") << "END FSET(" << mkString(r) << ") = " << pcset
+                       << std::endl;
+}
 
-  if(Trace.isOn("regexp-fset")) {
-    Trace("regexp-fset") << "END FSET(" << mkString(r) << ") = {";
-    for (std::set<unsigned>::const_iterator it = pcset.begin();
-         it != pcset.end();
-         ++it)
+void RegExpOpr::collectCharBounds(Node r, std::set<unsigned>& bounds)
+{
+  std::unordered_set<TNode, TNodeHashFunction> visited;
+  std::vector<TNode> visit;
+  TNode cur;
+  visit.push_back(r);
+  do
+  {
+    cur = visit.back();
+    visit.pop_back();
+    if (visited.find(cur) != visited.end())
+    {
+      continue;
+    }
+    visited.insert(cur);
+    Kind k = cur.getKind();
+    if (k == REGEXP_RANGE)
+    {
+      bounds.insert(cur[0].getConst<String>().front());
+      bounds.insert(cur[1].getConst<String>().front() + 1);
+    }
+    else if (k == STRING_TO_REGEXP)
     {
-      if (it != pcset.begin())
+      // derivatives only test the first character of constant strings
+      if (cur[0].isConst() && Word::getLength(cur[0]) > 0)
       {
-        Trace("regexp-fset") << ",";
-      }
-      Trace("regexp-fset") << (*it);
+        unsigned c = cur[0].getConst<String>().front();
+        bounds.insert(c);
+        bounds.insert(c + 1);
       }
-    Trace("regexp-fset") << "}" << std::endl;
-  }
+    }
+    else if (utils::isRegExpKind(k))
+    {
+      visit.insert(visit.end(), cur.begin(), cur.end());
+    }
+  } while (!visit.empty());
 }
 
 //simplify
@@ -1463,14 +1480,12 @@ Node RegExpOpr::intersectInternal( Node r1, Node r2, std::map< PairNodes, Node >
         rNode = itrcache->second;
       } else {
         Trace("regexp-int-debug") << " ... normal without cache" << std::endl;
-        std::vector<unsigned> cset;
-        std::set<unsigned> cset1, cset2;
+        CharSet cset1, cset2;
         std::set< Node > vset1, vset2;
         firstChars(r1, cset1, vset1);
         firstChars(r2, cset2, vset2);
         Trace("regexp-int-debug") << " ... got fset" << std::endl;
-        std::set_intersection(cset1.begin(), cset1.end(), cset2.begin(), cset2.end(),
-             std::inserter(cset, cset.begin()));
+        CharSet cset = cset1.intersect(cset2);
         std::vector< Node > vec_nodes;
         Node delta_exp;
         Trace("regexp-int-debug") << " ... try delta" << std::endl;
@@ -1485,55 +1500,71 @@ Node RegExpOpr::intersectInternal( Node r1, Node r2, std::map< PairNodes, Node >
             Unreachable();
           }
         }
-        if(Trace.isOn("regexp-int-debug")) {
-          Trace("regexp-int-debug") << "Try CSET(" << cset.size() << ") = {";
-          for (std::vector<unsigned>::const_iterator it = cset.begin();
-               it != cset.end();
-               ++it)
-          {
-            if (it != cset.begin())
-            {
-              Trace("regexp-int-debug") << ", ";
-            }
-            Trace("regexp-int-debug") << (*it);
-          }
-          Trace("regexp-int-debug") << std::endl;
-        }
+        Trace("regexp-int-debug")
+            << "Try CSET(" << cset.size() << ") = " << cset << std::endl;
+        // The derivatives of r1 and r2 are the same for all characters in
+        // an interval between two consecutive bounds, hence we compute them
+        // for one character of each such interval only.
+        std::set<unsigned> bounds;
+        collectCharBounds(r1, bounds);
+        collectCharBounds(r2, bounds);
+        NodeManager* nm = NodeManager::currentNM();
         std::map< PairNodes, Node > cacheX;
-        for (std::vector<unsigned>::const_iterator it = cset.begin();
-             it != cset.end();
-             ++it)
+        for (const CharSet::Interval& ci : cset.getIntervals())
         {
-          std::vector<unsigned> cvec;
-          cvec.push_back(*it);
-          String c(cvec);
-          Trace("regexp-int-debug") << "Try character " << c << " ... " << std::endl;
-          Node r1l = derivativeSingle(r1, c);
-          Node r2l = derivativeSingle(r2, c);
-          Trace("regexp-int-debug") << "  ... got partial(r1,c) = " << mkString(r1l) << std::endl;
-          Trace("regexp-int-debug") << "  ... got partial(r2,c) = " << mkString(r2l) << std::endl;
-          Node rt;
-          
-          if(r1l > r2l) {
-            Node tnode = r1l;
-            r1l = r2l; r2l = tnode;
-          }
-          PairNodes pp(r1l, r2l);
-          std::map< PairNodes, Node >::const_iterator itr2 = cacheX.find(pp);
-          if(itr2 != cacheX.end()) {
-            rt = itr2->second;
-          } else {
-            std::map< PairNodes, Node > cache2(cache);
-            cache2[ p ] = NodeManager::currentNM()->mkNode(kind::REGEXP_RV, NodeManager::currentNM()->mkConst(CVC4::Rational(cnt)));
-            rt = intersectInternal(r1l, r2l, cache2, cnt+1);
-            cacheX[ pp ] = rt;
-          }
+          unsigned lo = ci.first;
+          while (lo <= ci.second)
+          {
+            std::set<unsigned>::const_iterator itb = bounds.upper_bound(lo);
+            unsigned hi = itb == bounds.end() || *itb > ci.second
+                              ? ci.second
+                              : *itb - 1;
+            std::vector<unsigned> cvec;
+            cvec.push_back(lo);
+            String c(cvec);
+            Trace("regexp-int-debug") << "Try characters " << lo << "-" << hi
+                                      << " ... " << std::endl;
+            Node r1l = derivativeSingle(r1, c);
+            Node r2l = derivativeSingle(r2, c);
+            Trace("regexp-int-debug") << "  ... got partial(r1,c) = " << mkString(r1l) << std::endl;
+            Trace("regexp-int-debug") << "  ... got partial(r2,c) = " << mkString(r2l) << std::endl;
+            Node rt;
 
-          rt = Rewriter::rewrite( NodeManager::currentNM()->mkNode(kind::REGEXP_CONCAT,
-            NodeManager::currentNM()->mkNode(kind::STRING_TO_REGEXP, NodeManager::currentNM()->mkConst(c)), rt) );
+            if(r1l > r2l) {
+              Node tnode = r1l;
+              r1l = r2l; r2l = tnode;
+            }
+            PairNodes pp(r1l, r2l);
+            std::map< PairNodes, Node >::const_iterator itr2 = cacheX.find(pp);
+            if(itr2 != cacheX.end()) {
+              rt = itr2->second;
+            } else {
+              std::map< PairNodes, Node > cache2(cache);
+              cache2[p] = nm->mkNode(kind::REGEXP_RV,
+                                     nm->mkConst(CVC4::Rational(cnt)));
+              rt = intersectInternal(r1l, r2l, cache2, cnt+1);
+              cacheX[ pp ] = rt;
+            }
 
-          Trace("regexp-int-debug") << "  ... got p(r1,c) && p(r2,c) = " << mkString(rt) << std::endl;
-          vec_nodes.push_back(rt);
+            Node rc;
+            if (lo == hi)
+            {
+              rc = nm->mkNode(kind::STRING_TO_REGEXP, nm->mkConst(c));
+            }
+            else
+            {
+              std::vector<unsigned> hvec;
+              hvec.push_back(hi);
+              rc = nm->mkNode(kind::REGEXP_RANGE,
+                              nm->mkConst(c),
+                              nm->mkConst(String(hvec)));
+            }
+            rt = Rewriter::rewrite(nm->mkNode(kind::REGEXP_CONCAT, rc, rt));
+
+            Trace("regexp-int-debug") << "  ... got p(r1,c) && p(r2,c) = " << mkString(rt) << std::endl;
+            vec_nodes.push_back(rt);
+            lo = hi + 1;
+          }
         }
         rNode = Rewriter::rewrite( vec_nodes.size()==0 ? d_emptyRegexp : vec_nodes.size()==1 ? vec_nodes[0] :
             NodeManager::currentNM()->mkNode(kind::REGEXP_UNION, vec_nodes) );
@@ -1614,6 +1645,19 @@ Node RegExpOpr::intersect(Node r1, Node r2, bool &spflag) {
   if(checkConstRegExp(r1) && checkConstRegExp(r2)) {
     Node rr1 = removeIntersection(r1);
     Node rr2 = removeIntersection(r2);
+    // if the intersection is empty, which is cheap to check on automata, we
+    // do not need to construct it
+    std::shared_ptr<RegExpDfa> a1 =
+        options::stringRegExpAutomata() ? d_dfaCache.getDfa(rr1) : nullptr;
+    std::shared_ptr<RegExpDfa> a2 =
+        a1 == nullptr ? nullptr : d_dfaCache.getDfa(rr2);
+    if (a2 != nullptr && RegExpDfa::hasWitness(*a1, *a2, false) == 0)
+    {
+      Trace("regexp-intersect") << "INTERSECTION(\n\t" << mkString(r1)
+                                << ",\n\t" << mkString(r2)
+                                << ") is empty" << std::endl;
+      return d_emptyRegexp;
+    }
     std::map< PairNodes, Node > cache;
     Trace("regexp-intersect-node") << "Intersect (1): " << rr1 << std::endl;
     Trace("regexp-intersect-node") << "Intersect (2): " << rr2 << std::endl;
@@ -1756,10 +1800,64 @@ bool RegExpOpr::regExpIncludes(Node r1, Node r2)
     return (*it).second;
   }
   bool result = RegExpEntail::regExpIncludes(r1, r2);
+  if (!result && options::stringRegExpAutomata() && hasAutomaton(r1)
+      && hasAutomaton(r2))
+  {
+    // r1 includes r2 if no string is in r2 and not in r1
+    result = hasWitness({r2, r1}, {true, false}) == 0;
+    Trace("regexp-automata") << "Inclusion of " << mkString(r2) << " in "
+                             << mkString(r1) << " by automata: " << result
+                             << std::endl;
+  }
   d_inclusionCache[std::make_pair(r1, r2)] = result;
   return result;
 }
 
+bool RegExpOpr::hasAutomaton(Node r)
+{
+  return d_dfaCache.getDfa(r) != nullptr;
+}
+
+int RegExpOpr::hasWitness(const std::vector<Node>& res,
+                          const std::vector<bool>& pol)
+{
+  Assert(res.size() == pol.size());
+  // owns the automata while they are used
+  std::vector<std::shared_ptr<RegExpDfa>> owned;
+  std::vector<RegExpDfa*> dfas;
+  std::vector<bool> complement;
+  for (size_t i = 0, nres = res.size(); i < nres; i++)
+  {
+    owned.push_back(d_dfaCache.getDfa(res[i]));
+    Assert(owned.back() != nullptr);
+    dfas.push_back(owned.back().get());
+    complement.push_back(!pol[i]);
+  }
+  return RegExpDfa::hasWitness(dfas, complement);
+}
+
+int RegExpOpr::getWitness(const std::vector<Node>& res,
+                          const std::vector<bool>& pol,
+                          size_t len,
+                          const std::set<String>& exclude,
+                          String& w)
+{
+  Assert(res.size() == pol.size());
+  // owns the automata while they are used
+  std::vector<std::shared_ptr<RegExpDfa>> owned;
+  std::vector<RegExpDfa*> dfas;
+  std::vector<bool> complement;
+  for (size_t i = 0, nres = res.size(); i < nres; i++)
+  {
+    owned.push_back(d_dfaCache.getDfa(res[i]));
+    Assert(owned.back() != nullptr);
+    dfas.push_back(owned.back().get());
+    complement.push_back(!pol[i]);
+  }
+  return RegExpDfa::getWitness(
+      dfas, complement, len, d_lastchar + 1, exclude, w);
+}
+
 }/* CVC4::theory::strings namespace */
 }/* CVC4::theory namespace */
 }/* CVC4 namespace */
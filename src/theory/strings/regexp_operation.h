@@ -27,6 +27,8 @@
 #include "util/string.h"
 #include "theory/theory.h"
 #include "theory/rewriter.h"
+#include "theory/strings/char_set.h"
+#include "theory/strings/regexp_dfa.h"
 
 namespace CVC4 {
 namespace theory {
@@ -81,13 +83,14 @@ class RegExpOpr {
   std::map<Node, std::pair<Node, int> > d_compl_cache;
   /** cache mapping regular expressions to whether they contain constants */
   std::unordered_map<Node, RegExpConstType, NodeHashFunction> d_constCache;
-  std::map<Node, std::pair<std::set<unsigned>, std::set<Node> > > d_cset_cache;
-  std::map<Node, std::pair<std::set<unsigned>, std::set<Node> > > d_fset_cache;
+  std::map<Node, std::pair<CharSet, std::set<Node> > > d_fset_cache;
   std::map<PairNodes, Node> d_inter_cache;
   std::map<Node, Node> d_rm_inter_cache;
   std::map<Node, bool> d_norv_cache;
   std::map<Node, std::vector<PairNodes> > d_split_cache;
   std::map<PairNodes, bool> d_inclusionCache;
+  /** The automata for the constant regular expressions we have intersected */
+  RegExpDfaCache d_dfaCache;
   void simplifyPRegExp(Node s, Node r, std::vector<Node> &new_nodes);
   void simplifyNRegExp(Node s, Node r, std::vector<Node> &new_nodes);
   /**
@@ -107,7 +110,19 @@ class RegExpOpr {
                          std::map<PairNodes, Node> cache,
                          unsigned cnt);
   Node removeIntersection(Node r);
-  void firstChars(Node r, std::set<unsigned> &pcset, SetNodes &pvset);
+  /**
+   * Add the code points that words in r may start with to pcset, and the
+   * non-constant strings that words in r may start with to pvset.
+   */
+  void firstChars(Node r, CharSet& pcset, SetNodes& pvset);
+  /**
+   * Add to bounds the smallest code points of the intervals of code points
+   * that the derivatives of r do not distinguish. In other words, the
+   * derivatives of r with respect to code points c and d are the same if no
+   * element b of bounds is such that c < b <= d. Only the code points
+   * tested by re.range and str.to_re in r are added.
+   */
+  void collectCharBounds(Node r, std::set<unsigned>& bounds);
 
  public:
   RegExpOpr();
@@ -151,10 +166,35 @@ class RegExpOpr {
    * Returns true if we can show that the regular expression `r1` includes
    * the regular expression `r2` (i.e. `r1` matches a superset of sequences
    * that `r2` matches). See documentation in RegExpEntail::regExpIncludes for
-   * more details. This call caches the result (which is context-independent),
-   * for performance reasons.
+   * more details. If this check fails and r1 and r2 can be compiled to
+   * automata, inclusion is decided on the automata. This call caches the
+   * result (which is context-independent), for performance reasons.
    */
   bool regExpIncludes(Node r1, Node r2);
+  /**
+   * Returns true if r can be compiled to an automaton (see
+   * RegExpDfa::compile).
+   */
+  bool hasAutomaton(Node r);
+  /**
+   * Is there a string that is in all res[i] for which pol[i] is true, and in
+   * none of the res[i] for which pol[i] is false? Returns 1 if there is, 0 if
+   * there is not, and -1 if this is unknown. This method requires that
+   * hasAutomaton(res[i]) holds for all i.
+   */
+  int hasWitness(const std::vector<Node>& res, const std::vector<bool>& pol);
+  /**
+   * Find a string w of length len in the alphabet, which is in all res[i] for
+   * which pol[i] is true, in none of the res[i] for which pol[i] is false,
+   * and not in exclude. Returns 1 if w was found, 0 if no such string exists,
+   * and -1 if this is unknown. This method requires that hasAutomaton(res[i])
+   * holds for all i.
+   */
+  int getWitness(const std::vector<Node>& res,
+                 const std::vector<bool>& pol,
+                 size_t len,
+                 const std::set<String>& exclude,
+                 String& w);
 };
 
 }/* CVC4::theory::strings namespace */
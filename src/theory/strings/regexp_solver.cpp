@@ -31,6 +31,8 @@ namespace CVC4 {
 namespace theory {
 namespace strings {
 
+const unsigned RegExpSolver::s_maxModelTries = 16;
+
 RegExpSolver::RegExpSolver(SolverState& s,
                            InferenceManager& im,
                            CoreSolver& cs,
@@ -61,6 +63,7 @@ Node RegExpSolver::mkAnd(Node c1, Node c2)
 
 void RegExpSolver::checkMemberships()
 {
+  d_modelMems.clear();
   // add the memberships
   std::vector<Node> mems = d_esolver.getActive(STRING_IN_REGEXP);
   // maps representatives to regular expression memberships in that class
@@ -103,6 +106,11 @@ void RegExpSolver::check(const std::map<Node, std::vector<Node> >& mems)
     std::vector<Node> mems2 = mr.second;
     Trace("regexp-process")
         << "Memberships(" << mr.first << ") = " << mr.second << std::endl;
+    if (options::stringRegExpAutomata() && !checkEqcAutomata(mems2))
+    {
+      // conflict discovered, return
+      return;
+    }
     if (!checkEqcInclusion(mems2))
     {
       // conflict discovered, return
@@ -240,6 +248,15 @@ void RegExpSolver::check(const std::map<Node, std::vector<Node> >& mems)
           // than disequalities), and are easier to check.
           continue;
         }
+        if (r == atom[1] && isModelMembership(x, nx, r, polarity))
+        {
+          // do not unfold, the model value of x will satisfy this membership
+          Trace("strings-regexp")
+              << "Defer membership to model construction : " << assertion
+              << std::endl;
+          d_modelMems[rep].push_back(assertion);
+          continue;
+        }
         if (polarity)
         {
           flag = checkPDerivative(x, r, atom, addedLemma, rnfexp);
@@ -332,6 +349,191 @@ void RegExpSolver::check(const std::map<Node, std::vector<Node> >& mems)
   }
 }
 
+bool RegExpSolver::isModelMembership(Node x, Node nx, Node r, bool polarity)
+{
+  if (!options::stringModelFind() || !x.getType().isString())
+  {
+    return false;
+  }
+  if (!polarity && !options::stringExp())
+  {
+    return false;
+  }
+  // the normal form of x must be a single variable
+  if (nx.isConst() || nx.getKind() == STRING_CONCAT)
+  {
+    return false;
+  }
+  return d_regexp_opr.checkConstRegExp(r) && d_regexp_opr.hasAutomaton(r);
+}
+
+void RegExpSolver::checkMembershipsModel()
+{
+  NodeManager* nm = NodeManager::currentNM();
+  TheoryModel* m = d_state.getModel();
+  for (const std::pair<const Node, std::vector<Node> >& mm : d_modelMems)
+  {
+    for (const Node& assertion : mm.second)
+    {
+      bool polarity = assertion.getKind() != NOT;
+      Node atom = polarity ? assertion : assertion[0];
+      Node mv = m->getValue(atom[0]);
+      Node mem = Rewriter::rewrite(nm->mkNode(STRING_IN_REGEXP, mv, atom[1]));
+      Trace("strings-regexp-model")
+          << "Membership " << assertion << " with model value " << mv
+          << " evaluates to " << mem << std::endl;
+      if (mem.isConst() && mem.getConst<bool>() == polarity)
+      {
+        continue;
+      }
+      // the bounded search did not succeed, unfold the membership as usual
+      std::vector<Node> nvec;
+      d_regexp_opr.simplify(atom, nvec, polarity);
+      if (nvec.empty())
+      {
+        d_im.setIncomplete();
+        continue;
+      }
+      std::vector<Node> exp;
+      std::vector<Node> exp_n;
+      exp_n.push_back(assertion);
+      Node conc = nvec.size() == 1 ? nvec[0] : nm->mkNode(AND, nvec);
+      if (polarity)
+      {
+        d_statistics.d_regexpUnfoldingsPos << atom[1].getKind();
+      }
+      else
+      {
+        d_statistics.d_regexpUnfoldingsNeg << atom[1].getKind();
+      }
+      Inference inf =
+          polarity ? Inference::RE_UNFOLD_POS : Inference::RE_UNFOLD_NEG;
+      d_im.sendInference(exp, exp_n, conc, inf);
+      d_regexp_ucached.insert(assertion);
+    }
+  }
+}
+
+Node RegExpSolver::findModelValue(Node r, size_t len, TheoryModel* m)
+{
+  std::map<Node, std::vector<Node> >::const_iterator it = d_modelMems.find(r);
+  if (it == d_modelMems.end())
+  {
+    return Node::null();
+  }
+  std::vector<Node> res;
+  std::vector<bool> pol;
+  for (const Node& assertion : it->second)
+  {
+    bool polarity = assertion.getKind() != NOT;
+    res.push_back(polarity ? assertion[1] : assertion[0][1]);
+    pol.push_back(polarity);
+  }
+  // the strings that are already values in the model
+  std::set<String> exclude;
+  NodeManager* nm = NodeManager::currentNM();
+  for (unsigned i = 0; i < s_maxModelTries; i++)
+  {
+    String w;
+    if (d_regexp_opr.getWitness(res, pol, len, exclude, w) != 1)
+    {
+      break;
+    }
+    Node c = nm->mkConst(w);
+    if (!m->hasTerm(c))
+    {
+      Trace("strings-regexp-model")
+          << "Found model value " << c << " for " << r << std::endl;
+      ++(d_statistics.d_regexpModelValues);
+      return c;
+    }
+    exclude.insert(w);
+  }
+  Trace("strings-regexp-model")
+      << "No model value of length " << len << " for " << r << std::endl;
+  return Node::null();
+}
+
+bool RegExpSolver::checkEqcAutomata(const std::vector<Node>& mems)
+{
+  std::vector<Node> lits;
+  for (const Node& m : mems)
+  {
+    Node mLit = m.getKind() == NOT ? m[0] : m;
+    if (d_regexp_opr.hasAutomaton(mLit[1]))
+    {
+      lits.push_back(m);
+    }
+  }
+  if (lits.size() < 2)
+  {
+    return true;
+  }
+  std::sort(lits.begin(), lits.end());
+  NodeManager* nm = NodeManager::currentNM();
+  Node conj = nm->mkNode(AND, lits);
+  if (d_automataSat.find(conj) != d_automataSat.end()
+      || d_automataUnknown.find(conj) != d_automataUnknown.end())
+  {
+    return true;
+  }
+  std::vector<Node> res;
+  std::vector<bool> pol;
+  for (const Node& m : lits)
+  {
+    bool mPol = m.getKind() != NOT;
+    res.push_back(mPol ? m[1] : m[0][1]);
+    pol.push_back(mPol);
+  }
+  int wres = d_regexp_opr.hasWitness(res, pol);
+  if (wres == 1)
+  {
+    d_automataSat.insert(conj);
+    return true;
+  }
+  else if (wres == -1)
+  {
+    // the product is too large to be explored, hence we do not know whether
+    // the memberships are satisfiable, and they are processed by the
+    // remaining checks and unfolded as usual
+    d_automataUnknown.insert(conj);
+    return true;
+  }
+  // minimize the conflict by removing the memberships it does not depend on
+  for (size_t i = 0; i < lits.size() && lits.size() > 1;)
+  {
+    std::vector<Node> resi = res;
+    std::vector<bool> poli = pol;
+    resi.erase(resi.begin() + i);
+    poli.erase(poli.begin() + i);
+    if (d_regexp_opr.hasWitness(resi, poli) == 0)
+    {
+      lits.erase(lits.begin() + i);
+      res.swap(resi);
+      pol.swap(poli);
+    }
+    else
+    {
+      i++;
+    }
+  }
+  Trace("regexp-automata") << "Conflict by automata: " << lits << std::endl;
+  std::vector<Node> vec_nodes;
+  Node x = lits[0].getKind() == NOT ? lits[0][0][0] : lits[0][0];
+  for (const Node& m : lits)
+  {
+    vec_nodes.push_back(m);
+    Node y = m.getKind() == NOT ? m[0][0] : m[0];
+    if (x != y)
+    {
+      vec_nodes.push_back(x.eqNode(y));
+    }
+  }
+  Node conc;
+  d_im.sendInference(vec_nodes, conc, Inference::RE_INTER_AUTOMATA_CONF, true);
+  return false;
+}
+
 bool RegExpSolver::checkEqcInclusion(std::vector<Node>& mems)
 {
   std::unordered_set<Node, NodeHashFunction> remove;
@@ -19,6 +19,8 @@
 #define CVC4__THEORY__STRINGS__REGEXP_SOLVER_H
 
 #include <map>
+#include <unordered_set>
+
 #include "context/cdhashset.h"
 #include "context/cdlist.h"
 #include "context/context.h"
@@ -62,6 +64,25 @@ class RegExpSolver
    * FroCoS 2015.
    */
   void checkMemberships();
+  /** check regular expression memberships in the model
+   *
+   * This checks whether the memberships that checkMemberships did not unfold
+   * since they are satisfied during model construction (see findModelValue)
+   * hold in the current model, which is only available at last call effort.
+   * Those that do not hold are unfolded.
+   */
+  void checkMembershipsModel();
+  /** Are there memberships that are satisfied during model construction? */
+  bool hasModelMemberships() const { return !d_modelMems.empty(); }
+  /**
+   * Find a value of length len for the string equivalence class r that
+   * satisfies the memberships of r that checkMemberships did not unfold, and
+   * that is not already a term of model m. This uses a bounded search on the
+   * automata of the regular expressions of these memberships. Returns the null
+   * node if there are no such memberships, or if the search did not find a
+   * value.
+   */
+  Node findModelValue(Node r, size_t len, TheoryModel* m);
 
  private:
   /** check
@@ -76,6 +97,24 @@ class RegExpSolver
    * engine of the theory of strings.
    */
   void check(const std::map<Node, std::vector<Node>>& mems);
+  /**
+   * Check memberships in equivalence class using automata.
+   *
+   * This method returns false if it discovered a conflict for this set of
+   * assertions, and true otherwise. It discovers a conflict if the product of
+   * the automata for the regular expressions of the positive memberships in
+   * mems and the complements of the automata for the regular expressions of
+   * the negative memberships in mems has no accepting state. Only memberships
+   * in regular expressions that can be compiled to automata are considered,
+   * and the conflict is minimized by removing memberships that are not
+   * needed for it.
+   *
+   * @param mems Vector of memberships of the form: (~)str.in.re(x1, R1)
+   *             ... (~)str.in.re(xn, Rn) where x1 = ... = xn in the
+   *             current context.
+   * @return False if a conflict was detected, true otherwise
+   */
+  bool checkEqcAutomata(const std::vector<Node>& mems);
   /**
    * Check memberships in equivalence class for regular expression
    * inclusion.
@@ -150,6 +189,34 @@ class RegExpSolver
   NodeSet d_processed_memberships;
   /** regular expression operation module */
   RegExpOpr d_regexp_opr;
+  /**
+   * The conjunctions of memberships that we have shown to be satisfiable in
+   * checkEqcAutomata, which is independent of the context.
+   */
+  std::unordered_set<Node, NodeHashFunction> d_automataSat;
+  /**
+   * The conjunctions of memberships for which checkEqcAutomata gave up, since
+   * the product of their automata has too many states.
+   */
+  std::unordered_set<Node, NodeHashFunction> d_automataUnknown;
+  /**
+   * Maps the representatives of pure equivalence classes, whose normal form
+   * is a single variable, to the memberships in constant regular expressions
+   * that we did not unfold in the last call to checkMemberships, since the
+   * model value of the class is constructed to satisfy them
+   * (--strings-model-find).
+   */
+  std::map<Node, std::vector<Node> > d_modelMems;
+  /**
+   * The maximal number of values findModelValue considers that are already
+   * terms of the model
+   */
+  static const unsigned s_maxModelTries;
+  /**
+   * Is the membership assertion of x in r, whose normal form is nx in r, one
+   * that is satisfied during model construction?
+   */
+  bool isModelMembership(Node x, Node nx, Node r, bool polarity);
 }; /* class TheoryStrings */
 
 }  // namespace strings
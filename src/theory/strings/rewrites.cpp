@@ -204,6 +204,12 @@ const char* toString(Rewrite r)
     case Rewrite::LEN_CONV_INV: return "LEN_CONV_INV";
     case Rewrite::CHARAT_ELIM: return "CHARAT_ELIM";
     case Rewrite::SEQ_UNIT_EVAL: return "SEQ_UNIT_EVAL";
+    case Rewrite::LEN_UPDATE_INV: return "LEN_UPDATE_INV";
+    case Rewrite::SEQ_NTH_EVAL: return "SEQ_NTH_EVAL";
+    case Rewrite::SEQ_NTH_UNIT: return "SEQ_NTH_UNIT";
+    case Rewrite::UPDATE_EVAL: return "UPDATE_EVAL";
+    case Rewrite::UPDATE_EMPTY: return "UPDATE_EMPTY";
+    case Rewrite::UPDATE_OOB: return "UPDATE_OOB";
     default: return "?";
   }
 }
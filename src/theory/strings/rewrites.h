@@ -206,7 +206,13 @@ enum class Rewrite : uint32_t
   LEN_REPL_INV,
   LEN_CONV_INV,
   CHARAT_ELIM,
-  SEQ_UNIT_EVAL
+  SEQ_UNIT_EVAL,
+  LEN_UPDATE_INV,
+  SEQ_NTH_EVAL,
+  SEQ_NTH_UNIT,
+  UPDATE_EVAL,
+  UPDATE_EMPTY,
+  UPDATE_OOB
 };
 
 /**
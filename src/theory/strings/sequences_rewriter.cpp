@@ -18,6 +18,7 @@
 
 #include "expr/attribute.h"
 #include "expr/node_builder.h"
+#include "expr/sequence.h"
 #include "theory/rewriter.h"
 #include "theory/strings/arith_entail.h"
 #include "theory/strings/regexp_entail.h"
@@ -576,6 +577,12 @@ Node SequencesRewriter::rewriteLength(Node node)
     Node retNode = nm->mkNode(STRING_LENGTH, node[0][0]);
     return returnRewrite(node, retNode, Rewrite::LEN_CONV_INV);
   }
+  else if (nk0 == STRING_UPDATE)
+  {
+    // len( str.update( x, n, y ) ) == len( x )
+    Node retNode = nm->mkNode(STRING_LENGTH, node[0][0]);
+    return returnRewrite(node, retNode, Rewrite::LEN_UPDATE_INV);
+  }
   return node;
 }
 
@@ -794,7 +801,8 @@ Node SequencesRewriter::rewriteConcatRegExp(TNode node)
       // if empty, drop it
       // e.g. this ensures we rewrite (_)* ++ (a)* ---> (_)*
       if (RegExpEntail::isConstRegExp(curr)
-          && RegExpEntail::testConstStringInRegExp(emptyStr, 0, curr))
+          && RegExpEntail::testConstStringInRegExp(
+                 emptyStr, 0, curr, d_dfaCache))
       {
         curr = Node::null();
       }
@@ -817,7 +825,7 @@ Node SequencesRewriter::rewriteConcatRegExp(TNode node)
           // e.g. this ensures we rewrite (a)* ++ (_)* ---> (_)*
           while (!cvec.empty() && RegExpEntail::isConstRegExp(cvec.back())
                  && RegExpEntail::testConstStringInRegExp(
-                     emptyStr, 0, cvec.back()))
+                     emptyStr, 0, cvec.back(), d_dfaCache))
           {
             cvec.pop_back();
           }
@@ -1132,7 +1140,7 @@ Node SequencesRewriter::rewriteMembership(TNode node)
   {
     // test whether x in node[1]
     CVC4::String s = x.getConst<String>();
-    bool test = RegExpEntail::testConstStringInRegExp(s, 0, r);
+    bool test = RegExpEntail::testConstStringInRegExp(s, 0, r, d_dfaCache);
     Node retNode = NodeManager::currentNM()->mkConst(test);
     return returnRewrite(node, retNode, Rewrite::RE_IN_EVAL);
   }
@@ -1473,10 +1481,18 @@ RewriteResponse SequencesRewriter::postRewrite(TNode node)
   {
     retNode = rewriteRepeatRegExp(node);
   }
+  else if (nk == STRING_UPDATE)
+  {
+    retNode = rewriteUpdate(node);
+  }
   else if (nk == SEQ_UNIT)
   {
     retNode = rewriteSeqUnit(node);
   }
+  else if (nk == SEQ_NTH)
+  {
+    retNode = rewriteSeqNth(node);
+  }
 
   Trace("sequences-postrewrite")
       << "Strings::SequencesRewriter::postRewrite returning " << retNode
@@ -2954,7 +2970,7 @@ Node SequencesRewriter::rewriteReplaceRe(Node node)
   }
   // str.replace_re( x, y, z ) ---> z ++ x if "" in y ---> true
   String emptyStr("");
-  if (RegExpEntail::testConstStringInRegExp(emptyStr, 0, y))
+  if (RegExpEntail::testConstStringInRegExp(emptyStr, 0, y, d_dfaCache))
   {
     Node ret = nm->mkNode(STRING_CONCAT, z, x);
     return returnRewrite(node, ret, Rewrite::REPLACE_RE_EMP_RE);
@@ -3005,15 +3021,32 @@ std::pair<size_t, size_t> SequencesRewriter::firstMatch(Node n, Node r)
   Assert(n.isConst() && n.getType().isStringLike());
   Assert(r.getType().isRegExp());
   NodeManager* nm = NodeManager::currentNM();
+  String s = n.getConst<String>();
+
+  std::shared_ptr<RegExpDfa> dfa = d_dfaCache.getDfa(r);
+  if (dfa != nullptr)
+  {
+    // the automaton is run from each position in turn, until the shortest
+    // match starting there is found or its dead state is reached, which is
+    // quadratic in the size of s in the worst case
+    for (size_t i = 0, size = s.size(); i <= size; i++)
+    {
+      int len = dfa->shortestMatch(s, i);
+      if (len >= 0)
+      {
+        return std::make_pair(i, i + len);
+      }
+    }
+    return std::make_pair(string::npos, string::npos);
+  }
 
   std::vector<Node> emptyVec;
   Node sigmaStar = nm->mkNode(REGEXP_STAR, nm->mkNode(REGEXP_SIGMA, emptyVec));
   Node re = nm->mkNode(REGEXP_CONCAT, r, sigmaStar);
-  String s = n.getConst<String>();
 
   if (s.size() == 0)
   {
-    if (RegExpEntail::testConstStringInRegExp(s, 0, r))
+    if (RegExpEntail::testConstStringInRegExp(s, 0, r, d_dfaCache))
     {
       return std::make_pair(0, 0);
     }
@@ -3025,12 +3058,12 @@ std::pair<size_t, size_t> SequencesRewriter::firstMatch(Node n, Node r)
 
   for (size_t i = 0, size = s.size(); i < size; i++)
   {
-    if (RegExpEntail::testConstStringInRegExp(s, i, re))
+    if (RegExpEntail::testConstStringInRegExp(s, i, re, d_dfaCache))
     {
       for (size_t j = i; j <= size; j++)
       {
         String substr = s.substr(i, j - i);
-        if (RegExpEntail::testConstStringInRegExp(substr, 0, r))
+        if (RegExpEntail::testConstStringInRegExp(substr, 0, r, d_dfaCache))
         {
           return std::make_pair(i, j);
         }
@@ -3240,6 +3273,79 @@ Node SequencesRewriter::rewriteSeqUnit(Node node)
   return node;
 }
 
+Node SequencesRewriter::rewriteSeqNth(Node node)
+{
+  Assert(node.getKind() == SEQ_NTH);
+  Node s = node[0];
+  Node i = node[1];
+  if (!i.isConst())
+  {
+    return node;
+  }
+  // the value of nth out of bounds is unspecified, which is why we only
+  // rewrite within bounds
+  const Rational& ri = i.getConst<Rational>();
+  if (s.isConst())
+  {
+    const std::vector<Node>& vec =
+        s.getConst<ExprSequence>().getSequence().getVec();
+    if (ri.sgn() >= 0 && ri < Rational(vec.size()))
+    {
+      Node ret = vec[ri.getNumerator().toUnsignedInt()];
+      return returnRewrite(node, ret, Rewrite::SEQ_NTH_EVAL);
+    }
+  }
+  else if (s.getKind() == SEQ_UNIT && ri.isZero())
+  {
+    return returnRewrite(node, s[0], Rewrite::SEQ_NTH_UNIT);
+  }
+  return node;
+}
+
+Node SequencesRewriter::rewriteUpdate(Node node)
+{
+  Assert(node.getKind() == STRING_UPDATE);
+  Node s = node[0];
+  Node i = node[1];
+  Node t = node[2];
+  if (t.isConst() && Word::isEmpty(t))
+  {
+    // str.update( s, i, "" ) ---> s
+    return returnRewrite(node, s, Rewrite::UPDATE_EMPTY);
+  }
+  if (!i.isConst())
+  {
+    return node;
+  }
+  const Rational& ri = i.getConst<Rational>();
+  if (ri.sgn() < 0)
+  {
+    // str.update( s, i, t ) ---> s if i < 0
+    return returnRewrite(node, s, Rewrite::UPDATE_OOB);
+  }
+  if (!s.isConst())
+  {
+    return node;
+  }
+  size_t len = Word::getLength(s);
+  if (ri >= Rational(len))
+  {
+    return returnRewrite(node, s, Rewrite::UPDATE_OOB);
+  }
+  if (t.isConst())
+  {
+    size_t start = ri.getNumerator().toUnsignedInt();
+    size_t tlen = std::min(Word::getLength(t), len - start);
+    std::vector<Node> children;
+    children.push_back(Word::prefix(s, start));
+    children.push_back(Word::prefix(t, tlen));
+    children.push_back(Word::substr(s, start + tlen));
+    Node ret = Word::mkWordFlatten(children);
+    return returnRewrite(node, ret, Rewrite::UPDATE_EVAL);
+  }
+  return node;
+}
+
 Node SequencesRewriter::returnRewrite(Node node, Node ret, Rewrite r)
 {
   Trace("strings-rewrite") << "Rewrite " << node << " to " << ret << " by " << r
@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "expr/node.h"
+#include "theory/strings/regexp_dfa.h"
 #include "theory/strings/rewrites.h"
 #include "theory/strings/sequences_stats.h"
 #include "theory/strings/strings_entail.h"
@@ -257,6 +258,18 @@ class SequencesRewriter : public TheoryRewriter
    * Returns the rewritten form of node.
    */
   Node rewriteSeqUnit(Node node);
+  /** rewrite seq.nth
+   * This is the entry point for post-rewriting terms n of the form
+   *   seq.nth( s, i )
+   * Returns the rewritten form of node.
+   */
+  Node rewriteSeqNth(Node node);
+  /** rewrite str.update
+   * This is the entry point for post-rewriting terms n of the form
+   *   str.update( s, i, t )
+   * Returns the rewritten form of node.
+   */
+  Node rewriteUpdate(Node node);
 
   /** length preserving rewrite
    *
@@ -279,6 +292,9 @@ class SequencesRewriter : public TheoryRewriter
 
   /** Instance of the entailment checker for strings. */
   StringsEntail d_stringsEntail;
+
+  /** The automata for the constant regular expressions we have evaluated. */
+  RegExpDfaCache d_dfaCache;
 }; /* class SequencesRewriter */
 
 }  // namespace strings
@@ -24,11 +24,14 @@ namespace strings {
 SequencesStatistics::SequencesStatistics()
     : d_checkRuns("theory::strings::checkRuns", 0),
       d_strategyRuns("theory::strings::strategyRuns", 0),
+      d_normalFormsComputed("theory::strings::normalFormsComputed", 0),
+      d_normalFormsReused("theory::strings::normalFormsReused", 0),
       d_inferences("theory::strings::inferences"),
       d_cdSimplifications("theory::strings::cdSimplifications"),
       d_reductions("theory::strings::reductions"),
       d_regexpUnfoldingsPos("theory::strings::regexpUnfoldingsPos"),
       d_regexpUnfoldingsNeg("theory::strings::regexpUnfoldingsNeg"),
+      d_regexpModelValues("theory::strings::regexpModelValues", 0),
       d_rewrites("theory::strings::rewrites"),
       d_conflictsEqEngine("theory::strings::conflictsEqEngine", 0),
       d_conflictsEagerPrefix("theory::strings::conflictsEagerPrefix", 0),
@@ -42,11 +45,14 @@ SequencesStatistics::SequencesStatistics()
 {
   smtStatisticsRegistry()->registerStat(&d_checkRuns);
   smtStatisticsRegistry()->registerStat(&d_strategyRuns);
+  smtStatisticsRegistry()->registerStat(&d_normalFormsComputed);
+  smtStatisticsRegistry()->registerStat(&d_normalFormsReused);
   smtStatisticsRegistry()->registerStat(&d_inferences);
   smtStatisticsRegistry()->registerStat(&d_cdSimplifications);
   smtStatisticsRegistry()->registerStat(&d_reductions);
   smtStatisticsRegistry()->registerStat(&d_regexpUnfoldingsPos);
   smtStatisticsRegistry()->registerStat(&d_regexpUnfoldingsNeg);
+  smtStatisticsRegistry()->registerStat(&d_regexpModelValues);
   smtStatisticsRegistry()->registerStat(&d_rewrites);
   smtStatisticsRegistry()->registerStat(&d_conflictsEqEngine);
   smtStatisticsRegistry()->registerStat(&d_conflictsEagerPrefix);
@@ -62,11 +68,14 @@ SequencesStatistics::~SequencesStatistics()
 {
   smtStatisticsRegistry()->unregisterStat(&d_checkRuns);
   smtStatisticsRegistry()->unregisterStat(&d_strategyRuns);
+  smtStatisticsRegistry()->unregisterStat(&d_normalFormsComputed);
+  smtStatisticsRegistry()->unregisterStat(&d_normalFormsReused);
   smtStatisticsRegistry()->unregisterStat(&d_inferences);
   smtStatisticsRegistry()->unregisterStat(&d_cdSimplifications);
   smtStatisticsRegistry()->unregisterStat(&d_reductions);
   smtStatisticsRegistry()->unregisterStat(&d_regexpUnfoldingsPos);
   smtStatisticsRegistry()->unregisterStat(&d_regexpUnfoldingsNeg);
+  smtStatisticsRegistry()->unregisterStat(&d_regexpModelValues);
   smtStatisticsRegistry()->unregisterStat(&d_rewrites);
   smtStatisticsRegistry()->unregisterStat(&d_conflictsEqEngine);
   smtStatisticsRegistry()->unregisterStat(&d_conflictsEagerPrefix);
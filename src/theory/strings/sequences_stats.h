@@ -59,6 +59,13 @@ class SequencesStatistics
   IntStat d_checkRuns;
   /** Number of calls to run the strategy */
   IntStat d_strategyRuns;
+  /** Number of normal forms of equivalence classes that were computed */
+  IntStat d_normalFormsComputed;
+  /**
+   * Number of normal forms of equivalence classes that were reused from a
+   * previous check (see options::stringIncNormalForms)
+   */
+  IntStat d_normalFormsReused;
   //--------------- inferences
   /** Counts the number of applications of each type of inference */
   HistogramStat<Inference> d_inferences;
@@ -81,6 +88,12 @@ class SequencesStatistics
    */
   HistogramStat<Kind> d_regexpUnfoldingsPos;
   HistogramStat<Kind> d_regexpUnfoldingsNeg;
+  /**
+   * Number of values of equivalence classes that were found by searching the
+   * automata of their regular expression memberships (see
+   * options::stringModelFind)
+   */
+  IntStat d_regexpModelValues;
   //--------------- end of inferences
   /** Counts the number of applications of each type of rewrite rule */
   HistogramStat<Rewrite> d_rewrites;
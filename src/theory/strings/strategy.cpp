@@ -33,9 +33,11 @@ std::ostream& operator<<(std::ostream& out, InferStep s)
     case CHECK_NORMAL_FORMS_EQ: out << "check_normal_forms_eq"; break;
     case CHECK_NORMAL_FORMS_DEQ: out << "check_normal_forms_deq"; break;
     case CHECK_CODES: out << "check_codes"; break;
+    case CHECK_SEQUENCES_ARRAY: out << "check_sequences_array"; break;
     case CHECK_LENGTH_EQC: out << "check_length_eqc"; break;
     case CHECK_EXTF_REDUCTION: out << "check_extf_reduction"; break;
     case CHECK_MEMBERSHIP: out << "check_membership"; break;
+    case CHECK_MEMBERSHIP_MODEL: out << "check_membership_model"; break;
     case CHECK_CARDINALITY: out << "check_cardinality"; break;
     default: out << "?"; break;
   }
@@ -112,6 +114,10 @@ void Strategy::initializeStrategy()
       // do only the above inferences at standard effort, if applicable
       step_end[Theory::EFFORT_STANDARD] = d_infer_steps.size() - 1;
     }
+    if (options::seqArray())
+    {
+      addStrategyStep(CHECK_SEQUENCES_ARRAY);
+    }
     if (!options::stringEagerLen())
     {
       addStrategyStep(CHECK_REGISTER_TERMS_PRE_NF);
@@ -136,12 +142,20 @@ void Strategy::initializeStrategy()
     addStrategyStep(CHECK_MEMBERSHIP);
     addStrategyStep(CHECK_CARDINALITY);
     step_end[Theory::EFFORT_FULL] = d_infer_steps.size() - 1;
-    if (options::stringExp() && options::stringGuessModel())
+    bool guessModel = options::stringExp() && options::stringGuessModel();
+    if (guessModel || options::stringModelFind())
     {
       step_begin[Theory::EFFORT_LAST_CALL] = d_infer_steps.size();
-      // these two steps are run in parallel
-      addStrategyStep(CHECK_EXTF_REDUCTION, 2, false);
-      addStrategyStep(CHECK_EXTF_EVAL, 3);
+      if (guessModel)
+      {
+        // these two steps are run in parallel
+        addStrategyStep(CHECK_EXTF_REDUCTION, 2, false);
+        addStrategyStep(CHECK_EXTF_EVAL, 3);
+      }
+      if (options::stringModelFind())
+      {
+        addStrategyStep(CHECK_MEMBERSHIP_MODEL);
+      }
       step_end[Theory::EFFORT_LAST_CALL] = d_infer_steps.size() - 1;
     }
     // set the beginning/ending ranges
@@ -54,6 +54,8 @@ enum InferStep
   CHECK_NORMAL_FORMS_DEQ,
   // check codes
   CHECK_CODES,
+  // check array-style reasoning over seq.nth and seq.update terms
+  CHECK_SEQUENCES_ARRAY,
   // check lengths for equivalence classes
   CHECK_LENGTH_EQC,
   // check register terms for normal forms
@@ -62,6 +64,8 @@ enum InferStep
   CHECK_EXTF_REDUCTION,
   // check regular expression memberships
   CHECK_MEMBERSHIP,
+  // check regular expression memberships in the model
+  CHECK_MEMBERSHIP_MODEL,
   // check cardinality
   CHECK_CARDINALITY,
 };
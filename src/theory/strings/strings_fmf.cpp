@@ -28,6 +28,7 @@ StringsFmf::StringsFmf(context::Context* c,
                        Valuation valuation,
                        TermRegistry& tr)
     : d_sslds(nullptr),
+      d_lengthLowerBound(u, Rational(0)),
       d_satContext(c),
       d_userContext(u),
       d_valuation(valuation),
@@ -40,7 +41,7 @@ StringsFmf::~StringsFmf() {}
 void StringsFmf::presolve()
 {
   d_sslds.reset(new StringSumLengthDecisionStrategy(
-      d_satContext, d_userContext, d_valuation));
+      d_satContext, d_userContext, d_valuation, d_lengthLowerBound.get()));
   Trace("strings-dstrat-reg")
       << "presolve: register decision strategy." << std::endl;
   const NodeSet& ivars = d_termReg.getInputVars();
@@ -57,9 +58,22 @@ DecisionStrategy* StringsFmf::getDecisionStrategy() const
   return d_sslds.get();
 }
 
+void StringsFmf::notifyLengthLowerBound(const Rational& lb)
+{
+  if (lb > d_lengthLowerBound.get())
+  {
+    Trace("strings-fmf") << "StringsFMF: length lower bound " << lb
+                         << std::endl;
+    d_lengthLowerBound = lb;
+  }
+}
+
 StringsFmf::StringSumLengthDecisionStrategy::StringSumLengthDecisionStrategy(
-    context::Context* c, context::UserContext* u, Valuation valuation)
-    : DecisionStrategyFmf(c, valuation), d_inputVarLsum(u)
+    context::Context* c,
+    context::UserContext* u,
+    Valuation valuation,
+    const Rational& lb)
+    : DecisionStrategyFmf(c, valuation), d_inputVarLsum(u), d_lb(lb)
 {
 }
 
@@ -91,7 +105,8 @@ Node StringsFmf::StringSumLengthDecisionStrategy::mkLiteral(unsigned i)
     return Node::null();
   }
   NodeManager* nm = NodeManager::currentNM();
-  Node lit = nm->mkNode(LEQ, d_inputVarLsum.get(), nm->mkConst(Rational(i)));
+  Node lit = nm->mkNode(
+      LEQ, d_inputVarLsum.get(), nm->mkConst(d_lb + Rational(i)));
   Trace("strings-fmf") << "StringsFMF::mkLiteral: " << lit << std::endl;
   return lit;
 }
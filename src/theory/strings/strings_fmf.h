@@ -24,6 +24,7 @@
 #include "theory/decision_strategy.h"
 #include "theory/strings/term_registry.h"
 #include "theory/valuation.h"
+#include "util/rational.h"
 
 namespace CVC4 {
 namespace theory {
@@ -54,6 +55,12 @@ class StringsFmf
    * of a check-sat call.
    */
   DecisionStrategy* getDecisionStrategy() const;
+  /**
+   * Notify that the sum of lengths of input variables is at least lb in all
+   * models of the current assertions. The decision strategy of subsequent
+   * check-sat calls in this user context starts from this bound.
+   */
+  void notifyLengthLowerBound(const Rational& lb);
 
  private:
   /** String sum of lengths decision strategy
@@ -69,7 +76,8 @@ class StringsFmf
    public:
     StringSumLengthDecisionStrategy(context::Context* c,
                                     context::UserContext* u,
-                                    Valuation valuation);
+                                    Valuation valuation,
+                                    const Rational& lb);
     /** make literal */
     Node mkLiteral(unsigned i) override;
     /** identify */
@@ -91,9 +99,13 @@ class StringsFmf
      * input variables of type string
      */
     context::CDO<Node> d_inputVarLsum;
+    /** The lower bound on the sum, the i^th literal bounds it by d_lb + i */
+    Rational d_lb;
   };
   /** an instance of the above class */
   std::unique_ptr<StringSumLengthDecisionStrategy> d_sslds;
+  /** The lower bound given by notifyLengthLowerBound */
+  context::CDO<Rational> d_lengthLowerBound;
   /** The SAT search context for the theory of strings. */
   context::Context* d_satContext;
   /** The user level assertion context for the theory of strings. */
@@ -51,6 +51,7 @@ TheoryStrings::TheoryStrings(context::Context* c,
       d_csolver(nullptr),
       d_esolver(nullptr),
       d_rsolver(nullptr),
+      d_asolver(nullptr),
       d_stringsFmf(c, u, valuation, d_termReg)
 {
   setupExtTheory();
@@ -60,7 +61,8 @@ TheoryStrings::TheoryStrings(context::Context* c,
       new InferenceManager(c, u, d_state, d_termReg, *extt, out, d_statistics));
   // initialize the solvers
   d_bsolver.reset(new BaseSolver(d_state, *d_im));
-  d_csolver.reset(new CoreSolver(c, u, d_state, *d_im, d_termReg, *d_bsolver));
+  d_csolver.reset(new CoreSolver(
+      c, u, d_state, *d_im, d_termReg, *d_bsolver, d_statistics));
   d_esolver.reset(new ExtfSolver(c,
                                  u,
                                  d_state,
@@ -73,6 +75,7 @@ TheoryStrings::TheoryStrings(context::Context* c,
                                  d_statistics));
   d_rsolver.reset(new RegExpSolver(
       d_state, *d_im, *d_csolver, *d_esolver, d_statistics, c, u));
+  d_asolver.reset(new ArraySolver(u, d_state, *d_im, d_termReg));
 
   // The kinds we are treating as function application in congruence
   d_equalityEngine.addFunctionKind(kind::STRING_LENGTH);
@@ -96,6 +99,8 @@ TheoryStrings::TheoryStrings(context::Context* c,
   d_equalityEngine.addFunctionKind(kind::STRING_TOLOWER);
   d_equalityEngine.addFunctionKind(kind::STRING_TOUPPER);
   d_equalityEngine.addFunctionKind(kind::STRING_REV);
+  d_equalityEngine.addFunctionKind(kind::STRING_UPDATE);
+  d_equalityEngine.addFunctionKind(kind::SEQ_NTH);
 
   d_zero = NodeManager::currentNM()->mkConst( Rational( 0 ) );
   d_one = NodeManager::currentNM()->mkConst( Rational( 1 ) );
@@ -233,6 +238,11 @@ void TheoryStrings::presolve() {
   Debug("strings-presolve") << "Finished presolve" << std::endl;
 }
 
+void TheoryStrings::notifyLengthLowerBound(const Rational& lb)
+{
+  d_stringsFmf.notifyLengthLowerBound(lb);
+}
+
 
 /////////////////////////////////////////////////////////////////////////////
 // MODEL GENERATION
@@ -433,6 +443,16 @@ bool TheoryStrings::collectModelInfoType(
         Node c;
         std::map<Node, Node>::iterator itp = pure_eq_assign.find(eqc);
         if (itp == pure_eq_assign.end())
+        {
+          // find a value satisfying the memberships of eqc that were not
+          // unfolded, if any
+          c = d_rsolver->findModelValue(eqc, currLen, m);
+        }
+        else
+        {
+          c = itp->second;
+        }
+        if (c.isNull())
         {
           do
           {
@@ -481,10 +501,6 @@ bool TheoryStrings::collectModelInfoType(
             sel->increment();
           } while (m->hasTerm(c));
         }
-        else
-        {
-          c = itp->second;
-        }
         Trace("strings-model") << "*** Assigned constant " << c << " for "
                                << eqc << std::endl;
         processed[eqc] = c;
@@ -690,10 +706,10 @@ void TheoryStrings::check(Effort e) {
 }
 
 bool TheoryStrings::needsCheckLastEffort() {
-  if( options::stringGuessModel() ){
-    return d_esolver->hasExtendedFunctions();
+  if( options::stringGuessModel() && d_esolver->hasExtendedFunctions() ){
+    return true;
   }
-  return false;
+  return options::stringModelFind() && d_rsolver->hasModelMemberships();
 }
 
 /** Conflict when merging two constants */
@@ -1002,10 +1018,12 @@ void TheoryStrings::runInferStep(InferStep s, int effort)
     case CHECK_NORMAL_FORMS_EQ: d_csolver->checkNormalFormsEq(); break;
     case CHECK_NORMAL_FORMS_DEQ: d_csolver->checkNormalFormsDeq(); break;
     case CHECK_CODES: checkCodes(); break;
+    case CHECK_SEQUENCES_ARRAY: d_asolver->checkArray(); break;
     case CHECK_LENGTH_EQC: d_csolver->checkLengthsEqc(); break;
     case CHECK_REGISTER_TERMS_NF: checkRegisterTermsNormalForms(); break;
     case CHECK_EXTF_REDUCTION: d_esolver->checkExtfReductions(effort); break;
     case CHECK_MEMBERSHIP: d_rsolver->checkMemberships(); break;
+    case CHECK_MEMBERSHIP_MODEL: d_rsolver->checkMembershipsModel(); break;
     case CHECK_CARDINALITY: d_bsolver->checkCardinality(); break;
     default: Unreachable(); break;
   }
@@ -25,6 +25,7 @@
 #include "context/cdhashset.h"
 #include "context/cdlist.h"
 #include "expr/node_trie.h"
+#include "theory/strings/array_solver.h"
 #include "theory/strings/base_solver.h"
 #include "theory/strings/core_solver.h"
 #include "theory/strings/extf_solver.h"
@@ -86,6 +87,12 @@ class TheoryStrings : public Theory {
                               std::map<Node, std::vector<Node> >& exp) override;
   /** presolve */
   void presolve() override;
+  /**
+   * Notify that the sum of lengths of input variables of type string is at
+   * least lb in all models of the current assertions. This is used for
+   * seeding the decision strategy of --strings-fmf.
+   */
+  void notifyLengthLowerBound(const Rational& lb);
   /** shutdown */
   void shutdown() override {}
   /** add shared term */
@@ -293,6 +300,8 @@ class TheoryStrings : public Theory {
   std::unique_ptr<ExtfSolver> d_esolver;
   /** regular expression solver module */
   std::unique_ptr<RegExpSolver> d_rsolver;
+  /** array solver module, for reads and updates of sequences */
+  std::unique_ptr<ArraySolver> d_asolver;
   /** regular expression elimination module */
   RegExpElimination d_regexp_elim;
   /** Strings finite model finding decision strategy */
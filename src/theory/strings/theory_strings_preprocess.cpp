@@ -701,6 +701,78 @@ Node StringsPreprocess::reduce(Node t,
     // Thus, toLower( x ) = r
     retNode = r;
   }
+  else if (t.getKind() == SEQ_NTH)
+  {
+    // processing term:  nth( s, n )
+    Node s = t[0];
+    Node n = t[1];
+    TypeNode stype = s.getType();
+    Node skt = sc->mkTypedSkolemCached(
+        stype.getSequenceElementType(), t, SkolemCache::SK_PURIFY, "snth");
+    Node ls = nm->mkNode(STRING_LENGTH, s);
+    Node cond =
+        nm->mkNode(AND, nm->mkNode(GEQ, n, zero), nm->mkNode(GT, ls, n));
+    Node sk1 =
+        sc->mkTypedSkolemCached(stype, s, n, SkolemCache::SK_PREFIX, "snpre");
+    Node sk2 = sc->mkTypedSkolemCached(stype,
+                                       s,
+                                       nm->mkNode(PLUS, n, one),
+                                       SkolemCache::SK_SUFFIX_REM,
+                                       "snsuf");
+    Node b1 = s.eqNode(
+        nm->mkNode(STRING_CONCAT, sk1, nm->mkNode(SEQ_UNIT, skt), sk2));
+    Node b2 = nm->mkNode(STRING_LENGTH, sk1).eqNode(n);
+    // assert:
+    // IF    n >= 0 AND n < len( s )
+    // THEN: s = sk1 ++ unit( skt ) ++ sk2 AND len( sk1 ) = n
+    // The value of skt is unconstrained otherwise.
+    asserts.push_back(nm->mkNode(IMPLIES, cond, nm->mkNode(AND, b1, b2)));
+
+    // Thus, nth( s, n ) = skt
+    retNode = skt;
+  }
+  else if (t.getKind() == STRING_UPDATE)
+  {
+    // processing term:  update( s, n, r )
+    Node s = t[0];
+    Node n = t[1];
+    Node r = t[2];
+    TypeNode stype = s.getType();
+    Node skt = sc->mkTypedSkolemCached(stype, t, SkolemCache::SK_PURIFY, "sup");
+    Node ls = nm->mkNode(STRING_LENGTH, s);
+    Node cond =
+        nm->mkNode(AND, nm->mkNode(GEQ, n, zero), nm->mkNode(GT, ls, n));
+    // the prefix of r that is written to s
+    Node rp = nm->mkNode(STRING_SUBSTR, r, zero, nm->mkNode(MINUS, ls, n));
+    Node lrp = nm->mkNode(STRING_LENGTH, rp);
+    Node sk1 =
+        sc->mkTypedSkolemCached(stype, s, n, SkolemCache::SK_PREFIX, "supre");
+    Node sk2 = sc->mkTypedSkolemCached(stype,
+                                       nm->mkNode(STRING_SUBSTR, s, n, lrp),
+                                       SkolemCache::SK_PURIFY,
+                                       "sumid");
+    Node sk3 = sc->mkTypedSkolemCached(stype,
+                                       s,
+                                       nm->mkNode(PLUS, n, lrp),
+                                       SkolemCache::SK_SUFFIX_REM,
+                                       "susuf");
+    Node b1 = s.eqNode(nm->mkNode(STRING_CONCAT, sk1, sk2, sk3));
+    Node b2 = nm->mkNode(STRING_LENGTH, sk1).eqNode(n);
+    Node b3 = nm->mkNode(STRING_LENGTH, sk2).eqNode(lrp);
+    Node b4 = skt.eqNode(nm->mkNode(STRING_CONCAT, sk1, rp, sk3));
+    Node lemma =
+        nm->mkNode(ITE, cond, nm->mkNode(AND, b1, b2, b3, b4), skt.eqNode(s));
+    // assert:
+    // IF    n >= 0 AND n < len( s )
+    // THEN: s = sk1 ++ sk2 ++ sk3 AND len( sk1 ) = n AND
+    //       len( sk2 ) = len( rp ) AND skt = sk1 ++ rp ++ sk3
+    // ELSE: skt = s
+    // where rp = substr( r, 0, len( s ) - n ).
+    asserts.push_back(lemma);
+
+    // Thus, update( s, n, r ) = skt
+    retNode = skt;
+  }
   else if (t.getKind() == STRING_REV)
   {
     Node x = t[0];
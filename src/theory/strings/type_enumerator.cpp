@@ -165,6 +165,9 @@ SeqEnumLen::SeqEnumLen(TypeNode tn,
 {
   d_elementEnumerator.reset(
       new TypeEnumerator(d_type.getSequenceElementType(), tep));
+  // the first sequence of each length consists of the first element
+  d_elementDomain.push_back((**d_elementEnumerator).toExpr());
+  ++(*d_elementEnumerator);
   mkCurr();
 }
 
@@ -176,6 +179,9 @@ SeqEnumLen::SeqEnumLen(TypeNode tn,
 {
   d_elementEnumerator.reset(
       new TypeEnumerator(d_type.getSequenceElementType(), tep));
+  // the first sequence of each length consists of the first element
+  d_elementDomain.push_back((**d_elementEnumerator).toExpr());
+  ++(*d_elementEnumerator);
   mkCurr();
 }
 
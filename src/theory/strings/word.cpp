@@ -27,14 +27,12 @@ Node Word::mkEmptyWord(TypeNode tn)
 {
   if (tn.isString())
   {
-    std::vector<unsigned> vec;
-    return NodeManager::currentNM()->mkConst(String(vec));
+    return NodeManager::currentNM()->mkConst(String());
   }
   else if (tn.isSequence())
   {
     std::vector<Expr> seq;
-    return NodeManager::currentNM()->mkConst(
-        ExprSequence(tn.getSequenceElementType().toType(), seq));
+    return NodeManager::currentNM()->mkConst(ExprSequence(tn.toType(), seq));
   }
   Unimplemented();
   return Node::null();
@@ -47,15 +45,20 @@ Node Word::mkWordFlatten(const std::vector<Node>& xs)
   Kind k = xs[0].getKind();
   if (k == CONST_STRING)
   {
-    std::vector<unsigned> vec;
+    size_t size = 0;
     for (TNode x : xs)
     {
       Assert(x.getKind() == CONST_STRING);
-      String sx = x.getConst<String>();
-      const std::vector<unsigned>& vecc = sx.getVec();
+      size += x.getConst<String>().size();
+    }
+    std::vector<unsigned> vec;
+    vec.reserve(size);
+    for (TNode x : xs)
+    {
+      const std::vector<unsigned>& vecc = x.getConst<String>().getVec();
       vec.insert(vec.end(), vecc.begin(), vecc.end());
     }
-    return nm->mkConst(String(vec));
+    return nm->mkConst(String(std::move(vec)));
   }
   else if (k == CONST_SEQUENCE)
   {
@@ -71,8 +74,7 @@ Node Word::mkWordFlatten(const std::vector<Node>& xs)
         seq.push_back(c.toExpr());
       }
     }
-    return NodeManager::currentNM()->mkConst(
-        ExprSequence(tn.getSequenceElementType().toType(), seq));
+    return NodeManager::currentNM()->mkConst(ExprSequence(tn.toType(), seq));
   }
   Unimplemented();
   return Node::null();
@@ -18,6 +18,7 @@
 #include "options/smt_options.h"
 #include "options/uf_options.h"
 #include "smt/smt_engine.h"
+#include "theory/theory_model_builder.h"
 
 using namespace std;
 using namespace CVC4::kind;
@@ -32,6 +33,7 @@ TheoryModel::TheoryModel(context::Context* c,
     : d_substitutions(c, false),
       d_modelBuilt(false),
       d_modelBuiltSuccess(false),
+      d_lazyBuilder(nullptr),
       d_using_model_core(false),
       d_enableFuncModels(enableFuncModels)
 {
@@ -69,6 +71,7 @@ TheoryModel::~TheoryModel()
 void TheoryModel::reset(){
   d_modelBuilt = false;
   d_modelBuiltSuccess = false;
+  d_lazyBuilder = nullptr;
   d_modelCache.clear();
   d_comment_str.clear();
   d_sep_heap = Node::null();
@@ -126,6 +129,7 @@ std::vector<Expr> TheoryModel::getDomainElements(Type t) const
 {
   // must be an uninterpreted sort
   Assert(t.isSort());
+  ensureLazyModelComplete();
   std::vector<Expr> elements;
   TypeNode tn = TypeNode::fromType(t);
   const std::vector<Node>* type_refs = d_rep_set.getTypeRepsOrNull(tn);
@@ -143,6 +147,18 @@ std::vector<Expr> TheoryModel::getDomainElements(Type t) const
   return elements;
 }
 
+const RepSet* TheoryModel::getRepSet() const
+{
+  ensureLazyModelComplete();
+  return &d_rep_set;
+}
+
+RepSet* TheoryModel::getRepSetPtr()
+{
+  ensureLazyModelComplete();
+  return &d_rep_set;
+}
+
 Node TheoryModel::getValue(TNode n) const
 {
   //apply substitutions
@@ -180,6 +196,7 @@ Expr TheoryModel::getValue( Expr expr ) const{
 /** get cardinality for sort */
 Cardinality TheoryModel::getCardinality( Type t ) const{
   TypeNode tn = TypeNode::fromType( t );
+  ensureLazyModelComplete();
   //for now, we only handle cardinalities for uninterpreted sorts
   if( tn.isSort() ){
     if( d_rep_set.hasType( tn ) ){
@@ -298,6 +315,7 @@ Node TheoryModel::getModelValue(TNode n) const
     Debug("model-getvalue-debug")
         << "get value from representative " << ret << "..." << std::endl;
     ret = d_equalityEngine->getRepresentative(ret);
+    ensureLazyValue(ret);
     Assert(d_reps.find(ret) != d_reps.end());
     std::map<Node, Node>::const_iterator it2 = d_reps.find(ret);
     if (it2 != d_reps.end())
@@ -316,6 +334,7 @@ Node TheoryModel::getModelValue(TNode n) const
     {
       if (d_enableFuncModels)
       {
+        ensureLazyModelComplete();
         std::map<Node, Node>::const_iterator entry = d_uf_models.find(n);
         if (entry != d_uf_models.end())
         {
@@ -473,7 +492,8 @@ bool TheoryModel::assertEqualityEngine(const eq::EqualityEngine* ee,
       if (predicate) {
         if (predTrue || predFalse)
         {
-          if (!assertPredicate(*eqc_i, predTrue))
+          if (!isEntailedEqual(*eqc_i, predTrue ? d_true : d_false)
+              && !assertPredicate(*eqc_i, predTrue))
           {
             return false;
           }
@@ -483,7 +503,8 @@ bool TheoryModel::assertEqualityEngine(const eq::EqualityEngine* ee,
             rep = (*eqc_i);
             first = false;
           }
-          else {
+          else if (!isEntailedEqual(*eqc_i, rep))
+          {
             Node eq = (*eqc_i).eqNode(rep);
             Trace("model-builder-assertions")
                 << "(assert " << eq << ");" << std::endl;
@@ -505,7 +526,8 @@ bool TheoryModel::assertEqualityEngine(const eq::EqualityEngine* ee,
           }
           first = false;
         }
-        else {
+        else if (!isEntailedEqual(*eqc_i, rep))
+        {
           if (!assertEquality(*eqc_i, rep, true))
           {
             return false;
@@ -517,6 +539,16 @@ bool TheoryModel::assertEqualityEngine(const eq::EqualityEngine* ee,
   return true;
 }
 
+bool TheoryModel::isEntailedEqual(TNode a, TNode b) const
+{
+  // Equalities that occur in the equality engines of several theories, or
+  // that follow by congruence from the equalities asserted so far, are
+  // redundant and need not be asserted again.
+  return a == b
+         || (d_equalityEngine->hasTerm(a) && d_equalityEngine->hasTerm(b)
+             && d_equalityEngine->areEqual(a, b));
+}
+
 void TheoryModel::assertSkeleton(TNode n)
 {
   Trace("model-builder-reps") << "Assert skeleton : " << n << std::endl;
@@ -637,6 +669,7 @@ Node TheoryModel::getRepresentative(TNode a)
 {
   if( d_equalityEngine->hasTerm( a ) ){
     Node r = d_equalityEngine->getRepresentative( a );
+    ensureLazyValue(r);
     if( d_reps.find( r )!=d_reps.end() ){
       return d_reps[ r ];
     }else{
@@ -647,6 +680,22 @@ Node TheoryModel::getRepresentative(TNode a)
   }
 }
 
+void TheoryModel::ensureLazyValue(TNode r) const
+{
+  if (d_lazyBuilder != nullptr && d_reps.find(r) == d_reps.end())
+  {
+    d_lazyBuilder->extendLazyModel(r);
+  }
+}
+
+void TheoryModel::ensureLazyModelComplete() const
+{
+  if (d_lazyBuilder != nullptr)
+  {
+    d_lazyBuilder->completeLazyModel();
+  }
+}
+
 bool TheoryModel::areEqual(TNode a, TNode b)
 {
   if( a==b ){
@@ -30,6 +30,8 @@
 namespace CVC4 {
 namespace theory {
 
+class TheoryEngineModelBuilder;
+
 /** Theory Model class.
  *
  * This class represents a model produced by the TheoryEngine.
@@ -121,6 +123,14 @@ public:
    */
   bool assertEqualityEngine(const eq::EqualityEngine* ee,
                             std::set<Node>* termSet = NULL);
+  /** is a = b already entailed by the equality engine of this model?
+   *
+   * This is used by assertEqualityEngine to skip asserting equalities that
+   * hold in this model already. Note that nothing is shared between model
+   * builds: every call to assertEqualityEngine still visits all equivalence
+   * classes of the given equality engine.
+   */
+  bool isEntailedEqual(TNode a, TNode b) const;
   /** assert skeleton
    *
    * This method gives a "skeleton" for the model value of the equivalence
@@ -310,9 +320,9 @@ public:
   /** get domain elements for uninterpreted sort t */
   std::vector<Expr> getDomainElements(Type t) const override;
   /** get the representative set object */
-  const RepSet* getRepSet() const { return &d_rep_set; }
+  const RepSet* getRepSet() const;
   /** get the representative set object (FIXME: remove this, see #1199) */
-  RepSet* getRepSetPtr() { return &d_rep_set; }
+  RepSet* getRepSetPtr();
 
   //---------------------------- model cores
   /** set using model core */
@@ -354,6 +364,12 @@ public:
   bool d_modelBuilt;
   /** whether this model has been built successfully */
   bool d_modelBuiltSuccess;
+  /**
+   * The model builder that is building this model lazily, or null if this
+   * model is fully built. If non-null, the values of equivalence classes are
+   * computed on demand by this builder.
+   */
+  TheoryEngineModelBuilder* d_lazyBuilder;
   /** special local context for our equalityEngine so we can clear it
    * independently of search context */
   context::Context* d_eeContext;
@@ -399,6 +415,13 @@ public:
    * This function is a helper function for getValue.
    */
   Node getModelValue(TNode n) const;
+  /**
+   * Ensure that equivalence class representative r has a value, if this model
+   * is being built lazily.
+   */
+  void ensureLazyValue(TNode r) const;
+  /** Ensure that this model is fully built, if it is being built lazily. */
+  void ensureLazyModelComplete() const;
   /** add term internal
    *
    * This will do any model-specific processing necessary for n,
@@ -16,7 +16,9 @@
 #include "expr/dtype.h"
 #include "options/quantifiers_options.h"
 #include "options/smt_options.h"
+#include "options/theory_options.h"
 #include "options/uf_options.h"
+#include "smt/smt_statistics_registry.h"
 #include "theory/theory_engine.h"
 #include "theory/uf/theory_uf_model.h"
 
@@ -60,8 +62,17 @@ Node TheoryEngineModelBuilder::Assigner::getNextAssignment()
   return n;
 }
 
-TheoryEngineModelBuilder::TheoryEngineModelBuilder(TheoryEngine* te) : d_te(te)
+TheoryEngineModelBuilder::TheoryEngineModelBuilder(TheoryEngine* te)
+    : d_te(te),
+      d_lazyModel(nullptr),
+      d_eqcsAssigned("theory::TheoryEngineModelBuilder::eqcsAssigned", 0)
 {
+  smtStatisticsRegistry()->registerStat(&d_eqcsAssigned);
+}
+
+TheoryEngineModelBuilder::~TheoryEngineModelBuilder()
+{
+  smtStatisticsRegistry()->unregisterStat(&d_eqcsAssigned);
 }
 
 Node TheoryEngineModelBuilder::evaluateEqc(TheoryModel* m, TNode r)
@@ -198,6 +209,11 @@ void TheoryEngineModelBuilder::assignConstantRep(TheoryModel* tm,
   Trace("model-builder") << "    Assign: Setting constant rep of " << eqc
                          << " to " << const_rep << endl;
   tm->d_rep_set.setTermForRepresentative(const_rep, eqc);
+  if (d_lazyModel != nullptr)
+  {
+    tm->d_reps[eqc] = const_rep;
+    tm->d_rep_set.add(const_rep.getType(), const_rep);
+  }
 }
 
 bool TheoryEngineModelBuilder::isExcludedCdtValue(
@@ -414,7 +430,7 @@ bool TheoryEngineModelBuilder::buildModel(Model* m)
   // Loop through all terms and make sure that assignable sub-terms are in the
   // equality engine
   // Also, record #eqc per type (for finite model finding)
-  std::map<TypeNode, unsigned> eqc_usort_count;
+  d_eqcUsortCount.clear();
   eq::EqClassesIterator eqcs_i = eq::EqClassesIterator(ee);
   {
     NodeSet cache;
@@ -428,13 +444,13 @@ bool TheoryEngineModelBuilder::buildModel(Model* m)
       TypeNode tn = (*eqcs_i).getType();
       if (tn.isSort())
       {
-        if (eqc_usort_count.find(tn) == eqc_usort_count.end())
+        if (d_eqcUsortCount.find(tn) == d_eqcUsortCount.end())
         {
-          eqc_usort_count[tn] = 1;
+          d_eqcUsortCount[tn] = 1;
         }
         else
         {
-          eqc_usort_count[tn]++;
+          d_eqcUsortCount[tn]++;
         }
       }
     }
@@ -444,8 +460,10 @@ bool TheoryEngineModelBuilder::buildModel(Model* m)
 
   // Process all terms in the equality engine, store representatives for each EC
   d_constantReps.clear();
-  std::map<Node, Node> assertedReps;
-  TypeSet typeConstSet, typeRepSet, typeNoRepSet;
+  d_assertedReps.clear();
+  d_typeConstSet.reset(new TypeSet);
+  d_typeRepSet.reset(new TypeSet);
+  d_typeNoRepSet.reset(new TypeSet);
   // Compute type enumerator properties. This code ensures we do not
   // enumerate terms that have uninterpreted constants that violate the
   // bounds imposed by finite model finding. For example, if finite
@@ -453,19 +471,19 @@ bool TheoryEngineModelBuilder::buildModel(Model* m)
   // then the type enumerator for list of U should enumerate:
   //   nil, (cons U1 nil), (cons U2 nil), (cons U1 (cons U1 nil)), ...
   // instead of enumerating (cons U3 nil).
-  TypeEnumeratorProperties tep;
+  d_tep = TypeEnumeratorProperties();
   if (options::finiteModelFind())
   {
-    tep.d_fixed_usort_card = true;
-    for (std::map<TypeNode, unsigned>::iterator it = eqc_usort_count.begin();
-         it != eqc_usort_count.end();
+    d_tep.d_fixed_usort_card = true;
+    for (std::map<TypeNode, unsigned>::iterator it = d_eqcUsortCount.begin();
+         it != d_eqcUsortCount.end();
          ++it)
     {
       Trace("model-builder") << "Fixed bound (#eqc) for " << it->first << " : "
                              << it->second << std::endl;
-      tep.d_fixed_card[it->first] = Integer(it->second);
+      d_tep.d_fixed_card[it->first] = Integer(it->second);
     }
-    typeConstSet.setTypeEnumeratorProperties(&tep);
+    d_typeConstSet->setTypeEnumeratorProperties(&d_tep);
   }
 
   // AJR: build ordered list of types that ensures that base types are
@@ -474,7 +492,12 @@ bool TheoryEngineModelBuilder::buildModel(Model* m)
   // parametric types instantiated with uninterpreted sorts, but is probably
   // a good idea to do in general since it leads to models with smaller term
   // sizes.
-  std::vector<TypeNode> type_list;
+  d_typeList.clear();
+  // If we are building the model lazily, we only assign constants to
+  // equivalence classes when their value is requested (see extendLazyModel).
+  bool lazy = options::lazyModelBuild();
+  d_lazyModel = nullptr;
+  d_lazyEqc.clear();
   eqcs_i = eq::EqClassesIterator(tm->d_equalityEngine);
   for (; !eqcs_i.isFinished(); ++eqcs_i)
   {
@@ -483,7 +506,7 @@ bool TheoryEngineModelBuilder::buildModel(Model* m)
     Trace("model-builder") << "Processing EC: " << eqc << endl;
     Assert(tm->d_equalityEngine->getRepresentative(eqc) == eqc);
     TypeNode eqct = eqc.getType();
-    Assert(assertedReps.find(eqc) == assertedReps.end());
+    Assert(d_assertedReps.find(eqc) == d_assertedReps.end());
     Assert(d_constantReps.find(eqc) == d_constantReps.end());
 
     // Loop through terms in this EC
@@ -527,39 +550,93 @@ bool TheoryEngineModelBuilder::buildModel(Model* m)
       // merge with constant eqc
       // Assert(rep.isNull() || rep == const_rep);
       assignConstantRep(tm, eqc, const_rep);
-      typeConstSet.add(eqct.getBaseType(), const_rep);
+      d_typeConstSet->add(eqct.getBaseType(), const_rep);
     }
-    else if (!rep.isNull())
+    else if (lazy)
     {
-      assertedReps[eqc] = rep;
-      typeRepSet.add(eqct.getBaseType(), eqc);
-      std::unordered_set<TypeNode, TypeNodeHashFunction> visiting;
-      addToTypeList(eqct.getBaseType(), type_list, visiting);
+      d_lazyEqc[eqc] = rep;
     }
     else
     {
-      typeNoRepSet.add(eqct, eqc);
-      std::unordered_set<TypeNode, TypeNodeHashFunction> visiting;
-      addToTypeList(eqct, type_list, visiting);
+      addEqc(eqc, rep);
     }
   }
 
   Trace("model-builder") << "Compute assignable information..." << std::endl;
-  // The set of equivalence classes that are "assignable"
-  std::unordered_set<Node, NodeHashFunction> assignableEqc;
-  // The set of equivalence classes that are "evaluable"
-  std::unordered_set<Node, NodeHashFunction> evaluableEqc;
-  // Assigner objects for relevant equivalence classes
-  std::map<Node, Assigner> eqcToAssigner;
-  // Maps equivalence classes to the equivalence class that maps to its assigner
-  // object in the above map.
-  std::map<Node, Node> eqcToAssignerMaster;
-  // Compute the above information
-  computeAssignableInfo(
-      tm, tep, assignableEqc, evaluableEqc, eqcToAssigner, eqcToAssignerMaster);
+  d_assignableEqc.clear();
+  d_evaluableEqc.clear();
+  d_eqcToAssigner.clear();
+  d_eqcToAssignerMaster.clear();
+  computeAssignableInfo(tm,
+                        d_tep,
+                        d_assignableEqc,
+                        d_evaluableEqc,
+                        d_eqcToAssigner,
+                        d_eqcToAssignerMaster);
+
+  // the representatives asserted by the theories were processed above
+  tm->d_reps.clear();
+  if (lazy)
+  {
+    // The constants assigned to equivalence classes are copied to the model
+    // as they are assigned from now on.
+    std::map<Node, Node>::iterator itMap;
+    for (itMap = d_constantReps.begin(); itMap != d_constantReps.end();
+         ++itMap)
+    {
+      tm->d_reps[itMap->first] = itMap->second;
+      tm->d_rep_set.add(itMap->second.getType(), itMap->second);
+    }
+    d_lazyModel = tm;
+  }
 
   // Need to ensure that each EC has a constant representative.
+  assignConstantReps(tm);
+
+  if (!d_lazyEqc.empty())
+  {
+    // the remaining steps are done by extendLazyModel and completeLazyModel
+    Trace("model-builder") << "TheoryEngineModelBuilder: success (lazy), "
+                           << d_lazyEqc.size() << " unassigned eqc"
+                           << std::endl;
+    tm->d_lazyBuilder = this;
+    tm->d_modelBuiltSuccess = true;
+    return true;
+  }
+  d_lazyModel = nullptr;
 
+  // modelBuilder-specific initialization
+  if (!processBuildModel(tm))
+  {
+    Trace("model-builder")
+        << "TheoryEngineModelBuilder: fail process build model." << std::endl;
+    return false;
+  }
+  Trace("model-builder") << "TheoryEngineModelBuilder: success" << std::endl;
+  tm->d_modelBuiltSuccess = true;
+  return true;
+}
+
+void TheoryEngineModelBuilder::addEqc(TNode eqc, TNode rep)
+{
+  ++d_eqcsAssigned;
+  TypeNode eqct = eqc.getType();
+  std::unordered_set<TypeNode, TypeNodeHashFunction> visiting;
+  if (!rep.isNull())
+  {
+    d_assertedReps[eqc] = rep;
+    d_typeRepSet->add(eqct.getBaseType(), eqc);
+    addToTypeList(eqct.getBaseType(), d_typeList, visiting);
+  }
+  else
+  {
+    d_typeNoRepSet->add(eqct, eqc);
+    addToTypeList(eqct, d_typeList, visiting);
+  }
+}
+
+void TheoryEngineModelBuilder::assignConstantReps(TheoryModel* tm)
+{
   Trace("model-builder") << "Processing EC's..." << std::endl;
 
   TypeSet::iterator it;
@@ -585,11 +662,11 @@ bool TheoryEngineModelBuilder::buildModel(Model* m)
       evaluableSet.clear();
 
       // Iterate over all types we've seen
-      for (type_it = type_list.begin(); type_it != type_list.end(); ++type_it)
+      for (type_it = d_typeList.begin(); type_it != d_typeList.end(); ++type_it)
       {
         TypeNode t = *type_it;
         TypeNode tb = t.getBaseType();
-        set<Node>* noRepSet = typeNoRepSet.getSet(t);
+        set<Node>* noRepSet = d_typeNoRepSet->getSet(t);
 
         // 1. Try to evaluate the EC's in this type
         if (noRepSet != NULL && !noRepSet->empty())
@@ -606,7 +683,7 @@ bool TheoryEngineModelBuilder::buildModel(Model* m)
                                          << std::endl;
             Node normalized;
             // only possible to normalize if we are evaluable
-            evaluable = evaluableEqc.find(*i2) != evaluableEqc.end();
+            evaluable = d_evaluableEqc.find(*i2) != d_evaluableEqc.end();
             if (evaluable)
             {
               normalized = evaluateEqc(tm, *i2);
@@ -614,7 +691,7 @@ bool TheoryEngineModelBuilder::buildModel(Model* m)
             if (!normalized.isNull())
             {
               Assert(normalized.isConst());
-              typeConstSet.add(tb, normalized);
+              d_typeConstSet->add(tb, normalized);
               assignConstantRep(tm, *i2, normalized);
               Trace("model-builder") << "    Eval: Setting constant rep of "
                                      << (*i2) << " to " << normalized << endl;
@@ -629,7 +706,7 @@ bool TheoryEngineModelBuilder::buildModel(Model* m)
               }
               // If assignable, remember there is an equivalence class that is
               // not assigned and assignable.
-              if (assignableEqc.find(*i2) != assignableEqc.end())
+              if (d_assignableEqc.find(*i2) != d_assignableEqc.end())
               {
                 unassignedAssignable = true;
               }
@@ -638,7 +715,7 @@ bool TheoryEngineModelBuilder::buildModel(Model* m)
         }
 
         // 2. Normalize any non-const representative terms for this type
-        set<Node>* repSet = typeRepSet.getSet(t);
+        set<Node>* repSet = d_typeRepSet->getSet(t);
         if (repSet != NULL && !repSet->empty())
         {
           Trace("model-builder")
@@ -646,8 +723,8 @@ bool TheoryEngineModelBuilder::buildModel(Model* m)
           d_normalizedCache.clear();
           for (i = repSet->begin(); i != repSet->end();)
           {
-            Assert(assertedReps.find(*i) != assertedReps.end());
-            Node rep = assertedReps[*i];
+            Assert(d_assertedReps.find(*i) != d_assertedReps.end());
+            Node rep = d_assertedReps[*i];
             Node normalized = normalize(tm, rep, false);
             Trace("model-builder") << "    Normalizing rep (" << rep
                                    << "), normalized to (" << normalized << ")"
@@ -655,9 +732,9 @@ bool TheoryEngineModelBuilder::buildModel(Model* m)
             if (normalized.isConst())
             {
               changed = true;
-              typeConstSet.add(tb, normalized);
+              d_typeConstSet->add(tb, normalized);
               assignConstantRep(tm, *i, normalized);
-              assertedReps.erase(*i);
+              d_assertedReps.erase(*i);
               i2 = i;
               ++i;
               repSet->erase(i2);
@@ -666,7 +743,7 @@ bool TheoryEngineModelBuilder::buildModel(Model* m)
             {
               if (normalized != rep)
               {
-                assertedReps[*i] = normalized;
+                d_assertedReps[*i] = normalized;
                 changed = true;
               }
               ++i;
@@ -704,12 +781,12 @@ bool TheoryEngineModelBuilder::buildModel(Model* m)
     //  however, it does not break cyclic type dependencies for mutually
     //  recursive datatypes, but this is handled
     //  by recording all subterms of enumerated values in TypeSet::addSubTerms.
-    for (type_it = type_list.begin(); type_it != type_list.end(); ++type_it)
+    for (type_it = d_typeList.begin(); type_it != d_typeList.end(); ++type_it)
     {
       TypeNode t = *type_it;
       // continue if there are no more equivalence classes of this type to
       // assign
-      std::set<Node>* noRepSetPtr = typeNoRepSet.getSet(t);
+      std::set<Node>* noRepSetPtr = d_typeNoRepSet->getSet(t);
       if (noRepSetPtr == NULL)
       {
         continue;
@@ -739,7 +816,7 @@ bool TheoryEngineModelBuilder::buildModel(Model* m)
       TypeNode tb = t.getBaseType();
       if (!assignOne)
       {
-        set<Node>* repSet = typeRepSet.getSet(tb);
+        set<Node>* repSet = d_typeRepSet->getSet(tb);
         if (repSet != NULL && !repSet->empty())
         {
           continue;
@@ -754,33 +831,33 @@ bool TheoryEngineModelBuilder::buildModel(Model* m)
       bool assignable, evaluable CVC4_UNUSED;
       std::map<Node, Assigner>::iterator itAssigner;
       std::map<Node, Node>::iterator itAssignerM;
-      set<Node>* repSet = typeRepSet.getSet(t);
+      set<Node>* repSet = d_typeRepSet->getSet(t);
       for (i = noRepSet.begin(); i != noRepSet.end();)
       {
         i2 = i;
         ++i;
         // check whether it has an assigner object
-        itAssignerM = eqcToAssignerMaster.find(*i2);
-        if (itAssignerM != eqcToAssignerMaster.end())
+        itAssignerM = d_eqcToAssignerMaster.find(*i2);
+        if (itAssignerM != d_eqcToAssignerMaster.end())
         {
           // Take the master's assigner. Notice we don't care which order
           // equivalence classes are assigned. For instance, the master can
           // be assigned after one of its slaves.
-          itAssigner = eqcToAssigner.find(itAssignerM->second);
+          itAssigner = d_eqcToAssigner.find(itAssignerM->second);
         }
         else
         {
-          itAssigner = eqcToAssigner.find(*i2);
+          itAssigner = d_eqcToAssigner.find(*i2);
         }
-        if (itAssigner != eqcToAssigner.end())
+        if (itAssigner != d_eqcToAssigner.end())
         {
           assignable = isAssignerActive(tm, itAssigner->second);
         }
         else
         {
-          assignable = assignableEqc.find(*i2) != assignableEqc.end();
+          assignable = d_assignableEqc.find(*i2) != d_assignableEqc.end();
         }
-        evaluable = evaluableEqc.find(*i2) != evaluableEqc.end();
+        evaluable = d_evaluableEqc.find(*i2) != d_evaluableEqc.end();
         Trace("model-builder-debug")
             << "    eqc " << *i2 << " is assignable=" << assignable
             << ", evaluable=" << evaluable << std::endl;
@@ -795,7 +872,7 @@ bool TheoryEngineModelBuilder::buildModel(Model* m)
           // assigning.
           Assert(!t.isBoolean() || isAssignable(*i2));
           Node n;
-          if (itAssigner != eqcToAssigner.end())
+          if (itAssigner != d_eqcToAssigner.end())
           {
             Trace("model-builder-debug")
                 << "Get value from assigner for finite type..." << std::endl;
@@ -812,7 +889,7 @@ bool TheoryEngineModelBuilder::buildModel(Model* m)
             {
               Trace("model-builder-debug") << "Enumerate term of type " << t
                                            << std::endl;
-              n = typeConstSet.nextTypeEnum(t, true);
+              n = d_typeConstSet->nextTypeEnum(t, true);
               //--- AJR: this code checks whether n is a legal value
               Assert(!n.isNull());
               success = true;
@@ -827,7 +904,7 @@ bool TheoryEngineModelBuilder::buildModel(Model* m)
                 // should ensure that only legal values are enumerated wrt this
                 // constraint.
                 std::map<Node, bool> visited;
-                success = !isExcludedUSortValue(eqc_usort_count, n, visited);
+                success = !isExcludedUSortValue(d_eqcUsortCount, n, visited);
                 if (!success)
                 {
                   Trace("model-builder")
@@ -844,7 +921,7 @@ bool TheoryEngineModelBuilder::buildModel(Model* m)
                 {
                   // in the case of codatatypes, check if it is in the set of
                   // values that we cannot assign
-                  success = !isExcludedCdtValue(n, repSet, assertedReps, *i2);
+                  success = !isExcludedCdtValue(n, repSet, d_assertedReps, *i2);
                   if (!success)
                   {
                     Trace("model-builder")
@@ -897,7 +974,7 @@ bool TheoryEngineModelBuilder::buildModel(Model* m)
 
 #ifdef CVC4_ASSERTIONS
   // Assert that all representatives have been converted to constants
-  for (it = typeRepSet.begin(); it != typeRepSet.end(); ++it)
+  for (it = d_typeRepSet->begin(); it != d_typeRepSet->end(); ++it)
   {
     set<Node>& repSet = TypeSet::getSet(it);
     if (!repSet.empty())
@@ -909,23 +986,26 @@ bool TheoryEngineModelBuilder::buildModel(Model* m)
   }
 #endif /* CVC4_ASSERTIONS */
 
-  Trace("model-builder") << "Copy representatives to model..." << std::endl;
-  tm->d_reps.clear();
   std::map<Node, Node>::iterator itMap;
-  for (itMap = d_constantReps.begin(); itMap != d_constantReps.end(); ++itMap)
+  if (d_lazyModel == nullptr)
   {
-    tm->d_reps[itMap->first] = itMap->second;
-    tm->d_rep_set.add(itMap->second.getType(), itMap->second);
+    Trace("model-builder") << "Copy representatives to model..." << std::endl;
+    for (itMap = d_constantReps.begin(); itMap != d_constantReps.end();
+         ++itMap)
+    {
+      tm->d_reps[itMap->first] = itMap->second;
+      tm->d_rep_set.add(itMap->second.getType(), itMap->second);
+    }
   }
 
   Trace("model-builder") << "Make sure ECs have reps..." << std::endl;
   // Make sure every EC has a rep
-  for (itMap = assertedReps.begin(); itMap != assertedReps.end(); ++itMap)
+  for (itMap = d_assertedReps.begin(); itMap != d_assertedReps.end(); ++itMap)
   {
     tm->d_reps[itMap->first] = itMap->second;
     tm->d_rep_set.add(itMap->second.getType(), itMap->second);
   }
-  for (it = typeNoRepSet.begin(); it != typeNoRepSet.end(); ++it)
+  for (it = d_typeNoRepSet->begin(); it != d_typeNoRepSet->end(); ++it)
   {
     set<Node>& noRepSet = TypeSet::getSet(it);
     for (const Node& node : noRepSet)
@@ -933,18 +1013,152 @@ bool TheoryEngineModelBuilder::buildModel(Model* m)
       tm->d_reps[node] = node;
       tm->d_rep_set.add(node.getType(), node);
     }
+    // processed, so that they are not considered by later calls to this
+    // method when building models lazily
+    noRepSet.clear();
+  }
+  d_assertedReps.clear();
+  for (it = d_typeRepSet->begin(); it != d_typeRepSet->end(); ++it)
+  {
+    TypeSet::getSet(it).clear();
   }
+}
 
-  // modelBuilder-specific initialization
-  if (!processBuildModel(tm))
+void TheoryEngineModelBuilder::extendLazyModel(TNode r)
+{
+  Assert(d_lazyModel != nullptr);
+  TheoryModel* tm = d_lazyModel;
+  Trace("model-builder") << "TheoryEngineModelBuilder: extend lazy model for "
+                         << r << std::endl;
+  // do not extend the model recursively while we are assigning values
+  tm->d_lazyBuilder = nullptr;
+  eq::EqualityEngine* ee = tm->d_equalityEngine;
+  std::vector<Node> visit;
+  NodeSet visited;
+  // the base types whose computed equivalence classes were added to visit
+  std::unordered_set<TypeNode, TypeNodeHashFunction> enumTypes;
+  std::map<Node, Node>::iterator it;
+  visit.push_back(r);
+  do
   {
-    Trace("model-builder")
-        << "TheoryEngineModelBuilder: fail process build model." << std::endl;
-    return false;
+    Node eqc = visit.back();
+    visit.pop_back();
+    it = d_lazyEqc.find(eqc);
+    if (it == d_lazyEqc.end())
+    {
+      // already assigned or being assigned
+      continue;
+    }
+    Node rep = it->second;
+    d_lazyEqc.erase(it);
+    Trace("model-builder-debug") << "...relevant eqc " << eqc << std::endl;
+    addEqc(eqc, rep);
+    // The value of eqc may be computed from the values of the subterms of its
+    // terms, of its asserted representative, and of the members of its
+    // assignment exclusion set.
+    eq::EqClassIterator eqc_i = eq::EqClassIterator(eqc, ee);
+    for (; !eqc_i.isFinished(); ++eqc_i)
+    {
+      addLazyDependencies(tm, *eqc_i, visit, visited);
+    }
+    if (!rep.isNull())
+    {
+      addLazyDependencies(tm, rep, visit, visited);
+    }
+    TypeNode tn = eqc.getType();
+    TypeNode tb = tn.getBaseType();
+    if (rep.isNull() && enumTypes.find(tb) == enumTypes.end())
+    {
+      // The value of eqc may be enumerated. Enumeration skips the values
+      // already assigned to equivalence classes of its type, hence the
+      // equivalence classes of its type whose values are computed (from
+      // their asserted representative or by evaluation) must be assigned
+      // first, as they are when the model is built eagerly. Otherwise, one of
+      // them may later be assigned the value enumerated for eqc.
+      enumTypes.insert(tb);
+      for (const std::pair<const Node, Node>& le : d_lazyEqc)
+      {
+        if (le.first.getType().getBaseType() == tb
+            && (!le.second.isNull()
+                || d_evaluableEqc.find(le.first) != d_evaluableEqc.end()))
+        {
+          visit.push_back(le.first);
+        }
+      }
+    }
+    if (tn.isCodatatype())
+    {
+      // values of codatatypes are chosen based on all equivalence classes of
+      // their type (see isExcludedCdtValue)
+      for (const std::pair<const Node, Node>& le : d_lazyEqc)
+      {
+        if (le.first.getType() == tn)
+        {
+          visit.push_back(le.first);
+        }
+      }
+    }
+    std::map<Node, Node>::iterator itm = d_eqcToAssignerMaster.find(eqc);
+    Node master = itm == d_eqcToAssignerMaster.end() ? eqc : itm->second;
+    std::map<Node, Assigner>::iterator ita = d_eqcToAssigner.find(master);
+    if (ita != d_eqcToAssigner.end())
+    {
+      for (const Node& e : ita->second.d_assignExcSet)
+      {
+        if (!e.isConst())
+        {
+          visit.push_back(e);
+        }
+      }
+    }
+  } while (!visit.empty());
+  assignConstantReps(tm);
+  tm->d_lazyBuilder = this;
+}
+
+void TheoryEngineModelBuilder::completeLazyModel()
+{
+  Assert(d_lazyModel != nullptr);
+  TheoryModel* tm = d_lazyModel;
+  Trace("model-builder") << "TheoryEngineModelBuilder: complete lazy model, "
+                         << d_lazyEqc.size() << " unassigned eqc" << std::endl;
+  tm->d_lazyBuilder = nullptr;
+  for (const std::pair<const Node, Node>& le : d_lazyEqc)
+  {
+    addEqc(le.first, le.second);
+  }
+  d_lazyEqc.clear();
+  assignConstantReps(tm);
+  d_lazyModel = nullptr;
+  // Lazy model construction is only enabled when quantified formulas are not,
+  // in which case the processing below does not fail.
+  bool success CVC4_UNUSED = processBuildModel(tm);
+  Assert(success);
+}
+
+void TheoryEngineModelBuilder::addLazyDependencies(TheoryModel* tm,
+                                                   TNode n,
+                                                   std::vector<Node>& visit,
+                                                   NodeSet& visited)
+{
+  if (n.isClosure())
+  {
+    return;
+  }
+  eq::EqualityEngine* ee = tm->d_equalityEngine;
+  for (TNode::iterator child_it = n.begin(); child_it != n.end(); ++child_it)
+  {
+    TNode c = *child_it;
+    if (ee->hasTerm(c))
+    {
+      visit.push_back(ee->getRepresentative(c));
+    }
+    else if (visited.find(c) == visited.end())
+    {
+      visited.insert(c);
+      addLazyDependencies(tm, c, visit, visited);
+    }
   }
-  Trace("model-builder") << "TheoryEngineModelBuilder: success" << std::endl;
-  tm->d_modelBuiltSuccess = true;
-  return true;
 }
 void TheoryEngineModelBuilder::computeAssignableInfo(
     TheoryModel* tm,
@@ -17,10 +17,12 @@
 #ifndef CVC4__THEORY__THEORY_MODEL_BUILDER_H
 #define CVC4__THEORY__THEORY_MODEL_BUILDER_H
 
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 
 #include "theory/theory_model.h"
+#include "util/statistics_registry.h"
 
 namespace CVC4 {
 namespace theory {
@@ -45,7 +47,7 @@ class TheoryEngineModelBuilder : public ModelBuilder
 
  public:
   TheoryEngineModelBuilder(TheoryEngine* te);
-  virtual ~TheoryEngineModelBuilder() {}
+  virtual ~TheoryEngineModelBuilder();
   /** Build model function.
    *
    * Should be called only on TheoryModels m.
@@ -66,8 +68,37 @@ class TheoryEngineModelBuilder : public ModelBuilder
    * Lemmas may be sent on an output channel by this
    * builder in steps (2) or (5), for instance, if the model we
    * are building fails to satisfy a quantified formula.
+   *
+   * If --lazy-model-build is enabled, step (4) is only done for equivalence
+   * classes whose value is requested, and step (5) is postponed until the
+   * model is needed in its entirety, see extendLazyModel and
+   * completeLazyModel. Steps (1) and (3) are still done for all theories and
+   * all equivalence classes, hence lazy model construction only saves the
+   * evaluation and enumeration of the values that are not requested.
    */
   bool buildModel(Model* m) override;
+  /** Extend lazy model
+   *
+   * Called when the value of equivalence class r of the model we are lazily
+   * building is requested. This assigns constants to all equivalence classes
+   * in the cone of influence of r, that is, r and the equivalence classes
+   * whose values its value may be computed from.
+   *
+   * If the value of an equivalence class in the cone may be enumerated, the
+   * cone also includes all equivalence classes of its base type whose values
+   * are computed (from an asserted representative or by evaluation), since
+   * they must be assigned before enumeration to ensure that distinct
+   * equivalence classes get distinct values. Hence the cone is only small for
+   * a term whose type has few such equivalence classes.
+   */
+  void extendLazyModel(TNode r);
+  /** Complete lazy model
+   *
+   * Called when the model we are lazily building is needed in its entirety.
+   * This assigns constants to all remaining equivalence classes and does
+   * step (5) of the model construction.
+   */
+  void completeLazyModel();
 
   /** postprocess model
    *
@@ -214,6 +245,19 @@ class TheoryEngineModelBuilder : public ModelBuilder
   /** mapping from terms to the constant associated with their equivalence class
    */
   std::map<Node, Node> d_constantReps;
+  /** mapping from equivalence classes to their asserted representatives */
+  std::map<Node, Node> d_assertedReps;
+  /** the sets of constants, asserted representatives, and equivalence classes
+   * without representatives, for each type */
+  std::unique_ptr<TypeSet> d_typeConstSet;
+  std::unique_ptr<TypeSet> d_typeRepSet;
+  std::unique_ptr<TypeSet> d_typeNoRepSet;
+  /** type enumerator properties */
+  TypeEnumeratorProperties d_tep;
+  /** the number of equivalence classes of each uninterpreted sort */
+  std::map<TypeNode, unsigned> d_eqcUsortCount;
+  /** ordered list of types that ensures base types are enumerated first */
+  std::vector<TypeNode> d_typeList;
 
   /** Theory engine model builder assigner class
    *
@@ -260,6 +304,11 @@ class TheoryEngineModelBuilder : public ModelBuilder
    * these values whenever possible.
    */
   bool isAssignerActive(TheoryModel* tm, Assigner& a);
+  /** The information computed by computeAssignableInfo below */
+  std::unordered_set<Node, NodeHashFunction> d_assignableEqc;
+  std::unordered_set<Node, NodeHashFunction> d_evaluableEqc;
+  std::map<Node, Assigner> d_eqcToAssigner;
+  std::map<Node, Node> d_eqcToAssignerMaster;
   /** compute assignable information
    *
    * This computes necessary information pertaining to how values should be
@@ -291,6 +340,46 @@ class TheoryEngineModelBuilder : public ModelBuilder
       std::unordered_set<Node, NodeHashFunction>& evaluableEqc,
       std::map<Node, Assigner>& eqcToAssigner,
       std::map<Node, Node>& eqcToAssignerMaster);
+  /** add equivalence class
+   *
+   * Adds eqc, whose asserted representative is rep (null if none), to the
+   * equivalence classes that are assigned constants by assignConstantReps.
+   */
+  void addEqc(TNode eqc, TNode rep);
+  /** assign constant representatives
+   *
+   * Assigns constants to the equivalence classes added by addEqc, through
+   * alternating iterations of evaluation and enumeration. Equivalence classes
+   * that cannot be assigned a constant are given their asserted
+   * representative (or themselves) as a representative.
+   */
+  void assignConstantReps(TheoryModel* tm);
+  //------------------------------------for lazy model construction
+  /**
+   * The model we are lazily building, or null if we are not building a model
+   * lazily.
+   */
+  TheoryModel* d_lazyModel;
+  /**
+   * Maps the equivalence classes of d_lazyModel that are not yet assigned
+   * constants to their asserted representative (null if none).
+   */
+  std::map<Node, Node> d_lazyEqc;
+  /**
+   * Add to visit the equivalence classes of the subterms of n whose value
+   * the value of n may be computed from.
+   */
+  void addLazyDependencies(TheoryModel* tm,
+                           TNode n,
+                           std::vector<Node>& visit,
+                           NodeSet& visited);
+  //------------------------------------end for lazy model construction
+  /**
+   * The number of equivalence classes without constants that were assigned
+   * values, which is smaller with --lazy-model-build if only part of the
+   * model is requested.
+   */
+  IntStat d_eqcsAssigned;
   //------------------------------------for codatatypes
   /** is v an excluded codatatype value?
    *
@@ -17,6 +17,8 @@
 
 #include "theory/uf/equality_engine.h"
 
+#include <algorithm>
+
 #include "smt/smt_statistics_registry.h"
 
 namespace CVC4 {
@@ -42,26 +44,6 @@ EqualityEngine::Statistics::~Statistics() {
   smtStatisticsRegistry()->unregisterStat(&d_constantTermsCount);
 }
 
-/**
- * Data used in the BFS search through the equality graph.
- */
-struct BfsData {
-  // The current node
-  EqualityNodeId d_nodeId;
-  // The index of the edge we traversed
-  EqualityEdgeId d_edgeId;
-  // Index in the queue of the previous node. Shouldn't be too much of them, at most the size
-  // of the biggest equivalence class
-  size_t d_previousIndex;
-
-  BfsData(EqualityNodeId nodeId = null_id,
-          EqualityEdgeId edgeId = null_edge,
-          size_t prev = 0)
-      : d_nodeId(nodeId), d_edgeId(edgeId), d_previousIndex(prev)
-  {
-  }
-};
-
 class ScopedBool {
   bool& d_watch;
   bool d_oldValue;
@@ -124,6 +106,8 @@ EqualityEngine::EqualityEngine(context::Context* context, std::string name, bool
 , d_subtermEvaluatesSize(context, 0)
 , d_stats(name)
 , d_inPropagate(false)
+, d_explanationCacheKeysSize(context, 0)
+, d_explanationCacheDataSize(context, 0)
 , d_constantsAreTriggers(constantsAreTriggers)
 , d_triggerDatabaseSize(context, 0)
 , d_triggerTermSetUpdatesSize(context, 0)
@@ -149,6 +133,8 @@ EqualityEngine::EqualityEngine(EqualityEngineNotify& notify, context::Context* c
 , d_subtermEvaluatesSize(context, 0)
 , d_stats(name)
 , d_inPropagate(false)
+, d_explanationCacheKeysSize(context, 0)
+, d_explanationCacheDataSize(context, 0)
 , d_constantsAreTriggers(constantsAreTriggers)
 , d_triggerDatabaseSize(context, 0)
 , d_triggerTermSetUpdatesSize(context, 0)
@@ -226,7 +212,7 @@ EqualityNodeId EqualityEngine::newNode(TNode node) {
 
   // Register the new id of the term
   EqualityNodeId newId = d_nodes.size();
-  d_nodeIds[node] = newId;
+  d_nodeIds.insert(node, newId);
   // Add the node to it's position
   d_nodes.push_back(node);
   // Note if this is an application or not
@@ -235,6 +221,8 @@ EqualityNodeId EqualityEngine::newNode(TNode node) {
   d_nodeTriggers.push_back(+null_trigger);
   // Add it to the equality graph
   d_equalityGraph.push_back(+null_edge);
+  // It is its own tree in the proof forest
+  d_proofForestParent.push_back(+null_edge);
   // Mark the no-individual trigger
   d_nodeIndividualTrigger.push_back(+null_set_id);
   // Mark non-constant by default
@@ -398,12 +386,12 @@ void EqualityEngine::addTermInternal(TNode t, bool isOperator) {
 }
 
 bool EqualityEngine::hasTerm(TNode t) const {
-  return d_nodeIds.find(t) != d_nodeIds.end();
+  return d_nodeIds.contains(t);
 }
 
 EqualityNodeId EqualityEngine::getNodeId(TNode node) const {
   Assert(hasTerm(node)) << node;
-  return (*d_nodeIds.find(node)).second;
+  return d_nodeIds.find(node);
 }
 
 EqualityNode& EqualityEngine::getEqualityNode(TNode t) {
@@ -850,9 +838,23 @@ void EqualityEngine::backtrack() {
       EqualityEdge& edge2 = d_equalityEdges[i | 1];
       d_equalityGraph[edge2.getNodeId()] = edge1.getNext();
       d_equalityGraph[edge1.getNodeId()] = edge2.getNext();
+      // Detach the child and restore the old root of its tree
+      const ProofForestUpdate& update = d_proofForestUpdates[i / 2];
+      d_proofForestParent[update.d_child] = null_edge;
+      rerootProofForest(update.d_oldRoot);
     }
 
     d_equalityEdges.resize(2 * d_assertedEqualitiesCount);
+    d_proofForestUpdates.resize(d_assertedEqualitiesCount,
+                                ProofForestUpdate(null_id, null_id));
+  }
+
+  if (d_explanationCacheKeys.size() > d_explanationCacheKeysSize) {
+    for (size_t i = d_explanationCacheKeys.size(), i_end = d_explanationCacheKeysSize; i > i_end; -- i) {
+      d_explanationCache.erase(d_explanationCacheKeys[i - 1]);
+    }
+    d_explanationCacheKeys.resize(d_explanationCacheKeysSize);
+    d_explanationCacheData.resize(d_explanationCacheDataSize);
   }
 
   if (d_triggerTermSetUpdates.size() > d_triggerTermSetUpdatesSize) {
@@ -915,6 +917,7 @@ void EqualityEngine::backtrack() {
     d_isEquality.resize(d_nodesCount);
     d_isInternal.resize(d_nodesCount);
     d_equalityGraph.resize(d_nodesCount);
+    d_proofForestParent.resize(d_nodesCount);
     d_equalityNodes.resize(d_nodesCount);
   }
 
@@ -942,11 +945,85 @@ void EqualityEngine::addGraphEdge(EqualityNodeId t1, EqualityNodeId t2, unsigned
   d_equalityGraph[t1] = edge;
   d_equalityGraph[t2] = edge | 1;
 
+  // Update the proof forest: reroot the tree of the smaller class at its node
+  // and hang it below the other node. The edge pointing to t1 is edge | 1.
+  EqualityNodeId t1classId = getEqualityNode(t1).getFind();
+  EqualityNodeId t2classId = getEqualityNode(t2).getFind();
+  bool hangT2 = getEqualityNode(t2classId).getSize()
+                <= getEqualityNode(t1classId).getSize();
+  EqualityNodeId child = hangT2 ? t2 : t1;
+  EqualityNodeId oldRoot = rerootProofForest(child);
+  d_proofForestParent[child] = hangT2 ? (edge | 1) : edge;
+  d_proofForestUpdates.push_back(ProofForestUpdate(child, oldRoot));
+
   if (Debug.isOn("equality::internal")) {
     debugPrintGraph();
   }
 }
 
+EqualityNodeId EqualityEngine::rerootProofForest(EqualityNodeId n) {
+  // Reverse the edges on the path from n to the root
+  EqualityEdgeId previousEdge = null_edge;
+  EqualityNodeId current = n;
+  while (true) {
+    EqualityEdgeId parentEdge = d_proofForestParent[current];
+    d_proofForestParent[current] = previousEdge;
+    if (parentEdge == null_edge) {
+      return current;
+    }
+    // The reverse edge points from the parent back to current
+    previousEdge = parentEdge ^ 1;
+    current = d_equalityEdges[parentEdge].getNodeId();
+  }
+}
+
+unsigned EqualityEngine::getProofForestDepth(EqualityNodeId n) const {
+  unsigned depth = 0;
+  for (EqualityEdgeId edge = d_proofForestParent[n]; edge != null_edge;
+       edge = d_proofForestParent[d_equalityEdges[edge].getNodeId()]) {
+    ++ depth;
+  }
+  return depth;
+}
+
+void EqualityEngine::getProofForestPath(EqualityNodeId t1,
+                                        EqualityNodeId t2,
+                                        std::vector<EqualityEdgeId>& path) const
+{
+  // Find the nearest common ancestor by walking up from the same depth
+  unsigned depth1 = getProofForestDepth(t1);
+  unsigned depth2 = getProofForestDepth(t2);
+  EqualityNodeId a = t1;
+  EqualityNodeId b = t2;
+  for (; depth1 > depth2; -- depth1) {
+    a = d_equalityEdges[d_proofForestParent[a]].getNodeId();
+  }
+  for (; depth2 > depth1; -- depth2) {
+    b = d_equalityEdges[d_proofForestParent[b]].getNodeId();
+  }
+  while (a != b) {
+    Assert(d_proofForestParent[a] != null_edge
+           && d_proofForestParent[b] != null_edge)
+        << "Nodes are not in the same proof forest tree";
+    a = d_equalityEdges[d_proofForestParent[a]].getNodeId();
+    b = d_equalityEdges[d_proofForestParent[b]].getNodeId();
+  }
+  // The edges going up from t1 are oriented towards t2
+  for (EqualityNodeId current = t1; current != a;) {
+    EqualityEdgeId edge = d_proofForestParent[current];
+    path.push_back(edge);
+    current = d_equalityEdges[edge].getNodeId();
+  }
+  // The edges going up from t2 are reversed, and added in reverse order
+  size_t downStart = path.size();
+  for (EqualityNodeId current = t2; current != a;) {
+    EqualityEdgeId edge = d_proofForestParent[current];
+    path.push_back(edge ^ 1);
+    current = d_equalityEdges[edge].getNodeId();
+  }
+  std::reverse(path.begin() + downStart, path.end());
+}
+
 std::string EqualityEngine::edgesToString(EqualityEdgeId edgeId) const {
   std::stringstream out;
   bool first = true;
@@ -982,7 +1059,11 @@ void EqualityEngine::explainEquality(TNode t1, TNode t2, bool polarity,
   std::map<std::pair<EqualityNodeId, EqualityNodeId>, EqProof*> cache;
   if (polarity) {
     // Get the explanation
-    getExplanation(t1Id, t2Id, equalities, cache, eqp);
+    if (eqp) {
+      getExplanation(t1Id, t2Id, equalities, cache, eqp);
+    } else {
+      getExplanationCached(t1Id, t2Id, equalities);
+    }
   } else {
     if (eqp) {
       eqp->d_id = eq::MERGED_THROUGH_TRANS;
@@ -1083,10 +1164,45 @@ void EqualityEngine::explainPredicate(TNode p, bool polarity,
                     << std::endl;
   // Must have the term
   Assert(hasTerm(p));
+  EqualityNodeId pId = getNodeId(p);
+  EqualityNodeId polId = polarity ? d_trueId : d_falseId;
+  if (!eqp) {
+    getExplanationCached(pId, polId, assertions);
+    return;
+  }
   std::map<std::pair<EqualityNodeId, EqualityNodeId>, EqProof*> cache;
   // Get the explanation
-  getExplanation(
-      getNodeId(p), polarity ? d_trueId : d_falseId, assertions, cache, eqp);
+  getExplanation(pId, polId, assertions, cache, eqp);
+}
+
+void EqualityEngine::getExplanationCached(
+    EqualityNodeId t1Id,
+    EqualityNodeId t2Id,
+    std::vector<TNode>& equalities) const
+{
+  EqualityPair key = std::minmax(t1Id, t2Id);
+  ExplanationCache::const_iterator it = d_explanationCache.find(key);
+  if (it != d_explanationCache.end()) {
+    Debug("equality") << d_name << "::eq::getExplanationCached(): cache hit"
+                      << std::endl;
+    equalities.insert(equalities.end(),
+                      d_explanationCacheData.begin() + it->second.first,
+                      d_explanationCacheData.begin() + it->second.second);
+    return;
+  }
+  size_t start = equalities.size();
+  std::map<std::pair<EqualityNodeId, EqualityNodeId>, EqProof*> cache;
+  getExplanation(t1Id, t2Id, equalities, cache, nullptr);
+  // Store the explanation
+  size_t dataStart = d_explanationCacheData.size();
+  d_explanationCacheData.insert(d_explanationCacheData.end(),
+                                equalities.begin() + start,
+                                equalities.end());
+  d_explanationCache[key] =
+      std::pair<size_t, size_t>(dataStart, d_explanationCacheData.size());
+  d_explanationCacheKeys.push_back(key);
+  d_explanationCacheKeysSize = d_explanationCacheKeys.size();
+  d_explanationCacheDataSize = d_explanationCacheData.size();
 }
 
 void EqualityEngine::getExplanation(
@@ -1174,268 +1290,218 @@ void EqualityEngine::getExplanation(
     debugPrintGraph();
   }
 
-  // Queue for the BFS containing nodes
-  std::vector<BfsData> bfsQueue;
+  // Find the path from t1 to t2 in the proof forest. The path is stored in
+  // the shared scratch space, recursive calls only use the space above it.
+  size_t pathStart = d_explanationPath.size();
+  getProofForestPath(t1Id, t2Id, d_explanationPath);
+  size_t pathEnd = d_explanationPath.size();
 
-  // Find a path from t1 to t2 in the graph (BFS)
-  bfsQueue.push_back(BfsData(t1Id, null_id, 0));
-  size_t currentIndex = 0;
-  while (true) {
-    // There should always be a path, and every node can be visited only once (tree)
-    Assert(currentIndex < bfsQueue.size());
+  std::vector<std::shared_ptr<EqProof>> eqp_trans;
 
-    // The next node to visit
-    BfsData current = bfsQueue[currentIndex];
-    EqualityNodeId currentNode = current.d_nodeId;
+  // Go through the path backwards, from t2 to t1
+  for (size_t pathIndex = pathEnd; pathIndex > pathStart; -- pathIndex) {
+    EqualityEdgeId currentEdge = d_explanationPath[pathIndex - 1];
+    // The current node is the source of the edge, i.e. the target of its twin
+    EqualityNodeId currentNode = d_equalityEdges[currentEdge ^ 1].getNodeId();
+    EqualityNodeId edgeNode = d_equalityEdges[currentEdge].getNodeId();
+    unsigned reasonType = d_equalityEdges[currentEdge].getReasonType();
+    Node reason = d_equalityEdges[currentEdge].getReason();
 
-    Debug("equality") << d_name << "::eq::getExplanation(): currentNode =  " << d_nodes[currentNode] << std::endl;
+    Debug("equality") << d_name << "::eq::getExplanation(): currentEdge = " << currentEdge << ", currentNode = " << currentNode << std::endl;
+    Debug("equality") << d_name << "                     targetNode = " << d_nodes[edgeNode] << std::endl;
+    Debug("equality") << d_name << "                     reason type = " << reasonType << std::endl;
 
-    // Go through the equality edges of this node
-    EqualityEdgeId currentEdge = d_equalityGraph[currentNode];
-    if (Debug.isOn("equality")) {
-      Debug("equality") << d_name << "::eq::getExplanation(): edgesId =  " << currentEdge << std::endl;
-      Debug("equality") << d_name << "::eq::getExplanation(): edges =  " << edgesToString(currentEdge) << std::endl;
+    std::shared_ptr<EqProof> eqpc;;
+    // Make child proof if a proof is being constructed
+    if (eqp) {
+      eqpc = std::make_shared<EqProof>();
+      eqpc->d_id = reasonType;
     }
 
-    while (currentEdge != null_edge) {
-      // Get the edge
-      const EqualityEdge& edge = d_equalityEdges[currentEdge];
-
-      // If not just the backwards edge
-      if ((currentEdge | 1u) != (current.d_edgeId | 1u))
-      {
-        Debug("equality") << d_name << "::eq::getExplanation(): currentEdge = (" << d_nodes[currentNode] << "," << d_nodes[edge.getNodeId()] << ")" << std::endl;
-
-        // Did we find the path
-        if (edge.getNodeId() == t2Id) {
-
-          Debug("equality") << d_name << "::eq::getExplanation(): path found: " << std::endl;
-
-          std::vector<std::shared_ptr<EqProof>> eqp_trans;
-
-          // Reconstruct the path
-          do {
-            // The current node
-            currentNode = bfsQueue[currentIndex].d_nodeId;
-            EqualityNodeId edgeNode = d_equalityEdges[currentEdge].getNodeId();
-            unsigned reasonType = d_equalityEdges[currentEdge].getReasonType();
-            Node reason = d_equalityEdges[currentEdge].getReason();
-
-            Debug("equality") << d_name << "::eq::getExplanation(): currentEdge = " << currentEdge << ", currentNode = " << currentNode << std::endl;
-            Debug("equality") << d_name << "                     targetNode = " << d_nodes[edgeNode] << std::endl;
-            Debug("equality") << d_name << "                     in currentEdge = (" << d_nodes[currentNode] << "," << d_nodes[edge.getNodeId()] << ")" << std::endl;
-            Debug("equality") << d_name << "                     reason type = " << reasonType << std::endl;
-
-            std::shared_ptr<EqProof> eqpc;;
-            // Make child proof if a proof is being constructed
-            if (eqp) {
-              eqpc = std::make_shared<EqProof>();
-              eqpc->d_id = reasonType;
+    // Add the actual equality to the vector
+    switch (reasonType) {
+    case MERGED_THROUGH_CONGRUENCE: {
+      // f(x1, x2) == f(y1, y2) because x1 = y1 and x2 = y2
+      Debug("equality") << d_name << "::eq::getExplanation(): due to congruence, going deeper" << std::endl;
+      const FunctionApplication& f1 =
+          d_applications[currentNode].d_original;
+      const FunctionApplication& f2 =
+          d_applications[edgeNode].d_original;
+
+      Debug("equality") << push;
+      Debug("equality") << "Explaining left hand side equalities" << std::endl;
+      std::shared_ptr<EqProof> eqpc1 =
+          eqpc ? std::make_shared<EqProof>() : nullptr;
+      getExplanation(f1.d_a, f2.d_a, equalities, cache, eqpc1.get());
+      Debug("equality") << "Explaining right hand side equalities" << std::endl;
+      std::shared_ptr<EqProof> eqpc2 =
+          eqpc ? std::make_shared<EqProof>() : nullptr;
+      getExplanation(f1.d_b, f2.d_b, equalities, cache, eqpc2.get());
+      if( eqpc ){
+        eqpc->d_children.push_back( eqpc1 );
+        eqpc->d_children.push_back( eqpc2 );
+        if( d_nodes[currentNode].getKind()==kind::EQUAL ){
+          //leave node null for now
+          eqpc->d_node = Node::null();
+        } else {
+          if (d_nodes[f1.d_a].getKind() == kind::APPLY_UF
+              || d_nodes[f1.d_a].getKind() == kind::SELECT
+              || d_nodes[f1.d_a].getKind() == kind::STORE)
+          {
+            eqpc->d_node = d_nodes[f1.d_a];
+          }
+          else
+          {
+            if (d_nodes[f1.d_a].getKind() == kind::BUILTIN
+                && d_nodes[f1.d_a].getConst<Kind>() == kind::SELECT)
+            {
+              eqpc->d_node = NodeManager::currentNM()->mkNode(
+                  kind::PARTIAL_SELECT_1, d_nodes[f1.d_b]);
+              // The first child is a PARTIAL_SELECT_0.
+              // Give it a child so that we know what kind of (read) it is, when we dump to LFSC.
+              Assert(eqpc->d_children[0]->d_node.getKind()
+                     == kind::PARTIAL_SELECT_0);
+              Assert(eqpc->d_children[0]->d_children.size() == 0);
+
+              eqpc->d_children[0]->d_node =
+                  NodeManager::currentNM()->mkNode(
+                      kind::PARTIAL_SELECT_0, d_nodes[f1.d_b]);
             }
-
-            // Add the actual equality to the vector
-            switch (reasonType) {
-            case MERGED_THROUGH_CONGRUENCE: {
-              // f(x1, x2) == f(y1, y2) because x1 = y1 and x2 = y2
-              Debug("equality") << d_name << "::eq::getExplanation(): due to congruence, going deeper" << std::endl;
-              const FunctionApplication& f1 =
-                  d_applications[currentNode].d_original;
-              const FunctionApplication& f2 =
-                  d_applications[edgeNode].d_original;
-
-              Debug("equality") << push;
-              Debug("equality") << "Explaining left hand side equalities" << std::endl;
-              std::shared_ptr<EqProof> eqpc1 =
-                  eqpc ? std::make_shared<EqProof>() : nullptr;
-              getExplanation(f1.d_a, f2.d_a, equalities, cache, eqpc1.get());
-              Debug("equality") << "Explaining right hand side equalities" << std::endl;
-              std::shared_ptr<EqProof> eqpc2 =
-                  eqpc ? std::make_shared<EqProof>() : nullptr;
-              getExplanation(f1.d_b, f2.d_b, equalities, cache, eqpc2.get());
-              if( eqpc ){
-                eqpc->d_children.push_back( eqpc1 );
-                eqpc->d_children.push_back( eqpc2 );
-                if( d_nodes[currentNode].getKind()==kind::EQUAL ){
-                  //leave node null for now
-                  eqpc->d_node = Node::null();
-                } else {
-                  if (d_nodes[f1.d_a].getKind() == kind::APPLY_UF
-                      || d_nodes[f1.d_a].getKind() == kind::SELECT
-                      || d_nodes[f1.d_a].getKind() == kind::STORE)
-                  {
-                    eqpc->d_node = d_nodes[f1.d_a];
-                  }
-                  else
-                  {
-                    if (d_nodes[f1.d_a].getKind() == kind::BUILTIN
-                        && d_nodes[f1.d_a].getConst<Kind>() == kind::SELECT)
-                    {
-                      eqpc->d_node = NodeManager::currentNM()->mkNode(
-                          kind::PARTIAL_SELECT_1, d_nodes[f1.d_b]);
-                      // The first child is a PARTIAL_SELECT_0.
-                      // Give it a child so that we know what kind of (read) it is, when we dump to LFSC.
-                      Assert(eqpc->d_children[0]->d_node.getKind()
-                             == kind::PARTIAL_SELECT_0);
-                      Assert(eqpc->d_children[0]->d_children.size() == 0);
-
-                      eqpc->d_children[0]->d_node =
-                          NodeManager::currentNM()->mkNode(
-                              kind::PARTIAL_SELECT_0, d_nodes[f1.d_b]);
-                    }
-                    else
-                    {
-                      eqpc->d_node = NodeManager::currentNM()->mkNode(
-                          kind::PARTIAL_APPLY_UF,
-                          ProofManager::currentPM()->mkOp(d_nodes[f1.d_a]),
-                          d_nodes[f1.d_b]);
-                    }
-                  }
-                }
-              }
-              Debug("equality") << pop;
-              break;
+            else
+            {
+              eqpc->d_node = NodeManager::currentNM()->mkNode(
+                  kind::PARTIAL_APPLY_UF,
+                  ProofManager::currentPM()->mkOp(d_nodes[f1.d_a]),
+                  d_nodes[f1.d_b]);
             }
+          }
+        }
+      }
+      Debug("equality") << pop;
+      break;
+    }
 
-            case MERGED_THROUGH_REFLEXIVITY: {
-              // x1 == x1
-              Debug("equality") << d_name << "::eq::getExplanation(): due to reflexivity, going deeper" << std::endl;
-              EqualityNodeId eqId = currentNode == d_trueId ? edgeNode : currentNode;
-              const FunctionApplication& eq = d_applications[eqId].d_original;
-              Assert(eq.isEquality()) << "Must be an equality";
-
-              // Explain why a = b constant
-              Debug("equality") << push;
-              std::shared_ptr<EqProof> eqpc1 =
-                  eqpc ? std::make_shared<EqProof>() : nullptr;
-              getExplanation(eq.d_a, eq.d_b, equalities, cache, eqpc1.get());
-              if( eqpc ){
-                eqpc->d_children.push_back( eqpc1 );
-              }
-              Debug("equality") << pop;
+    case MERGED_THROUGH_REFLEXIVITY: {
+      // x1 == x1
+      Debug("equality") << d_name << "::eq::getExplanation(): due to reflexivity, going deeper" << std::endl;
+      EqualityNodeId eqId = currentNode == d_trueId ? edgeNode : currentNode;
+      const FunctionApplication& eq = d_applications[eqId].d_original;
+      Assert(eq.isEquality()) << "Must be an equality";
+
+      // Explain why a = b constant
+      Debug("equality") << push;
+      std::shared_ptr<EqProof> eqpc1 =
+          eqpc ? std::make_shared<EqProof>() : nullptr;
+      getExplanation(eq.d_a, eq.d_b, equalities, cache, eqpc1.get());
+      if( eqpc ){
+        eqpc->d_children.push_back( eqpc1 );
+      }
+      Debug("equality") << pop;
 
-              break;
-            }
+      break;
+    }
 
-            case MERGED_THROUGH_CONSTANTS: {
-              // f(c1, ..., cn) = c semantically, we can just ignore it
-              Debug("equality") << d_name << "::eq::getExplanation(): due to constants, explain the constants" << std::endl;
-              Debug("equality") << push;
+    case MERGED_THROUGH_CONSTANTS: {
+      // f(c1, ..., cn) = c semantically, we can just ignore it
+      Debug("equality") << d_name << "::eq::getExplanation(): due to constants, explain the constants" << std::endl;
+      Debug("equality") << push;
 
-              // Get the node we interpreted
-              TNode interpreted = d_nodes[currentNode];
-              if (interpreted.isConst()) {
-                interpreted = d_nodes[edgeNode];
-              }
+      // Get the node we interpreted
+      TNode interpreted = d_nodes[currentNode];
+      if (interpreted.isConst()) {
+        interpreted = d_nodes[edgeNode];
+      }
 
-              // Explain why a is a constant by explaining each argument
-              for (unsigned i = 0; i < interpreted.getNumChildren(); ++ i) {
-                EqualityNodeId childId = getNodeId(interpreted[i]);
-                Assert(isConstant(childId));
-                std::shared_ptr<EqProof> eqpcc =
-                    eqpc ? std::make_shared<EqProof>() : nullptr;
-                getExplanation(childId,
-                               getEqualityNode(childId).getFind(),
-                               equalities,
-                               cache,
-                               eqpcc.get());
-                if( eqpc ) {
-                  eqpc->d_children.push_back( eqpcc );
-                  if (Debug.isOn("pf::ee"))
-                  {
-                    Debug("pf::ee")
-                        << "MERGED_THROUGH_CONSTANTS. Dumping the child proof"
-                        << std::endl;
-                    eqpc->debug_print("pf::ee", 1);
-                  }
-                }
-              }
+      // Explain why a is a constant by explaining each argument
+      for (unsigned i = 0; i < interpreted.getNumChildren(); ++ i) {
+        EqualityNodeId childId = getNodeId(interpreted[i]);
+        Assert(isConstant(childId));
+        std::shared_ptr<EqProof> eqpcc =
+            eqpc ? std::make_shared<EqProof>() : nullptr;
+        getExplanation(childId,
+                       getEqualityNode(childId).getFind(),
+                       equalities,
+                       cache,
+                       eqpcc.get());
+        if( eqpc ) {
+          eqpc->d_children.push_back( eqpcc );
+          if (Debug.isOn("pf::ee"))
+          {
+            Debug("pf::ee")
+                << "MERGED_THROUGH_CONSTANTS. Dumping the child proof"
+                << std::endl;
+            eqpc->debug_print("pf::ee", 1);
+          }
+        }
+      }
 
-              Debug("equality") << pop;
-              break;
-            }
+      Debug("equality") << pop;
+      break;
+    }
 
-            default: {
-              // Construct the equality
-              Debug("equality") << d_name << "::eq::getExplanation(): adding: "
-                                << reason << std::endl;
-              Debug("equality") << d_name << "::eq::getExplanation(): reason type = " << reasonType << std::endl;
-              Node a = d_nodes[currentNode];
-              Node b = d_nodes[d_equalityEdges[currentEdge].getNodeId()];
-
-              if (eqpc) {
-                //apply proof reconstruction processing (when eqpc is non-null)
-                if (d_pathReconstructionTriggers.find(reasonType) != d_pathReconstructionTriggers.end()) {
-                  d_pathReconstructionTriggers.find(reasonType)
-                      ->second->notify(reasonType, reason, a, b, equalities,
-                                       eqpc.get());
-                }
-                if (reasonType == MERGED_THROUGH_EQUALITY) {
-                  eqpc->d_node = reason;
-                } else {
-                  // The LFSC translator prefers (not (= a b)) over (= (= a b) false)
-
-                  if (a == NodeManager::currentNM()->mkConst(false)) {
-                    eqpc->d_node = b.notNode();
-                  } else if (b == NodeManager::currentNM()->mkConst(false)) {
-                    eqpc->d_node = a.notNode();
-                  } else {
-                    eqpc->d_node = b.eqNode(a);
-                  }
-                }
-                eqpc->d_id = reasonType;
-              }
-              equalities.push_back(reason);
-              break;
-            }
-            }
+    default: {
+      // Construct the equality
+      Debug("equality") << d_name << "::eq::getExplanation(): adding: "
+                        << reason << std::endl;
+      Debug("equality") << d_name << "::eq::getExplanation(): reason type = " << reasonType << std::endl;
+      Node a = d_nodes[currentNode];
+      Node b = d_nodes[d_equalityEdges[currentEdge].getNodeId()];
 
-            // Go to the previous
-            currentEdge = bfsQueue[currentIndex].d_edgeId;
-            currentIndex = bfsQueue[currentIndex].d_previousIndex;
-
-            //---from Morgan---
-            if (eqpc != NULL && eqpc->d_id == MERGED_THROUGH_REFLEXIVITY) {
-              if(eqpc->d_node.isNull()) {
-                Assert(eqpc->d_children.size() == 1);
-                std::shared_ptr<EqProof> p = eqpc;
-                eqpc = p->d_children[0];
-              } else {
-                Assert(eqpc->d_children.empty());
-              }
-            }
-            //---end from Morgan---
-
-            eqp_trans.push_back(eqpc);
-          } while (currentEdge != null_id);
-
-          if (eqp) {
-            if(eqp_trans.size() == 1) {
-              *eqp = *eqp_trans[0];
-            } else {
-              eqp->d_id = MERGED_THROUGH_TRANS;
-              eqp->d_children.insert( eqp->d_children.end(), eqp_trans.begin(), eqp_trans.end() );
-              eqp->d_node = NodeManager::currentNM()->mkNode(kind::EQUAL, d_nodes[t1Id], d_nodes[t2Id]);
-            }
-            if (Debug.isOn("pf::ee"))
-            {
-              eqp->debug_print("pf::ee", 1);
-            }
+      if (eqpc) {
+        //apply proof reconstruction processing (when eqpc is non-null)
+        if (d_pathReconstructionTriggers.find(reasonType) != d_pathReconstructionTriggers.end()) {
+          d_pathReconstructionTriggers.find(reasonType)
+              ->second->notify(reasonType, reason, a, b, equalities,
+                               eqpc.get());
+        }
+        if (reasonType == MERGED_THROUGH_EQUALITY) {
+          eqpc->d_node = reason;
+        } else {
+          // The LFSC translator prefers (not (= a b)) over (= (= a b) false)
+
+          if (a == NodeManager::currentNM()->mkConst(false)) {
+            eqpc->d_node = b.notNode();
+          } else if (b == NodeManager::currentNM()->mkConst(false)) {
+            eqpc->d_node = a.notNode();
+          } else {
+            eqpc->d_node = b.eqNode(a);
           }
-
-          // Done
-          return;
         }
-
-        // Push to the visitation queue if it's not the backward edge
-        bfsQueue.push_back(BfsData(edge.getNodeId(), currentEdge, currentIndex));
+        eqpc->d_id = reasonType;
       }
+      equalities.push_back(reason);
+      break;
+    }
+    }
 
-      // Go to the next edge
-      currentEdge = edge.getNext();
+    //---from Morgan---
+    if (eqpc != NULL && eqpc->d_id == MERGED_THROUGH_REFLEXIVITY) {
+      if(eqpc->d_node.isNull()) {
+        Assert(eqpc->d_children.size() == 1);
+        std::shared_ptr<EqProof> p = eqpc;
+        eqpc = p->d_children[0];
+      } else {
+        Assert(eqpc->d_children.empty());
+      }
     }
+    //---end from Morgan---
 
-    // Go to the next node to visit
-    ++ currentIndex;
+    eqp_trans.push_back(eqpc);
+  }
+  d_explanationPath.resize(pathStart);
+
+  if (eqp) {
+    if(eqp_trans.size() == 1) {
+      *eqp = *eqp_trans[0];
+    } else {
+      eqp->d_id = MERGED_THROUGH_TRANS;
+      eqp->d_children.insert( eqp->d_children.end(), eqp_trans.begin(), eqp_trans.end() );
+      eqp->d_node = NodeManager::currentNM()->mkNode(kind::EQUAL, d_nodes[t1Id], d_nodes[t2Id]);
+    }
+    if (Debug.isOn("pf::ee"))
+    {
+      eqp->debug_print("pf::ee", 1);
+    }
   }
 }
 
@@ -251,7 +251,7 @@ private:
   std::map<unsigned, const PathReconstructionNotify*> d_pathReconstructionTriggers;
 
   /** Map from nodes to their ids */
-  std::unordered_map<TNode, EqualityNodeId, TNodeHashFunction> d_nodeIds;
+  NodeIdMap d_nodeIds;
 
   /** Map from function applications to their ids */
   typedef std::unordered_map<FunctionApplication, EqualityNodeId, FunctionApplicationHashFunction> ApplicationIdsMap;
@@ -372,6 +372,51 @@ private:
   /** Add an edge to the equality graph */
   void addGraphEdge(EqualityNodeId t1, EqualityNodeId t2, unsigned type, TNode reason);
 
+  /**
+   * The equality graph is a forest (edges are only added between different
+   * classes), which we additionally keep as a rooted proof forest: the edge
+   * d_proofForestParent[n] points from n to its parent, or is null_edge if n
+   * is a root. This allows us to find the path between two nodes in time
+   * linear in the length of the path, instead of searching the whole class.
+   */
+  std::vector<EqualityEdgeId> d_proofForestParent;
+
+  /** Information needed to undo the proof forest update of an edge */
+  struct ProofForestUpdate {
+    /** The node that was attached to its new parent */
+    EqualityNodeId d_child;
+    /** The root of the child's tree before it was rerooted */
+    EqualityNodeId d_oldRoot;
+    ProofForestUpdate(EqualityNodeId child, EqualityNodeId oldRoot)
+        : d_child(child), d_oldRoot(oldRoot)
+    {
+    }
+  };/* struct EqualityEngine::ProofForestUpdate */
+
+  /** Proof forest updates, one for each pair of edges */
+  std::vector<ProofForestUpdate> d_proofForestUpdates;
+
+  /** Make n the root of its proof forest tree, returns the old root */
+  EqualityNodeId rerootProofForest(EqualityNodeId n);
+
+  /** Returns the depth of n in its proof forest tree */
+  unsigned getProofForestDepth(EqualityNodeId n) const;
+
+  /**
+   * Appends to path the edges on the path from t1 to t2 in the proof forest,
+   * in order. Each edge is oriented from the t1 side towards t2, i.e. its
+   * target is the node closer to t2.
+   */
+  void getProofForestPath(EqualityNodeId t1,
+                          EqualityNodeId t2,
+                          std::vector<EqualityEdgeId>& path) const;
+
+  /**
+   * Scratch space for the paths of getExplanation, shared among its recursive
+   * calls to avoid allocations.
+   */
+  mutable std::vector<EqualityEdgeId> d_explanationPath;
+
   /** Returns the equality node of the given node */
   EqualityNode& getEqualityNode(TNode node);
 
@@ -520,6 +565,39 @@ private:
   /** Are we in propagate */
   bool d_inPropagate;
 
+  /**
+   * Cache of explanations computed without proofs. The path between two nodes
+   * of the proof forest does not change until one of its edges is
+   * backtracked, so an explanation remains valid in all contexts extending the
+   * one it was computed in. The cache maps ordered pairs of ids to ranges in
+   * d_explanationCacheData, and is backtracked like the rest of the data.
+   */
+  typedef std::unordered_map<EqualityPair,
+                             std::pair<size_t, size_t>,
+                             EqualityPairHashFunction>
+      ExplanationCache;
+  mutable ExplanationCache d_explanationCache;
+
+  /** The keys of d_explanationCache, in the order they were added */
+  mutable std::vector<EqualityPair> d_explanationCacheKeys;
+
+  /** Context-dependent size of d_explanationCacheKeys */
+  mutable context::CDO<size_t> d_explanationCacheKeysSize;
+
+  /** The explanations of d_explanationCache */
+  mutable std::vector<TNode> d_explanationCacheData;
+
+  /** Context-dependent size of d_explanationCacheData */
+  mutable context::CDO<size_t> d_explanationCacheDataSize;
+
+  /**
+   * Get the explanation of t1Id = t2Id without proofs, using and updating
+   * the explanation cache.
+   */
+  void getExplanationCached(EqualityNodeId t1Id,
+                            EqualityNodeId t2Id,
+                            std::vector<TNode>& equalities) const;
+
   /**
    * Get an explanation of the equality t1 = t2. Returns the asserted equalities
    * that imply t1 = t2. Returns TNodes as the assertion equalities should be
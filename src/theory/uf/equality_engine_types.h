@@ -23,7 +23,9 @@
 #include <string>
 #include <iostream>
 #include <sstream>
+#include <vector>
 
+#include "expr/node.h"
 #include "util/hash.h"
 
 namespace CVC4 {
@@ -273,6 +275,113 @@ public:
   }
 };
 
+/**
+ * A flat hash map from terms to their equality node ids. It uses open
+ * addressing with linear probing in a single array, which is considerably
+ * more cache-friendly than std::unordered_map for the frequent lookups of
+ * EqualityEngine::getNodeId. Entries are erased by shifting the following
+ * entries of the probe sequence backwards, so no tombstones are needed.
+ */
+class NodeIdMap {
+
+  /** An entry of the table, it is empty if the id is null_id */
+  struct Entry {
+    TNode d_node;
+    EqualityNodeId d_id;
+    Entry() : d_id(null_id) {}
+  };
+
+  /** The table, its size is always a power of two */
+  std::vector<Entry> d_entries;
+
+  /** Number of non-empty entries */
+  size_t d_size;
+
+  /** The size of the table minus one */
+  size_t d_mask;
+
+  /** Returns the first slot of the probe sequence for t */
+  size_t getSlot(TNode t) const {
+    uint64_t h = TNodeHashFunction()(t);
+    return static_cast<size_t>((h * 0x9e3779b97f4a7c15ULL) >> 32) & d_mask;
+  }
+
+  /** Returns the slot of t, or the empty slot where it would be inserted */
+  size_t findSlot(TNode t) const {
+    size_t i = getSlot(t);
+    while (d_entries[i].d_id != null_id && d_entries[i].d_node != t) {
+      i = (i + 1) & d_mask;
+    }
+    return i;
+  }
+
+  /** Doubles the size of the table */
+  void grow() {
+    std::vector<Entry> old;
+    old.swap(d_entries);
+    d_entries.resize(old.empty() ? 64 : 2 * old.size());
+    d_mask = d_entries.size() - 1;
+    for (const Entry& e : old) {
+      if (e.d_id != null_id) {
+        d_entries[findSlot(e.d_node)] = e;
+      }
+    }
+  }
+
+public:
+
+  NodeIdMap() : d_size(0), d_mask(0) {}
+
+  /** Returns the id of t, or null_id if t is not in the map */
+  EqualityNodeId find(TNode t) const {
+    if (d_size == 0) {
+      return null_id;
+    }
+    return d_entries[findSlot(t)].d_id;
+  }
+
+  /** Returns true if t is in the map */
+  bool contains(TNode t) const { return find(t) != null_id; }
+
+  /** Maps t to id */
+  void insert(TNode t, EqualityNodeId id) {
+    Assert(id != null_id);
+    // Keep the load factor at most 1/2
+    if (2 * (d_size + 1) > d_entries.size()) {
+      grow();
+    }
+    Entry& e = d_entries[findSlot(t)];
+    if (e.d_id == null_id) {
+      ++ d_size;
+    }
+    e.d_node = t;
+    e.d_id = id;
+  }
+
+  /** Removes t from the map */
+  void erase(TNode t) {
+    if (d_size == 0) {
+      return;
+    }
+    size_t i = findSlot(t);
+    if (d_entries[i].d_id == null_id) {
+      return;
+    }
+    // Move back any following entry whose probe sequence passes through i
+    for (size_t j = (i + 1) & d_mask; d_entries[j].d_id != null_id;
+         j = (j + 1) & d_mask) {
+      size_t k = getSlot(d_entries[j].d_node);
+      bool canMove = i <= j ? (k <= i || k > j) : (k <= i && k > j);
+      if (canMove) {
+        d_entries[i] = d_entries[j];
+        i = j;
+      }
+    }
+    d_entries[i] = Entry();
+    -- d_size;
+  }
+};/* class NodeIdMap */
+
 /** A pair of ids */
 typedef std::pair<EqualityNodeId, EqualityNodeId> EqualityPair;
 using EqualityPairHashFunction =
@@ -26,6 +26,7 @@
  * Including <cstddef> is a workaround for this issue.
  */
 #include <cstddef>
+#include <iosfwd>
 
 #include <gmpxx.h>
 
@@ -42,6 +43,13 @@ inline size_t gmpz_hash(const mpz_t toHash) {
   return hash;
 }/* gmpz_hash() */
 
+/**
+ * Writes the decimal representation of the gmp integer z to out. The digits
+ * of small integers are formatted in a buffer on the stack, hence without a
+ * temporary string.
+ */
+void gmpz_write(std::ostream& out, mpz_srcptr z);
+
 }/* CVC4 namespace */
 
 #endif /* CVC4__GMP_UTIL_H */
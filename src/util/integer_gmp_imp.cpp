@@ -17,6 +17,8 @@
 #include "util/integer.h"
 
 #include <cmath>
+#include <cstring>
+#include <memory>
 #include <sstream>
 #include <string>
 
@@ -34,6 +36,34 @@ using namespace std;
 
 namespace CVC4 {
 
+void gmpz_write(std::ostream& out, mpz_srcptr z)
+{
+  // the size may exceed the number of digits by one, plus the sign and the
+  // terminating null character
+  size_t size = mpz_sizeinbase(z, 10) + 2;
+  char small[64];
+  std::unique_ptr<char[]> large;
+  char* buf = small;
+  if (size > sizeof(small))
+  {
+    large.reset(new char[size]);
+    buf = large.get();
+  }
+  mpz_get_str(buf, 10, z);
+  out.write(buf, std::strlen(buf));
+}
+
+std::ostream& operator<<(std::ostream& os, const Integer& n)
+{
+  if (os.width() != 0)
+  {
+    // honor the field width
+    return os << n.toString();
+  }
+  gmpz_write(os, n.getValue().get_mpz_t());
+  return os;
+}
+
 Integer::Integer(const char* s, unsigned base)
   : d_value(s, base)
 {}
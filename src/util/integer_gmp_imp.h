@@ -548,10 +548,7 @@ struct IntegerHashFunction
   inline size_t operator()(const CVC4::Integer& i) const { return i.hash(); }
 }; /* struct IntegerHashFunction */
 
-inline std::ostream& operator<<(std::ostream& os, const Integer& n)
-{
-  return os << n.toString();
-}
+CVC4_PUBLIC std::ostream& operator<<(std::ostream& os, const Integer& n);
 
 }  // namespace CVC4
 
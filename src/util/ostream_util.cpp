@@ -15,6 +15,13 @@
  **/
 #include "util/ostream_util.h"
 
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
 namespace CVC4 {
 
 StreamFormatScope::StreamFormatScope(std::ostream& out)
@@ -28,4 +35,97 @@ StreamFormatScope::~StreamFormatScope()
   d_out.flags(d_format_flags);
 }
 
+FdStreamBuf::FdStreamBuf(int fd, bool owned, size_t size)
+    : d_fd(fd), d_owned(owned), d_buffer(std::max<size_t>(size, 1))
+{
+  setp(d_buffer.data(), d_buffer.data() + d_buffer.size());
+}
+
+FdStreamBuf::~FdStreamBuf()
+{
+  writeBuffer();
+  if (d_owned)
+  {
+    ::close(d_fd);
+  }
+}
+
+bool FdStreamBuf::writeAll(const char* s, size_t n)
+{
+  while (n > 0)
+  {
+    ssize_t written = ::write(d_fd, s, n);
+    if (written < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      return false;
+    }
+    s += written;
+    n -= written;
+  }
+  return true;
+}
+
+bool FdStreamBuf::writeBuffer()
+{
+  size_t n = pptr() - pbase();
+  setp(d_buffer.data(), d_buffer.data() + d_buffer.size());
+  return writeAll(d_buffer.data(), n);
+}
+
+FdStreamBuf::int_type FdStreamBuf::overflow(int_type c)
+{
+  if (!writeBuffer())
+  {
+    return traits_type::eof();
+  }
+  if (!traits_type::eq_int_type(c, traits_type::eof()))
+  {
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+  }
+  return traits_type::not_eof(c);
+}
+
+std::streamsize FdStreamBuf::xsputn(const char* s, std::streamsize n)
+{
+  size_t count = n;
+  if (count <= static_cast<size_t>(epptr() - pptr()))
+  {
+    std::memcpy(pptr(), s, count);
+    pbump(count);
+    return n;
+  }
+  // the buffer is full, write it out, and then write the data directly if it
+  // would not fit in the buffer either
+  if (!writeBuffer())
+  {
+    return 0;
+  }
+  if (count >= d_buffer.size())
+  {
+    return writeAll(s, count) ? n : 0;
+  }
+  std::memcpy(pptr(), s, count);
+  pbump(count);
+  return n;
+}
+
+int FdStreamBuf::sync() { return writeBuffer() ? 0 : -1; }
+
+FdOstream::FdOstream(const std::string& filename) : std::ostream(nullptr)
+{
+  int fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+  if (fd < 0)
+  {
+    setstate(std::ios_base::badbit);
+    return;
+  }
+  d_buf.reset(new FdStreamBuf(fd, true));
+  rdbuf(d_buf.get());
+}
+
 }  // namespace CVC4
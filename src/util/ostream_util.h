@@ -20,7 +20,11 @@
 #define CVC4__UTIL__OSTREAM_UTIL_H
 
 #include <ios>
+#include <memory>
 #include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
 
 namespace CVC4 {
 
@@ -44,6 +48,59 @@ class StreamFormatScope
   std::streamsize d_precision;
 };
 
+/**
+ * A stream buffer that writes to a file descriptor with write(2). The buffer
+ * is allocated once, with a fixed size, and writes larger than the buffer
+ * bypass it. A flush of the stream, e.g. by std::endl, writes the buffer out.
+ */
+class FdStreamBuf : public std::streambuf
+{
+ public:
+  /**
+   * Create a stream buffer for fd, which is closed on destruction if owned
+   * is true.
+   */
+  FdStreamBuf(int fd, bool owned, size_t size = 1 << 20);
+  ~FdStreamBuf();
+
+ protected:
+  int_type overflow(int_type c) override;
+  std::streamsize xsputn(const char* s, std::streamsize n) override;
+  int sync() override;
+
+ private:
+  /** Write the contents of the buffer, returns false on error */
+  bool writeBuffer();
+  /** Write n bytes at s to the file descriptor, returns false on error */
+  bool writeAll(const char* s, size_t n);
+
+  /** The file descriptor */
+  int d_fd;
+  /** Whether the file descriptor is closed on destruction */
+  bool d_owned;
+  /** The buffer */
+  std::vector<char> d_buffer;
+};
+
+/**
+ * An output stream on a file, which writes through an FdStreamBuf. It is
+ * used for the files that output options name, such as --dump-to, which may
+ * receive tens of megabytes of output.
+ */
+class FdOstream : public std::ostream
+{
+ public:
+  /**
+   * Open the file filename for writing, truncating it. If it cannot be
+   * opened, the badbit of the stream is set, and errno gives the reason.
+   */
+  FdOstream(const std::string& filename);
+
+ private:
+  /** The stream buffer, which is null if the file could not be opened */
+  std::unique_ptr<FdStreamBuf> d_buf;
+};
+
 }  // namespace CVC4
 
 #endif /* CVC4__UTIL__OSTREAM_UTIL_H */
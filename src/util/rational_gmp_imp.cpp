@@ -30,7 +30,19 @@
 namespace CVC4 {
 
 std::ostream& operator<<(std::ostream& os, const Rational& q){
-  return os << q.toString();
+  if (os.width() != 0)
+  {
+    // honor the field width
+    return os << q.toString();
+  }
+  const mpq_class& value = q.getValue();
+  gmpz_write(os, value.get_num_mpz_t());
+  if (mpz_cmp_ui(value.get_den_mpz_t(), 1) != 0)
+  {
+    os << '/';
+    gmpz_write(os, value.get_den_mpz_t());
+  }
+  return os;
 }
 
 
@@ -199,6 +199,11 @@ ResourceManager::ResourceManager(StatisticsRegistry& stats, Options& options)
       d_spendResourceCalls(0),
       d_hardListeners(),
       d_softListeners(),
+      d_progressListeners(),
+      d_progressPeriod(0),
+      d_progressTimer(),
+      d_interruptRequested(false),
+      d_resourceCounts(static_cast<size_t>(Resource::TheoryCheckStep) + 1, 0),
       d_statistics(new ResourceManager::Statistics(stats)),
       d_options(options)
 
@@ -260,6 +265,17 @@ void ResourceManager::spendResource(unsigned amount)
 {
   ++d_spendResourceCalls;
   d_cumulativeResourceUsed += amount;
+  if (d_progressTimer.expired())
+  {
+    d_progressTimer.set(d_progressPeriod);
+    d_progressListeners.notify();
+  }
+  if (d_interruptRequested.load(std::memory_order_relaxed))
+  {
+    Trace("limit") << "ResourceManager::spendResource: interrupt requested"
+                   << std::endl;
+    d_softListeners.notify();
+  }
   if (!d_on) return;
 
   Debug("limit") << "ResourceManager::spendResource()" << std::endl;
@@ -284,6 +300,7 @@ void ResourceManager::spendResource(unsigned amount)
 
 void ResourceManager::spendResource(Resource r)
 {
+  ++d_resourceCounts[static_cast<size_t>(r)];
   uint32_t amount = 0;
   switch (r)
   {
@@ -348,6 +365,27 @@ void ResourceManager::spendResource(Resource r)
   spendResource(amount);
 }
 
+uint64_t ResourceManager::getResourceCount(Resource r) const
+{
+  return d_resourceCounts[static_cast<size_t>(r)];
+}
+
+void ResourceManager::interrupt()
+{
+  d_interruptRequested.store(true, std::memory_order_relaxed);
+}
+
+void ResourceManager::clearInterrupt()
+{
+  d_interruptRequested.store(false, std::memory_order_relaxed);
+}
+
+void ResourceManager::setProgressPeriod(uint64_t millis)
+{
+  d_progressPeriod = millis;
+  d_progressTimer.set(millis);
+}
+
 void ResourceManager::beginCall() {
 
   d_perCallTimer.set(d_timeBudgetPerCall, !d_cpuTime);
@@ -445,4 +483,10 @@ ListenerCollection::Registration* ResourceManager::registerSoftListener(
   return d_softListeners.registerListener(listener);
 }
 
+ListenerCollection::Registration* ResourceManager::registerProgressListener(
+    Listener* listener)
+{
+  return d_progressListeners.registerListener(listener);
+}
+
 } /* namespace CVC4 */
@@ -22,8 +22,10 @@
 
 #include <sys/time.h>
 
+#include <atomic>
 #include <cstddef>
 #include <memory>
+#include <vector>
 
 #include "base/exception.h"
 #include "base/listener.h"
@@ -142,6 +144,30 @@ public:
 
  static uint64_t getFrequencyCount() { return s_resourceCount; }
 
+ /**
+  * Returns the number of times that the resource r has been spent. Unlike
+  * the statistics, these counts are kept in builds without statistics.
+  */
+ uint64_t getResourceCount(Resource r) const;
+
+ /**
+  * Requests the interruption of the current call, or of the next one if no
+  * call is in progress. The request is handled as a soft resource out, the
+  * next time that a resource is spent, and it remains pending until
+  * clearInterrupt() is called. Unlike the other methods of this class, this
+  * method may be called from any thread.
+  */
+ void interrupt();
+
+ /** Clears a pending interruption request. */
+ void clearInterrupt();
+
+ /**
+  * Sets the period at which the progress listeners are notified while
+  * resources are spent, in milliseconds of wall time (0 = never).
+  */
+ void setProgressPeriod(uint64_t millis);
+
  /**
   * Registers a listener that is notified on a hard resource out.
   *
@@ -158,6 +184,16 @@ public:
   */
  ListenerCollection::Registration* registerSoftListener(Listener* listener);
 
+ /**
+  * Registers a listener that is notified periodically while resources are
+  * spent, see setProgressPeriod().
+  *
+  * This Registration must be destroyed by the user before this
+  * ResourceManager.
+  */
+ ListenerCollection::Registration* registerProgressListener(
+     Listener* listener);
+
 private:
  Timer d_cumulativeTimer;
  Timer d_perCallTimer;
@@ -200,6 +236,23 @@ private:
  /** Receives a notification on reaching a hard limit. */
  ListenerCollection d_softListeners;
 
+ /** Receives the periodic progress notifications. */
+ ListenerCollection d_progressListeners;
+
+ /** The period of the progress notifications, in milliseconds. */
+ uint64_t d_progressPeriod;
+ /** Expires when the progress listeners are to be notified next. */
+ Timer d_progressTimer;
+
+ /** Whether an interruption was requested, possibly by another thread. */
+ std::atomic<bool> d_interruptRequested;
+
+ /**
+  * The number of times that each resource has been spent, indexed by
+  * Resource, whose last value is TheoryCheckStep.
+  */
+ std::vector<uint64_t> d_resourceCounts;
+
  /**
   * ResourceManagers cannot be copied as they are given an explicit
   * list of Listeners to respond to.
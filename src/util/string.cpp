@@ -15,6 +15,7 @@
 #include "util/string.h"
 
 #include <algorithm>
+#include <cctype>
 #include <climits>
 #include <iomanip>
 #include <iostream>
@@ -29,24 +30,85 @@ namespace CVC4 {
 
 static_assert(UCHAR_MAX == 255, "Unsigned char is assumed to have 256 values.");
 
-String::String(const std::vector<unsigned> &s) : d_str(s)
+namespace {
+
+/** Hash of the code points in vec */
+size_t hashCodePoints(const std::vector<unsigned>& vec)
+{
+  // FNV-1a
+  size_t h = 14695981039346656037ULL;
+  for (unsigned c : vec)
+  {
+    h = (h ^ c) * 1099511628211ULL;
+  }
+  return h;
+}
+
+}  // namespace
+
+String::Buffer::Buffer(std::vector<unsigned>&& vec)
+    : d_vec(std::move(vec)), d_hash(hashCodePoints(d_vec))
 {
 #ifdef CVC4_ASSERTIONS
-  for (unsigned u : d_str)
+  for (unsigned u : d_vec)
   {
     Assert(u < num_codes());
   }
 #endif
 }
 
+const std::shared_ptr<const String::Buffer>& String::emptyBuffer()
+{
+  // all empty strings share the same buffer
+  static const std::shared_ptr<const Buffer> buf =
+      std::make_shared<const Buffer>(std::vector<unsigned>());
+  return buf;
+}
+
+String::String() : d_buf(emptyBuffer()) {}
+
+String::String(String&& s) : d_buf(std::move(s.d_buf))
+{
+  s.d_buf = emptyBuffer();
+}
+
+String& String::operator=(String&& s)
+{
+  if (this != &s)
+  {
+    d_buf = std::move(s.d_buf);
+    s.d_buf = emptyBuffer();
+  }
+  return *this;
+}
+
+String::String(const std::vector<unsigned>& s)
+    : d_buf(std::make_shared<const Buffer>(std::vector<unsigned>(s)))
+{
+}
+
+String::String(std::vector<unsigned>&& s)
+    : d_buf(std::make_shared<const Buffer>(std::move(s)))
+{
+}
+
+bool String::operator==(const String& y) const
+{
+  if (d_buf == y.d_buf)
+  {
+    return true;
+  }
+  return hash() == y.hash() && getVec() == y.getVec();
+}
+
 int String::cmp(const String &y) const {
   if (size() != y.size()) {
     return size() < y.size() ? -1 : 1;
   }
   for (unsigned int i = 0; i < size(); ++i) {
-    if (d_str[i] != y.d_str[i]) {
-      unsigned cp = d_str[i];
-      unsigned cpy = y.d_str[i];
+    if (getVec()[i] != y.getVec()[i]) {
+      unsigned cp = getVec()[i];
+      unsigned cpy = y.getVec()[i];
       return cp < cpy ? -1 : 1;
     }
   }
@@ -54,9 +116,21 @@ int String::cmp(const String &y) const {
 }
 
 String String::concat(const String &other) const {
-  std::vector<unsigned int> ret_vec(d_str);
-  ret_vec.insert(ret_vec.end(), other.d_str.begin(), other.d_str.end());
-  return String(ret_vec);
+  if (other.empty())
+  {
+    return *this;
+  }
+  else if (empty())
+  {
+    return other;
+  }
+  const std::vector<unsigned>& vec = getVec();
+  const std::vector<unsigned>& ovec = other.getVec();
+  std::vector<unsigned> ret_vec;
+  ret_vec.reserve(vec.size() + ovec.size());
+  ret_vec.insert(ret_vec.end(), vec.begin(), vec.end());
+  ret_vec.insert(ret_vec.end(), ovec.begin(), ovec.end());
+  return String(std::move(ret_vec));
 }
 
 bool String::strncmp(const String& y, std::size_t n) const
@@ -71,7 +145,7 @@ bool String::strncmp(const String& y, std::size_t n) const
     }
   }
   for (std::size_t i = 0; i < n; ++i) {
-    if (d_str[i] != y.d_str[i]) return false;
+    if (getVec()[i] != y.getVec()[i]) return false;
   }
   return true;
 }
@@ -88,7 +162,7 @@ bool String::rstrncmp(const String& y, std::size_t n) const
     }
   }
   for (std::size_t i = 0; i < n; ++i) {
-    if (d_str[size() - i - 1] != y.d_str[y.size() - i - 1]) return false;
+    if (getVec()[size() - i - 1] != y.getVec()[y.size() - i - 1]) return false;
   }
   return true;
 }
@@ -113,8 +187,17 @@ std::vector<unsigned> String::toInternal(const std::string& s,
                                          bool useEscSequences)
 {
   std::vector<unsigned> str;
-  unsigned i = 0;
-  while (i < s.size())
+  appendInternal(s.c_str(), s.size(), useEscSequences, str);
+  return str;
+}
+
+void String::appendInternal(const char* s,
+                            size_t n,
+                            bool useEscSequences,
+                            std::vector<unsigned>& str)
+{
+  size_t i = 0;
+  while (i < n)
   {
     // get the current character
     char si = s[i];
@@ -131,10 +214,11 @@ std::vector<unsigned> String::toInternal(const std::string& s,
     ++i;
     // are we an escape sequence?
     bool isEscapeSequence = true;
-    // the string corresponding to the hexidecimal code point
-    std::stringstream hexString;
+    // the hexidecimal code point and its number of digits
+    uint32_t val = 0;
+    size_t ndigits = 0;
     // is the slash followed by a 'u'? Could be last character.
-    if (i >= s.size() || s[i] != 'u')
+    if (i >= n || s[i] != 'u')
     {
       isEscapeSequence = false;
     }
@@ -146,7 +230,7 @@ std::vector<unsigned> String::toInternal(const std::string& s,
       bool isStart = true;
       bool isEnd = false;
       bool hasBrace = false;
-      while (i < s.size())
+      while (i < n)
       {
         // add the next character
         si = s[i];
@@ -165,7 +249,7 @@ std::vector<unsigned> String::toInternal(const std::string& s,
         else if (si == '}')
         {
           // can only end if we had an open brace and read at least one digit
-          isEscapeSequence = hasBrace && !hexString.str().empty();
+          isEscapeSequence = hasBrace && ndigits > 0;
           isEnd = true;
           addCharToInternal(si, nonEscCache);
           ++i;
@@ -177,16 +261,18 @@ std::vector<unsigned> String::toInternal(const std::string& s,
           isEscapeSequence = false;
           break;
         }
-        hexString << si;
+        val = val * 16
+              + (isdigit(si) ? si - '0' : std::tolower(si) - 'a' + 10);
+        ndigits++;
         addCharToInternal(si, nonEscCache);
         ++i;
-        if (!hasBrace && hexString.str().size() == 4)
+        if (!hasBrace && ndigits == 4)
         {
           // will be finished reading \ u d_3 d_2 d_1 d_0 with no parens
           isEnd = true;
           break;
         }
-        else if (hasBrace && hexString.str().size() > 5)
+        else if (hasBrace && ndigits > 5)
         {
           // too many digits enclosed in brace, not an escape sequence
           isEscapeSequence = false;
@@ -202,11 +288,9 @@ std::vector<unsigned> String::toInternal(const std::string& s,
     }
     if (isEscapeSequence)
     {
-      Assert(!hexString.str().empty() && hexString.str().size() <= 5);
+      Assert(ndigits > 0 && ndigits <= 5);
       // Otherwise, we add the escaped character.
-      // This is guaranteed not to overflow due to the length of hstr.
-      uint32_t val;
-      hexString >> std::hex >> val;
+      // This is guaranteed not to overflow due to the number of digits.
       if (val > num_codes())
       {
         // Failed due to being out of range. This can happen for strings of
@@ -232,19 +316,18 @@ std::vector<unsigned> String::toInternal(const std::string& s,
     Assert(u < num_codes());
   }
 #endif
-  return str;
 }
 
 unsigned String::front() const
 {
-  Assert(!d_str.empty());
-  return d_str.front();
+  Assert(!getVec().empty());
+  return getVec().front();
 }
 
 unsigned String::back() const
 {
-  Assert(!d_str.empty());
-  return d_str.back();
+  Assert(!getVec().empty());
+  return getVec().back();
 }
 
 std::size_t String::overlap(const String &y) const {
@@ -277,14 +360,14 @@ std::string String::toString(bool useEscSequences) const {
     // we always print forward slash as a code point so that it cannot
     // be interpreted as specifying part of a code point, e.g. the string
     // '\' + 'u' + '0' of length three.
-    if (isPrintable(d_str[i]) && d_str[i] != '\\' && !useEscSequences)
+    if (isPrintable(getVec()[i]) && getVec()[i] != '\\' && !useEscSequences)
     {
-      str << static_cast<char>(d_str[i]);
+      str << static_cast<char>(getVec()[i]);
     }
     else
     {
       std::stringstream ss;
-      ss << std::hex << d_str[i];
+      ss << std::hex << getVec()[i];
       str << "\\u{" << ss.str() << "}";
     }
   }
@@ -299,8 +382,8 @@ bool String::isLeq(const String &y) const
     {
       return false;
     }
-    unsigned ci = d_str[i];
-    unsigned cyi = y.d_str[i];
+    unsigned ci = getVec()[i];
+    unsigned cyi = y.getVec()[i];
     if (ci > cyi)
     {
       return false;
@@ -315,9 +398,9 @@ bool String::isLeq(const String &y) const
 
 bool String::isRepeated() const {
   if (size() > 1) {
-    unsigned int f = d_str[0];
+    unsigned int f = getVec()[0];
     for (unsigned i = 1; i < size(); ++i) {
-      if (f != d_str[i]) return false;
+      if (f != getVec()[i]) return false;
     }
   }
   return true;
@@ -327,7 +410,7 @@ bool String::tailcmp(const String &y, int &c) const {
   int id_x = size() - 1;
   int id_y = y.size() - 1;
   while (id_x >= 0 && id_y >= 0) {
-    if (d_str[id_x] != y.d_str[id_y]) {
+    if (getVec()[id_x] != y.getVec()[id_y]) {
       c = id_x;
       return false;
     }
@@ -343,10 +426,12 @@ std::size_t String::find(const String &y, const std::size_t start) const {
   if (y.empty()) return start;
   if (empty()) return std::string::npos;
 
-  std::vector<unsigned>::const_iterator itr = std::search(
-      d_str.begin() + start, d_str.end(), y.d_str.begin(), y.d_str.end());
-  if (itr != d_str.end()) {
-    return itr - d_str.begin();
+  const std::vector<unsigned>& str = getVec();
+  const std::vector<unsigned>& ystr = y.getVec();
+  std::vector<unsigned>::const_iterator itr =
+      std::search(str.begin() + start, str.end(), ystr.begin(), ystr.end());
+  if (itr != str.end()) {
+    return itr - str.begin();
   }
   return std::string::npos;
 }
@@ -356,10 +441,12 @@ std::size_t String::rfind(const String &y, const std::size_t start) const {
   if (y.empty()) return start;
   if (empty()) return std::string::npos;
 
+  const std::vector<unsigned>& str = getVec();
+  const std::vector<unsigned>& ystr = y.getVec();
   std::vector<unsigned>::const_reverse_iterator itr = std::search(
-      d_str.rbegin() + start, d_str.rend(), y.d_str.rbegin(), y.d_str.rend());
-  if (itr != d_str.rend()) {
-    return itr - d_str.rbegin();
+      str.rbegin() + start, str.rend(), ystr.rbegin(), ystr.rend());
+  if (itr != str.rend()) {
+    return itr - str.rbegin();
   }
   return std::string::npos;
 }
@@ -374,7 +461,7 @@ bool String::hasPrefix(const String& y) const
   }
   for (size_t i = 0; i < ys; i++)
   {
-    if (d_str[i] != y.d_str[i])
+    if (getVec()[i] != y.getVec()[i])
     {
       return false;
     }
@@ -393,7 +480,7 @@ bool String::hasSuffix(const String& y) const
   size_t idiff = s - ys;
   for (size_t i = 0; i < ys; i++)
   {
-    if (d_str[i + idiff] != y.d_str[i])
+    if (getVec()[i + idiff] != y.getVec()[i])
     {
       return false;
     }
@@ -404,11 +491,14 @@ bool String::hasSuffix(const String& y) const
 String String::replace(const String &s, const String &t) const {
   std::size_t ret = find(s);
   if (ret != std::string::npos) {
+    const std::vector<unsigned>& str = getVec();
+    const std::vector<unsigned>& tvec = t.getVec();
     std::vector<unsigned int> vec;
-    vec.insert(vec.begin(), d_str.begin(), d_str.begin() + ret);
-    vec.insert(vec.end(), t.d_str.begin(), t.d_str.end());
-    vec.insert(vec.end(), d_str.begin() + ret + s.size(), d_str.end());
-    return String(vec);
+    vec.reserve(size() - s.size() + t.size());
+    vec.insert(vec.begin(), str.begin(), str.begin() + ret);
+    vec.insert(vec.end(), tvec.begin(), tvec.end());
+    vec.insert(vec.end(), str.begin() + ret + s.size(), str.end());
+    return String(std::move(vec));
   } else {
     return *this;
   }
@@ -416,18 +506,17 @@ String String::replace(const String &s, const String &t) const {
 
 String String::substr(std::size_t i) const {
   Assert(i <= size());
-  std::vector<unsigned int> ret_vec;
-  std::vector<unsigned int>::const_iterator itr = d_str.begin() + i;
-  ret_vec.insert(ret_vec.end(), itr, d_str.end());
-  return String(ret_vec);
+  return substr(i, size() - i);
 }
 
 String String::substr(std::size_t i, std::size_t j) const {
   Assert(i + j <= size());
-  std::vector<unsigned int> ret_vec;
-  std::vector<unsigned int>::const_iterator itr = d_str.begin() + i;
-  ret_vec.insert(ret_vec.end(), itr, itr + j);
-  return String(ret_vec);
+  if (j == size())
+  {
+    return *this;
+  }
+  std::vector<unsigned int>::const_iterator itr = getVec().begin() + i;
+  return String(std::vector<unsigned>(itr, itr + j));
 }
 
 bool String::noOverlapWith(const String& y) const
@@ -438,10 +527,10 @@ bool String::noOverlapWith(const String& y) const
 }
 
 bool String::isNumber() const {
-  if (d_str.empty()) {
+  if (getVec().empty()) {
     return false;
   }
-  for (unsigned character : d_str) {
+  for (unsigned character : getVec()) {
     if (!isDigit(character))
     {
       return false;
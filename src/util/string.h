@@ -19,6 +19,7 @@
 
 #include <cstddef>
 #include <functional>
+#include <memory>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -47,7 +48,10 @@ class CVC4_PUBLIC String {
   /** constructors for String
    *
    * Internally, a CVC4::String is represented by a vector of unsigned
-   * integers (d_str) representing the code points of the characters.
+   * integers representing the code points of the characters. This vector is
+   * immutable and shared between copies of a string, so that copying a
+   * string takes constant time. The hash of a string is computed once when
+   * it is constructed.
    *
    * To build a string from a C++ string, we may process escape sequences
    * according to the SMT-LIB standard. In particular, if useEscSequences is
@@ -63,28 +67,28 @@ class CVC4_PUBLIC String {
    * If useEscSequences is false, then the characters of the constructed
    * CVC4::String correspond one-to-one with the input string.
    */
-  String() = default;
+  String();
   explicit String(const std::string& s, bool useEscSequences = false)
-      : d_str(toInternal(s, useEscSequences))
+      : String(toInternal(s, useEscSequences))
   {
   }
   explicit String(const char* s, bool useEscSequences = false)
-      : d_str(toInternal(std::string(s), useEscSequences))
+      : String(toInternal(std::string(s), useEscSequences))
   {
   }
   explicit String(const std::vector<unsigned>& s);
-
-  String& operator=(const String& y) {
-    if (this != &y) {
-      d_str = y.d_str;
-    }
-    return *this;
-  }
+  explicit String(std::vector<unsigned>&& s);
+  String(const String& s) = default;
+  /** Move constructor, which leaves s as the empty string */
+  String(String&& s);
+  String& operator=(const String& s) = default;
+  /** Move assignment, which leaves s as the empty string */
+  String& operator=(String&& s);
 
   String concat(const String& other) const;
 
-  bool operator==(const String& y) const { return cmp(y) == 0; }
-  bool operator!=(const String& y) const { return cmp(y) != 0; }
+  bool operator==(const String& y) const;
+  bool operator!=(const String& y) const { return !(*this == y); }
   bool operator<(const String& y) const { return cmp(y) < 0; }
   bool operator>(const String& y) const { return cmp(y) > 0; }
   bool operator<=(const String& y) const { return cmp(y) <= 0; }
@@ -116,11 +120,13 @@ class CVC4_PUBLIC String {
    */
   std::string toString(bool useEscSequences = false) const;
   /** is this the empty string? */
-  bool empty() const { return d_str.empty(); }
+  bool empty() const { return d_buf->d_vec.empty(); }
   /** is less than or equal to string y */
   bool isLeq(const String& y) const;
   /** Return the length of the string */
-  std::size_t size() const { return d_str.size(); }
+  std::size_t size() const { return d_buf->d_vec.size(); }
+  /** Return the hash of this string */
+  std::size_t hash() const { return d_buf->d_hash; }
 
   bool isRepeated() const;
   bool tailcmp(const String& y, int& c) const;
@@ -197,7 +203,7 @@ class CVC4_PUBLIC String {
   /** Returns the corresponding rational for the text of this string. */
   Rational toNumber() const;
   /** Get the unsigned representation (code points) of this string */
-  const std::vector<unsigned>& getVec() const { return d_str; }
+  const std::vector<unsigned>& getVec() const { return d_buf->d_vec; }
   /**
    * Get the unsigned (code point) value of the first character in this string
    */
@@ -225,10 +231,27 @@ class CVC4_PUBLIC String {
 
   /**
    * Returns the maximum length of string representable by this class.
-   * Corresponds to the maximum size of d_str.
+   * Corresponds to the maximum size of the vector of code points.
    */
   static size_t maxSize();
+  /**
+   * Append the code points of the n characters starting at s to vec. This is
+   * the conversion done by String(std::string(s, n), useEscSequences), without
+   * building intermediate strings. It is used for decoding string literals
+   * directly from the input buffer of a parser.
+   */
+  static void appendInternal(const char* s,
+                             size_t n,
+                             bool useEscSequences,
+                             std::vector<unsigned>& vec);
  private:
+  /** The immutable storage of the code points of a string and its hash */
+  struct Buffer
+  {
+    Buffer(std::vector<unsigned>&& vec);
+    const std::vector<unsigned> d_vec;
+    const std::size_t d_hash;
+  };
   /**
    * Helper for toInternal: add character ch to vector vec, storing a string in
    * internal format. This throws an error if ch is not a printable character,
@@ -248,15 +271,18 @@ class CVC4_PUBLIC String {
    * positive number if *this > y.
    */
   int cmp(const String& y) const;
+  /** Get the buffer shared by all empty strings */
+  static const std::shared_ptr<const Buffer>& emptyBuffer();
 
-  std::vector<unsigned> d_str;
+  /** The code points of this string, which is never null */
+  std::shared_ptr<const Buffer> d_buf;
 }; /* class String */
 
 namespace strings {
 
 struct CVC4_PUBLIC StringHashFunction {
   size_t operator()(const ::CVC4::String& s) const {
-    return std::hash<std::string>()(s.toString());
+    return s.hash();
   }
 }; /* struct StringHashFunction */
 
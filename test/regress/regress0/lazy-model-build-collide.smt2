@@ -0,0 +1,21 @@
+; COMMAND-LINE: --lazy-model-build
+; COMMAND-LINE: --lazy-model-build --check-models
+; EXPECT: sat
+; EXPECT: ((d2 (mk 1)))
+; EXPECT: ((d1 (mk 0)))
+; EXPECT: ((d3 nil))
+(set-logic QF_DT)
+(set-option :produce-models true)
+(declare-datatype D ((nil) (mk (fld Int))))
+(declare-fun d1 () D)
+(declare-fun d2 () D)
+(declare-fun d3 () D)
+(assert (distinct d1 d2 d3))
+(assert (= d3 nil))
+; the value of d1 is computed from its representative (mk (fld d1)), and the
+; value of d2 is enumerated, when it is requested first
+(assert ((_ is mk) d1))
+(check-sat)
+(get-value (d2))
+(get-value (d1))
+(get-value (d3))
@@ -0,0 +1,29 @@
+; COMMAND-LINE: --lazy-model-build
+; COMMAND-LINE: --lazy-model-build --check-models
+; EXPECT: sat
+; EXPECT: ((x 3))
+; EXPECT: (((f x) 4))
+; EXPECT: (((select a (f x)) 5))
+; EXPECT: ((z 7))
+(set-logic QF_AUFLIA)
+(set-option :produce-models true)
+(declare-sort U 0)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+(declare-fun f (Int) Int)
+(declare-fun g (U) U)
+(declare-fun u () U)
+(declare-fun v () U)
+(declare-fun a () (Array Int Int))
+(assert (= x 3))
+(assert (= (f x) (+ x 1)))
+(assert (= (select a (f x)) (+ (f x) 1)))
+(assert (distinct (g u) (g v) u))
+(assert (> y z))
+(assert (= z (+ (select a (f x)) 2)))
+(check-sat)
+(get-value (x))
+(get-value ((f x)))
+(get-value ((select a (f x))))
+(get-value (z))
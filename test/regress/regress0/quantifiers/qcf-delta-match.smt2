@@ -0,0 +1,21 @@
+; COMMAND-LINE: --qcf-delta-match
+; EXPECT: unsat
+(set-logic UF)
+(set-info :status unsat)
+(declare-sort U 0)
+(declare-sort V 0)
+(declare-fun f (U) U)
+(declare-fun g (V) V)
+(declare-fun P (U) Bool)
+(declare-fun Q (U) Bool)
+(declare-fun a () U)
+(declare-fun b () U)
+(declare-fun c () U)
+(declare-fun d () V)
+(assert (or (P a) (P b)))
+(assert (or (= a c) (= b c)))
+(assert (not (= (g d) d)))
+(assert (forall ((y V)) (= (g (g y)) y)))
+(assert (forall ((x U)) (=> (P x) (Q (f x)))))
+(assert (forall ((x U)) (not (Q (f x)))))
+(check-sat)
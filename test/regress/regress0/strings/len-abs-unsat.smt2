@@ -0,0 +1,13 @@
+; COMMAND-LINE: --strings-len-abs
+; COMMAND-LINE: --strings-len-abs --strings-fmf
+; EXPECT: unsat
+(set-logic QF_SLIA)
+(set-info :status unsat)
+(declare-fun x () String)
+(declare-fun y () String)
+(declare-fun z () String)
+(assert (= x (str.++ y "ab" z)))
+(assert (or (< (str.len x) 2) (str.in_re x (re.++ re.allchar re.allchar))))
+(assert (str.prefixof z y))
+(assert (> (str.len z) 0))
+(check-sat)
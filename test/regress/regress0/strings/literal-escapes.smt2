@@ -0,0 +1,19 @@
+; COMMAND-LINE: --strings-exp --lang=smt2.6
+; EXPECT: sat
+(set-logic QF_SLIA)
+(declare-fun x () String)
+
+(assert (= """" (str.from_code 34)))
+(assert (= "\u{22}" """"))
+(assert (= (str.len "a""b") 3))
+(assert (= (str.len """""""") 3))
+(assert (= (str.len "\u{22}""") 2))
+(assert (= "a""A" (str.++ "a" """" "A")))
+(assert (= (str.len "\u{2""}") 6))
+(assert (= (str.len "\u00""41") 7))
+(assert (= (str.len "") 0))
+(assert (= (str.at "ab""cd" 2) """"))
+(assert (= x (str.++ "x""y" "\u{7a}")))
+(assert (= (str.len x) 4))
+
+(check-sat)
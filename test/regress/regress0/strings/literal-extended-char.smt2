@@ -0,0 +1,7 @@
+; EXPECT: Extended/unprintable characters are not part of SMT-LIB, and they must be encoded as escape sequences
+; SCRUBBER: grep -o "Extended/unprintable characters are not part of SMT-LIB, and they must be encoded as escape sequences"
+; EXIT: 1
+(set-logic QF_S)
+(declare-fun x () String)
+(assert (= x "caf"))
+(check-sat)
@@ -0,0 +1,14 @@
+; COMMAND-LINE: --strings-exp --strings-model-find
+; COMMAND-LINE: --strings-exp --strings-model-find --check-models
+; EXPECT: sat
+(set-logic QF_SLIA)
+(set-info :status sat)
+(declare-fun x () String)
+(declare-fun y () String)
+(assert (str.in_re x (re.+ (re.range "a" "c"))))
+(assert (str.in_re y (re.++ (str.to_re "ab") (re.* re.allchar))))
+(assert (not (str.in_re y (re.* (re.range "a" "b")))))
+(assert (not (= x y)))
+(assert (= (str.len x) 5))
+(assert (= (str.len y) (str.len x)))
+(check-sat)
@@ -0,0 +1,14 @@
+; COMMAND-LINE: --strings-exp
+; EXPECT: unsat
+(set-logic QF_S)
+(set-info :status unsat)
+(declare-fun x () String)
+(declare-fun y () String)
+
+(assert (str.in_re x (re.++ (re.* (re.range "a" "c")) (str.to_re "d"))))
+(assert (str.in_re y (re.* (re.union (str.to_re "ab") (str.to_re "d")))))
+(assert (not (str.in_re x (re.++ (re.* re.allchar) (str.to_re "abd")))))
+(assert (str.in_re x (re.++ re.allchar re.allchar (re.* re.allchar))))
+(assert (= x y))
+
+(check-sat)
@@ -0,0 +1,12 @@
+; COMMAND-LINE: --strings-exp
+; EXPECT: unsat
+(set-logic QF_S)
+(set-info :status unsat)
+(declare-fun x () String)
+
+; the product of the automata of these memberships has more than 4096
+; states, so the automata check gives up and they are unfolded instead
+(assert (str.in_re x (re.++ (re.* re.allchar) (str.to_re "a") ((_ re.loop 7 7) re.allchar))))
+(assert (str.in_re x (re.++ (re.* re.allchar) (str.to_re "b") ((_ re.loop 7 7) re.allchar))))
+
+(check-sat)
@@ -0,0 +1,153 @@
+import array
+import gc
+import sys
+import threading
+
+import pytest
+
+import pycvc4
+from pycvc4 import kinds
+
+
+def mk_pigeonhole(solver, n):
+    # n + 1 pigeons in n holes, which is hard for the SAT solver
+    boolsort = solver.getBooleanSort()
+    pigeons = [solver.mkConsts(boolsort, n) for _ in range(n + 1)]
+    formulas = [solver.mkTerm(kinds.Or, holes) for holes in pigeons]
+    for j in range(n):
+        for i in range(n + 1):
+            for k in range(i + 1, n + 1):
+                formulas.append(
+                    solver.mkTerm(kinds.Or,
+                                  solver.mkTerm(kinds.Not, pigeons[i][j]),
+                                  solver.mkTerm(kinds.Not, pigeons[k][j])))
+    solver.assertFormulas(formulas)
+
+
+def test_mk_consts():
+    solver = pycvc4.Solver()
+    intsort = solver.getIntegerSort()
+    xs = solver.mkConsts(intsort, ['x0', 'x1', 'x2'])
+    assert [str(x) for x in xs] == ['x0', 'x1', 'x2']
+    assert all(x.getSort() == intsort for x in xs)
+    assert len(solver.mkConsts(intsort, 5)) == 5
+
+
+def test_mk_terms():
+    solver = pycvc4.Solver()
+    intsort = solver.getIntegerSort()
+    funsort = solver.mkFunctionSort(intsort, intsort)
+    f = solver.mkConst(funsort, 'f')
+    y = solver.mkConst(intsort, 'y')
+    n = 100
+    xs = solver.mkConsts(intsort, ['x' + str(i) for i in range(n)])
+
+    # nodes: f, y, x_0 .. x_(n-1), then (f x_i), (* (f x_i) y), (+ x_i ...)
+    leaves = [f, y] + xs
+    ops = [kinds.ApplyUf, kinds.Mult, kinds.Plus]
+    records = []
+    children = []
+    roots = []
+    for i in range(n):
+        fx = len(leaves) + 3 * i
+        records += [0, 2, 1, 2, 2, 2]
+        children += [0, 2 + i, fx, 1, 2 + i, fx + 1]
+        roots.append(fx + 2)
+    terms = solver.mkTerms(leaves, ops, records, children, roots)
+    assert len(terms) == n
+    for i in range(n):
+        expected = solver.mkTerm(
+            kinds.Plus, xs[i],
+            solver.mkTerm(kinds.Mult, solver.mkTerm(kinds.ApplyUf, f, xs[i]),
+                          y))
+        assert terms[i] == expected
+
+    # buffers of uint32 values are converted directly
+    assert solver.mkTerms(leaves, ops, array.array('I', records),
+                          array.array('I', children),
+                          array.array('I', roots)) == terms
+
+    with pytest.raises(ValueError):
+        solver.mkTerms(leaves, ops, records[:-1], children, roots)
+    with pytest.raises(RuntimeError):
+        solver.mkTerms(leaves, ops, records, children, [len(leaves) + 3 * n])
+
+
+def test_assert_formulas():
+    solver = pycvc4.Solver()
+    solver.setOption('incremental', 'true')
+    intsort = solver.getIntegerSort()
+    x, y = solver.mkConsts(intsort, ['x', 'y'])
+    solver.assertFormulas(solver.mkTerm(kinds.Lt, x, y),
+                          solver.mkTerm(kinds.Lt, y, solver.mkReal(0)))
+    assert solver.checkSat().isSat()
+    solver.assertFormulas([solver.mkTerm(kinds.Lt, solver.mkReal(0), x)])
+    assert solver.checkSat().isUnsat()
+
+
+@pytest.fixture
+def explicit_switches():
+    # threads only switch when the running thread releases the GIL, rather
+    # than after the switch interval
+    interval = sys.getswitchinterval()
+    sys.setswitchinterval(1000)
+    yield
+    sys.setswitchinterval(interval)
+
+
+def test_check_sat_releases_gil(explicit_switches):
+    # the check is cut short by a time limit, the instance is too hard to be
+    # solved within it
+    solver = pycvc4.Solver()
+    solver.setOption("tlimit-per", "2000")
+    mk_pigeonhole(solver, 12)
+    started = threading.Event()
+    progressed = threading.Event()
+    outcome = {}
+
+    def check():
+        started.set()
+        outcome["result"] = solver.checkSat()
+        # if the check held the GIL, the main thread could not have run
+        # between the start of the check and its end
+        outcome["progressed"] = progressed.is_set()
+
+    thread = threading.Thread(target=check)
+    thread.start()
+    started.wait()
+    progressed.set()
+    thread.join()
+    assert outcome["result"].isSatUnknown() or outcome["result"].isUnsat()
+    assert outcome["progressed"]
+
+
+def test_check_sat_defers_release(explicit_switches):
+    # terms and sorts that are collected while the check runs are released
+    # after the check, the solver may not release nodes concurrently
+    solver = pycvc4.Solver()
+    solver.setOption("tlimit-per", "2000")
+    mk_pigeonhole(solver, 12)
+    boolsort = solver.getBooleanSort()
+    garbage = []
+    for i in range(1000):
+        xs = solver.mkConsts(boolsort, 2)
+        garbage.append(solver.mkTerm(kinds.And, xs[0], xs[1]))
+        garbage.append(solver.mkArraySort(boolsort, boolsort))
+    started = threading.Event()
+    released = threading.Event()
+    outcome = {}
+
+    def check():
+        started.set()
+        outcome["result"] = solver.checkSat()
+        outcome["released"] = released.is_set()
+
+    thread = threading.Thread(target=check)
+    thread.start()
+    started.wait()
+    del garbage[:]
+    gc.collect()
+    released.set()
+    thread.join()
+    assert outcome["result"].isSatUnknown() or outcome["result"].isUnsat()
+    assert outcome["released"]
@@ -16,6 +16,9 @@
 
 #include <cxxtest/TestSuite.h>
 
+#include <condition_variable>
+#include <mutex>
+
 #include "api/cvc4cpp.h"
 #include "base/configuration.h"
 
@@ -73,6 +76,8 @@ class SolverBlack : public CxxTest::TestSuite
   void testMkChar();
   void testMkTerm();
   void testMkTermFromOp();
+  void testMkTerms();
+  void testMkTermsDeep();
   void testMkTrue();
   void testMkTuple();
   void testMkUninterpretedConst();
@@ -142,6 +147,8 @@ class SolverBlack : public CxxTest::TestSuite
   void testCheckSatAssuming();
   void testCheckSatAssuming1();
   void testCheckSatAssuming2();
+  void testCheckSatAsync();
+  void testCheckSatAsyncCancel();
 
   void testSetInfo();
   void testSetLogic();
@@ -882,6 +889,109 @@ void SolverBlack::testMkTermFromOp()
   TS_ASSERT_THROWS(slv.mkTerm(opterm2, v4), CVC4ApiException&);
 }
 
+void SolverBlack::testMkTerms()
+{
+  Sort intSort = d_solver->getIntegerSort();
+  Sort bv32 = d_solver->mkBitVectorSort(32);
+  Term x = d_solver->mkConst(intSort, "x");
+  Term y = d_solver->mkConst(intSort, "y");
+  Term a = d_solver->mkConst(bv32, "a");
+  Term f = d_solver->mkConst(d_solver->mkFunctionSort(intSort, intSort), "f");
+  Solver slv;
+
+  // nodes 0-3 are the leaves, 4-8 the records
+  std::vector<Term> leaves = {x, y, a, f};
+  std::vector<Op> ops = {d_solver->mkOp(PLUS),
+                         d_solver->mkOp(APPLY_UF),
+                         d_solver->mkOp(EQUAL),
+                         d_solver->mkOp(BITVECTOR_EXTRACT, 7, 0),
+                         d_solver->mkOp(MINUS)};
+  std::vector<TermRecord> records = {
+      {0, 2}, {1, 2}, {2, 3}, {3, 1}, {4, 3}};
+  std::vector<uint32_t> children = {0, 1, 3, 4, 5, 0, 1, 2, 0, 1, 4};
+  std::vector<Term> terms;
+  TS_ASSERT_THROWS_NOTHING(terms = d_solver->mkTerms(
+                               leaves, ops, records, children, {6, 7, 8, 4, 0}));
+  Term xy = d_solver->mkTerm(PLUS, x, y);
+  Term fxy = d_solver->mkTerm(APPLY_UF, f, xy);
+  TS_ASSERT_EQUALS(terms.size(), 5);
+  TS_ASSERT_EQUALS(terms[0], d_solver->mkTerm(EQUAL, {fxy, x, y}));
+  TS_ASSERT_EQUALS(terms[1], d_solver->mkTerm(ops[3], a));
+  TS_ASSERT_EQUALS(terms[2], d_solver->mkTerm(MINUS, {x, y, xy}));
+  TS_ASSERT_EQUALS(terms[3], xy);
+  TS_ASSERT_EQUALS(terms[4], x);
+
+  // invalid operator index
+  TS_ASSERT_THROWS(d_solver->mkTerms(leaves, ops, {{5, 2}}, {0, 1}, {4}),
+                   CVC4ApiException&);
+  // a record that is its own child
+  TS_ASSERT_THROWS(d_solver->mkTerms(leaves, ops, {{0, 2}}, {0, 4}, {4}),
+                   CVC4ApiException&);
+  // too few and too many children
+  TS_ASSERT_THROWS(d_solver->mkTerms(leaves, ops, {{2, 1}}, {0}, {4}),
+                   CVC4ApiException&);
+  TS_ASSERT_THROWS(d_solver->mkTerms(leaves, ops, {{3, 2}}, {2, 2}, {4}),
+                   CVC4ApiException&);
+  TS_ASSERT_THROWS(d_solver->mkTerms(leaves, ops, {{0, 2}}, {0}, {4}),
+                   CVC4ApiException&);
+  TS_ASSERT_THROWS(d_solver->mkTerms(leaves, ops, {{0, 2}}, {0, 1, 1}, {4}),
+                   CVC4ApiException&);
+  // ill-typed term
+  TS_ASSERT_THROWS(d_solver->mkTerms(leaves, ops, {{0, 2}}, {0, 2}, {4}),
+                   CVC4ApiException&);
+  // invalid root
+  TS_ASSERT_THROWS(d_solver->mkTerms(leaves, ops, {{0, 2}}, {0, 1}, {5}),
+                   CVC4ApiException&);
+  // terms and operators of another solver
+  TS_ASSERT_THROWS(d_solver->mkTerms({slv.mkTrue()}, {}, {}, {}, {0}),
+                   CVC4ApiException&);
+  TS_ASSERT_THROWS(
+      d_solver->mkTerms(leaves, {slv.mkOp(PLUS)}, {{0, 2}}, {0, 1}, {4}),
+      CVC4ApiException&);
+  TS_ASSERT_THROWS(d_solver->mkTerms({Term()}, {}, {}, {}, {0}),
+                   CVC4ApiException&);
+}
+
+void SolverBlack::testMkTermsDeep()
+{
+  // t_0 = x_0, t_i = (+ t_{i-1} (* t_{i-1} x_{i mod 10})), with mkTerm() and
+  // with mkTerms()
+  const uint32_t n = 1000;
+  const uint32_t nvars = 10;
+  std::vector<Term> vars;
+  for (uint32_t i = 0; i < nvars; i++)
+  {
+    vars.push_back(d_solver->mkConst(d_solver->getIntegerSort(),
+                                     "x" + std::to_string(i)));
+  }
+
+  Term t = vars[0];
+  for (uint32_t i = 1; i < n; i++)
+  {
+    t = d_solver->mkTerm(PLUS, t, d_solver->mkTerm(MULT, t, vars[i % nvars]));
+  }
+  std::vector<Op> ops = {d_solver->mkOp(PLUS), d_solver->mkOp(MULT)};
+  std::vector<TermRecord> records;
+  std::vector<uint32_t> children;
+  uint32_t last = 0;
+  for (uint32_t i = 1; i < n; i++)
+  {
+    records.emplace_back(1, 2);
+    children.push_back(last);
+    children.push_back(i % nvars);
+    uint32_t mult = nvars + records.size() - 1;
+    records.emplace_back(0, 2);
+    children.push_back(last);
+    children.push_back(mult);
+    last = nvars + records.size() - 1;
+  }
+  std::vector<Term> bulk;
+  TS_ASSERT_THROWS_NOTHING(
+      bulk = d_solver->mkTerms(vars, ops, records, children, {last}));
+  TS_ASSERT_EQUALS(bulk.size(), 1);
+  TS_ASSERT_EQUALS(bulk[0], t);
+}
+
 void SolverBlack::testMkTrue()
 {
   TS_ASSERT_THROWS_NOTHING(d_solver->mkTrue());
@@ -1958,6 +2068,134 @@ void SolverBlack::testCheckSatAssuming2()
   TS_ASSERT_THROWS(slv.checkSatAssuming(d_solver->mkTrue()), CVC4ApiException&);
 }
 
+void SolverBlack::testCheckSatAsync()
+{
+  Sort intSort = d_solver->getIntegerSort();
+  Term x = d_solver->mkConst(intSort, "x");
+  Term y = d_solver->mkConst(intSort, "y");
+  d_solver->setOption("incremental", "true");
+  d_solver->assertFormula(d_solver->mkTerm(LT, x, y));
+
+  AsyncResult a;
+  TS_ASSERT(a.isNull());
+  TS_ASSERT_THROWS(a.getResult(), CVC4ApiException&);
+  TS_ASSERT_THROWS_NOTHING(a = d_solver->checkSatAsync());
+  TS_ASSERT(!a.isNull());
+  TS_ASSERT(a.getResult().isSat());
+  TS_ASSERT(a.isReady());
+  TS_ASSERT(a.waitFor(0));
+  TS_ASSERT_THROWS_NOTHING(a.cancel());
+
+  Term lt = d_solver->mkTerm(LT, y, x);
+  AsyncResult b = d_solver->checkSatAsync({lt});
+  b.wait();
+  TS_ASSERT(b.getResult().isUnsat());
+  // a cancellation after the end of a check does not affect the next one
+  b.cancel();
+  TS_ASSERT(d_solver->checkSat().isSat());
+  TS_ASSERT(a.getResult().isSat());
+
+  TS_ASSERT_THROWS(d_solver->checkSatAsync({Term()}), CVC4ApiException&);
+  TS_ASSERT_THROWS(
+      d_solver->checkSatAsync({}, [](const CheckProgress&) {}, 0),
+      CVC4ApiException&);
+  Solver slv;
+  TS_ASSERT_THROWS(slv.checkSatAsync({lt}), CVC4ApiException&);
+}
+
+void SolverBlack::testCheckSatAsyncCancel()
+{
+  // the pigeonhole problem for 15 pigeons, which takes the solver a long time
+  d_solver->setOption("incremental", "true");
+  Sort boolSort = d_solver->getBooleanSort();
+  const size_t n = 14;
+  std::vector<std::vector<Term>> in(n + 1);
+  for (size_t i = 0; i <= n; i++)
+  {
+    for (size_t j = 0; j < n; j++)
+    {
+      in[i].push_back(d_solver->mkConst(boolSort));
+    }
+    d_solver->assertFormula(d_solver->mkTerm(OR, in[i]));
+  }
+  for (size_t j = 0; j < n; j++)
+  {
+    for (size_t i = 0; i <= n; i++)
+    {
+      for (size_t k = i + 1; k <= n; k++)
+      {
+        d_solver->assertFormula(
+            d_solver->mkTerm(OR, in[i][j].notTerm(), in[k][j].notTerm()));
+      }
+    }
+  }
+
+  // the progress callback blocks at the first report that counts decisions
+  // and conflicts, until the check has been cancelled
+  std::mutex mutex;
+  std::condition_variable cond;
+  bool reported = false;
+  bool cancelled = false;
+  std::vector<CheckProgress> progress;
+  AsyncResult a = d_solver->checkSatAsync(
+      {},
+      [&](const CheckProgress& p) {
+        std::unique_lock<std::mutex> lock(mutex);
+        progress.push_back(p);
+        if (!reported && p.d_decisions > 0 && p.d_conflicts > 0)
+        {
+          reported = true;
+          cond.notify_all();
+          cond.wait(lock, [&cancelled]() { return cancelled; });
+        }
+      },
+      10);
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cond.wait(lock, [&reported]() { return reported; });
+  }
+  TS_ASSERT(!a.isReady());
+  TS_ASSERT(!a.waitFor(0));
+  TS_ASSERT_THROWS(d_solver->checkSat(), CVC4ApiException&);
+  TS_ASSERT_THROWS(d_solver->checkSatAsync(), CVC4ApiException&);
+  // neither may the other methods that use the SMT engine
+  TS_ASSERT_THROWS(d_solver->checkEntailed(in[0][0]), CVC4ApiException&);
+  TS_ASSERT_THROWS(d_solver->assertFormula(in[0][0]), CVC4ApiException&);
+  TS_ASSERT_THROWS(d_solver->getValue(in[0][0]), CVC4ApiException&);
+  TS_ASSERT_THROWS(d_solver->getAssertions(), CVC4ApiException&);
+  TS_ASSERT_THROWS(d_solver->declareFun("f", {}, boolSort),
+                   CVC4ApiException&);
+  TS_ASSERT_THROWS(d_solver->push(), CVC4ApiException&);
+  TS_ASSERT_THROWS(d_solver->pop(), CVC4ApiException&);
+  TS_ASSERT_THROWS(d_solver->getOption("incremental"), CVC4ApiException&);
+  a.cancel();
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    cancelled = true;
+  }
+  cond.notify_all();
+  Result r = a.getResult();
+  TS_ASSERT(r.isSatUnknown());
+  TS_ASSERT_EQUALS(r.getUnknownExplanation(), "INTERRUPTED");
+
+  TS_ASSERT_LESS_THAN(0u, progress.size());
+  TS_ASSERT_LESS_THAN(0u, progress.back().d_decisions);
+  TS_ASSERT_LESS_THAN(0u, progress.back().d_conflicts);
+  TS_ASSERT_LESS_THAN(0u, progress.back().d_resourceUnits);
+  TS_ASSERT_LESS_THAN_EQUALS(progress.front().d_resourceUnits,
+                             progress.back().d_resourceUnits);
+
+  // a solver with a running check cancels it and waits for it when it is
+  // destroyed
+  a = d_solver->checkSatAsync();
+  // terms and sorts must not outlive their solver
+  in.clear();
+  boolSort = Sort();
+  d_solver.reset();
+  TS_ASSERT(a.isReady());
+  TS_ASSERT(a.getResult().isSatUnknown());
+}
+
 void SolverBlack::testSetLogic()
 {
   TS_ASSERT_THROWS_NOTHING(d_solver->setLogic("AUFLIRA"));
@@ -18,6 +18,7 @@
 
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "base/check.h"
 #include "base/exception.h"
@@ -159,6 +160,115 @@ private:
     TS_ASSERT_EQUALS( symtab.lookup("x"), x );
   }
 
+  void testBindLevelZero()
+  {
+    SymbolTable symtab;
+    Type booleanType = d_exprManager->booleanType();
+    Expr x = d_exprManager->mkVar(booleanType);
+    Expr y = d_exprManager->mkVar(booleanType);
+    Expr z = d_exprManager->mkVar(booleanType);
+    symtab.pushScope();
+    symtab.bind("x", x);
+    symtab.pushScope();
+    symtab.bind("x", y);
+    // a global binding survives the scopes, and is visible until then
+    symtab.bind("x", z, true);
+    symtab.bind("y", z, true);
+    TS_ASSERT_EQUALS(symtab.lookup("x"), z);
+    symtab.popScope();
+    TS_ASSERT_EQUALS(symtab.lookup("x"), x);
+    symtab.popScope();
+    TS_ASSERT_EQUALS(symtab.lookup("x"), z);
+    TS_ASSERT_EQUALS(symtab.lookup("y"), z);
+    TS_ASSERT_EQUALS(symtab.getLevel(), 0u);
+  }
+
+  void testPopScopeTypes()
+  {
+    SymbolTable symtab;
+    Type s = d_exprManager->mkSort("S");
+    Type t = d_exprManager->mkSort("T");
+    symtab.bindType("S", s);
+    symtab.pushScope();
+    symtab.bindType("S", t);
+    symtab.bindType("T", t);
+    TS_ASSERT_EQUALS(symtab.lookupType("S"), t);
+    TS_ASSERT(symtab.isBoundType("T"));
+    symtab.popScope();
+    TS_ASSERT_EQUALS(symtab.lookupType("S"), s);
+    TS_ASSERT(!symtab.isBoundType("T"));
+    TS_ASSERT(!symtab.isBound("S"));
+  }
+
+  void testOverloading()
+  {
+    SymbolTable symtab;
+    Type integerType = d_exprManager->integerType();
+    Type booleanType = d_exprManager->booleanType();
+    Expr fi = d_exprManager->mkVar(
+        d_exprManager->mkFunctionType(integerType, integerType));
+    Expr fb = d_exprManager->mkVar(
+        d_exprManager->mkFunctionType(booleanType, integerType));
+    Expr fb2 = d_exprManager->mkVar(
+        d_exprManager->mkFunctionType(booleanType, booleanType));
+    Expr ci = d_exprManager->mkVar(integerType);
+    Expr cb = d_exprManager->mkVar(booleanType);
+    vector<Type> argInt(1, integerType);
+    vector<Type> argBool(1, booleanType);
+
+    TS_ASSERT(symtab.bind("f", fi, false, true));
+    TS_ASSERT(!symtab.isOverloadedFunction(fi));
+    TS_ASSERT_EQUALS(symtab.lookup("f"), fi);
+    symtab.pushScope();
+    TS_ASSERT(symtab.bind("f", fb, false, true));
+    TS_ASSERT(symtab.isOverloadedFunction(fi));
+    TS_ASSERT(symtab.isOverloadedFunction(fb));
+    TS_ASSERT(symtab.lookup("f").isNull());
+    TS_ASSERT_EQUALS(symtab.getOverloadedFunctionForTypes("f", argInt), fi);
+    TS_ASSERT_EQUALS(symtab.getOverloadedFunctionForTypes("f", argBool), fb);
+    // a variant of f expecting the same argument types is rejected
+    TS_ASSERT(!symtab.bind("f", fb2, false, true));
+    symtab.popScope();
+    TS_ASSERT(!symtab.isOverloadedFunction(fi));
+    TS_ASSERT(!symtab.isOverloadedFunction(fb));
+    TS_ASSERT_EQUALS(symtab.lookup("f"), fi);
+    TS_ASSERT(symtab.getOverloadedFunctionForTypes("g", argInt).isNull());
+
+    TS_ASSERT(symtab.bind("c", ci, false, true));
+    TS_ASSERT(symtab.bind("c", cb, false, true));
+    TS_ASSERT_EQUALS(symtab.getOverloadedConstantForType("c", integerType),
+                     ci);
+    TS_ASSERT_EQUALS(symtab.getOverloadedConstantForType("c", booleanType),
+                     cb);
+    TS_ASSERT(!symtab.bind("c", d_exprManager->mkVar(integerType), false, true));
+  }
+
+  void testNestedScopes()
+  {
+    // many declarations, each in a scope of its own as in BMC unrollings
+    const unsigned n = 1000;
+    Type integerType = d_exprManager->integerType();
+    vector<Expr> vars;
+    SymbolTable symtab;
+    for (unsigned i = 0; i < n; i++)
+    {
+      vars.push_back(d_exprManager->mkVar(integerType));
+      symtab.pushScope();
+      symtab.bind("x@" + to_string(i), vars[i]);
+    }
+    TS_ASSERT_EQUALS(symtab.getLevel(), n);
+    for (unsigned i = 0; i < n; i++)
+    {
+      TS_ASSERT_EQUALS(symtab.lookup("x@" + to_string(i)), vars[i]);
+    }
+    for (unsigned i = n; i > 0; i--)
+    {
+      TS_ASSERT(symtab.isBound("x@" + to_string(i - 1)));
+      symtab.popScope();
+      TS_ASSERT(!symtab.isBound("x@" + to_string(i - 1)));
+    }
+  }
+
   void testBadPop() {
     SymbolTable symtab;
     // TODO: What kind of exception gets thrown here?
@@ -0,0 +1,278 @@
+/*********************                                                        */
+/*! \file binary_input_black.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of the binary format.
+ **
+ ** Black box testing of the binary format, which is written by the printer
+ ** for the binary output language and read by the binary input.
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "api/cvc4cpp.h"
+#include "base/exception.h"
+#include "options/language.h"
+#include "options/options.h"
+#include "parser/parser.h"
+#include "parser/parser_builder.h"
+#include "parser/parser_exception.h"
+#include "printer/binary/binary_format.h"
+#include "smt/command.h"
+
+using namespace CVC4;
+using namespace CVC4::parser;
+using namespace std;
+
+class BinaryInputBlack : public CxxTest::TestSuite
+{
+ public:
+  void testRoundTrip()
+  {
+    const string input =
+        "(set-logic ALL)\n"
+        "(set-info :status sat)\n"
+        "(set-option :produce-models true)\n"
+        "(declare-sort U 0)\n"
+        "(declare-sort L 1)\n"
+        "(define-sort M (X) (L X))\n"
+        "(declare-fun u () U)\n"
+        "(declare-fun f (U Int) Real)\n"
+        "(declare-fun l () (M Int))\n"
+        "(declare-fun g ((L Int)) Bool)\n"
+        "(declare-fun b () (_ BitVec 8))\n"
+        "(declare-fun s () String)\n"
+        "(declare-fun a () (Array Int Int))\n"
+        "(define-fun h ((x Int) (y Int)) Int (+ x (* 2 y)))\n"
+        "(push 1)\n"
+        "(assert (! (> (f u (h 1 -2)) 1.5) :named p))\n"
+        "(assert (= ((_ extract 3 0) b) #b1010))\n"
+        "(assert (str.in_re s (re.* (str.to_re \"a\\u{48}c\"))))\n"
+        "(assert (g l))\n"
+        "(assert (forall ((z Int)) (=> (> z 0) (> (select a z) 0))))\n"
+        "(check-sat-assuming ((= u u)))\n"
+        "(get-value ((f u 3) b))\n"
+        "(pop 1)\n"
+        "(check-sat)\n"
+        "(echo \"done\")\n"
+        "(exit)\n";
+
+    api::Solver textSolver(&d_options);
+    vector<string> expected;
+    string binary;
+    {
+      unique_ptr<Parser> parser(makeParser(&textSolver, input, false));
+      stringstream out;
+      Command* cmd;
+      while ((cmd = parser->nextCommand()) != NULL)
+      {
+        expected.push_back(toSmt2(cmd));
+        cmd->toStream(out, -1, false, 0, language::output::LANG_BINARY);
+        delete cmd;
+      }
+      binary = out.str();
+    }
+    TS_ASSERT(!expected.empty());
+
+    // the terms are rebuilt with another solver
+    api::Solver binarySolver(&d_options);
+    unique_ptr<Parser> parser(makeParser(&binarySolver, binary, true));
+    vector<string> actual;
+    Command* cmd;
+    while ((cmd = parser->nextCommand()) != NULL)
+    {
+      actual.push_back(toSmt2(cmd));
+      delete cmd;
+    }
+    TS_ASSERT_EQUALS(actual, expected);
+  }
+
+  void testSharing()
+  {
+    // the shared subterm of the assertions is written only once, hence each
+    // assertion adds only its constant and its root
+    stringstream ss;
+    ss << "(set-logic QF_NIA)\n(declare-fun x () Int)\n";
+    for (unsigned i = 0; i < 100; i++)
+    {
+      ss << "(assert (> (+ (* x x) (* (* x x) (* x x))) " << i << "))\n";
+    }
+    api::Solver solver(&d_options);
+    unique_ptr<Parser> parser(makeParser(&solver, ss.str(), false));
+    stringstream out;
+    Command* cmd;
+    while ((cmd = parser->nextCommand()) != NULL)
+    {
+      cmd->toStream(out, -1, false, 0, language::output::LANG_BINARY);
+      delete cmd;
+    }
+    TS_ASSERT_LESS_THAN(out.str().size() * 3, ss.str().size());
+  }
+
+  void testUnsupported()
+  {
+    api::Solver solver(&d_options);
+    unique_ptr<Parser> parser(makeParser(
+        &solver,
+        "(set-logic ALL)(declare-datatype D ((c (d Int))))(assert true)",
+        false));
+    stringstream out;
+    unique_ptr<Command> logic(parser->nextCommand());
+    logic->toStream(out, -1, false, 0, language::output::LANG_BINARY);
+    unique_ptr<Command> datatype(parser->nextCommand());
+    TS_ASSERT_THROWS(
+        datatype->toStream(out, -1, false, 0, language::output::LANG_BINARY),
+        Exception&);
+  }
+
+  void testBadInput()
+  {
+    api::Solver solver(&d_options);
+    {
+      unique_ptr<Parser> parser(makeParser(&solver, "(check-sat)", true));
+      TS_ASSERT_THROWS(parser->nextCommand(), ParserException&);
+    }
+
+    api::Solver textSolver(&d_options);
+    unique_ptr<Parser> text(makeParser(
+        &textSolver, "(declare-fun x () Int)(assert (> x 0))", false));
+    stringstream out;
+    Command* cmd;
+    while ((cmd = text->nextCommand()) != NULL)
+    {
+      cmd->toStream(out, -1, false, 0, language::output::LANG_BINARY);
+      delete cmd;
+    }
+    string binary = out.str();
+    // truncate the last record
+    binary.resize(binary.size() - 1);
+    unique_ptr<Parser> parser(makeParser(&solver, binary, true));
+    delete parser->nextCommand();
+    TS_ASSERT_THROWS(parser->nextCommand(), ParserException&);
+  }
+
+  void testBadNumberOfChildren()
+  {
+    api::Solver solver(&d_options);
+    unique_ptr<Parser> text(
+        makeParser(&solver, "(set-logic QF_LIA)", false));
+    stringstream out;
+    unique_ptr<Command> logic(text->nextCommand());
+    logic->toStream(out, -1, false, 0, language::output::LANG_BINARY);
+    // a term with more children than the input has bytes left, which must
+    // be rejected before their storage is allocated
+    out.put(printer::binary::TAG_TERM_NODE);
+    printer::binary::writeVarint(out, kind::PLUS);
+    printer::binary::writeVarint(out, 60000000);
+    printer::binary::writeVarint(out, 1);
+    printer::binary::writeVarint(out, 1);
+    unique_ptr<Parser> parser(makeParser(&solver, out.str(), true));
+    delete parser->nextCommand();
+    TS_ASSERT_THROWS(parser->nextCommand(), ParserException&);
+  }
+
+  void testIllTyped()
+  {
+    api::Solver solver(&d_options);
+    stringstream out;
+    writeLogic(&solver, out);
+    // (+ true true)
+    out.put(printer::binary::TAG_TERM_CONSTANT);
+    printer::binary::writeVarint(out, kind::CONST_BOOLEAN);
+    printer::binary::writeVarint(out, 1);
+    out.put(printer::binary::TAG_TERM_NODE);
+    printer::binary::writeVarint(out, kind::PLUS);
+    printer::binary::writeVarint(out, 2);
+    printer::binary::writeVarint(out, 1);
+    printer::binary::writeVarint(out, 1);
+    out.put(printer::binary::TAG_CMD_ASSERT);
+    printer::binary::writeVarint(out, 1);
+    unique_ptr<Parser> parser(makeParser(&solver, out.str(), true));
+    delete parser->nextCommand();
+    TS_ASSERT_THROWS(parser->nextCommand(), ParserException&);
+  }
+
+  void testBadRoundingMode()
+  {
+    api::Solver solver(&d_options);
+    stringstream out;
+    writeLogic(&solver, out);
+    out.put(printer::binary::TAG_TERM_CONSTANT);
+    printer::binary::writeVarint(out, kind::CONST_ROUNDINGMODE);
+    printer::binary::writeVarint(out, 1000);
+    out.put(printer::binary::TAG_CMD_SIMPLIFY);
+    printer::binary::writeVarint(out, 1);
+    unique_ptr<Parser> parser(makeParser(&solver, out.str(), true));
+    delete parser->nextCommand();
+    TS_ASSERT_THROWS(parser->nextCommand(), ParserException&);
+  }
+
+  void testDeepNesting()
+  {
+    // nesting that would exhaust the stack if the reader did not bound it
+    const unsigned depth = 1000000;
+    api::Solver solver(&d_options);
+    {
+      stringstream out;
+      writeLogic(&solver, out);
+      out.put(printer::binary::TAG_CMD_SET_INFO);
+      printer::binary::writeString(out, "source");
+      for (unsigned i = 0; i < depth; i++)
+      {
+        out.put(printer::binary::SEXPR_LIST);
+        printer::binary::writeVarint(out, 1);
+      }
+      unique_ptr<Parser> parser(makeParser(&solver, out.str(), true));
+      delete parser->nextCommand();
+      TS_ASSERT_THROWS(parser->nextCommand(), ParserException&);
+    }
+    stringstream out;
+    writeLogic(&solver, out);
+    for (unsigned i = 0; i < depth; i++)
+    {
+      out.put(printer::binary::TAG_CMD_SEQUENCE);
+      printer::binary::writeVarint(out, 1);
+    }
+    unique_ptr<Parser> parser(makeParser(&solver, out.str(), true));
+    delete parser->nextCommand();
+    TS_ASSERT_THROWS(parser->nextCommand(), ParserException&);
+  }
+
+ private:
+  /** Write the header and a set-logic command to out */
+  void writeLogic(api::Solver* solver, ostream& out)
+  {
+    unique_ptr<Parser> text(makeParser(solver, "(set-logic ALL)", false));
+    unique_ptr<Command> logic(text->nextCommand());
+    logic->toStream(out, -1, false, 0, language::output::LANG_BINARY);
+  }
+
+  Parser* makeParser(api::Solver* solver, const string& input, bool binary)
+  {
+    return ParserBuilder(solver, "test")
+        .withStringInput(input)
+        .withOptions(d_options)
+        .withInputLanguage(binary ? language::input::LANG_BINARY
+                                  : language::input::LANG_SMTLIB_V2_6)
+        .build();
+  }
+
+  static string toSmt2(const Command* cmd)
+  {
+    stringstream ss;
+    cmd->toStream(ss, -1, false, 0, language::output::LANG_SMTLIB_V2_6);
+    return ss.str();
+  }
+
+  Options d_options;
+}; /* class BinaryInputBlack */
@@ -0,0 +1,155 @@
+/*********************                                                        */
+/*! \file smt2_printer_black.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of the SMT-LIB printer
+ **
+ ** Black box testing of the SMT-LIB printer, in particular of its let
+ ** bindings.
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "options/language.h"
+#include "options/options.h"
+#include "util/rational.h"
+
+using namespace CVC4;
+using namespace CVC4::kind;
+using namespace std;
+
+class Smt2PrinterBlack : public CxxTest::TestSuite
+{
+ public:
+  void setUp() override
+  {
+    d_nodeManager = new NodeManager(nullptr, d_options);
+    d_scope = new NodeManagerScope(d_nodeManager);
+    d_intType = d_nodeManager->integerType();
+    d_x = mkConstant("x", d_intType);
+    d_y = mkConstant("y", d_intType);
+  }
+
+  void tearDown() override
+  {
+    d_x = Node::null();
+    d_y = Node::null();
+    d_intType = TypeNode::null();
+    delete d_scope;
+    delete d_nodeManager;
+  }
+
+  void testLetify()
+  {
+    Node f = mkConstant("f",
+                        d_nodeManager->mkFunctionType(d_intType, d_intType));
+    Node fx = d_nodeManager->mkNode(APPLY_UF, f, d_x);
+    Node fffx = d_nodeManager->mkNode(
+        APPLY_UF, f, d_nodeManager->mkNode(APPLY_UF, f, fx));
+    Node fy = d_nodeManager->mkNode(APPLY_UF, f, d_y);
+    Node n = d_nodeManager->mkNode(OR,
+                                   d_nodeManager->mkNode(EQUAL, fffx, d_x),
+                                   d_nodeManager->mkNode(EQUAL, fffx, d_y),
+                                   d_nodeManager->mkNode(EQUAL, fx, fy));
+
+    TS_ASSERT_EQUALS(
+        toString(n, 0),
+        "(or (= (f (f (f x))) x) (= (f (f (f x))) y) (= (f x) (f y)))");
+    // (f x) occurs in the definition of (f (f (f x))) only, hence only once
+    TS_ASSERT_EQUALS(toString(n, 1),
+                     "(let ((_let_0 (f x))) (let ((_let_1 (f (f _let_0)))) "
+                     "(or (= _let_1 x) (= _let_1 y) (= _let_0 (f y)))))");
+    TS_ASSERT_EQUALS(toString(n, 2),
+                     "(let ((_let_0 (f x))) (or (= (f (f _let_0)) x) "
+                     "(= (f (f _let_0)) y) (= _let_0 (f y))))");
+    TS_ASSERT_EQUALS(toString(n, 3), toString(n, 0));
+  }
+
+  void testReservedNames()
+  {
+    Node let0 = mkConstant("_let_0", d_intType);
+    Node xy = d_nodeManager->mkNode(MULT, d_x, d_y);
+    Node n = d_nodeManager->mkNode(AND,
+                                   d_nodeManager->mkNode(EQUAL, xy, xy),
+                                   d_nodeManager->mkNode(EQUAL, xy, let0));
+    TS_ASSERT_EQUALS(toString(n, 1),
+                     "(let ((_let_1 (* x y))) (and (= _let_1 _let_1) "
+                     "(= _let_1 _let_0)))");
+  }
+
+  void testBinderScopes()
+  {
+    TypeNode boolType = d_nodeManager->booleanType();
+    Node a = mkConstant("a", boolType);
+    Node b = mkConstant("b", boolType);
+    Node ab = d_nodeManager->mkNode(AND, a, b);
+    Node ba = d_nodeManager->mkNode(AND, b, a);
+    Node z = d_nodeManager->mkBoundVar("z", d_intType);
+    Node zx = d_nodeManager->mkNode(PLUS, z, d_x);
+    Node zero = d_nodeManager->mkConst(Rational(0));
+    Node body = d_nodeManager->mkNode(
+        AND,
+        ab,
+        ba,
+        ba,
+        d_nodeManager->mkNode(GT, d_nodeManager->mkNode(MULT, zx, zx), zero));
+    Node q = d_nodeManager->mkNode(
+        FORALL, d_nodeManager->mkNode(BOUND_VAR_LIST, z), body);
+    Node n = d_nodeManager->mkNode(AND, ab, ab, q, q);
+
+    // the bindings of the body are introduced below the binder, since they
+    // may contain its variable, and the body may refer to outer bindings
+    TS_ASSERT_EQUALS(toString(n, 1),
+                     "(let ((_let_0 (and a b))) (let ((_let_1 (forall "
+                     "((z Int)) (let ((_let_2 (and b a))) (let ((_let_3 "
+                     "(+ z x))) (and _let_0 _let_2 _let_2 "
+                     "(> (* _let_3 _let_3) 0)))) ))) "
+                     "(and _let_0 _let_0 _let_1 _let_1)))");
+  }
+
+  void testDeepDag()
+  {
+    // a term whose tree has 2^10000 nodes, but its DAG only 2 * 10000
+    Node n = d_x;
+    for (unsigned i = 0; i < 10000; i++)
+    {
+      n = d_nodeManager->mkNode(PLUS, n, d_nodeManager->mkNode(MULT, n, d_y));
+    }
+    string s = toString(n, 1);
+    TS_ASSERT_EQUALS(s.compare(0, 30, "(let ((_let_0 (+ x (* x y)))) "), 0);
+    TS_ASSERT_LESS_THAN(s.size(), 10000u * 60);
+  }
+
+ private:
+  Node mkConstant(const string& name, TypeNode type)
+  {
+    return d_nodeManager->mkSkolem(
+        name, type, "", NodeManager::SKOLEM_EXACT_NAME);
+  }
+
+  static string toString(TNode n, int dag)
+  {
+    stringstream ss;
+    ss << Node::setlanguage(language::output::LANG_SMTLIB_V2_6)
+       << Node::dag(dag) << n;
+    return ss.str();
+  }
+
+  Options d_options;
+  NodeManager* d_nodeManager;
+  NodeManagerScope* d_scope;
+  TypeNode d_intType;
+  Node d_x;
+  Node d_y;
+}; /* class Smt2PrinterBlack */
@@ -0,0 +1,84 @@
+/*********************                                                        */
+/*! \file char_set_black.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of sets of code points
+ **
+ ** Black box testing of sets of code points represented by intervals.
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include <vector>
+
+#include "theory/strings/char_set.h"
+
+using namespace CVC4::theory::strings;
+
+class CharSetBlack : public CxxTest::TestSuite
+{
+ public:
+  void testInsert()
+  {
+    CharSet cs;
+    TS_ASSERT(cs.empty());
+    cs.insertRange(10, 20);
+    cs.insertRange(30, 40);
+    TS_ASSERT_EQUALS(cs.getIntervals().size(), 2);
+    TS_ASSERT_EQUALS(cs.size(), 22);
+    // adjacent intervals are merged
+    cs.insert(21);
+    TS_ASSERT_EQUALS(cs.getIntervals().size(), 2);
+    TS_ASSERT_EQUALS(cs.getIntervals()[0], CharSet::Interval(10, 21));
+    // an interval overlapping both
+    cs.insertRange(15, 29);
+    TS_ASSERT_EQUALS(cs.getIntervals().size(), 1);
+    TS_ASSERT_EQUALS(cs.getIntervals()[0], CharSet::Interval(10, 40));
+    cs.insert(0);
+    cs.insert(100);
+    TS_ASSERT_EQUALS(cs.getIntervals().size(), 3);
+    TS_ASSERT(cs.contains(0));
+    TS_ASSERT(!cs.contains(1));
+    TS_ASSERT(cs.contains(10));
+    TS_ASSERT(cs.contains(40));
+    TS_ASSERT(!cs.contains(41));
+    TS_ASSERT(cs.contains(100));
+    TS_ASSERT(!cs.contains(101));
+  }
+
+  void testLargeRanges()
+  {
+    // the full Unicode alphabet is a single interval
+    CharSet cs;
+    cs.insertRange(0, 196607);
+    TS_ASSERT_EQUALS(cs.getIntervals().size(), 1);
+    TS_ASSERT_EQUALS(cs.size(), 196608);
+    CharSet cs2;
+    cs2.insertRange(97, 122);
+    cs2.insertAll(cs);
+    TS_ASSERT_EQUALS(cs2, cs);
+  }
+
+  void testIntersect()
+  {
+    CharSet cs1;
+    cs1.insertRange(0, 10);
+    cs1.insertRange(20, 30);
+    CharSet cs2;
+    cs2.insertRange(5, 25);
+    cs2.insert(30);
+    CharSet cs = cs1.intersect(cs2);
+    std::vector<CharSet::Interval> expected = {
+        CharSet::Interval(5, 10),
+        CharSet::Interval(20, 25),
+        CharSet::Interval(30, 30)};
+    TS_ASSERT_EQUALS(cs.getIntervals(), expected);
+    TS_ASSERT_EQUALS(cs2.intersect(cs1), cs);
+    TS_ASSERT(cs1.intersect(CharSet()).empty());
+  }
+};
@@ -0,0 +1,165 @@
+/*********************                                                        */
+/*! \file equality_engine_white.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief White box testing of the equality engine
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "context/context.h"
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "smt/smt_engine.h"
+#include "smt/smt_engine_scope.h"
+#include "theory/uf/equality_engine.h"
+
+using namespace CVC4;
+using namespace CVC4::context;
+using namespace CVC4::smt;
+using namespace CVC4::theory;
+using namespace CVC4::theory::eq;
+
+class EqualityEngineWhite : public CxxTest::TestSuite
+{
+ public:
+  void setUp() override
+  {
+    d_em = new ExprManager();
+    d_smt = new SmtEngine(d_em);
+    d_scope = new SmtScope(d_smt);
+    d_nm = NodeManager::currentNM();
+    d_context = new Context();
+    d_ee = new EqualityEngine(d_context, "EqualityEngineWhite", false);
+  }
+
+  void tearDown() override
+  {
+    delete d_ee;
+    delete d_context;
+    delete d_scope;
+    delete d_smt;
+    delete d_em;
+  }
+
+  void testExplanationPaths()
+  {
+    TypeNode u = d_nm->mkSort("U");
+    std::vector<Node> x;
+    for (unsigned i = 0; i < 6; i++)
+    {
+      x.push_back(d_nm->mkSkolem("x", u));
+      d_ee->addTerm(x.back());
+    }
+    // x0 = x1 = x2 = x3 = x4, merged in an order that forces rerooting
+    Node eq01 = assertEq(x[0], x[1]);
+    Node eq23 = assertEq(x[2], x[3]);
+    Node eq34 = assertEq(x[3], x[4]);
+    Node eq12 = assertEq(x[1], x[2]);
+
+    assertExplanation(x[0], x[4], {eq01, eq12, eq23, eq34});
+    assertExplanation(x[4], x[0], {eq01, eq12, eq23, eq34});
+    assertExplanation(x[2], x[4], {eq23, eq34});
+    // cached explanations are the same
+    assertExplanation(x[0], x[4], {eq01, eq12, eq23, eq34});
+
+    d_context->push();
+    Node eq50 = assertEq(x[5], x[0]);
+    assertExplanation(x[5], x[3], {eq50, eq01, eq12, eq23});
+    d_context->pop();
+
+    TS_ASSERT(!d_ee->areEqual(x[5], x[0]));
+    assertExplanation(x[4], x[1], {eq12, eq23, eq34});
+
+    // the same equality explained differently after backtracking
+    d_context->push();
+    Node eq54 = assertEq(x[5], x[4]);
+    assertExplanation(x[5], x[3], {eq54, eq34});
+    assertExplanation(x[5], x[0], {eq54, eq34, eq23, eq12, eq01});
+    d_context->pop();
+  }
+
+  void testExplanationCongruence()
+  {
+    TypeNode u = d_nm->mkSort("U");
+    Node f = d_nm->mkSkolem("f", d_nm->mkFunctionType(u, u));
+    Node a = d_nm->mkSkolem("a", u);
+    Node b = d_nm->mkSkolem("b", u);
+    Node c = d_nm->mkSkolem("c", u);
+    d_ee->addFunctionKind(kind::APPLY_UF);
+    Node fa = d_nm->mkNode(kind::APPLY_UF, f, a);
+    Node fb = d_nm->mkNode(kind::APPLY_UF, f, b);
+    d_ee->addTerm(fa);
+    d_ee->addTerm(fb);
+    d_ee->addTerm(c);
+
+    Node eqfac = assertEq(fa, c);
+    d_context->push();
+    Node eqab = assertEq(a, b);
+    TS_ASSERT(d_ee->areEqual(fb, c));
+    assertExplanation(fb, c, {eqab, eqfac});
+    d_context->pop();
+    TS_ASSERT(!d_ee->areEqual(fb, c));
+  }
+
+  void testNodeIdMap()
+  {
+    TypeNode u = d_nm->mkSort("U");
+    std::vector<Node> x;
+    NodeIdMap map;
+    for (EqualityNodeId i = 0; i < 1000; i++)
+    {
+      x.push_back(d_nm->mkSkolem("x", u));
+      TS_ASSERT(!map.contains(x.back()));
+      map.insert(x.back(), i);
+    }
+    for (EqualityNodeId i = 0; i < 1000; i++)
+    {
+      TS_ASSERT_EQUALS(map.find(x[i]), i);
+    }
+    // erase every other term, in reverse order as done on backtracking
+    for (EqualityNodeId i = 1000; i > 0; i -= 2)
+    {
+      map.erase(x[i - 1]);
+    }
+    for (EqualityNodeId i = 0; i < 1000; i++)
+    {
+      TS_ASSERT_EQUALS(map.find(x[i]), i % 2 == 0 ? i : null_id);
+    }
+  }
+
+ private:
+  Node assertEq(Node a, Node b)
+  {
+    Node eq = a.eqNode(b);
+    d_ee->assertEquality(eq, true, eq);
+    return eq;
+  }
+
+  void assertExplanation(Node a, Node b, std::vector<Node> expected)
+  {
+    TS_ASSERT(d_ee->areEqual(a, b));
+    std::vector<TNode> assumptions;
+    d_ee->explainEquality(a, b, true, assumptions);
+    std::vector<Node> exp(assumptions.begin(), assumptions.end());
+    std::sort(exp.begin(), exp.end());
+    exp.erase(std::unique(exp.begin(), exp.end()), exp.end());
+    std::sort(expected.begin(), expected.end());
+    TS_ASSERT_EQUALS(exp, expected);
+  }
+
+  ExprManager* d_em;
+  SmtEngine* d_smt;
+  SmtScope* d_scope;
+  NodeManager* d_nm;
+  Context* d_context;
+  EqualityEngine* d_ee;
+};
@@ -0,0 +1,241 @@
+/*********************                                                        */
+/*! \file regexp_dfa_black.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Unit tests for automata for constant regular expressions
+ **
+ ** Unit tests for automata for constant regular expressions.
+ **/
+
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "smt/smt_engine.h"
+#include "smt/smt_engine_scope.h"
+#include "theory/strings/regexp_dfa.h"
+#include "theory/strings/regexp_entail.h"
+
+#include <cxxtest/TestSuite.h>
+#include <memory>
+#include <vector>
+
+using namespace CVC4;
+using namespace CVC4::kind;
+using namespace CVC4::smt;
+using namespace CVC4::theory;
+using namespace CVC4::theory::strings;
+
+class RegexpDfaBlack : public CxxTest::TestSuite
+{
+ public:
+  RegexpDfaBlack() {}
+
+  void setUp() override
+  {
+    Options opts;
+    opts.setOutputLanguage(language::output::LANG_SMTLIB_V2);
+    d_em = new ExprManager(opts);
+    d_smt = new SmtEngine(d_em);
+    d_scope = new SmtScope(d_smt);
+    d_smt->push();
+
+    d_nm = NodeManager::currentNM();
+  }
+
+  void tearDown() override
+  {
+    delete d_scope;
+    delete d_smt;
+    delete d_em;
+  }
+
+  Node str(const char* s)
+  {
+    return d_nm->mkNode(STRING_TO_REGEXP, d_nm->mkConst(String(s)));
+  }
+
+  /** All strings over {a, b, c} of length at most n */
+  std::vector<String> allStrings(unsigned n)
+  {
+    std::vector<String> res;
+    res.push_back(String(""));
+    for (size_t i = 0; i < res.size(); i++)
+    {
+      if (res[i].size() < n)
+      {
+        for (const char* c : {"a", "b", "c"})
+        {
+          res.push_back(res[i].concat(String(c)));
+        }
+      }
+    }
+    return res;
+  }
+
+  void testAgreesWithBacktracking()
+  {
+    Node sigma = d_nm->mkNode(REGEXP_SIGMA, std::vector<Node>{});
+    Node a = str("a");
+    Node b = str("b");
+    Node ab = str("ab");
+    Node empty = str("");
+    Node range = d_nm->mkNode(
+        REGEXP_RANGE, d_nm->mkConst(String("a")), d_nm->mkConst(String("b")));
+    std::vector<Node> res = {
+        d_nm->mkNode(REGEXP_STAR, sigma),
+        d_nm->mkNode(REGEXP_CONCAT, a, d_nm->mkNode(REGEXP_STAR, sigma), b),
+        d_nm->mkNode(REGEXP_STAR, d_nm->mkNode(REGEXP_UNION, ab, b)),
+        d_nm->mkNode(REGEXP_CONCAT, d_nm->mkNode(REGEXP_STAR, range), sigma),
+        d_nm->mkNode(REGEXP_UNION, empty, d_nm->mkNode(REGEXP_STAR, a)),
+        d_nm->mkNode(REGEXP_CONCAT,
+                     d_nm->mkNode(REGEXP_STAR, d_nm->mkNode(REGEXP_STAR, a)),
+                     b),
+        d_nm->mkNode(REGEXP_EMPTY, std::vector<Node>{}),
+        d_nm->mkNode(REGEXP_INTER,
+                     d_nm->mkNode(REGEXP_STAR, sigma),
+                     d_nm->mkNode(REGEXP_COMPLEMENT, a))};
+    std::vector<String> strs = allStrings(5);
+    RegExpDfaCache cache;
+    for (const Node& r : res)
+    {
+      for (String& s : strs)
+      {
+        for (unsigned i = 0; i <= s.size(); i++)
+        {
+          TS_ASSERT_EQUALS(RegExpEntail::testConstStringInRegExp(s, i, r),
+                           RegExpEntail::testConstStringInRegExp(s, i, r, cache));
+        }
+      }
+    }
+  }
+
+  void testLoop()
+  {
+    Node loop =
+        d_nm->mkNode(REGEXP_LOOP, d_nm->mkConst(RegExpLoop(2, 3)), str("ab"));
+    std::unique_ptr<RegExpDfa> dfa = RegExpDfa::compile(loop);
+    TS_ASSERT(dfa != nullptr);
+    TS_ASSERT(!dfa->accepts(String("ab")));
+    TS_ASSERT(dfa->accepts(String("abab")));
+    TS_ASSERT(dfa->accepts(String("ababab")));
+    TS_ASSERT(!dfa->accepts(String("abababab")));
+    TS_ASSERT(dfa->accepts(String("xabab"), 1));
+  }
+
+  void testShortestMatch()
+  {
+    Node r = d_nm->mkNode(
+        REGEXP_CONCAT, str("a"), d_nm->mkNode(REGEXP_STAR, str("b")), str("c"));
+    std::unique_ptr<RegExpDfa> dfa = RegExpDfa::compile(r);
+    TS_ASSERT(dfa != nullptr);
+    TS_ASSERT_EQUALS(dfa->shortestMatch(String("abbcac")), 4);
+    TS_ASSERT_EQUALS(dfa->shortestMatch(String("abbcac"), 4), 2);
+    TS_ASSERT_EQUALS(dfa->shortestMatch(String("abbcac"), 1), -1);
+  }
+
+  void testWitness()
+  {
+    Node sigma = d_nm->mkNode(REGEXP_SIGMA, std::vector<Node>{});
+    Node aStar = d_nm->mkNode(REGEXP_STAR, str("a"));
+    Node bStar = d_nm->mkNode(REGEXP_STAR, str("b"));
+    Node aPlus = d_nm->mkNode(REGEXP_CONCAT, str("a"), aStar);
+    Node sigmaStar = d_nm->mkNode(REGEXP_STAR, sigma);
+    std::unique_ptr<RegExpDfa> da = RegExpDfa::compile(aPlus);
+    std::unique_ptr<RegExpDfa> db = RegExpDfa::compile(bStar);
+    std::unique_ptr<RegExpDfa> ds = RegExpDfa::compile(sigmaStar);
+    // a+ and b* are disjoint
+    TS_ASSERT_EQUALS(RegExpDfa::hasWitness(*da, *db, false), 0);
+    // a+ is included in (_)*, but not vice versa
+    TS_ASSERT_EQUALS(RegExpDfa::hasWitness(*da, *ds, true), 0);
+    TS_ASSERT_EQUALS(RegExpDfa::hasWitness(*ds, *da, true), 1);
+  }
+
+  void testGetWitness()
+  {
+    Node ac = d_nm->mkNode(REGEXP_RANGE,
+                           d_nm->mkConst(String("a")),
+                           d_nm->mkConst(String("c")));
+    Node acStar = d_nm->mkNode(REGEXP_STAR, ac);
+    Node aStar = d_nm->mkNode(REGEXP_STAR, str("a"));
+    std::unique_ptr<RegExpDfa> dac = RegExpDfa::compile(acStar);
+    std::unique_ptr<RegExpDfa> da = RegExpDfa::compile(aStar);
+    std::vector<RegExpDfa*> dfas = {dac.get(), da.get()};
+    std::vector<bool> complement = {false, true};
+    std::set<String> exclude;
+    String w;
+    // the smallest string of length 2 in [a-c]* and not in a*
+    TS_ASSERT_EQUALS(
+        RegExpDfa::getWitness(dfas, complement, 2, 256, exclude, w), 1);
+    TS_ASSERT_EQUALS(w, String("ab"));
+    TS_ASSERT(dac->accepts(w) && !da->accepts(w));
+    // excluded strings are skipped
+    exclude.insert(w);
+    TS_ASSERT_EQUALS(
+        RegExpDfa::getWitness(dfas, complement, 2, 256, exclude, w), 1);
+    TS_ASSERT_EQUALS(w, String("ac"));
+    // all strings in a* are in [a-c]*
+    complement = {true, false};
+    TS_ASSERT_EQUALS(
+        RegExpDfa::getWitness(dfas, complement, 3, 256, exclude, w), 0);
+    // the only string of length 0 is the empty string
+    complement = {false, false};
+    TS_ASSERT_EQUALS(
+        RegExpDfa::getWitness(dfas, complement, 0, 256, exclude, w), 1);
+    TS_ASSERT_EQUALS(w, String(""));
+  }
+
+  void testUnsupported()
+  {
+    Node r = d_nm->mkNode(REGEXP_COMPLEMENT, str("a"));
+    TS_ASSERT(RegExpDfa::compile(r) == nullptr);
+    Node x = d_nm->mkSkolem("x", d_nm->stringType());
+    TS_ASSERT(RegExpDfa::compile(d_nm->mkNode(STRING_TO_REGEXP, x)) == nullptr);
+  }
+
+  void testPathological()
+  {
+    // (a*)*b on a long string of a's, which takes exponential time for the
+    // backtracking matcher
+    Node r = d_nm->mkNode(
+        REGEXP_CONCAT,
+        d_nm->mkNode(REGEXP_STAR, d_nm->mkNode(REGEXP_STAR, str("a"))),
+        str("b"));
+    String s(std::string(100000, 'a'));
+    String sb = s.concat(String("b"));
+    RegExpDfaCache cache;
+    TS_ASSERT(!RegExpEntail::testConstStringInRegExp(s, 0, r, cache));
+    TS_ASSERT(RegExpEntail::testConstStringInRegExp(sb, 0, r, cache));
+  }
+
+  void testCacheEviction()
+  {
+    RegExpDfaCache cache;
+    Node a = str("a");
+    std::shared_ptr<RegExpDfa> da = cache.getDfa(a);
+    TS_ASSERT(da != nullptr);
+    // a stays cached while it is used
+    for (unsigned i = 0; i < 1000; i++)
+    {
+      cache.getDfa(str(std::to_string(i).c_str()));
+      TS_ASSERT_EQUALS(cache.getDfa(a), da);
+    }
+    // the automaton of a is evicted once many others have been used since,
+    // but the copy we own stays valid
+    for (unsigned i = 0; i < 1000; i++)
+    {
+      cache.getDfa(str(std::to_string(i).c_str()));
+    }
+    TS_ASSERT_DIFFERS(cache.getDfa(a), da);
+    TS_ASSERT(da->accepts(String("a")));
+  }
+
+ private:
+  ExprManager* d_em;
+  SmtEngine* d_smt;
+  SmtScope* d_scope;
+  NodeManager* d_nm;
+};
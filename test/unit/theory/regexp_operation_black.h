@@ -146,6 +146,35 @@ class RegexpOperationBlack : public CxxTest::TestSuite
     doesNotInclude(_a_abc_, _abc_);
   }
 
+  void testIntersectRanges()
+  {
+    Node sigma = d_nm->mkNode(REGEXP_SIGMA, std::vector<Node>{});
+    Node sigmaStar = d_nm->mkNode(REGEXP_STAR, sigma);
+    Node az = d_nm->mkNode(REGEXP_RANGE,
+                           d_nm->mkConst(String("a")),
+                           d_nm->mkConst(String("z")));
+    Node b = d_nm->mkNode(STRING_TO_REGEXP, d_nm->mkConst(String("b")));
+    Node c = d_nm->mkNode(STRING_TO_REGEXP, d_nm->mkConst(String("c")));
+
+    // the intersection of (a-z).* and .b is (a-z)b, which is computed without
+    // enumerating all characters of the alphabet
+    Node r1 = Rewriter::rewrite(d_nm->mkNode(REGEXP_CONCAT, az, sigmaStar));
+    Node r2 = Rewriter::rewrite(d_nm->mkNode(REGEXP_CONCAT, sigma, b));
+    bool spflag = false;
+    Node r = d_regExpOpr->intersect(r1, r2, spflag);
+    TS_ASSERT(!spflag);
+    Node azb = d_nm->mkNode(REGEXP_CONCAT, az, b);
+    includes(r, azb);
+    includes(azb, r);
+
+    // the intersection of (a-z)b and c.* is cb
+    Node r3 = Rewriter::rewrite(d_nm->mkNode(REGEXP_CONCAT, c, sigmaStar));
+    r = d_regExpOpr->intersect(Rewriter::rewrite(azb), r3, spflag);
+    Node cb = d_nm->mkNode(REGEXP_CONCAT, c, b);
+    includes(r, cb);
+    includes(cb, r);
+  }
+
  private:
   ExprManager* d_em;
   SmtEngine* d_smt;
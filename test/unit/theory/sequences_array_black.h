@@ -0,0 +1,165 @@
+/*********************                                                        */
+/*! \file sequences_array_black.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of seq.nth and seq.update
+ **
+ ** Black box testing of the rewriting and solving of seq.nth and seq.update.
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include <sstream>
+#include <vector>
+
+#include "expr/expr_sequence.h"
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "smt/smt_engine.h"
+#include "smt/smt_engine_scope.h"
+#include "theory/rewriter.h"
+
+using namespace CVC4;
+using namespace CVC4::kind;
+using namespace CVC4::smt;
+using namespace CVC4::theory;
+
+class SequencesArrayBlack : public CxxTest::TestSuite
+{
+ public:
+  void setUp() override
+  {
+    d_em = new ExprManager();
+    d_smt = new SmtEngine(d_em);
+    d_scope = new SmtScope(d_smt);
+    d_smt->setLogic("ALL");
+    d_smt->setOption("strings-exp", SExpr(true));
+    d_smt->setOption("incremental", SExpr(true));
+    d_smt->finalOptionsAreSet();
+    d_nm = NodeManager::currentNM();
+    d_intSeq = d_nm->mkSequenceType(d_nm->integerType());
+  }
+
+  void tearDown() override
+  {
+    d_intSeq = TypeNode::null();
+    delete d_scope;
+    delete d_smt;
+    delete d_em;
+  }
+
+  void testRewrite()
+  {
+    Node s = mkSeq({1, 2, 3});
+    Node x = d_nm->mkSkolem("x", d_nm->integerType());
+    Node y = d_nm->mkSkolem("y", d_intSeq);
+    Node i = d_nm->mkSkolem("i", d_nm->integerType());
+    TS_ASSERT_EQUALS(Rewriter::rewrite(d_nm->mkNode(SEQ_NTH, s, mkInt(1))),
+                     mkInt(2));
+    Node nthOut = d_nm->mkNode(SEQ_NTH, s, mkInt(3));
+    TS_ASSERT_EQUALS(Rewriter::rewrite(nthOut), nthOut);
+    TS_ASSERT_EQUALS(
+        Rewriter::rewrite(
+            d_nm->mkNode(SEQ_NTH, d_nm->mkNode(SEQ_UNIT, x), mkInt(0))),
+        x);
+    TS_ASSERT_EQUALS(
+        Rewriter::rewrite(
+            d_nm->mkNode(STRING_UPDATE, s, mkInt(1), mkSeq({5, 6, 7}))),
+        mkSeq({1, 5, 6}));
+    TS_ASSERT_EQUALS(
+        Rewriter::rewrite(d_nm->mkNode(STRING_UPDATE, y, mkInt(-1), s)), y);
+    TS_ASSERT_EQUALS(
+        Rewriter::rewrite(d_nm->mkNode(STRING_LENGTH,
+                                       d_nm->mkNode(STRING_UPDATE, y, i, s))),
+        d_nm->mkNode(STRING_LENGTH, y));
+  }
+
+  void testPrint()
+  {
+    Node s = d_nm->mkVar("s", d_nm->stringType());
+    Node t = d_nm->mkVar("t", d_nm->stringType());
+    Node y = d_nm->mkVar("y", d_intSeq);
+    Node i = d_nm->mkVar("i", d_nm->integerType());
+    TS_ASSERT_EQUALS(toSmt2(d_nm->mkNode(STRING_UPDATE, s, i, t)),
+                     "(str.update s i t)");
+    TS_ASSERT_EQUALS(toSmt2(d_nm->mkNode(STRING_UPDATE, y, i, y)),
+                     "(seq.update y i y)");
+  }
+
+  void testReadOverWrite()
+  {
+    Node s = d_nm->mkSkolem("s", d_intSeq);
+    Node j = d_nm->mkSkolem("j", d_nm->integerType());
+    Node u = d_nm->mkNode(
+        STRING_UPDATE, s, mkInt(1), d_nm->mkNode(SEQ_UNIT, mkInt(5)));
+    Node lens = d_nm->mkNode(GT, d_nm->mkNode(STRING_LENGTH, s), mkInt(3));
+    // the written position
+    checkEntails(lens, d_nm->mkNode(SEQ_NTH, u, mkInt(1)).eqNode(mkInt(5)));
+    // positions that are not written
+    Node jBounds = d_nm->mkNode(
+        AND, d_nm->mkNode(GEQ, j, mkInt(2)), d_nm->mkNode(LT, j, mkInt(4)));
+    Node nthuj = d_nm->mkNode(SEQ_NTH, u, j);
+    Node nthsj = d_nm->mkNode(SEQ_NTH, s, j);
+    checkEntails(d_nm->mkNode(AND, lens, jBounds), nthuj.eqNode(nthsj));
+    // reads of a concatenation
+    Node t = d_nm->mkSkolem("t", d_intSeq);
+    Node c = d_nm->mkNode(STRING_CONCAT, t, d_nm->mkNode(SEQ_UNIT, mkInt(3)));
+    Node tEmpty = d_nm->mkNode(STRING_LENGTH, t).eqNode(mkInt(0));
+    checkEntails(tEmpty, d_nm->mkNode(SEQ_NTH, c, mkInt(0)).eqNode(mkInt(3)));
+  }
+
+  void testSat()
+  {
+    Node s = d_nm->mkSkolem("s", d_intSeq);
+    Node u = d_nm->mkNode(
+        STRING_UPDATE, s, mkInt(0), d_nm->mkNode(SEQ_UNIT, mkInt(5)));
+    d_smt->push();
+    d_smt->assertFormula(
+        d_nm->mkNode(SEQ_NTH, u, mkInt(1)).eqNode(mkInt(7)).toExpr());
+    d_smt->assertFormula(
+        d_nm->mkNode(GT, d_nm->mkNode(STRING_LENGTH, s), mkInt(1)).toExpr());
+    TS_ASSERT_EQUALS(d_smt->checkSat().isSat(), Result::SAT);
+    d_smt->pop();
+  }
+
+ private:
+  Node mkInt(int i) { return d_nm->mkConst(Rational(i)); }
+
+  Node mkSeq(const std::vector<int>& vals)
+  {
+    std::vector<Expr> elems;
+    for (int v : vals)
+    {
+      elems.push_back(mkInt(v).toExpr());
+    }
+    return d_nm->mkConst(ExprSequence(d_intSeq.toType(), elems));
+  }
+
+  std::string toSmt2(Node n)
+  {
+    std::stringstream ss;
+    n.toStream(ss, -1, false, 0, language::output::LANG_SMTLIB_V2_6);
+    return ss.str();
+  }
+
+  /** Check that assumption entails conclusion */
+  void checkEntails(Node assumption, Node conclusion)
+  {
+    d_smt->push();
+    d_smt->assertFormula(assumption.toExpr());
+    d_smt->assertFormula(conclusion.negate().toExpr());
+    TS_ASSERT_EQUALS(d_smt->checkSat().isSat(), Result::UNSAT);
+    d_smt->pop();
+  }
+
+  ExprManager* d_em;
+  SmtEngine* d_smt;
+  SmtScope* d_scope;
+  NodeManager* d_nm;
+  TypeNode d_intSeq;
+};
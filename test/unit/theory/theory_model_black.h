@@ -0,0 +1,132 @@
+/*********************                                                        */
+/*! \file theory_model_black.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of the theory model
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include "context/context.h"
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "smt/smt_engine.h"
+#include "smt/smt_engine_scope.h"
+#include "theory/theory_model.h"
+#include "theory/uf/equality_engine.h"
+
+using namespace CVC4;
+using namespace CVC4::context;
+using namespace CVC4::kind;
+using namespace CVC4::smt;
+using namespace CVC4::theory;
+using namespace CVC4::theory::eq;
+
+class TheoryModelBlack : public CxxTest::TestSuite
+{
+ public:
+  void setUp() override
+  {
+    d_em = new ExprManager();
+    d_smt = new SmtEngine(d_em);
+    d_scope = new SmtScope(d_smt);
+    d_nm = NodeManager::currentNM();
+    d_context = new Context();
+    d_model = new TheoryModel(d_context, "TheoryModelBlack", true);
+  }
+
+  void tearDown() override
+  {
+    delete d_model;
+    delete d_context;
+    delete d_scope;
+    delete d_smt;
+    delete d_em;
+  }
+
+  void testAssertEqualityEngines()
+  {
+    TypeNode u = d_nm->mkSort("U");
+    Node a = d_nm->mkSkolem("a", u);
+    Node b = d_nm->mkSkolem("b", u);
+    Node c = d_nm->mkSkolem("c", u);
+    Node d = d_nm->mkSkolem("d", u);
+    Node f = d_nm->mkSkolem("f", d_nm->mkFunctionType(u, u));
+    Node fa = d_nm->mkNode(APPLY_UF, f, a);
+    Node fc = d_nm->mkNode(APPLY_UF, f, c);
+    Node p = d_nm->mkSkolem("p", d_nm->booleanType());
+
+    // the equality engines of two theories that share a, c and f(a)
+    Context ctx;
+    EqualityEngine ee1(&ctx, "ee1", false);
+    ee1.addFunctionKind(APPLY_UF);
+    EqualityEngine ee2(&ctx, "ee2", false);
+    ee2.addFunctionKind(APPLY_UF);
+    for (const Node& n : {a, b, c, d, fa})
+    {
+      ee1.addTerm(n);
+    }
+    ee1.addTerm(p);
+    ee1.assertEquality(a.eqNode(b), true, d_nm->mkConst(true));
+    ee1.assertEquality(b.eqNode(c), true, d_nm->mkConst(true));
+    ee1.assertPredicate(p, true, d_nm->mkConst(true));
+    for (const Node& n : {a, c, fa, fc})
+    {
+      ee2.addTerm(n);
+    }
+    ee2.assertEquality(a.eqNode(c), true, d_nm->mkConst(true));
+    TS_ASSERT(ee2.areEqual(fa, fc));
+
+    TS_ASSERT(d_model->assertEqualityEngine(&ee1));
+    TS_ASSERT(d_model->isEntailedEqual(a, c));
+    TS_ASSERT(d_model->isEntailedEqual(p, d_nm->mkConst(true)));
+    TS_ASSERT(!d_model->isEntailedEqual(a, d));
+    // f(c) is new, but its equality with f(a) follows by congruence
+    TS_ASSERT(d_model->assertEqualityEngine(&ee2));
+    TS_ASSERT(d_model->areEqual(fa, fc));
+    TS_ASSERT(d_model->areEqual(a, c));
+    TS_ASSERT(!d_model->areEqual(a, d));
+  }
+
+  void testLazyModelBuild()
+  {
+    // the number of equivalence classes that are assigned values when
+    // requesting the value of one of ten distinct variables
+    TS_ASSERT_EQUALS(getValueEqcsAssigned(false), 10);
+    TS_ASSERT_EQUALS(getValueEqcsAssigned(true), 1);
+  }
+
+ private:
+  int64_t getValueEqcsAssigned(bool lazy)
+  {
+    ExprManager em;
+    SmtEngine smt(&em);
+    smt.setOption("produce-models", SExpr(true));
+    smt.setOption("lazy-model-build", SExpr(lazy));
+    smt.setLogic("QF_UF");
+    Type u = em.mkSort("U");
+    std::vector<Expr> xs;
+    for (unsigned i = 0; i < 10; i++)
+    {
+      xs.push_back(em.mkVar("x" + std::to_string(i), u));
+    }
+    smt.assertFormula(em.mkExpr(DISTINCT, xs));
+    TS_ASSERT_EQUALS(smt.checkSat(), Result::SAT);
+    smt.getValue(xs[0]);
+    return smt.getStatistic("theory::TheoryEngineModelBuilder::eqcsAssigned")
+        .getIntegerValue()
+        .getLong();
+  }
+
+  ExprManager* d_em;
+  SmtEngine* d_smt;
+  SmtScope* d_scope;
+  NodeManager* d_nm;
+  Context* d_context;
+  TheoryModel* d_model;
+}; /* class TheoryModelBlack */
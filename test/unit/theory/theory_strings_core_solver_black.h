@@ -0,0 +1,61 @@
+/*********************                                                        */
+/*! \file theory_strings_core_solver_black.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of the core solver of the theory of strings.
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include "expr/expr_manager.h"
+#include "smt/smt_engine.h"
+#include "util/rational.h"
+#include "util/string.h"
+
+using namespace CVC4;
+using namespace CVC4::kind;
+
+class TheoryStringsCoreSolverBlack : public CxxTest::TestSuite
+{
+ public:
+  void testNormalFormsReused()
+  {
+    TS_ASSERT_LESS_THAN(0, getNormalFormsReused(true));
+    TS_ASSERT_EQUALS(getNormalFormsReused(false), 0);
+  }
+
+ private:
+  /**
+   * The number of normal forms that are reused when checking the same
+   * formula twice, with --strings-inc-nf if incNf is true.
+   */
+  int64_t getNormalFormsReused(bool incNf)
+  {
+    ExprManager em;
+    SmtEngine smt(&em);
+    smt.setOption("strings-inc-nf", SExpr(incNf));
+    smt.setOption("incremental", SExpr(true));
+    smt.setLogic("QF_SLIA");
+    Type str = em.stringType();
+    Expr x = em.mkVar("x", str);
+    Expr y = em.mkVar("y", str);
+    Expr z = em.mkVar("z", str);
+    Expr a = em.mkConst(String("a"));
+    smt.assertFormula(x.eqExpr(em.mkExpr(STRING_CONCAT, y, a, z)));
+    smt.assertFormula(em.mkExpr(
+        EQUAL, em.mkExpr(STRING_LENGTH, x), em.mkConst(Rational(5))));
+    smt.assertFormula(y.eqExpr(z).notExpr());
+    for (unsigned i = 0; i < 2; i++)
+    {
+      TS_ASSERT_EQUALS(smt.checkSat(), Result::SAT);
+    }
+    return smt.getStatistic("theory::strings::normalFormsReused")
+        .getIntegerValue()
+        .getLong();
+  }
+};
@@ -0,0 +1,76 @@
+/*********************                                                        */
+/*! \file theory_strings_regexp_solver_black.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of the regular expression solver of the theory
+ ** of strings.
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include "expr/expr_manager.h"
+#include "smt/smt_engine.h"
+#include "util/rational.h"
+#include "util/string.h"
+
+using namespace CVC4;
+using namespace CVC4::kind;
+
+class TheoryStringsRegExpSolverBlack : public CxxTest::TestSuite
+{
+ public:
+  void testModelFind()
+  {
+    TS_ASSERT_LESS_THAN(0, getRegExpModelValues(true));
+    TS_ASSERT_EQUALS(getRegExpModelValues(false), 0);
+  }
+
+ private:
+  /**
+   * The number of model values found by searching the automata of regular
+   * expression memberships, with --strings-model-find if modelFind is true.
+   */
+  int64_t getRegExpModelValues(bool modelFind)
+  {
+    ExprManager em;
+    SmtEngine smt(&em);
+    smt.setOption("strings-exp", SExpr(true));
+    smt.setOption("strings-model-find", SExpr(modelFind));
+    smt.setOption("produce-models", SExpr(true));
+    smt.setOption("check-models", SExpr(true));
+    smt.setLogic("QF_SLIA");
+    Type str = em.stringType();
+    Expr x = em.mkVar("x", str);
+    Expr y = em.mkVar("y", str);
+    Expr ac = em.mkExpr(
+        REGEXP_RANGE, em.mkConst(String("a")), em.mkConst(String("c")));
+    Expr ab = em.mkExpr(
+        REGEXP_RANGE, em.mkConst(String("a")), em.mkConst(String("b")));
+    Expr allStar =
+        em.mkExpr(REGEXP_STAR, em.mkExpr(REGEXP_SIGMA, std::vector<Expr>{}));
+    // x in [a-c]+, y in "ab".*, y not in [a-b]*
+    smt.assertFormula(
+        em.mkExpr(STRING_IN_REGEXP, x, em.mkExpr(REGEXP_PLUS, ac)));
+    smt.assertFormula(em.mkExpr(
+        STRING_IN_REGEXP,
+        y,
+        em.mkExpr(REGEXP_CONCAT,
+                  em.mkExpr(STRING_TO_REGEXP, em.mkConst(String("ab"))),
+                  allStar)));
+    smt.assertFormula(
+        em.mkExpr(STRING_IN_REGEXP, y, em.mkExpr(REGEXP_STAR, ab)).notExpr());
+    smt.assertFormula(x.eqExpr(y).notExpr());
+    Expr lenx = em.mkExpr(STRING_LENGTH, x);
+    smt.assertFormula(lenx.eqExpr(em.mkConst(Rational(5))));
+    smt.assertFormula(em.mkExpr(STRING_LENGTH, y).eqExpr(lenx));
+    TS_ASSERT_EQUALS(smt.checkSat(), Result::SAT);
+    return smt.getStatistic("theory::strings::regexpModelValues")
+        .getIntegerValue()
+        .getLong();
+  }
+};
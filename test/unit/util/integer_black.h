@@ -16,6 +16,7 @@
 
 #include <cxxtest/TestSuite.h>
 
+#include <iomanip>
 #include <limits>
 #include <sstream>
 
@@ -281,6 +282,15 @@ public:
     string res = ss.str();
 
     TS_ASSERT_EQUALS(res, large.toString());
+
+    ss.str("");
+    Integer negative = -large;
+    ss << negative << ' ' << Integer(-42) << ' ' << Integer(0);
+    TS_ASSERT_EQUALS(ss.str(), negative.toString() + " -42 0");
+
+    ss.str("");
+    ss << setw(5) << Integer(42) << '|';
+    TS_ASSERT_EQUALS(ss.str(), "   42|");
   }
 
   void testBaseInference() {
@@ -0,0 +1,92 @@
+/*********************                                                        */
+/*! \file ostream_util_black.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of the ostream utilities.
+ **
+ ** Black box testing of the ostream utilities.
+ **/
+
+#include <cxxtest/TestSuite.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "util/ostream_util.h"
+#include "util/rational.h"
+
+using namespace CVC4;
+using namespace std;
+
+class OstreamUtilBlack : public CxxTest::TestSuite
+{
+ public:
+  void setUp() override
+  {
+    char name[] = "/tmp/cvc4_ostream_util_XXXXXX";
+    int fd = mkstemp(name);
+    TS_ASSERT(fd >= 0);
+    close(fd);
+    d_filename = name;
+  }
+
+  void tearDown() override { unlink(d_filename.c_str()); }
+
+  void testFdOstream()
+  {
+    // more than the size of the buffer, in small and in large writes
+    string large(3 << 20, 'x');
+    stringstream expected;
+    {
+      FdOstream out(d_filename);
+      TS_ASSERT(out.good());
+      for (unsigned i = 0; i < 100000; i++)
+      {
+        out << "(define-fun x" << i << " () Int " << i << ")\n";
+        expected << "(define-fun x" << i << " () Int " << i << ")\n";
+      }
+      out << large << endl;
+      expected << large << endl;
+      out << Rational(-7, 3);
+      expected << "-7/3";
+      TS_ASSERT(out.good());
+    }
+    TS_ASSERT_EQUALS(readFile(), expected.str());
+  }
+
+  void testFdOstreamFlush()
+  {
+    FdOstream out(d_filename);
+    out << "(check-sat)" << endl;
+    TS_ASSERT_EQUALS(readFile(), "(check-sat)\n");
+    out << "sat";
+    TS_ASSERT_EQUALS(readFile(), "(check-sat)\n");
+    out << flush;
+    TS_ASSERT_EQUALS(readFile(), "(check-sat)\nsat");
+  }
+
+  void testFdOstreamBadFile()
+  {
+    FdOstream out("/nonexistent-directory/file");
+    TS_ASSERT(!out);
+  }
+
+ private:
+  string readFile() const
+  {
+    ifstream in(d_filename);
+    stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+  }
+
+  string d_filename;
+}; /* class OstreamUtilBlack */
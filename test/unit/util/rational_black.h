@@ -44,4 +44,15 @@ public:
     TS_ASSERT_THROWS( Rational::fromDecimal("Hello, world!");, const std::invalid_argument& );
   }
 
+  void testOutput() {
+    Rational reduced(canReduce);
+    stringstream ss;
+    ss << reduced;
+    TS_ASSERT_EQUALS(ss.str(), reduced.toString());
+
+    ss.str("");
+    ss << Rational(-3, 6) << ' ' << Rational(10, 5) << ' ' << Rational(0);
+    TS_ASSERT_EQUALS(ss.str(), "-1/2 2 0");
+  }
+
 };
@@ -0,0 +1,78 @@
+/*********************                                                        */
+/*! \file string_black.h
+ ** \verbatim
+ ** This file is part of the CVC4 project.
+ ** Copyright (c) 2009-2020 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Black box testing of CVC4::String
+ **
+ ** Black box testing of CVC4::String.
+ **/
+
+#include <cxxtest/TestSuite.h>
+
+#include "util/string.h"
+
+using namespace CVC4;
+using namespace CVC4::strings;
+
+class StringBlack : public CxxTest::TestSuite
+{
+ public:
+  void testEmpty()
+  {
+    String e1;
+    String e2("");
+    String e3(std::vector<unsigned>{});
+    TS_ASSERT(e1.empty());
+    TS_ASSERT_EQUALS(e1, e2);
+    TS_ASSERT_EQUALS(e1, e3);
+    TS_ASSERT_EQUALS(e1.hash(), e2.hash());
+    TS_ASSERT_EQUALS(e1.concat(e2), e3);
+  }
+
+  void testHash()
+  {
+    StringHashFunction h;
+    String abc("abc");
+    String ab("ab");
+    TS_ASSERT_EQUALS(h(abc), h(ab.concat(String("c"))));
+    TS_ASSERT_EQUALS(h(abc.substr(1)), h(String("bc")));
+    TS_ASSERT_DIFFERS(h(abc), h(ab));
+    TS_ASSERT_DIFFERS(String("ba"), ab);
+  }
+
+  void testCopy()
+  {
+    String s("abcdef");
+    String t = s;
+    TS_ASSERT_EQUALS(&s.getVec(), &t.getVec());
+    t = t.concat(String("g"));
+    TS_ASSERT_EQUALS(s, String("abcdef"));
+    TS_ASSERT_EQUALS(t, String("abcdefg"));
+    TS_ASSERT_EQUALS(s.substr(0, 6), s);
+    TS_ASSERT_EQUALS(s.substr(2, 3), String("cde"));
+    TS_ASSERT_EQUALS(s.replace(String("cd"), String("x")), String("abxef"));
+  }
+
+  void testMove()
+  {
+    String s("abc");
+    String t(std::move(s));
+    TS_ASSERT_EQUALS(t, String("abc"));
+    // the moved-from string is the empty string
+    TS_ASSERT(s.empty());
+    TS_ASSERT_EQUALS(s.size(), 0);
+    TS_ASSERT_EQUALS(s.hash(), String().hash());
+    TS_ASSERT(s.getVec().empty());
+    s = std::move(t);
+    TS_ASSERT_EQUALS(s, String("abc"));
+    TS_ASSERT(t.empty());
+    TS_ASSERT_EQUALS(t, String());
+    s = std::move(s);
+    TS_ASSERT_EQUALS(s, String("abc"));
+  }
+};